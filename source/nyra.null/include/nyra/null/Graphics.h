@@ -0,0 +1,185 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_NULL_GRAPHICS_H_
+#define NYRA_NULL_GRAPHICS_H_
+
+#include <unordered_set>
+#include <stdint.h>
+#include <nyra/GraphicsInterface.h>
+#include <nyra/null/Texture.h>
+
+namespace nyra
+{
+namespace null
+{
+/*
+ *  \class Graphics
+ *  \brief Graphics that draw nothing. Renderables still report what they
+ *         would have drawn, so the counters show the work a real backend
+ *         would be handed while the CPU cost is only the game logic and
+ *         scene preparation. The counters add up until they are reset.
+ */
+class Graphics : public GraphicsInterface
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates graphics with all counters at zero.
+     */
+    Graphics();
+
+    /*
+     *  \fn clear
+     *  \brief Counts the clear.
+     *
+     *  \param handle Ignored since nothing is drawn.
+     */
+    void clear(WindowsHandle handle) override;
+
+    /*
+     *  \fn present
+     *  \brief Counts the frame.
+     */
+    void present() override;
+
+    /*
+     *  \fn screenshot
+     *  \brief There are no pixels to save.
+     *
+     *  \param pathname Ignored.
+     *  \throw std::runtime_error Always.
+     */
+    void screenshot(const std::string& pathname) const override;
+
+    /*
+     *  \fn draw
+     *  \brief Counts a draw call. Switching to a different texture counts
+     *         as a bind, and the first bind of a texture counts its pixels
+     *         as uploaded.
+     *
+     *  \param texture The texture the draw uses.
+     *  \param numVertices The number of vertices in the draw.
+     */
+    inline void draw(const Texture& texture, size_t numVertices)
+    {
+        ++mNumDraws;
+        mNumVertices += numVertices;
+        getStats().addDraw(&texture, numVertices);
+        if (texture.getId() != mBoundTexture || !mHasBoundTexture)
+        {
+            bind(texture);
+        }
+    }
+
+    /*
+     *  \fn resetCounters
+     *  \brief Sets every counter back to zero. Textures that have already
+     *         been uploaded stay uploaded.
+     */
+    void resetCounters();
+
+    /*
+     *  \fn getNumFrames
+     *  \brief Gets how many frames have been presented.
+     *
+     *  \return The number of frames.
+     */
+    inline uint64_t getNumFrames() const
+    {
+        return mNumFrames;
+    }
+
+    /*
+     *  \fn getNumClears
+     *  \brief Gets how many times the graphics have been cleared.
+     *
+     *  \return The number of clears.
+     */
+    inline uint64_t getNumClears() const
+    {
+        return mNumClears;
+    }
+
+    /*
+     *  \fn getNumDraws
+     *  \brief Gets how many draw calls have been made.
+     *
+     *  \return The number of draw calls.
+     */
+    inline uint64_t getNumDraws() const
+    {
+        return mNumDraws;
+    }
+
+    /*
+     *  \fn getNumVertices
+     *  \brief Gets how many vertices have been drawn.
+     *
+     *  \return The number of vertices.
+     */
+    inline uint64_t getNumVertices() const
+    {
+        return mNumVertices;
+    }
+
+    /*
+     *  \fn getNumTextureBinds
+     *  \brief Gets how many times the texture changed between draws.
+     *
+     *  \return The number of binds.
+     */
+    inline uint64_t getNumTextureBinds() const
+    {
+        return mNumTextureBinds;
+    }
+
+    /*
+     *  \fn getNumBytesUploaded
+     *  \brief Gets how many bytes of texture data would have been sent to
+     *         the GPU.
+     *
+     *  \return The number of bytes.
+     */
+    inline uint64_t getNumBytesUploaded() const
+    {
+        return mNumBytesUploaded;
+    }
+
+private:
+    void bind(const Texture& texture);
+
+    std::unordered_set<uint32_t> mUploaded;
+    uint32_t mBoundTexture;
+    bool mHasBoundTexture;
+    uint64_t mNumFrames;
+    uint64_t mNumClears;
+    uint64_t mNumDraws;
+    uint64_t mNumVertices;
+    uint64_t mNumTextureBinds;
+    uint64_t mNumBytesUploaded;
+};
+}
+}
+
+#endif
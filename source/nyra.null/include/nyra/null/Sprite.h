@@ -0,0 +1,140 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_NULL_SPRITE_H_
+#define NYRA_NULL_SPRITE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <nyra/RenderableBase.h>
+#include <nyra/SpriteInterface.h>
+#include <nyra/SpriteSheet.h>
+#include <nyra/null/Texture.h>
+#include <nyra/null/Graphics.h>
+
+namespace nyra
+{
+namespace null
+{
+/*
+ *  \class Sprite
+ *  \brief A sprite that only reports a four vertex draw to the null
+ *         graphics. Frames behave the same as in the other backends.
+ */
+class Sprite : public RenderableBase<Sprite, Graphics>,
+               public SpriteInterface
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates a sprite object.
+     *
+     *  \param pathname The pathname to the texture on disk.
+     *  \param numFrames The number of frames in the x and y direction.
+     */
+    Sprite(const std::string& pathname,
+           const Vector2U& numFrames = Vector2U(1, 1));
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates a sprite from the frames of a sprite sheet.
+     *
+     *  \param sheet The sheet describing the texture and its frames.
+     */
+    Sprite(const SpriteSheet& sheet);
+
+    using RenderableBase<Sprite, Graphics>::render;
+
+    /*
+     *  \fn render
+     *  \brief Counts the sprite with the null graphics.
+     *
+     *  \param matrix The positional information about the object.
+     *  \param graphics The graphics to render to.
+     */
+    inline void render(const Matrix& /* matrix */,
+                       Graphics& graphics)
+    {
+        graphics.draw(*mTexture, 4);
+    }
+
+    /*
+     *  \fn getSize
+     *  \brief Gets the overall size of the object when it is at its
+     *         default starting dimensions and rotation.
+     *
+     *  \return The size of the object.
+     */
+    Vector2U getSize() const override;
+
+    /*
+     *  \fn setFrame
+     *  \brief Sets a portion of the sprite as the current frame.
+     *
+     *  \param index The frame number to use for rendering.
+     */
+    void setFrame(size_t index) override;
+
+    /*
+     *  \fn setFrame
+     *  \brief Sets a named frame from the sprite sheet as the current
+     *         frame.
+     *
+     *  \param name The name of the frame.
+     */
+    void setFrame(const std::string& name);
+
+    /*
+     *  \fn getNumFrames
+     *  \brief Gets the number of frames in the sprite sheet.
+     *
+     *  \return The number of frames.
+     */
+    inline size_t getNumFrames() const
+    {
+        return mFrameSizes.size();
+    }
+
+    /*
+     *  \fn getFrame
+     *  \brief Gets the frame currently being shown.
+     *
+     *  \return The frame index.
+     */
+    inline size_t getFrame() const
+    {
+        return mFrame;
+    }
+
+private:
+    std::shared_ptr<const Texture> mTexture;
+    std::vector<Vector2U> mFrameSizes;
+    std::unordered_map<std::string, size_t> mFrameNames;
+    size_t mFrame;
+};
+}
+}
+
+#endif
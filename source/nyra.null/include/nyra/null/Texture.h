@@ -0,0 +1,104 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_NULL_TEXTURE_H_
+#define NYRA_NULL_TEXTURE_H_
+
+#include <memory>
+#include <string>
+#include <stdint.h>
+#include <nyra/Vector2.h>
+
+namespace nyra
+{
+namespace null
+{
+/*
+ *  \class Texture
+ *  \brief Stands in for a texture without holding any pixels. Only the PNG
+ *         header is read, so loading costs almost nothing while the size
+ *         is still known for sprite frames and upload accounting.
+ */
+class Texture
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Reads the size of a texture on disk.
+     *
+     *  \param pathname The pathname to the PNG on disk.
+     *  \throw std::runtime_error If the file is not a PNG.
+     */
+    Texture(const std::string& pathname);
+
+    /*
+     *  \fn load
+     *  \brief Loads a texture that is shared by everything that loads the
+     *         same file while any of them are alive, see ResourceCache.
+     *
+     *  \param pathname The pathname to the PNG on disk.
+     *  \return The shared texture.
+     */
+    static std::shared_ptr<const Texture> load(const std::string& pathname);
+
+    /*
+     *  \fn getSize
+     *  \brief Gets the size of the texture.
+     *
+     *  \return The size in pixels.
+     */
+    inline const Vector2U& getSize() const
+    {
+        return mSize;
+    }
+
+    /*
+     *  \fn getNumBytes
+     *  \brief Gets how much memory the texture would use on a GPU.
+     *
+     *  \return The size of the RGBA pixels in bytes.
+     */
+    inline size_t getNumBytes() const
+    {
+        return static_cast<size_t>(mSize.product()) * 4;
+    }
+
+    /*
+     *  \fn getId
+     *  \brief Gets an id that is unique for each load.
+     *
+     *  \return The texture id.
+     */
+    inline uint32_t getId() const
+    {
+        return mId;
+    }
+
+private:
+    Vector2U mSize;
+    uint32_t mId;
+};
+}
+}
+
+#endif
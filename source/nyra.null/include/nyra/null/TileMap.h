@@ -0,0 +1,91 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_NULL_TILE_MAP_H_
+#define NYRA_NULL_TILE_MAP_H_
+
+#include <memory>
+#include <nyra/TileMapInterface.h>
+#include <nyra/RenderableBase.h>
+#include <nyra/null/Texture.h>
+#include <nyra/null/Graphics.h>
+
+namespace nyra
+{
+namespace null
+{
+/*
+ *  \class TileMap
+ *  \brief A grid of tiles that reports a single draw with four vertices
+ *         per cell, the same as the SFML tile map.
+ */
+class TileMap : public TileMapInterface,
+                public RenderableBase<TileMap, Graphics>
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Checks that every tile is inside the tileset.
+     *
+     *  \param numTiles The number of tiles in the x and y direction.
+     *  \param tileSize The size of a single tile in pixels. Neither side
+     *         can be zero.
+     *  \param pathname The pathname to the tileset texture on disk.
+     *  \param tiles The tile index of each cell, stored row by row.
+     */
+    TileMap(const Vector2U& numTiles,
+            const Vector2U& tileSize,
+            const std::string& pathname,
+            const uint16_t* tiles);
+
+    using RenderableBase<TileMap, Graphics>::render;
+
+    /*
+     *  \fn render
+     *  \brief Counts the tile map with the null graphics.
+     *
+     *  \param matrix The positional information about the object.
+     *  \param graphics The graphics to render to.
+     */
+    inline void render(const Matrix& /* matrix */, Graphics& graphics)
+    {
+        graphics.draw(*mTexture, mNumTiles.product() * 4);
+    }
+
+    /*
+     *  \fn getSize
+     *  \brief Gets the overall size of the object when it is at its
+     *         default starting dimensions and rotation.
+     *
+     *  \return The size of the object.
+     */
+    Vector2U getSize() const override;
+
+private:
+    Vector2U mNumTiles;
+    Vector2U mTileSize;
+    std::shared_ptr<const Texture> mTexture;
+};
+}
+}
+#endif
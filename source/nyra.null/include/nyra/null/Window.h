@@ -0,0 +1,174 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_NULL_WINDOW_H_
+#define NYRA_NULL_WINDOW_H_
+
+#include <nyra/WindowInterface.h>
+
+namespace nyra
+{
+namespace null
+{
+/*
+ *  \class Window
+ *  \brief A window that only exists in memory. It stays open until it
+ *         is closed or its frame limit is reached, so the engine loop can
+ *         run flat out without a display.
+ */
+class Window : public WindowInterface
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates an open window.
+     *
+     *  \param title The title of the window.
+     *  \param size The size of the framebuffer in pixels.
+     *  \param position The position of the window. This is only stored.
+     *  \param fullscreen The fullscreen setting. This is only stored.
+     */
+    Window(const std::string& title,
+           const Vector2U& size,
+           const Vector2I& position,
+           bool fullscreen);
+
+    /*
+     *  \fn update
+     *  \brief There are no messages to poll. This counts frames and
+     *         closes the window once the frame limit is reached.
+     *
+     *  \return False once the window has been closed.
+     */
+    bool update() override;
+
+    /*
+     *  \fn getTitle
+     *  \brief Returns the title of the window.
+     *
+     *  \return The current title.
+     */
+    std::string getTitle() const override;
+
+    /*
+     *  \fn setTitle
+     *  \brief Sets the window title.
+     *
+     *  \param title The desired title.
+     */
+    void setTitle(const std::string& title) override;
+
+    /*
+     *  \fn getSize
+     *  \brief Returns the window size.
+     *
+     *  \return The current window size.
+     */
+    Vector2U getSize() const override;
+
+    /*
+     *  \fn setSize
+     *  \brief Sets the window size.
+     *
+     *  \param size The desired window size.
+     */
+    void setSize(const Vector2U& size) override;
+
+    /*
+     *  \fn getPosition
+     *  \brief Gets the stored position of the window.
+     *
+     *  \return The current window position.
+     */
+    Vector2I getPosition() const override;
+
+    /*
+     *  \fn setPosition
+     *  \brief Stores a new window position.
+     *
+     *  \param position The desired window position.
+     */
+    void setPosition(const Vector2I& position) override;
+
+    /*
+     *  \fn isOpen
+     *  \brief Used to determine if the window is opened. A closed window
+     *         should be treated as invalid.
+     *
+     *  \return True if the window is still open.
+     */
+    bool isOpen() const override;
+
+    /*
+     *  \fn getFullscreen
+     *  \brief Gets the stored fullscreen setting.
+     *
+     *  \return True if the window is in fullscreen mode.
+     */
+    bool getFullscreen() const override;
+
+    /*
+     *  \fn setFullscreen
+     *  \brief Stores a new fullscreen setting.
+     *
+     *  \param fullscreen The desired fullscreen setting.
+     */
+    void setFullscreen(bool fullscreen) override;
+
+    /*
+     *  \fn getHandle
+     *  \brief Gets a handle that is unique to the window.
+     *
+     *  \return A pointer to this window or 0 if the window is closed.
+     */
+    WindowsHandle getHandle() const override;
+
+    /*
+     *  \fn close
+     *  \brief Closes the window so the next update ends the engine loop.
+     */
+    void close();
+
+    /*
+     *  \fn setFrameLimit
+     *  \brief Closes the window after a number of updates. This lets
+     *         EngineBase::run be used for a fixed number of frames.
+     *
+     *  \param numFrames The number of updates that return true, counting
+     *         from now. Zero removes the limit.
+     */
+    void setFrameLimit(size_t numFrames);
+
+private:
+    std::string mTitle;
+    Vector2U mSize;
+    Vector2I mPosition;
+    bool mFullscreen;
+    bool mOpen;
+    bool mHasFrameLimit;
+    size_t mFramesLeft;
+};
+}
+}
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/null/Graphics.h>
+#include <stdexcept>
+
+namespace nyra
+{
+namespace null
+{
+//===========================================================================//
+Graphics::Graphics() :
+    mBoundTexture(0),
+    mHasBoundTexture(false)
+{
+    resetCounters();
+}
+
+//===========================================================================//
+void Graphics::clear(WindowsHandle /* handle */)
+{
+    getStats().beginClear();
+    ++mNumClears;
+    getStats().endClear();
+}
+
+//===========================================================================//
+void Graphics::present()
+{
+    getStats().beginPresent();
+    ++mNumFrames;
+    getStats().endPresent();
+}
+
+//===========================================================================//
+void Graphics::screenshot(const std::string& /* pathname */) const
+{
+    throw std::runtime_error("The null graphics have nothing to save");
+}
+
+//===========================================================================//
+void Graphics::resetCounters()
+{
+    mNumFrames = 0;
+    mNumClears = 0;
+    mNumDraws = 0;
+    mNumVertices = 0;
+    mNumTextureBinds = 0;
+    mNumBytesUploaded = 0;
+}
+
+//===========================================================================//
+void Graphics::bind(const Texture& texture)
+{
+    mBoundTexture = texture.getId();
+    mHasBoundTexture = true;
+    ++mNumTextureBinds;
+    if (mUploaded.insert(texture.getId()).second)
+    {
+        mNumBytesUploaded += texture.getNumBytes();
+    }
+}
+}
+}
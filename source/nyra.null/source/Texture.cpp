@@ -0,0 +1,81 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/null/Texture.h>
+#include <atomic>
+#include <fstream>
+#include <stdexcept>
+#include <string.h>
+#include <nyra/ResourceCache.h>
+
+namespace
+{
+//===========================================================================//
+uint32_t readBigEndian(const uint8_t* bytes)
+{
+    return (static_cast<uint32_t>(bytes[0]) << 24) |
+           (static_cast<uint32_t>(bytes[1]) << 16) |
+           (static_cast<uint32_t>(bytes[2]) << 8) |
+           static_cast<uint32_t>(bytes[3]);
+}
+
+//===========================================================================//
+nyra::Vector2U readPngSize(const std::string& pathname)
+{
+    // The signature is followed by the IHDR chunk, which starts with the
+    // width and height
+    static const uint8_t SIGNATURE[] = {0x89, 'P', 'N', 'G',
+                                        '\r', '\n', 0x1A, '\n'};
+    uint8_t header[24];
+    std::ifstream file(pathname.c_str(), std::ios::binary);
+    if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+        memcmp(header, SIGNATURE, sizeof(SIGNATURE)) != 0 ||
+        memcmp(header + 12, "IHDR", 4) != 0)
+    {
+        throw std::runtime_error("Unable to read PNG header: " + pathname);
+    }
+    return nyra::Vector2U(readBigEndian(header + 16),
+                          readBigEndian(header + 20));
+}
+}
+
+namespace nyra
+{
+namespace null
+{
+//===========================================================================//
+Texture::Texture(const std::string& pathname) :
+    mSize(readPngSize(pathname))
+{
+    static std::atomic<uint32_t> nextId(0);
+    mId = nextId++;
+}
+
+//===========================================================================//
+std::shared_ptr<const Texture> Texture::load(const std::string& pathname)
+{
+    static ResourceCache<Texture> cache;
+    return cache.load(pathname);
+}
+}
+}
@@ -0,0 +1,135 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/null/Window.h>
+
+namespace nyra
+{
+namespace null
+{
+//===========================================================================//
+Window::Window(const std::string& title,
+               const Vector2U& size,
+               const Vector2I& position,
+               bool fullscreen) :
+    mTitle(title),
+    mSize(size),
+    mPosition(position),
+    mFullscreen(fullscreen),
+    mOpen(true),
+    mHasFrameLimit(false),
+    mFramesLeft(0)
+{
+}
+
+//===========================================================================//
+bool Window::update()
+{
+    if (mOpen && mHasFrameLimit)
+    {
+        if (mFramesLeft == 0)
+        {
+            mOpen = false;
+        }
+        else
+        {
+            --mFramesLeft;
+        }
+    }
+    return mOpen;
+}
+
+//===========================================================================//
+std::string Window::getTitle() const
+{
+    return mTitle;
+}
+
+//===========================================================================//
+void Window::setTitle(const std::string& title)
+{
+    mTitle = title;
+}
+
+//===========================================================================//
+Vector2U Window::getSize() const
+{
+    return mSize;
+}
+
+//===========================================================================//
+void Window::setSize(const Vector2U& size)
+{
+    mSize = size;
+}
+
+//===========================================================================//
+Vector2I Window::getPosition() const
+{
+    return mPosition;
+}
+
+//===========================================================================//
+void Window::setPosition(const Vector2I& position)
+{
+    mPosition = position;
+}
+
+//===========================================================================//
+bool Window::isOpen() const
+{
+    return mOpen;
+}
+
+//===========================================================================//
+bool Window::getFullscreen() const
+{
+    return mFullscreen;
+}
+
+//===========================================================================//
+void Window::setFullscreen(bool fullscreen)
+{
+    mFullscreen = fullscreen;
+}
+
+//===========================================================================//
+WindowsHandle Window::getHandle() const
+{
+    return mOpen ? reinterpret_cast<WindowsHandle>(this) : 0;
+}
+
+//===========================================================================//
+void Window::close()
+{
+    mOpen = false;
+}
+
+//===========================================================================//
+void Window::setFrameLimit(size_t numFrames)
+{
+    mHasFrameLimit = numFrames > 0;
+    mFramesLeft = numFrames;
+}
+}
+}
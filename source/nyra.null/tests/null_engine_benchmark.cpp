@@ -0,0 +1,119 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <nyra/Constants.h>
+#include <nyra/EngineBase.h>
+#include <nyra/Scene.h>
+#include <nyra/Transform.h>
+#include <nyra/null/Window.h>
+#include <nyra/null/Graphics.h>
+#include <nyra/null/Sprite.h>
+
+namespace
+{
+typedef std::chrono::high_resolution_clock Clock;
+
+//===========================================================================//
+double milliseconds(const Clock::time_point& start)
+{
+    const std::chrono::duration<double, std::milli> elapsed =
+            Clock::now() - start;
+    return elapsed.count();
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        // Nothing reaches a GPU, so this is the CPU cost of moving the
+        // sprites, updating the scene and walking it to render
+        const nyra::Vector2F world(4096.0f, 4096.0f);
+        const size_t numSprites = 20000;
+        const size_t frames = 200;
+        nyra::EngineBase<nyra::null::Window, nyra::null::Graphics> engine(
+                "Null Benchmark", nyra::Vector2U(1920, 1080));
+        engine.setIdleTime(0.0);
+        nyra::null::Sprite sprite(
+                nyra::Constants::APP_PATH +
+                "../data/unittests/sfml_sprite_animation.png",
+                nyra::Vector2U(6, 3));
+        nyra::Scene scene(nyra::RectF(nyra::Vector2F(0.0f, 0.0f), world));
+
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> x(0.0f, world.x);
+        std::uniform_real_distribution<float> y(0.0f, world.y);
+        std::uniform_real_distribution<float> velocity(-2.0f, 2.0f);
+        std::vector<nyra::Transform> transforms(numSprites);
+        std::vector<nyra::Vector2F> velocities(numSprites);
+        std::vector<size_t> ids(numSprites);
+        for (size_t ii = 0; ii < numSprites; ++ii)
+        {
+            transforms[ii].setSize(sprite.getSize());
+            transforms[ii].setPosition(x(random), y(random));
+            velocities[ii] = nyra::Vector2F(velocity(random),
+                                            velocity(random));
+            ids[ii] = scene.add(sprite, transforms[ii]);
+        }
+        engine.setScene(&scene);
+
+        const auto start = Clock::now();
+        for (size_t frame = 0; frame < frames; ++frame)
+        {
+            for (size_t ii = 0; ii < numSprites; ++ii)
+            {
+                transforms[ii].setPosition(transforms[ii].getPosition() +
+                                           velocities[ii]);
+                scene.markMoved(ids[ii]);
+            }
+            engine.renderFrame();
+        }
+        const double time = milliseconds(start);
+
+        nyra::null::Graphics& graphics = engine.getGraphics();
+        const uint64_t presented = std::max<uint64_t>(
+                graphics.getNumFrames(), 1);
+        std::cout << numSprites << " moving sprites: "
+                  << time / frames << " ms per frame\n"
+                  << "Per frame: "
+                  << graphics.getNumDraws() / presented << " draws, "
+                  << graphics.getNumVertices() / presented << " vertices\n"
+                  << "Total: " << graphics.getNumTextureBinds()
+                  << " texture binds, " << graphics.getNumBytesUploaded()
+                  << " bytes uploaded\n";
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Caught standard exception from " <<
+            ex.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Caught unnamed Unwanted exception" << std::endl;
+    }
+}
@@ -0,0 +1,163 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+#include <nyra/null/Window.h>
+#include <nyra/null/Graphics.h>
+#include <nyra/null/Sprite.h>
+#include <nyra/null/TileMap.h>
+#include <nyra/Constants.h>
+#include <nyra/EngineBase.h>
+#include <nyra/Image.h>
+#include <nyra/Scene.h>
+#include <nyra/Transform.h>
+
+namespace
+{
+//===========================================================================//
+const std::string LOGO(nyra::Constants::APP_PATH +
+                       "../data/unittests/sfml-logo-small.png");
+const std::string LENA(nyra::Constants::APP_PATH +
+                       "../data/unittests/lena.png");
+}
+
+//===========================================================================//
+TEST(NullGraphicsTest, Texture)
+{
+    // Only the header is read but the size matches a full decode
+    const nyra::null::Texture texture(LOGO);
+    const nyra::Image image(LOGO);
+    EXPECT_EQ(texture.getSize(), image.getSize());
+    EXPECT_EQ(texture.getNumBytes(), image.getSize().product() * 4);
+
+    EXPECT_EQ(nyra::null::Texture::load(LOGO),
+              nyra::null::Texture::load(LOGO));
+    EXPECT_NE(nyra::null::Texture::load(LOGO)->getId(),
+              nyra::null::Texture::load(LENA)->getId());
+
+    // Once every handle is gone the next load reads the file again
+    const uint32_t id = nyra::null::Texture::load(LENA)->getId();
+    EXPECT_NE(nyra::null::Texture::load(LENA)->getId(), id);
+    EXPECT_THROW(nyra::null::Texture(nyra::Constants::APP_PATH +
+                                     "../data/unittests/sprite_sheet.json"),
+                 std::runtime_error);
+}
+
+//===========================================================================//
+TEST(NullGraphicsTest, Counters)
+{
+    nyra::null::Graphics graphics;
+    nyra::null::Sprite logo(LOGO, nyra::Vector2U(2, 1));
+    nyra::null::Sprite lena(LENA);
+    const nyra::Matrix matrix;
+    const uint64_t logoBytes = nyra::null::Texture::load(LOGO)->getNumBytes();
+    const uint64_t lenaBytes = nyra::null::Texture::load(LENA)->getNumBytes();
+    EXPECT_EQ(logo.getSize(),
+              nyra::null::Texture::load(LOGO)->getSize() /
+              nyra::Vector2U(2, 1));
+    EXPECT_THROW(logo.setFrame(2), std::runtime_error);
+
+    graphics.clear(0);
+    logo.render(matrix, graphics);
+    logo.render(matrix, graphics);
+    graphics.present();
+    EXPECT_EQ(graphics.getNumClears(), 1);
+    EXPECT_EQ(graphics.getNumFrames(), 1);
+    EXPECT_EQ(graphics.getNumDraws(), 2);
+    EXPECT_EQ(graphics.getNumVertices(), 8);
+    EXPECT_EQ(graphics.getNumTextureBinds(), 1);
+    EXPECT_EQ(graphics.getNumBytesUploaded(), logoBytes);
+
+    // Switching back is another bind but not another upload
+    lena.render(matrix, graphics);
+    logo.render(matrix, graphics);
+    EXPECT_EQ(graphics.getNumTextureBinds(), 3);
+    EXPECT_EQ(graphics.getNumBytesUploaded(), logoBytes + lenaBytes);
+
+    // The virtual path counts the same way
+    nyra::RenderableInterface& renderable = lena;
+    renderable.render(matrix, graphics);
+    EXPECT_EQ(graphics.getNumDraws(), 5);
+
+    graphics.resetCounters();
+    EXPECT_EQ(graphics.getNumDraws(), 0);
+    EXPECT_EQ(graphics.getNumVertices(), 0);
+    lena.render(matrix, graphics);
+    EXPECT_EQ(graphics.getNumTextureBinds(), 0);
+    EXPECT_EQ(graphics.getNumBytesUploaded(), 0);
+
+    // A tile map is one draw with four vertices per cell
+    const std::vector<uint16_t> tiles(12, 0);
+    nyra::null::TileMap map(nyra::Vector2U(4, 3), nyra::Vector2U(16, 16),
+                            LENA, tiles.data());
+    EXPECT_EQ(map.getSize(), nyra::Vector2U(64, 48));
+    map.render(matrix, graphics);
+    EXPECT_EQ(graphics.getNumDraws(), 2);
+    EXPECT_EQ(graphics.getNumVertices(), 4 + 48);
+    EXPECT_THROW(nyra::null::TileMap(nyra::Vector2U(4, 3),
+                                     nyra::Vector2U(0, 16),
+                                     LENA,
+                                     tiles.data()),
+                 std::runtime_error);
+
+    EXPECT_THROW(graphics.screenshot("null.png"), std::runtime_error);
+}
+
+//===========================================================================//
+TEST(NullGraphicsTest, Engine)
+{
+    nyra::EngineBase<nyra::null::Window, nyra::null::Graphics> engine(
+            "Null", nyra::Vector2U(320, 240));
+    nyra::null::Sprite sprite(LOGO);
+    nyra::Scene scene(nyra::RectF(nyra::Vector2F(0.0f, 0.0f),
+                                  nyra::Vector2F(320.0f, 240.0f)));
+    std::vector<nyra::Transform> transforms(10);
+    for (size_t ii = 0; ii < transforms.size(); ++ii)
+    {
+        transforms[ii].setSize(sprite.getSize());
+        transforms[ii].setPosition(nyra::Vector2F(ii * 30.0f, 100.0f));
+        scene.add(sprite, transforms[ii]);
+    }
+
+    // A static scene is drawn once and the rest of the frames are skipped
+    engine.setScene(&scene);
+    engine.setIdleTime(0.0);
+    engine.getWindow().setFrameLimit(5);
+    engine.run();
+    EXPECT_FALSE(engine.getWindow().isOpen());
+    EXPECT_EQ(engine.getWindow().getHandle(), 0);
+    EXPECT_EQ(engine.getNumFrames(), 1);
+    EXPECT_EQ(engine.getNumSkippedFrames(), 4);
+    EXPECT_EQ(engine.getGraphics().getNumFrames(), 1);
+    EXPECT_EQ(engine.getGraphics().getNumDraws(), 10);
+    EXPECT_EQ(engine.getGraphics().getNumTextureBinds(), 1);
+    EXPECT_EQ(engine.getGraphics().getStats().getNumFrames(), 1);
+    EXPECT_EQ(engine.getGraphics().getStats().getLast().drawCalls, 10);
+    EXPECT_EQ(engine.getGraphics().getStats().getLast().vertices, 40);
+
+    engine.invalidate();
+    EXPECT_TRUE(engine.renderFrame());
+    EXPECT_EQ(engine.getGraphics().getNumDraws(), 20);
+}
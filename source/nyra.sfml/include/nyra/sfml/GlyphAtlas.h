@@ -0,0 +1,245 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_SFML_GLYPH_ATLAS_H_
+#define NYRA_SFML_GLYPH_ATLAS_H_
+
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+#include <SFML/Graphics.hpp>
+#include <nyra/Vector2.h>
+
+namespace nyra
+{
+namespace sfml
+{
+/*
+ *  \class GlyphAtlas
+ *  \brief A single texture that glyphs from any font and character size
+ *         are copied into as they are needed. Since all text shares the
+ *         texture, all of it can be drawn with one draw call. The texture
+ *         is split into a grid of equally sized cells, and when it is full
+ *         the least recently used glyph is evicted. Glyphs used since the
+ *         last call to beginFrame are never evicted, so quads that are
+ *         waiting to be drawn stay valid.
+ *
+ *         Glyphs are copied from the font texture on the GPU, so nothing
+ *         is read back. The atlas only bounds the shared texture, each
+ *         sf::Font still keeps its own pages of every glyph it has
+ *         rasterized and never shrinks them.
+ */
+class GlyphAtlas
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates an empty atlas.
+     *
+     *  \param cellSize The size of each cell in pixels. This limits the
+     *         largest glyph the atlas can hold.
+     *  \param numCells The number of cells in the x and y direction.
+     */
+    GlyphAtlas(const Vector2U& cellSize = Vector2U(32, 32),
+               const Vector2U& numCells = Vector2U(32, 32));
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    /*
+     *  \fn find
+     *  \brief Looks up a glyph that is already in the atlas and marks it
+     *         as used this frame.
+     *
+     *  \param font The font of the glyph.
+     *  \param codepoint The unicode codepoint of the glyph.
+     *  \param size The character size in pixels.
+     *  \return The cell holding the glyph, or NO_CELL if it is not in the
+     *          atlas.
+     */
+    size_t find(const sf::Font& font, uint32_t codepoint, uint32_t size);
+
+    /*
+     *  \fn insert
+     *  \brief Copies a glyph that has been rasterized by the font into the
+     *         atlas and marks it as used this frame.
+     *
+     *  \param font The font of the glyph.
+     *  \param codepoint The unicode codepoint of the glyph.
+     *  \param size The character size in pixels.
+     *  \param page The font texture for this character size.
+     *  \param rect The area of the glyph within the page.
+     *  \throw std::runtime_error If the glyph is larger than a cell, or
+     *         every cell has been used this frame.
+     *  \return The cell holding the glyph.
+     */
+    size_t insert(const sf::Font& font,
+                  uint32_t codepoint,
+                  uint32_t size,
+                  const sf::Texture& page,
+                  const sf::IntRect& rect);
+
+    /*
+     *  \fn touch
+     *  \brief Marks a cell as used this frame.
+     *
+     *  \param cell The cell.
+     */
+    inline void touch(size_t cell)
+    {
+        mCells[cell].lastUsed = mFrame;
+    }
+
+    /*
+     *  \fn getGeneration
+     *  \brief Gets a number that changes every time the glyph in a cell is
+     *         replaced. Holding on to a cell and its generation lets a
+     *         glyph be checked without a lookup.
+     *
+     *  \param cell The cell.
+     *  \return The generation of the cell.
+     */
+    inline uint32_t getGeneration(size_t cell) const
+    {
+        return mCells[cell].generation;
+    }
+
+    /*
+     *  \fn getTextureRect
+     *  \brief Gets the area of the texture covered by the glyph in a cell.
+     *
+     *  \param cell The cell.
+     *  \return The area in pixels.
+     */
+    inline const sf::IntRect& getTextureRect(size_t cell) const
+    {
+        return mCells[cell].rect;
+    }
+
+    /*
+     *  \fn getTexture
+     *  \brief Gets the texture all glyphs are drawn from.
+     *
+     *  \return The atlas texture.
+     */
+    inline const sf::Texture& getTexture() const
+    {
+        return mTarget.getTexture();
+    }
+
+    /*
+     *  \fn beginFrame
+     *  \brief Lets the glyphs used up until now be evicted. This should
+     *         be called once per frame, after the previous frame has been
+     *         drawn.
+     */
+    inline void beginFrame()
+    {
+        ++mFrame;
+    }
+
+    /*
+     *  \fn getNumGlyphs
+     *  \brief Gets how many glyphs are in the atlas.
+     *
+     *  \return The number of glyphs.
+     */
+    inline size_t getNumGlyphs() const
+    {
+        return mLookup.size();
+    }
+
+    /*
+     *  \fn getCapacity
+     *  \brief Gets how many glyphs fit in the atlas.
+     *
+     *  \return The number of cells.
+     */
+    inline size_t getCapacity() const
+    {
+        return mCells.size();
+    }
+
+    /*
+     *  \fn getNumEvictions
+     *  \brief Gets how many glyphs have been evicted to make room.
+     *
+     *  \return The number of evictions.
+     */
+    inline size_t getNumEvictions() const
+    {
+        return mNumEvictions;
+    }
+
+    /*
+     *  \fn getDefault
+     *  \brief Gets the atlas that text renderers share when none is
+     *         given.
+     *
+     *  \return The default atlas.
+     */
+    static GlyphAtlas& getDefault();
+
+    static const size_t NO_CELL;
+
+private:
+    struct Key
+    {
+        const sf::Font* font;
+        uint32_t codepoint;
+        uint32_t size;
+
+        bool operator==(const Key& other) const
+        {
+            return font == other.font && codepoint == other.codepoint &&
+                   size == other.size;
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Cell
+    {
+        Key key;
+        sf::IntRect rect;
+        uint64_t lastUsed;
+        uint32_t generation;
+    };
+
+    size_t allocate();
+
+    sf::RenderTexture mTarget;
+    Vector2U mCellSize;
+    std::vector<Cell> mCells;
+    std::unordered_map<Key, size_t, KeyHash> mLookup;
+    std::vector<size_t> mFree;
+    uint64_t mFrame;
+    size_t mNumEvictions;
+};
+}
+}
+
+#endif
@@ -24,7 +24,13 @@
 #ifndef NYRA_SFML_GRAPHICS_H_
 #define NYRA_SFML_GRAPHICS_H_
 
+#include <functional>
+#include <memory>
+#include <vector>
 #include <nyra/GraphicsInterface.h>
+#include <nyra/RenderableInterface.h>
+#include <nyra/DynamicResolution.h>
+#include <nyra/Vector2.h>
 #include <SFML/Graphics.hpp>
 
 namespace nyra
@@ -34,10 +40,21 @@ namespace sfml
 /*
  *  \class GraphicsSFML
  *  \brief A SFML specific graphics renderer.
+ *
+ *         The scene can be rendered at a lower resolution than the window
+ *         to save fill rate. Everything is still positioned in window
+ *         pixels, the frame just renders into a smaller internal target
+ *         that is stretched over the window when it is presented.
  */
 class Graphics : public GraphicsInterface
 {
 public:
+    /*
+     *  \fn Constructor
+     *  \brief Sets up the graphics to render to its window.
+     */
+    Graphics();
+
     /*
      *  \fn clear
      *  \brief Clears a window.
@@ -65,20 +82,251 @@ public:
      */
     void screenshot(const std::string& pathname) const override;
 
+    /*
+     *  \fn setScissor
+     *  \brief Limits clears and draws to an area of the window. SFML has
+     *         no scissor test, so this is done with a view whose viewport
+     *         only covers the area. Clearing draws a black quad over it.
+     *
+     *  \param area The area in pixels.
+     */
+    void setScissor(const RectI& area) override;
+
+    /*
+     *  \fn resetScissor
+     *  \brief Allows clears and draws to cover the entire window again.
+     */
+    void resetScissor() override;
+
+    /*
+     *  \fn screenshot
+     *  \brief Saves a screenshot of an area that can be much larger than
+     *         the window. The scene is rendered offscreen one tile at a
+     *         time and each completed band of rows is streamed to disk, so
+     *         memory use only depends on the image width and tile height.
+     *         The window must have been cleared at least once.
+     *
+     *  \param pathname The pathname of the location to save to. Only PNG
+     *         is supported.
+     *  \param size The size of the area to capture in pixels, starting
+     *         from the top left corner of the scene.
+     *  \param renderScene Called once per tile. This should render the
+     *         entire scene as it would for a normal frame.
+     *  \param tileSize The size of each tile. If this is zero the current
+     *         window size is used.
+     */
+    void screenshot(const std::string& pathname,
+                    const Vector2U& size,
+                    const std::function<void()>& renderScene,
+                    const Vector2U& tileSize = Vector2U(0, 0));
+
     /*
      *  \fn getRenderTarget
-     *  \brief SFML has the draw command attached to the render window.
-     *         This gets that window so things can draw to it.
+     *  \brief SFML has the draw command attached to the render target.
+     *         This gets the target that is currently being rendered to so
+     *         things can draw to it. This is normally the window. Drawing
+     *         through draw instead keeps the render stats accurate.
      *
-     *  \return The render window.
+     *  \return The render target.
      */
-    inline sf::RenderWindow& getRenderTarget()
+    inline sf::RenderTarget& getRenderTarget()
     {
-        return mWindow;
+        return *mTarget;
     }
 
+    /*
+     *  \fn setRenderTarget
+     *  \brief Redirects rendering to another target, such as a render
+     *         texture. Anything rendered afterwards draws to it.
+     *
+     *  \param target The target to render to. This must outlive its use.
+     *  \return The previous target so it can be restored.
+     */
+    inline sf::RenderTarget& setRenderTarget(sf::RenderTarget& target)
+    {
+        sf::RenderTarget& previous = *mTarget;
+        mTarget = &target;
+        if (mTarget != mDefaultTarget)
+        {
+            getStats().addOffscreenPass();
+        }
+        return previous;
+    }
+
+    /*
+     *  \fn setRenderScale
+     *  \brief Sets the resolution the scene renders at, relative to the
+     *         window. This takes effect on the next clear. The internal
+     *         target is made once for the largest scale of the
+     *         controller, or the window size without one, and the scene
+     *         renders into its top left corner. It is only made again
+     *         when the window size changes. A new scale leaves stale
+     *         pixels behind, so partial redraws should be invalidated.
+     *
+     *  \param scale The scale of each axis. 1 renders directly to the
+     *         window.
+     */
+    void setRenderScale(float scale);
+
+    /*
+     *  \fn getRenderScale
+     *  \brief Gets the resolution the scene renders at.
+     *
+     *  \return The scale of each axis.
+     */
+    inline float getRenderScale() const
+    {
+        return mRenderScale;
+    }
+
+    /*
+     *  \fn getRenderSize
+     *  \brief Gets the size of the internal target the scene renders to.
+     *
+     *  \return The size in pixels. This is the window size when the scene
+     *          is not scaled.
+     */
+    Vector2U getRenderSize() const;
+
+    /*
+     *  \fn setResolutionController
+     *  \brief Lets a controller pick the render scale. After every
+     *         present the frame time is handed to the controller and its
+     *         scale is used for the next frame.
+     *
+     *  \param controller The controller or nullptr to keep the scale
+     *         fixed. It must outlive its use.
+     */
+    void setResolutionController(DynamicResolution* controller);
+
+    /*
+     *  \fn isRenderScaled
+     *  \brief Checks if draws are currently going to the scaled internal
+     *         target.
+     *
+     *  \return True if the scene is being rendered at a lower resolution.
+     */
+    inline bool isRenderScaled() const
+    {
+        return mScaled && mTarget == mScaled.get();
+    }
+
+    /*
+     *  \fn renderNative
+     *  \brief Renders an object at the full window resolution, on top of
+     *         the scene. This is meant for UI that should stay sharp. When
+     *         the scene is scaled the object is rendered during present,
+     *         after the scene has been stretched over the window, so it
+     *         must stay alive until then.
+     *
+     *  \param renderable The object to render.
+     *  \param matrix The positional information about the object.
+     */
+    void renderNative(RenderableInterface& renderable, const Matrix& matrix);
+
+    /*
+     *  \fn draw
+     *  \brief Draws an SFML sprite to the current render target. Drawing
+     *         through the graphics rather than the target directly keeps
+     *         the render stats accurate.
+     *
+     *  \param sprite The sprite to draw.
+     *  \param states The transform and blending to draw with.
+     */
+    inline void draw(const sf::Sprite& sprite,
+                     const sf::RenderStates& states)
+    {
+        record(sprite.getTexture(), 4, states);
+        mTarget->draw(sprite, states);
+    }
+
+    /*
+     *  \fn draw
+     *  \brief Draws vertices to the current render target.
+     *
+     *  \param vertices The first vertex.
+     *  \param numVertices The number of vertices.
+     *  \param type The type of primitive the vertices make up.
+     *  \param states The transform, texture and blending to draw with.
+     */
+    inline void draw(const sf::Vertex* vertices,
+                     size_t numVertices,
+                     sf::PrimitiveType type,
+                     const sf::RenderStates& states)
+    {
+        record(states.texture, numVertices, states);
+        mTarget->draw(vertices, numVertices, type, states);
+    }
+
+protected:
+    /*
+     *  \fn Constructor
+     *  \brief Sets up the graphics to render to a target other than its
+     *         window. The target must outlive the graphics.
+     *
+     *  \param target The target to render to.
+     */
+    Graphics(sf::RenderTarget& target);
+
+    /*
+     *  \fn beginFrame
+     *  \brief Picks the target the frame renders to and clears it.
+     */
+    void beginFrame();
+
+    /*
+     *  \fn clearTarget
+     *  \brief Clears the current render target, or only the scissor area
+     *         if one is set.
+     */
+    void clearTarget();
+
+    /*
+     *  \fn displayTarget
+     *  \brief Shows what has been rendered to the default target.
+     */
+    virtual void displayTarget();
+
 private:
+    struct NativeDraw
+    {
+        RenderableInterface* renderable;
+        Matrix matrix;
+    };
+
+    void applyView();
+    void applyScissor();
+    sf::View getBaseView() const;
+    sf::Vector2f getViewportScale() const;
+    void resolveScene();
+
+    inline void record(const sf::Texture* texture,
+                       size_t numVertices,
+                       const sf::RenderStates& states)
+    {
+        RenderStats& stats = getStats();
+        stats.addDraw(texture, numVertices);
+        if (states.blendMode != mBlendMode || states.shader != mShader)
+        {
+            stats.addStateChange();
+            mBlendMode = states.blendMode;
+            mShader = states.shader;
+        }
+    }
+
     sf::RenderWindow mWindow;
+    sf::RenderTarget* mTarget;
+    sf::RenderTarget* mDefaultTarget;
+    sf::BlendMode mBlendMode;
+    const sf::Shader* mShader;
+    std::unique_ptr<sf::RenderTexture> mScaled;
+    sf::Vector2u mScaledWindowSize;
+    sf::Vector2u mScaledSize;
+    float mRenderScale;
+    DynamicResolution* mController;
+    std::vector<NativeDraw> mNativeDraws;
+    RectI mScissor;
+    bool mHasScissor;
 };
 }
 }
@@ -0,0 +1,113 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_SFML_OFFSCREEN_GRAPHICS_H_
+#define NYRA_SFML_OFFSCREEN_GRAPHICS_H_
+
+#include <nyra/sfml/Graphics.h>
+#include <nyra/Image.h>
+
+namespace nyra
+{
+namespace sfml
+{
+/*
+ *  \class OffscreenGraphics
+ *  \brief Renders into a render texture instead of a window. Everything
+ *         that renders to sfml::Graphics renders here unchanged and gives
+ *         the same pixels, so tests and benchmarks do not need a visible
+ *         window. SFML still needs an OpenGL context, on a Linux machine
+ *         without a display a software GL (such as Mesa llvmpipe under
+ *         Xvfb) is enough.
+ */
+class OffscreenGraphics : public Graphics
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates the framebuffer.
+     *
+     *  \param size The size of the framebuffer in pixels. The default
+     *         matches the default EngineBase window.
+     */
+    OffscreenGraphics(const Vector2U& size = Vector2U(1280, 720));
+
+    /*
+     *  \fn clear
+     *  \brief Clears the framebuffer.
+     *
+     *  \param handle Ignored since there is no window.
+     */
+    void clear(WindowsHandle handle) override;
+
+    /*
+     *  \fn screenshot
+     *  \brief Saves the framebuffer as of the last present.
+     *
+     *  \param pathname The pathname of the location to save to. Only PNG
+     *         is supported.
+     */
+    void screenshot(const std::string& pathname) const override;
+
+    /*
+     *  \fn getImage
+     *  \brief Reads back the framebuffer as of the last present.
+     *
+     *  \return The framebuffer as an RGBA image.
+     */
+    Image getImage() const;
+
+    /*
+     *  \fn setSize
+     *  \brief Recreates the framebuffer at a new size. The contents are
+     *         lost.
+     *
+     *  \param size The new size in pixels.
+     */
+    void setSize(const Vector2U& size);
+
+    /*
+     *  \fn getSize
+     *  \brief Gets the size of the framebuffer.
+     *
+     *  \return The size in pixels.
+     */
+    inline Vector2U getSize() const
+    {
+        return Vector2U(mTexture.getSize());
+    }
+
+protected:
+    /*
+     *  \fn displayTarget
+     *  \brief Finishes the frame so the framebuffer can be read.
+     */
+    void displayTarget() override;
+
+private:
+    sf::RenderTexture mTexture;
+};
+}
+}
+
+#endif
@@ -0,0 +1,119 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_SFML_PARTICLE_SYSTEM_H_
+#define NYRA_SFML_PARTICLE_SYSTEM_H_
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include <nyra/ParticleEmitter.h>
+#include <nyra/sfml/Sprite.h>
+#include <nyra/sfml/SpriteBatch.h>
+#include <nyra/sfml/Graphics.h>
+
+namespace nyra
+{
+namespace sfml
+{
+/*
+ *  \class ParticleSystem
+ *  \brief Updates and draws particle emitters. Each particle is drawn as a
+ *         frame of a sprite sheet centered on its position. Emitters that
+ *         share a texture are drawn together, so rendering costs one draw
+ *         call per texture no matter how many particles there are.
+ */
+class ParticleSystem
+{
+public:
+    /*
+     *  \fn add
+     *  \brief Adds an emitter. The emitter and sprite must stay alive
+     *         until the emitter is removed.
+     *
+     *  \param emitter The emitter to draw.
+     *  \param sprite The sprite sheet to draw particles with. Only its
+     *         texture and frame layout are used.
+     */
+    void add(ParticleEmitter& emitter, const Sprite& sprite);
+
+    /*
+     *  \fn remove
+     *  \brief Removes an emitter.
+     *
+     *  \param emitter The emitter to remove.
+     */
+    void remove(const ParticleEmitter& emitter);
+
+    /*
+     *  \fn update
+     *  \brief Updates every emitter.
+     *
+     *  \param elapsed The time since the last update in seconds.
+     */
+    void update(float elapsed);
+
+    /*
+     *  \fn render
+     *  \brief Draws every particle.
+     *
+     *  \param graphics The graphics to render to.
+     */
+    void render(Graphics& graphics);
+
+    /*
+     *  \fn getNumParticles
+     *  \brief Gets the number of live particles across all emitters.
+     *
+     *  \return The number of particles.
+     */
+    size_t getNumParticles() const;
+
+    /*
+     *  \fn getDrawCalls
+     *  \brief Gets how many draw calls the last render issued.
+     *
+     *  \return The number of draw calls.
+     */
+    inline size_t getDrawCalls() const
+    {
+        return mBatch.getDrawCalls();
+    }
+
+private:
+    struct Entry
+    {
+        ParticleEmitter* emitter;
+        const sf::Texture* texture;
+        TextureStreamer* streamer;
+        size_t streamIndex;
+        std::vector<sf::IntRect> frames;
+        std::vector<Vector2F> halfSizes;
+    };
+
+    std::vector<Entry> mEntries;
+    SpriteBatch mBatch;
+};
+}
+}
+
+#endif
@@ -0,0 +1,317 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_SFML_RENDER_LAYER_H_
+#define NYRA_SFML_RENDER_LAYER_H_
+
+#include <list>
+#include <memory>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include <nyra/RenderableBase.h>
+#include <nyra/Transform.h>
+#include <nyra/sfml/Graphics.h>
+#include <nyra/sfml/Sprite.h>
+
+namespace nyra
+{
+namespace sfml
+{
+/*
+ *  \class RenderLayer
+ *  \brief A retained group of renderables. The children are rendered once
+ *         into a texture and every frame after that the layer is drawn as
+ *         a single textured quad. The texture is rebuilt automatically
+ *         when the transform of a child changes, or the frame of a child
+ *         sprite changes. Anything else that changes how a child looks
+ *         needs an explicit invalidate.
+ *
+ *         Children are positioned in the local space of the layer, with
+ *         the origin at its top left corner. Anything outside of the layer
+ *         size is cut off.
+ *
+ *         The textures of all layers sharing a budget are limited to a
+ *         number of bytes. When a layer would go over the budget the
+ *         least recently drawn layers drop their textures. A layer that
+ *         cannot fit on its own renders its children directly.
+ */
+class RenderLayer : public RenderableBase<RenderLayer, Graphics>
+{
+public:
+    /*
+     *  \class Budget
+     *  \brief Tracks the texture memory used by a group of layers.
+     */
+    class Budget
+    {
+    public:
+        /*
+         *  \fn Constructor
+         *  \brief Creates a budget with no layers in it.
+         *
+         *  \param maxBytes The most texture memory the layers can use.
+         */
+        Budget(size_t maxBytes);
+
+        Budget(const Budget&) = delete;
+        Budget& operator=(const Budget&) = delete;
+
+        /*
+         *  \fn setMaxBytes
+         *  \brief Changes the limit. If the layers are already over the
+         *         new limit the least recently drawn ones drop their
+         *         textures right away.
+         *
+         *  \param maxBytes The most texture memory the layers can use.
+         */
+        void setMaxBytes(size_t maxBytes);
+
+        /*
+         *  \fn getMaxBytes
+         *  \brief Gets the limit.
+         *
+         *  \return The most texture memory the layers can use.
+         */
+        inline size_t getMaxBytes() const
+        {
+            return mMaxBytes;
+        }
+
+        /*
+         *  \fn getBytesResident
+         *  \brief Gets the texture memory currently held by layers.
+         *
+         *  \return The number of bytes.
+         */
+        inline size_t getBytesResident() const
+        {
+            return mBytesResident;
+        }
+
+        /*
+         *  \fn getNumEvictions
+         *  \brief Gets how many times a layer dropped its texture to make
+         *         room for another one.
+         *
+         *  \return The number of evictions.
+         */
+        inline size_t getNumEvictions() const
+        {
+            return mNumEvictions;
+        }
+
+        /*
+         *  \fn getDefault
+         *  \brief Gets the budget layers use when none is given. This
+         *         starts at 64MB.
+         *
+         *  \return The default budget.
+         */
+        static Budget& getDefault();
+
+    private:
+        friend class RenderLayer;
+
+        bool reserve(RenderLayer& layer, size_t bytes);
+        void release(RenderLayer& layer, size_t bytes);
+        void touch(RenderLayer& layer);
+
+        // Most recently drawn first
+        std::list<RenderLayer*> mLayers;
+        size_t mMaxBytes;
+        size_t mBytesResident;
+        size_t mNumEvictions;
+    };
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates an empty layer. No texture memory is used until the
+     *         layer is rendered.
+     *
+     *  \param size The size of the layer in pixels.
+     *  \param budget The budget the texture counts against. This must
+     *         outlive the layer.
+     */
+    RenderLayer(const Vector2U& size,
+                Budget& budget = Budget::getDefault());
+
+    /*
+     *  \fn Destructor
+     *  \brief Gives the texture memory back to the budget.
+     */
+    ~RenderLayer();
+
+    RenderLayer(const RenderLayer&) = delete;
+    RenderLayer& operator=(const RenderLayer&) = delete;
+
+    /*
+     *  \fn add
+     *  \brief Adds a child to the top of the layer. Both the renderable
+     *         and the transform must outlive the layer or be removed.
+     *
+     *  \param renderable The object to render.
+     *  \param transform The position of the object within the layer.
+     */
+    void add(RenderableInterface& renderable, Transform& transform);
+
+    /*
+     *  \fn add
+     *  \brief Adds a sprite to the top of the layer. Changing its frame
+     *         rebuilds the layer. A streamed texture is kept in use while
+     *         the layer is drawn, and the layer is rebuilt once a texture
+     *         that was drawn as the placeholder becomes resident.
+     *
+     *  \param sprite The sprite to render.
+     *  \param transform The position of the sprite within the layer.
+     */
+    void add(Sprite& sprite, Transform& transform);
+
+    /*
+     *  \fn remove
+     *  \brief Removes every entry of a child from the layer.
+     *
+     *  \param renderable The object to remove.
+     */
+    void remove(const RenderableInterface& renderable);
+
+    /*
+     *  \fn clear
+     *  \brief Removes all children.
+     */
+    void clear();
+
+    /*
+     *  \fn invalidate
+     *  \brief Forces the texture to be rebuilt the next time the layer is
+     *         rendered.
+     */
+    inline void invalidate()
+    {
+        mDirty = true;
+    }
+
+    /*
+     *  \fn setNativeResolution
+     *  \brief Keeps the layer at the full window resolution when the
+     *         graphics renders the scene at a lower one. The layer is then
+     *         drawn on top of the scene, so this suits UI layers.
+     *
+     *  \param native True to always render at the window resolution.
+     */
+    inline void setNativeResolution(bool native)
+    {
+        mNativeResolution = native;
+    }
+
+    /*
+     *  \fn isNativeResolution
+     *  \brief Checks if the layer ignores the render scale.
+     *
+     *  \return True if it always renders at the window resolution.
+     */
+    inline bool isNativeResolution() const
+    {
+        return mNativeResolution;
+    }
+
+    using RenderableBase<RenderLayer, Graphics>::render;
+
+    /*
+     *  \fn render
+     *  \brief Draws the layer, rebuilding the texture first if any child
+     *         has changed.
+     *
+     *  \param matrix The positional information about the layer.
+     *  \param graphics The graphics to render to.
+     */
+    void render(const Matrix& matrix, Graphics& graphics);
+
+    /*
+     *  \fn getSize
+     *  \brief Gets the size of the layer.
+     *
+     *  \return The size in pixels.
+     */
+    Vector2U getSize() const override;
+
+    /*
+     *  \fn isCached
+     *  \brief Checks if the layer currently holds a texture.
+     *
+     *  \return True if the layer is drawn as a single quad.
+     */
+    inline bool isCached() const
+    {
+        return mTexture.get() != nullptr;
+    }
+
+    /*
+     *  \fn getNumRebuilds
+     *  \brief Gets how many times the children have been rendered into
+     *         the texture.
+     *
+     *  \return The number of rebuilds.
+     */
+    inline size_t getNumRebuilds() const
+    {
+        return mNumRebuilds;
+    }
+
+    /*
+     *  \fn getNumBytes
+     *  \brief Gets the texture memory the layer needs while cached.
+     *
+     *  \return The number of bytes.
+     */
+    inline size_t getNumBytes() const
+    {
+        return static_cast<size_t>(mSize.x) * mSize.y * 4;
+    }
+
+private:
+    struct Child
+    {
+        RenderableInterface* renderable;
+        Transform* transform;
+        const Sprite* sprite;
+        size_t version;
+        size_t frame;
+        bool resident;
+    };
+
+    bool updateChildren();
+    void rebuild(Graphics& graphics);
+    void drop();
+
+    Vector2U mSize;
+    Budget& mBudget;
+    std::vector<Child> mChildren;
+    std::unique_ptr<sf::RenderTexture> mTexture;
+    bool mDirty;
+    bool mNativeResolution;
+    size_t mNumRebuilds;
+};
+}
+}
+
+#endif
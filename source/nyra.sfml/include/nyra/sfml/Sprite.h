@@ -25,9 +25,18 @@
 #define NYRA_SFML_SPRITE_H_
 
 #include <string>
+#include <vector>
+#include <unordered_map>
 #include <SFML/Graphics.hpp>
-#include <nyra/RenderableInterface.h>
+#include <nyra/RenderableBase.h>
 #include <nyra/SpriteInterface.h>
+#include <nyra/CollisionMask.h>
+#include <nyra/SpriteSheet.h>
+#include <nyra/AssetResolver.h>
+#include <nyra/sfml/TextureCache.h>
+#include <nyra/sfml/TextureStreamer.h>
+#include <nyra/sfml/Graphics.h>
+#include <nyra/sfml/Convert.h>
 
 namespace nyra
 {
@@ -35,9 +44,16 @@ namespace sfml
 {
 /*
  *  \class Sprite
- *  \brief Represents a single drawable sprite.
+ *  \brief Represents a single drawable sprite. The texture is held
+ *         through a shared handle rather than inline, so sprites can be
+ *         moved and kept by value in containers.
+ *
+ *         The texture is the variant picked by an AssetResolver. Sizes,
+ *         pivots and collision masks are always in logical units, the
+ *         pixels of the 1x texture, whichever variant was loaded.
  */
-class Sprite : public RenderableInterface, public SpriteInterface
+class Sprite : public RenderableBase<Sprite, Graphics>,
+               public SpriteInterface
 {
 public:
     /*
@@ -46,19 +62,108 @@ public:
      *
      *  \param pathname The pathname to the texture on disk.
      *  \param numFrames The number of frames in the x and y direction.
+     *  \param cache The cache to share the texture through.
+     *  \param resolver Picks the resolution of the texture.
+     */
+    Sprite(const std::string& pathname,
+           const Vector2U& numFrames = Vector2U(1, 1),
+           TextureCache& cache = TextureCache::getDefault(),
+           const AssetResolver& resolver = AssetResolver::getDefault());
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates a sprite from the frames of a sprite sheet.
+     *
+     *  \param sheet The sheet describing the texture and its frames.
+     *  \param cache The cache to share the texture through.
+     *  \param resolver Picks the resolution of the texture.
+     */
+    Sprite(const SpriteSheet& sheet,
+           TextureCache& cache = TextureCache::getDefault(),
+           const AssetResolver& resolver = AssetResolver::getDefault());
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates a sprite whose texture is streamed. The placeholder
+     *         is drawn while the texture is evicted.
+     *
+     *  \param pathname The pathname to the texture on disk.
+     *  \param numFrames The number of frames in the x and y direction.
+     *  \param streamer The streamer that keeps the texture resident.
+     *  \param resolver Picks the resolution of the texture.
      */
     Sprite(const std::string& pathname,
-           const Vector2U& numFrames = Vector2U(1, 1));
+           const Vector2U& numFrames,
+           TextureStreamer& streamer,
+           const AssetResolver& resolver = AssetResolver::getDefault());
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates a sprite from the frames of a sprite sheet with a
+     *         streamed texture.
+     *
+     *  \param sheet The sheet describing the texture and its frames.
+     *  \param streamer The streamer that keeps the texture resident.
+     *  \param resolver Picks the resolution of the texture.
+     */
+    Sprite(const SpriteSheet& sheet,
+           TextureStreamer& streamer,
+           const AssetResolver& resolver = AssetResolver::getDefault());
+
+    using RenderableBase<Sprite, Graphics>::render;
 
     /*
      *  \fn render
-     *  \brief Renders the object to a graphics interface.
+     *  \brief Renders the object directly to SFML graphics. This is
+     *         statically bound so it can be inlined into the render loop.
      *
      *  \param matrix The positional information about the object.
-     *  \param graphics The graphics interface to render to.
+     *  \param graphics The graphics to render to.
      */
-    void render(const Matrix& matrix,
-                GraphicsInterface& graphics) override;
+    inline void render(const Matrix& matrix,
+                       Graphics& graphics)
+    {
+        mSprite.setTexture(acquireTexture());
+        graphics.draw(mSprite, toTransform(matrix));
+    }
+
+    /*
+     *  \fn acquireTexture
+     *  \brief Gets the texture to draw the sprite with this frame. A
+     *         streamed texture is marked as used so it is not evicted while
+     *         it is on screen. Anything that draws the sprite's texture
+     *         other than render, such as a batch, should get it here.
+     *
+     *  \return The texture, or the placeholder while a streamed texture
+     *          is evicted.
+     */
+    inline const sf::Texture& acquireTexture() const
+    {
+        return mStreamer ? mStreamer->use(mStreamIndex) :
+                           mTexture->texture;
+    }
+
+    /*
+     *  \fn getStreamer
+     *  \brief Gets the streamer that keeps the texture resident.
+     *
+     *  \return The streamer, or nullptr if the texture is not streamed.
+     */
+    inline TextureStreamer* getStreamer() const
+    {
+        return mStreamer;
+    }
+
+    /*
+     *  \fn getStreamIndex
+     *  \brief Gets the index of the texture in its streamer.
+     *
+     *  \return The index from TextureStreamer::add.
+     */
+    inline size_t getStreamIndex() const
+    {
+        return mStreamIndex;
+    }
 
     /*
      *  \fn getSize
@@ -77,11 +182,150 @@ public:
      */
     void setFrame(size_t index) override;
 
+    /*
+     *  \fn setFrame
+     *  \brief Sets a named frame from the sprite sheet as the current
+     *         frame.
+     *
+     *  \param name The name of the frame.
+     */
+    void setFrame(const std::string& name);
+
+    /*
+     *  \fn getNumFrames
+     *  \brief Gets the number of frames in the sprite sheet.
+     *
+     *  \return The number of frames.
+     */
+    inline size_t getNumFrames() const
+    {
+        return mFrameRects.size();
+    }
+
+    /*
+     *  \fn getFrame
+     *  \brief Gets the frame currently being shown.
+     *
+     *  \return The frame index.
+     */
+    inline size_t getFrame() const
+    {
+        return mFrame;
+    }
+
+    /*
+     *  \fn getFrameRect
+     *  \brief Gets the area of the texture used by any frame.
+     *
+     *  \param index The frame number.
+     *  \return The frame rectangle in texture pixels.
+     */
+    inline const sf::IntRect& getFrameRect(size_t index) const
+    {
+        return mFrameRects[index];
+    }
+
+    /*
+     *  \fn getFrameSize
+     *  \brief Gets the size any frame is drawn at.
+     *
+     *  \param index The frame number.
+     *  \return The frame size in logical pixels.
+     */
+    inline const Vector2U& getFrameSize(size_t index) const
+    {
+        return mFrameSizes[index];
+    }
+
+    /*
+     *  \fn getTextureScale
+     *  \brief Gets the scale of the texture variant that was loaded.
+     *
+     *  \return The texture pixels per logical pixel.
+     */
+    inline float getTextureScale() const
+    {
+        return mTextureScale;
+    }
+
+    /*
+     *  \fn getPivot
+     *  \brief Gets the pivot of the current frame, normalized to the frame
+     *         size. This can be handed to Transform::setPivot.
+     *
+     *  \return The pivot.
+     */
+    inline const Vector2F& getPivot() const
+    {
+        return mFramePivots[mFrame];
+    }
+
+    /*
+     *  \fn getCollisionMask
+     *  \brief Gets the pixel perfect collision mask of the current frame.
+     *         Masks for every frame are built when the sprite is loaded.
+     *
+     *  \return The mask for the current frame.
+     */
+    inline const CollisionMask& getCollisionMask() const
+    {
+        return mFrameMasks[mFrame];
+    }
+
+    /*
+     *  \fn getTexture
+     *  \brief Gets the texture the sprite draws from. For a streamed
+     *         sprite this is the placeholder if the texture was evicted
+     *         when it was last rendered.
+     *
+     *  \return The sprite sheet texture.
+     */
+    inline const sf::Texture& getTexture() const
+    {
+        return *mSprite.getTexture();
+    }
+
+    /*
+     *  \fn getTextureRect
+     *  \brief Gets the area of the texture used by the current frame.
+     *
+     *  \return The current frame rectangle in texture pixels.
+     */
+    inline const sf::IntRect& getTextureRect() const
+    {
+        return mSprite.getTextureRect();
+    }
+
+    /*
+     *  \fn getTextureId
+     *  \brief Gets the id of the texture for use in render sort keys.
+     *
+     *  \return The texture id.
+     */
+    inline uint32_t getTextureId() const
+    {
+        return mTextureId;
+    }
+
 private:
-    sf::Texture mTexture;
+    TextureCache::Handle mTexture;
+    TextureStreamer* mStreamer;
+    size_t mStreamIndex;
+    uint32_t mTextureId;
+    float mTextureScale;
     sf::Sprite mSprite;
-    const Vector2U mNumFrames;
-    Vector2U mFrameSize;
+    void buildGrid(const Vector2U& textureSize, const Vector2U& numFrames);
+    void buildSheet(const SpriteSheet& sheet);
+    void buildFrames(const Vector2U& textureSize,
+                     const CollisionMask& sheetMask);
+
+    // Frame switches are a lookup into these tables
+    std::vector<sf::IntRect> mFrameRects;
+    std::vector<Vector2U> mFrameSizes;
+    std::vector<Vector2F> mFramePivots;
+    std::unordered_map<std::string, size_t> mFrameNames;
+    size_t mFrame;
+    std::vector<CollisionMask> mFrameMasks;
 };
 }
 }
@@ -0,0 +1,167 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_SFML_SPRITE_BATCH_H_
+#define NYRA_SFML_SPRITE_BATCH_H_
+
+#include <vector>
+#include <unordered_map>
+#include <SFML/Graphics.hpp>
+#include <nyra/Matrix.h>
+#include <nyra/sfml/Sprite.h>
+#include <nyra/sfml/Graphics.h>
+
+namespace nyra
+{
+namespace sfml
+{
+/*
+ *  \class SpriteBatch
+ *  \brief Collects sprites into one vertex buffer per texture so that any
+ *         number of sprites can be drawn with a single draw call per
+ *         texture. Buffers keep their memory between frames.
+ *
+ *  \note Sprites that share a texture are drawn in the order they were
+ *        added. Different textures are drawn in the order they were first
+ *        used, so overlapping sprites from different textures may not
+ *        layer the same way as drawing them one at a time.
+ */
+class SpriteBatch
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates an empty batch.
+     */
+    SpriteBatch();
+
+    /*
+     *  \fn add
+     *  \brief Adds the current frame of a sprite to the batch.
+     *
+     *  \param sprite The sprite to add. Only its texture and frame are
+     *         used, so one sprite can be added many times.
+     *  \param matrix The positional information about the sprite.
+     */
+    void add(const Sprite& sprite, const Matrix& matrix);
+
+    /*
+     *  \fn allocate
+     *  \brief Reserves room for quads that the caller fills in directly.
+     *         This is for geometry that is not a Sprite, such as particles.
+     *         The returned memory is only valid until the next call that
+     *         changes the batch.
+     *
+     *  \param texture The texture the quads are drawn with.
+     *  \param numQuads The number of quads to reserve.
+     *  \return Four vertices per quad in sf::Quads order.
+     */
+    sf::Vertex* allocate(const sf::Texture& texture, size_t numQuads);
+
+    /*
+     *  \fn append
+     *  \brief Adds everything from another batch, as if its sprites were
+     *         added here in the same order. This lets batches be built on
+     *         worker threads and merged on the rendering thread.
+     *
+     *  \param other The batch to copy from. It is left unchanged.
+     */
+    void append(const SpriteBatch& other);
+
+    /*
+     *  \fn clear
+     *  \brief Empties the batch without drawing it.
+     */
+    void clear();
+
+    /*
+     *  \fn flush
+     *  \brief Draws everything that has been added and empties the batch.
+     *
+     *  \param graphics The graphics to render to.
+     */
+    void flush(Graphics& graphics);
+
+    /*
+     *  \fn getSpriteCount
+     *  \brief Returns how many sprites are waiting to be drawn.
+     *
+     *  \return The number of sprites added since the last flush.
+     */
+    inline size_t getSpriteCount() const
+    {
+        return mSpriteCount;
+    }
+
+    /*
+     *  \fn getDrawCalls
+     *  \brief Returns how many draw calls the last flush issued.
+     *
+     *  \return The number of draw calls.
+     */
+    inline size_t getDrawCalls() const
+    {
+        return mDrawCalls;
+    }
+
+    /*
+     *  \fn getNumBatches
+     *  \brief Returns how many textures the batch is keeping a vertex
+     *         buffer for. Buffers for textures that have not been drawn
+     *         for MAX_IDLE_FLUSHES flushes or clears are dropped.
+     *
+     *  \return The number of texture buffers.
+     */
+    inline size_t getNumBatches() const
+    {
+        return mBatches.size();
+    }
+
+    /*
+     *  \var MAX_IDLE_FLUSHES
+     *  \brief How many flushes or clears a texture buffer is kept without
+     *         being used.
+     */
+    static const size_t MAX_IDLE_FLUSHES = 60;
+
+private:
+    struct Batch
+    {
+        const sf::Texture* texture;
+        std::vector<sf::Vertex> vertices;
+        size_t idle;
+    };
+
+    std::vector<sf::Vertex>& getVertices(const sf::Texture& texture);
+    void prune();
+
+    std::vector<Batch> mBatches;
+    std::unordered_map<const sf::Texture*, size_t> mLookup;
+    size_t mLastBatch;
+    size_t mSpriteCount;
+    size_t mDrawCalls;
+};
+}
+}
+
+#endif
@@ -0,0 +1,167 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_SFML_TEXT_RENDERER_H_
+#define NYRA_SFML_TEXT_RENDERER_H_
+
+#include <list>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+#include <SFML/Graphics.hpp>
+#include <nyra/Matrix.h>
+#include <nyra/Vector2.h>
+#include <nyra/sfml/GlyphAtlas.h>
+#include <nyra/sfml/SpriteBatch.h>
+
+namespace nyra
+{
+namespace sfml
+{
+/*
+ *  \class TextRenderer
+ *  \brief Adds text to a SpriteBatch as one quad per glyph. The glyphs
+ *         come from a shared GlyphAtlas, so any amount of text costs a
+ *         single draw call when the batch is flushed. Laying out a string
+ *         is done once and cached, so text that does not change only
+ *         costs the quads each frame.
+ *
+ *         Strings are UTF-8 and may contain newlines. The first baseline
+ *         is one character size below the origin, the same as sf::Text.
+ */
+class TextRenderer
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates a renderer with nothing cached.
+     *
+     *  \param atlas The atlas to store glyphs in. This must outlive the
+     *         renderer.
+     *  \param maxRuns The most laid out strings to keep around. The least
+     *         recently used are dropped first.
+     */
+    TextRenderer(GlyphAtlas& atlas = GlyphAtlas::getDefault(),
+                 size_t maxRuns = 4096);
+
+    /*
+     *  \fn add
+     *  \brief Adds a string to a batch.
+     *
+     *  \param batch The batch to add the glyph quads to.
+     *  \param font The font to use. This must outlive the renderer.
+     *  \param size The character size in pixels.
+     *  \param text The UTF-8 string.
+     *  \param matrix The positional information about the text.
+     *  \param color The color of the text.
+     */
+    void add(SpriteBatch& batch,
+             const sf::Font& font,
+             uint32_t size,
+             const std::string& text,
+             const Matrix& matrix,
+             const sf::Color& color = sf::Color::White);
+
+    /*
+     *  \fn measure
+     *  \brief Gets the size of a string once laid out.
+     *
+     *  \param font The font to use.
+     *  \param size The character size in pixels.
+     *  \param text The UTF-8 string.
+     *  \return The width of the longest line and the height of all lines.
+     */
+    Vector2F measure(const sf::Font& font,
+                     uint32_t size,
+                     const std::string& text);
+
+    /*
+     *  \fn beginFrame
+     *  \brief Lets glyphs from earlier frames be evicted from the atlas.
+     *         This should be called once per frame, before any text is
+     *         added.
+     */
+    inline void beginFrame()
+    {
+        mAtlas.beginFrame();
+    }
+
+    /*
+     *  \fn getNumRuns
+     *  \brief Gets how many laid out strings are cached.
+     *
+     *  \return The number of cached strings.
+     */
+    inline size_t getNumRuns() const
+    {
+        return mLookup.size();
+    }
+
+    /*
+     *  \fn getNumLayouts
+     *  \brief Gets how many times a string had to be laid out because it
+     *         was not in the cache.
+     *
+     *  \return The number of layouts.
+     */
+    inline size_t getNumLayouts() const
+    {
+        return mNumLayouts;
+    }
+
+private:
+    struct Glyph
+    {
+        uint32_t codepoint;
+        sf::FloatRect bounds;
+        size_t cell;
+        uint32_t generation;
+    };
+
+    struct Run
+    {
+        std::string key;
+        const sf::Font* font;
+        uint32_t size;
+        std::vector<Glyph> glyphs;
+        Vector2F extent;
+    };
+
+    Run& getRun(const sf::Font& font,
+                uint32_t size,
+                const std::string& text);
+    void layout(Run& run, const std::string& text);
+    void resolve(Run& run);
+
+    GlyphAtlas& mAtlas;
+    size_t mMaxRuns;
+    std::list<Run> mRuns;
+    std::unordered_map<std::string, std::list<Run>::iterator> mLookup;
+    std::string mKey;
+    size_t mNumLayouts;
+};
+}
+}
+
+#endif
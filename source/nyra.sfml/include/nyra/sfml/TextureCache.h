@@ -0,0 +1,133 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_SFML_TEXTURE_CACHE_H_
+#define NYRA_SFML_TEXTURE_CACHE_H_
+
+#include <string>
+#include <memory>
+#include <stdint.h>
+#include <SFML/Graphics.hpp>
+#include <nyra/CollisionMask.h>
+#include <nyra/ResourceCache.h>
+
+namespace nyra
+{
+namespace sfml
+{
+/*
+ *  \class Texture
+ *  \brief A texture that has been loaded through a TextureCache. The alpha
+ *         mask is built once at load time so everything that shares the
+ *         texture also shares the collision data. The id is unique for
+ *         each load and is meant for render sort keys.
+ */
+struct Texture
+{
+    sf::Texture texture;
+    CollisionMask mask;
+    std::string pathname;
+    uint32_t id;
+};
+
+/*
+ *  \class TextureCache
+ *  \brief Loads each texture once and hands out shared handles to it.
+ *         Textures are keyed by their normalized pathname and are released
+ *         as soon as the last handle is dropped. Threads that ask for a
+ *         texture that is still loading wait for it rather than decoding
+ *         it again. All methods are thread safe.
+ */
+class TextureCache
+{
+public:
+    typedef std::shared_ptr<const Texture> Handle;
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates an empty cache.
+     */
+    TextureCache();
+
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    /*
+     *  \fn load
+     *  \brief Gets a texture, loading it from disk if nothing else is
+     *         currently holding it.
+     *
+     *  \param pathname The pathname to the texture on disk.
+     *  \return A shared handle to the texture.
+     */
+    Handle load(const std::string& pathname);
+
+    /*
+     *  \fn getHits
+     *  \brief Returns how many loads were served from memory, including
+     *         loads that waited for another thread to finish.
+     *
+     *  \return The number of cache hits.
+     */
+    size_t getHits() const;
+
+    /*
+     *  \fn getMisses
+     *  \brief Returns how many loads had to go to disk.
+     *
+     *  \return The number of cache misses.
+     */
+    size_t getMisses() const;
+
+    /*
+     *  \fn getNumResident
+     *  \brief Returns how many textures are currently loaded.
+     *
+     *  \return The number of loaded textures.
+     */
+    size_t getNumResident() const;
+
+    /*
+     *  \fn getBytesResident
+     *  \brief Returns an estimate of the texture memory currently in use,
+     *         assuming four bytes per pixel.
+     *
+     *  \return The resident size in bytes.
+     */
+    size_t getBytesResident() const;
+
+    /*
+     *  \fn getDefault
+     *  \brief Returns the cache used when nothing else is requested.
+     *
+     *  \return The default cache.
+     */
+    static TextureCache& getDefault();
+
+private:
+    ResourceCache<Texture> mCache;
+};
+}
+}
+
+#endif
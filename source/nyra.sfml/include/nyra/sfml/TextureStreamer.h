@@ -0,0 +1,355 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_SFML_TEXTURE_STREAMER_H_
+#define NYRA_SFML_TEXTURE_STREAMER_H_
+
+#include <string>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <stdint.h>
+#include <SFML/Graphics.hpp>
+#include <nyra/CollisionMask.h>
+#include <nyra/Vector2.h>
+
+namespace nyra
+{
+namespace sfml
+{
+/*
+ *  \class TextureStreamer
+ *  \brief Keeps only the recently used textures of a large world in
+ *         memory. Each texture is decoded once when it is added so its
+ *         size and collision mask are always known, but its pixels are
+ *         evicted in least recently used order whenever the resident
+ *         textures go over a byte budget. A texture that is used while
+ *         evicted is decoded again on a worker thread and a placeholder
+ *         is drawn until it has been uploaded.
+ *
+ *         Textures are referred to by the index returned from add. The
+ *         sf::Texture of each index keeps its address for the life of the
+ *         streamer, but it is empty while evicted, so drawing should go
+ *         through use. Everything except the decoding happens on the
+ *         thread that calls the streamer.
+ */
+class TextureStreamer
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates an empty streamer and starts its loading thread.
+     *
+     *  \param maxBytes The most texture memory to keep resident, assuming
+     *         four bytes per pixel.
+     */
+    TextureStreamer(size_t maxBytes = 256 * 1024 * 1024);
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    /*
+     *  \fn Destructor
+     *  \brief Stops the loading thread. Loads in progress are dropped.
+     */
+    ~TextureStreamer();
+
+    /*
+     *  \fn add
+     *  \brief Adds a texture to the streamer, decoding it right away.
+     *         Adding the same pathname again returns the same index.
+     *
+     *  \param pathname The pathname to the texture on disk.
+     *  \return The index of the texture.
+     */
+    size_t add(const std::string& pathname);
+
+    /*
+     *  \fn use
+     *  \brief Marks a texture as used this frame and gets what should be
+     *         drawn for it. An evicted texture is queued to be loaded
+     *         again.
+     *
+     *  \param index The index from add.
+     *  \return The texture if it is resident, otherwise the placeholder.
+     */
+    const sf::Texture& use(size_t index);
+
+    /*
+     *  \fn update
+     *  \brief Uploads finished loads and evicts textures that have not
+     *         been used this frame until the budget is met. This should be
+     *         called once per frame after rendering.
+     */
+    void update();
+
+    /*
+     *  \fn waitForLoads
+     *  \brief Blocks until every queued load has been decoded and then
+     *         uploads them. This is useful behind a loading screen.
+     */
+    void waitForLoads();
+
+    /*
+     *  \fn isResident
+     *  \brief Checks if the pixels of a texture are in memory.
+     *
+     *  \param index The index from add.
+     *  \return True if the texture can be drawn.
+     */
+    inline bool isResident(size_t index) const
+    {
+        return mEntries[index].resident;
+    }
+
+    /*
+     *  \fn getSize
+     *  \brief Gets the size of a texture, even while it is evicted.
+     *
+     *  \param index The index from add.
+     *  \return The size in pixels.
+     */
+    inline const Vector2U& getSize(size_t index) const
+    {
+        return mEntries[index].size;
+    }
+
+    /*
+     *  \fn getMask
+     *  \brief Gets the alpha mask of a texture, even while it is evicted.
+     *
+     *  \param index The index from add.
+     *  \return The collision mask of the whole texture.
+     */
+    inline const CollisionMask& getMask(size_t index) const
+    {
+        return mEntries[index].mask;
+    }
+
+    /*
+     *  \fn getTextureId
+     *  \brief Gets an id for the texture for use in render sort keys.
+     *
+     *  \param index The index from add.
+     *  \return The texture id.
+     */
+    inline uint32_t getTextureId(size_t index) const
+    {
+        return mEntries[index].id;
+    }
+
+    /*
+     *  \fn getPlaceholder
+     *  \brief Gets the texture drawn in place of evicted textures. It is a
+     *         small repeating checkerboard so it fills any frame.
+     *
+     *  \return The placeholder texture.
+     */
+    inline const sf::Texture& getPlaceholder() const
+    {
+        return mPlaceholder;
+    }
+
+    /*
+     *  \fn setMaxBytes
+     *  \brief Changes the budget. Textures are evicted on the next update.
+     *
+     *  \param maxBytes The most texture memory to keep resident.
+     */
+    inline void setMaxBytes(size_t maxBytes)
+    {
+        mMaxBytes = maxBytes;
+    }
+
+    /*
+     *  \fn getMaxBytes
+     *  \brief Gets the budget.
+     *
+     *  \return The most texture memory to keep resident.
+     */
+    inline size_t getMaxBytes() const
+    {
+        return mMaxBytes;
+    }
+
+    /*
+     *  \fn setThrashFrames
+     *  \brief Sets how soon after being evicted a reload counts as
+     *         thrashing. Frequent thrashing means the budget is too small
+     *         for what is on screen.
+     *
+     *  \param frames The number of frames.
+     */
+    inline void setThrashFrames(size_t frames)
+    {
+        mThrashFrames = frames;
+    }
+
+    /*
+     *  \fn getNumTextures
+     *  \brief Gets how many textures have been added.
+     *
+     *  \return The number of textures.
+     */
+    inline size_t getNumTextures() const
+    {
+        return mEntries.size();
+    }
+
+    /*
+     *  \fn getNumResident
+     *  \brief Gets how many textures are in memory.
+     *
+     *  \return The number of resident textures.
+     */
+    inline size_t getNumResident() const
+    {
+        return mLru.size();
+    }
+
+    /*
+     *  \fn getBytesResident
+     *  \brief Gets the texture memory in use, assuming four bytes per
+     *         pixel.
+     *
+     *  \return The resident size in bytes.
+     */
+    inline size_t getBytesResident() const
+    {
+        return mBytesResident;
+    }
+
+    /*
+     *  \fn getNumPending
+     *  \brief Gets how many textures are waiting to be loaded again.
+     *
+     *  \return The number of pending loads.
+     */
+    inline size_t getNumPending() const
+    {
+        return mNumPending;
+    }
+
+    /*
+     *  \fn getNumEvictions
+     *  \brief Gets how many times a texture has been evicted.
+     *
+     *  \return The number of evictions.
+     */
+    inline size_t getNumEvictions() const
+    {
+        return mNumEvictions;
+    }
+
+    /*
+     *  \fn getNumReloads
+     *  \brief Gets how many times an evicted texture has been loaded
+     *         again.
+     *
+     *  \return The number of reloads.
+     */
+    inline size_t getNumReloads() const
+    {
+        return mNumReloads;
+    }
+
+    /*
+     *  \fn getNumThrashes
+     *  \brief Gets how many reloads happened within the thrash frames of
+     *         the eviction.
+     *
+     *  \return The number of thrashing reloads.
+     */
+    inline size_t getNumThrashes() const
+    {
+        return mNumThrashes;
+    }
+
+    /*
+     *  \fn getNumPlaceholderDraws
+     *  \brief Gets how many times the placeholder was handed out.
+     *
+     *  \return The number of placeholder uses.
+     */
+    inline size_t getNumPlaceholderDraws() const
+    {
+        return mNumPlaceholderDraws;
+    }
+
+private:
+    struct Entry
+    {
+        sf::Texture texture;
+        CollisionMask mask;
+        std::string pathname;
+        Vector2U size;
+        uint32_t id;
+        bool resident;
+        bool loading;
+        size_t lastUsed;
+        size_t evictedFrame;
+        std::list<size_t>::iterator lru;
+    };
+
+    struct Load
+    {
+        size_t index;
+        std::string pathname;
+        std::unique_ptr<sf::Image> image;
+    };
+
+    void work();
+    void makeResident(size_t index);
+
+    std::deque<Entry> mEntries;
+    std::unordered_map<std::string, size_t> mIndices;
+    std::list<size_t> mLru;
+    sf::Texture mPlaceholder;
+    size_t mMaxBytes;
+    size_t mBytesResident;
+    size_t mFrame;
+    size_t mThrashFrames;
+    size_t mNumPending;
+    size_t mNumEvictions;
+    size_t mNumReloads;
+    size_t mNumThrashes;
+    size_t mNumPlaceholderDraws;
+
+    // Shared with the loading thread
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::condition_variable mDone;
+    std::deque<Load> mRequests;
+    std::vector<Load> mFinished;
+    bool mStop;
+    std::thread mThread;
+};
+}
+}
+
+#endif
@@ -24,8 +24,14 @@
 #ifndef NYRA_SFML_TILE_MAP_H_
 #define NYRA_SFML_TILE_MAP_H_
 
+#include <vector>
 #include <nyra/TileMapInterface.h>
-#include <nyra/RenderableInterface.h>
+#include <nyra/RenderableBase.h>
+#include <nyra/Allocator.h>
+#include <nyra/AssetResolver.h>
+#include <nyra/sfml/TextureCache.h>
+#include <nyra/sfml/Graphics.h>
+#include <nyra/sfml/Convert.h>
 #include <SFML/Graphics.hpp>
 
 namespace nyra
@@ -33,24 +39,58 @@ namespace nyra
 namespace sfml
 {
 /*
- *  TODO: This is untested.
+ *  \class TileMap
+ *  \brief A grid of tiles drawn from a single tileset in one draw call.
+ *         Nothing points back into the map, so maps can be moved and
+ *         stored by value. The tileset is the variant picked by an
+ *         AssetResolver, tiles stay the same size whichever is loaded.
  */
-class TileMap : public TileMapInterface, RenderableInterface
+class TileMap : public TileMapInterface,
+                public RenderableBase<TileMap, Graphics>
 {
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Builds the geometry for a grid of tiles.
+     *
+     *  \param numTiles The number of tiles in the x and y direction.
+     *  \param tileSize The size of a single tile in pixels of the 1x
+     *         tileset. Neither side can be zero.
+     *  \param pathname The pathname to the tileset texture on disk.
+     *  \param tiles The tile index of each cell, stored row by row.
+     *  \param resource Where the vertex data is allocated from. This
+     *         allows a whole level to live in a single Arena.
+     *  \param cache The cache to share the tileset texture through.
+     *  \param resolver Picks the resolution of the tileset.
+     */
     TileMap(const Vector2U& numTiles,
             const Vector2U& tileSize,
             const std::string& pathname,
-            const uint16_t* tiles);
+            const uint16_t* tiles,
+            MemoryResource& resource = MemoryResource::getDefault(),
+            TextureCache& cache = TextureCache::getDefault(),
+            const AssetResolver& resolver = AssetResolver::getDefault());
+
+    using RenderableBase<TileMap, Graphics>::render;
 
     /*
      *  \fn render
-     *  \brief Renders the object to a graphics interface.
+     *  \brief Renders the object directly to SFML graphics. This is
+     *         statically bound so it can be inlined into the render loop.
      *
      *  \param matrix The positional information about the object.
-     *  \param graphics The graphics interface to render to.
+     *  \param graphics The graphics to render to.
      */
-    void render(const Matrix& matrix,
-                GraphicsInterface& graphics) override;
+    inline void render(const Matrix& matrix,
+                       Graphics& graphics)
+    {
+        sf::RenderStates states(toTransform(matrix));
+        states.texture = &mTexture->texture;
+        graphics.draw(mVertices.data(),
+                      mVertices.size(),
+                      sf::Quads,
+                      states);
+    }
 
     /*
      *  \fn getSize
@@ -61,12 +101,24 @@ class TileMap : public TileMapInterface, RenderableInterface
      */
     Vector2U getSize() const override;
 
+    /*
+     *  \fn getTextureId
+     *  \brief Gets the id of the texture for use in render sort keys.
+     *
+     *  \return The texture id.
+     */
+    inline uint32_t getTextureId() const
+    {
+        return mTexture->id;
+    }
+
 private:
-    const Vector2U mNumTiles;
-    const Vector2U mTileSize;
-    sf::VertexArray mVertices;
-    sf::Texture mTexture;
-    sf::RenderStates mRenderState;
+    typedef std::vector<sf::Vertex, Allocator<sf::Vertex> > VertexBuffer;
+
+    Vector2U mNumTiles;
+    Vector2U mTileSize;
+    VertexBuffer mVertices;
+    TextureCache::Handle mTexture;
 };
 }
 }
@@ -0,0 +1,188 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/sfml/GlyphAtlas.h>
+#include <limits>
+#include <stdexcept>
+
+namespace nyra
+{
+namespace sfml
+{
+const size_t GlyphAtlas::NO_CELL = std::numeric_limits<size_t>::max();
+
+//===========================================================================//
+size_t GlyphAtlas::KeyHash::operator()(const Key& key) const
+{
+    return std::hash<const sf::Font*>()(key.font) ^
+           (((static_cast<size_t>(key.codepoint) << 8) + key.size) *
+            2654435761u);
+}
+
+//===========================================================================//
+GlyphAtlas::GlyphAtlas(const Vector2U& cellSize,
+                       const Vector2U& numCells) :
+    mCellSize(cellSize),
+    mCells(numCells.product()),
+    mFrame(1),
+    mNumEvictions(0)
+{
+    if (!mTarget.create(cellSize.x * numCells.x, cellSize.y * numCells.y))
+    {
+        throw std::runtime_error("Unable to create glyph atlas texture");
+    }
+
+    // Start from transparent so nothing bleeds in around small glyphs
+    mTarget.clear(sf::Color::Transparent);
+    mTarget.display();
+
+    mFree.reserve(mCells.size());
+    for (size_t ii = mCells.size(); ii > 0; --ii)
+    {
+        const size_t cell = ii - 1;
+        mCells[cell].rect = sf::IntRect((cell % numCells.x) * cellSize.x,
+                                        (cell / numCells.x) * cellSize.y,
+                                        0, 0);
+        mCells[cell].lastUsed = 0;
+        mCells[cell].generation = 0;
+        mFree.push_back(cell);
+    }
+}
+
+//===========================================================================//
+size_t GlyphAtlas::find(const sf::Font& font,
+                        uint32_t codepoint,
+                        uint32_t size)
+{
+    const Key key = {&font, codepoint, size};
+    auto iter = mLookup.find(key);
+    if (iter == mLookup.end())
+    {
+        return NO_CELL;
+    }
+    touch(iter->second);
+    return iter->second;
+}
+
+//===========================================================================//
+size_t GlyphAtlas::insert(const sf::Font& font,
+                          uint32_t codepoint,
+                          uint32_t size,
+                          const sf::Texture& page,
+                          const sf::IntRect& rect)
+{
+    if (rect.width < 0 || rect.height < 0 ||
+        static_cast<uint32_t>(rect.width) > mCellSize.x ||
+        static_cast<uint32_t>(rect.height) > mCellSize.y)
+    {
+        throw std::runtime_error("Glyph is larger than a glyph atlas cell");
+    }
+
+    const size_t index = allocate();
+    Cell& cell = mCells[index];
+    cell.key.font = &font;
+    cell.key.codepoint = codepoint;
+    cell.key.size = size;
+    cell.rect.width = rect.width;
+    cell.rect.height = rect.height;
+    cell.lastUsed = mFrame;
+    ++cell.generation;
+    mLookup[cell.key] = index;
+
+    // Replace the whole cell so the previous glyph is fully cleared, then
+    // copy the glyph texel for texel.
+    const float left = static_cast<float>(cell.rect.left);
+    const float top = static_cast<float>(cell.rect.top);
+    const float cellRight = left + mCellSize.x;
+    const float cellBottom = top + mCellSize.y;
+    const sf::Vertex blank[] =
+    {
+        sf::Vertex(sf::Vector2f(left, top), sf::Color::Transparent),
+        sf::Vertex(sf::Vector2f(cellRight, top), sf::Color::Transparent),
+        sf::Vertex(sf::Vector2f(cellRight, cellBottom),
+                   sf::Color::Transparent),
+        sf::Vertex(sf::Vector2f(left, cellBottom), sf::Color::Transparent)
+    };
+    mTarget.draw(blank, 4, sf::Quads, sf::RenderStates(sf::BlendNone));
+
+    const float right = left + rect.width;
+    const float bottom = top + rect.height;
+    const float u0 = static_cast<float>(rect.left);
+    const float v0 = static_cast<float>(rect.top);
+    const float u1 = static_cast<float>(rect.left + rect.width);
+    const float v1 = static_cast<float>(rect.top + rect.height);
+    const sf::Vertex glyph[] =
+    {
+        sf::Vertex(sf::Vector2f(left, top), sf::Vector2f(u0, v0)),
+        sf::Vertex(sf::Vector2f(right, top), sf::Vector2f(u1, v0)),
+        sf::Vertex(sf::Vector2f(right, bottom), sf::Vector2f(u1, v1)),
+        sf::Vertex(sf::Vector2f(left, bottom), sf::Vector2f(u0, v1))
+    };
+    sf::RenderStates states(sf::BlendNone);
+    states.texture = &page;
+    mTarget.draw(glyph, 4, sf::Quads, states);
+    mTarget.display();
+    return index;
+}
+
+//===========================================================================//
+GlyphAtlas& GlyphAtlas::getDefault()
+{
+    static GlyphAtlas atlas;
+    return atlas;
+}
+
+//===========================================================================//
+size_t GlyphAtlas::allocate()
+{
+    if (!mFree.empty())
+    {
+        const size_t cell = mFree.back();
+        mFree.pop_back();
+        return cell;
+    }
+
+    // Eviction only happens when the atlas is full, so a scan is fine
+    size_t oldest = NO_CELL;
+    for (size_t ii = 0; ii < mCells.size(); ++ii)
+    {
+        if (mCells[ii].lastUsed < mFrame &&
+            (oldest == NO_CELL ||
+             mCells[ii].lastUsed < mCells[oldest].lastUsed))
+        {
+            oldest = ii;
+        }
+    }
+
+    if (oldest == NO_CELL)
+    {
+        throw std::runtime_error(
+                "Glyph atlas is too small for the text in one frame");
+    }
+
+    mLookup.erase(mCells[oldest].key);
+    ++mNumEvictions;
+    return oldest;
+}
+}
+}
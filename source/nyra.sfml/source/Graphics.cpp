@@ -22,11 +22,54 @@
  * IN THE SOFTWARE.
  */
 #include <nyra/sfml/Graphics.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string.h>
+#include <vector>
+#include <nyra/ImageWriter.h>
+
+namespace
+{
+//===========================================================================//
+sf::Vector2u scaleSize(const sf::Vector2u& size, float scale)
+{
+    return sf::Vector2u(
+            std::max(1u, static_cast<unsigned int>(
+                    std::ceil(size.x * scale))),
+            std::max(1u, static_cast<unsigned int>(
+                    std::ceil(size.y * scale))));
+}
+}
 
 namespace nyra
 {
 namespace sfml
 {
+//===========================================================================//
+Graphics::Graphics() :
+    mTarget(&mWindow),
+    mDefaultTarget(&mWindow),
+    mBlendMode(sf::BlendAlpha),
+    mShader(nullptr),
+    mRenderScale(1.0f),
+    mController(nullptr),
+    mHasScissor(false)
+{
+}
+
+//===========================================================================//
+Graphics::Graphics(sf::RenderTarget& target) :
+    mTarget(&target),
+    mDefaultTarget(&target),
+    mBlendMode(sf::BlendAlpha),
+    mShader(nullptr),
+    mRenderScale(1.0f),
+    mController(nullptr),
+    mHasScissor(false)
+{
+}
+
 //===========================================================================//
 void Graphics::clear(WindowsHandle handle)
 {
@@ -42,21 +85,313 @@ void Graphics::clear(WindowsHandle handle)
         mWindow.create(reinterpret_cast<sf::WindowHandle>(handle));
     }
 
-    // clear the window with black color
-    mWindow.clear(sf::Color::Black);
+    beginFrame();
+}
+
+//===========================================================================//
+void Graphics::beginFrame()
+{
+    mTarget = mDefaultTarget;
+    if (mRenderScale < 1.0f)
+    {
+        // The target is made once for the largest scale that can be asked
+        // for, each frame only renders into its top left corner.
+        const sf::Vector2u windowSize = mDefaultTarget->getSize();
+        const float maxScale = mController ?
+                std::max(mRenderScale, mController->getMaxScale()) : 1.0f;
+        const sf::Vector2u capacity = scaleSize(windowSize, maxScale);
+        if (!mScaled || mScaledWindowSize != windowSize ||
+            mScaled->getSize().x < capacity.x ||
+            mScaled->getSize().y < capacity.y)
+        {
+            mScaled.reset(new sf::RenderTexture());
+            if (!mScaled->create(capacity.x, capacity.y))
+            {
+                mScaled.reset();
+                throw std::runtime_error(
+                        "Unable to create scaled render target");
+            }
+            mScaled->setSmooth(true);
+            mScaledWindowSize = windowSize;
+        }
+        mScaledSize = scaleSize(windowSize, mRenderScale);
+
+        // The view keeps the window coordinates, only the pixels shrink
+        mTarget = mScaled.get();
+        getStats().addOffscreenPass();
+    }
+
+    applyView();
+    clearTarget();
+}
+
+//===========================================================================//
+void Graphics::clearTarget()
+{
+    getStats().beginClear();
+    if (mHasScissor)
+    {
+        // Only clear the scissor area, the view clips everything else
+        const sf::Vector2f min(mScissor.min.x, mScissor.min.y);
+        const sf::Vector2f max(mScissor.max.x, mScissor.max.y);
+        const sf::Vertex quad[] = {
+                sf::Vertex(min, sf::Color::Black),
+                sf::Vertex(sf::Vector2f(max.x, min.y), sf::Color::Black),
+                sf::Vertex(max, sf::Color::Black),
+                sf::Vertex(sf::Vector2f(min.x, max.y), sf::Color::Black)};
+        mTarget->draw(quad, 4, sf::Quads);
+    }
+    else
+    {
+        // clear the window with black color
+        mTarget->clear(sf::Color::Black);
+    }
+    getStats().endClear();
 }
 
 //===========================================================================//
 void Graphics::present()
 {
     // end the current frame
+    getStats().beginPresent();
+    resolveScene();
+    displayTarget();
+    getStats().endPresent();
+
+    if (mController)
+    {
+        setRenderScale(mController->update(getStats().getLast().frameTime));
+    }
+}
+
+//===========================================================================//
+void Graphics::displayTarget()
+{
     mWindow.display();
 }
 
+//===========================================================================//
+void Graphics::resolveScene()
+{
+    if (isRenderScaled())
+    {
+        // Stretch the scene over the window. Blending is off since the
+        // scene already covers everything it is drawn over.
+        mScaled->display();
+        mTarget = mDefaultTarget;
+        applyView();
+
+        const sf::Vector2u windowSize = mTarget->getSize();
+        sf::Sprite scene(mScaled->getTexture(),
+                         sf::IntRect(0, 0, mScaledSize.x, mScaledSize.y));
+        scene.setScale(static_cast<float>(windowSize.x) / mScaledSize.x,
+                       static_cast<float>(windowSize.y) / mScaledSize.y);
+        draw(scene, sf::RenderStates(sf::BlendNone));
+    }
+
+    for (size_t ii = 0; ii < mNativeDraws.size(); ++ii)
+    {
+        mNativeDraws[ii].renderable->render(mNativeDraws[ii].matrix, *this);
+    }
+    mNativeDraws.clear();
+}
+
+//===========================================================================//
+void Graphics::setRenderScale(float scale)
+{
+    if (scale <= 0.0f || scale > 1.0f)
+    {
+        throw std::runtime_error("Render scale must be in (0, 1]");
+    }
+    mRenderScale = scale;
+}
+
+//===========================================================================//
+Vector2U Graphics::getRenderSize() const
+{
+    if (isRenderScaled())
+    {
+        return Vector2U(mScaledSize);
+    }
+    return Vector2U(mDefaultTarget->getSize());
+}
+
+//===========================================================================//
+void Graphics::setResolutionController(DynamicResolution* controller)
+{
+    mController = controller;
+    if (mController)
+    {
+        setRenderScale(mController->getScale());
+    }
+}
+
+//===========================================================================//
+void Graphics::renderNative(RenderableInterface& renderable,
+                            const Matrix& matrix)
+{
+    if (isRenderScaled())
+    {
+        NativeDraw native;
+        native.renderable = &renderable;
+        native.matrix = matrix;
+        mNativeDraws.push_back(native);
+    }
+    else
+    {
+        renderable.render(matrix, *this);
+    }
+}
+
 //===========================================================================//
 void Graphics::screenshot(const std::string& pathname) const
 {
     mWindow.capture().saveToFile(pathname);
 }
+
+//===========================================================================//
+void Graphics::setScissor(const RectI& area)
+{
+    mScissor = area;
+    mHasScissor = true;
+    applyScissor();
+    getStats().addStateChange();
+}
+
+//===========================================================================//
+void Graphics::resetScissor()
+{
+    mHasScissor = false;
+    applyView();
+    getStats().addStateChange();
+}
+
+//===========================================================================//
+void Graphics::applyView()
+{
+    if (mHasScissor)
+    {
+        applyScissor();
+    }
+    else
+    {
+        mTarget->setView(getBaseView());
+    }
+}
+
+//===========================================================================//
+void Graphics::applyScissor()
+{
+    const sf::Vector2u windowSize = mDefaultTarget->getSize();
+    if (windowSize.x == 0 || windowSize.y == 0)
+    {
+        return;
+    }
+
+    // The view shows exactly the scissor area in the same spot it has in
+    // the default view, so coordinates do not change but nothing outside
+    // of it is touched.
+    const Vector2I size = mScissor.getSize();
+    const sf::Vector2f scale = getViewportScale();
+    sf::View view(sf::FloatRect(mScissor.min.x, mScissor.min.y,
+                                size.x, size.y));
+    view.setViewport(sf::FloatRect(
+            scale.x * mScissor.min.x / windowSize.x,
+            scale.y * mScissor.min.y / windowSize.y,
+            scale.x * size.x / windowSize.x,
+            scale.y * size.y / windowSize.y));
+    mTarget->setView(view);
+}
+
+//===========================================================================//
+sf::View Graphics::getBaseView() const
+{
+    const sf::Vector2u size = mDefaultTarget->getSize();
+    const sf::Vector2f scale = getViewportScale();
+    sf::View view(sf::FloatRect(0.0f, 0.0f, size.x, size.y));
+    view.setViewport(sf::FloatRect(0.0f, 0.0f, scale.x, scale.y));
+    return view;
+}
+
+//===========================================================================//
+sf::Vector2f Graphics::getViewportScale() const
+{
+    // The viewport is a fraction of the target, the scaled target is only
+    // partly used.
+    if (!isRenderScaled())
+    {
+        return sf::Vector2f(1.0f, 1.0f);
+    }
+    const sf::Vector2u size = mScaled->getSize();
+    return sf::Vector2f(static_cast<float>(mScaledSize.x) / size.x,
+                        static_cast<float>(mScaledSize.y) / size.y);
+}
+
+//===========================================================================//
+void Graphics::screenshot(const std::string& pathname,
+                          const Vector2U& size,
+                          const std::function<void()>& renderScene,
+                          const Vector2U& tileSize)
+{
+    const Vector2U tile = tileSize.product() > 0 ?
+            tileSize : Vector2U(mTarget->getSize());
+    if (tile.product() == 0)
+    {
+        throw std::runtime_error(
+                "Tiled screenshots require a tile size or an open window");
+    }
+
+    sf::RenderTexture target;
+    if (!target.create(tile.x, tile.y))
+    {
+        throw std::runtime_error("Unable to create screenshot render target");
+    }
+
+    // Only one band of rows is ever held in memory.
+    const size_t pixelSize = 4;
+    const size_t lineSize = size.x * pixelSize;
+    std::vector<uint8_t> band(lineSize * tile.y);
+    ImageWriter writer(pathname, size, pixelSize);
+
+    sf::RenderTarget* previousTarget = mTarget;
+    mTarget = &target;
+    try
+    {
+        for (size_t yy = 0; yy < size.y; yy += tile.y)
+        {
+            const size_t numRows = std::min<size_t>(tile.y, size.y - yy);
+            for (size_t xx = 0; xx < size.x; xx += tile.x)
+            {
+                const size_t numColumns =
+                        std::min<size_t>(tile.x, size.x - xx);
+
+                // Move the view so the scene renders this tile at the origin
+                target.setView(sf::View(sf::FloatRect(xx, yy,
+                                                      tile.x, tile.y)));
+                target.clear(sf::Color::Black);
+                getStats().addOffscreenPass();
+                renderScene();
+                target.display();
+
+                const sf::Image tileImage = target.getTexture().copyToImage();
+                const uint8_t* pixels = tileImage.getPixelsPtr();
+                for (size_t row = 0; row < numRows; ++row)
+                {
+                    memcpy(&band[(row * lineSize) + (xx * pixelSize)],
+                           pixels + (row * tile.x * pixelSize),
+                           numColumns * pixelSize);
+                }
+            }
+            writer.writeRows(band.data(), numRows);
+        }
+    }
+    catch (...)
+    {
+        mTarget = previousTarget;
+        throw;
+    }
+    mTarget = previousTarget;
+    writer.close();
+}
 }
 }
@@ -0,0 +1,79 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/sfml/OffscreenGraphics.h>
+#include <stdexcept>
+#include <string.h>
+
+namespace nyra
+{
+namespace sfml
+{
+//===========================================================================//
+OffscreenGraphics::OffscreenGraphics(const Vector2U& size) :
+    Graphics(mTexture)
+{
+    setSize(size);
+}
+
+//===========================================================================//
+void OffscreenGraphics::clear(WindowsHandle /* handle */)
+{
+    beginFrame();
+}
+
+//===========================================================================//
+void OffscreenGraphics::displayTarget()
+{
+    mTexture.display();
+}
+
+//===========================================================================//
+void OffscreenGraphics::screenshot(const std::string& pathname) const
+{
+    getImage().write(pathname);
+}
+
+//===========================================================================//
+Image OffscreenGraphics::getImage() const
+{
+    const sf::Image image = mTexture.getTexture().copyToImage();
+    const Vector2U size(image.getSize());
+    const size_t pixelSize = 4;
+    Image ret(size, pixelSize);
+    memcpy(ret.getBuffer(), image.getPixelsPtr(),
+           size.product() * pixelSize);
+    return ret;
+}
+
+//===========================================================================//
+void OffscreenGraphics::setSize(const Vector2U& size)
+{
+    if (!mTexture.create(size.x, size.y))
+    {
+        throw std::runtime_error("Unable to create offscreen framebuffer");
+    }
+    resetScissor();
+}
+}
+}
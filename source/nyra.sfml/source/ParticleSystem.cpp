@@ -0,0 +1,139 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/sfml/ParticleSystem.h>
+#include <stdexcept>
+
+namespace nyra
+{
+namespace sfml
+{
+//===========================================================================//
+void ParticleSystem::add(ParticleEmitter& emitter, const Sprite& sprite)
+{
+    if (emitter.getSettings().numFrames > sprite.getNumFrames())
+    {
+        throw std::runtime_error(
+                "Particle emitter has more frames than its sprite");
+    }
+
+    Entry entry;
+    entry.emitter = &emitter;
+    entry.texture = &sprite.acquireTexture();
+    entry.streamer = sprite.getStreamer();
+    entry.streamIndex = sprite.getStreamIndex();
+    for (size_t ii = 0; ii < sprite.getNumFrames(); ++ii)
+    {
+        entry.frames.push_back(sprite.getFrameRect(ii));
+        entry.halfSizes.push_back(
+                Vector2F(sprite.getFrameSize(ii)) * 0.5f);
+    }
+    mEntries.push_back(entry);
+}
+
+//===========================================================================//
+void ParticleSystem::remove(const ParticleEmitter& emitter)
+{
+    for (size_t ii = 0; ii < mEntries.size(); ++ii)
+    {
+        if (mEntries[ii].emitter == &emitter)
+        {
+            mEntries.erase(mEntries.begin() + ii);
+            return;
+        }
+    }
+}
+
+//===========================================================================//
+void ParticleSystem::update(float elapsed)
+{
+    for (size_t ii = 0; ii < mEntries.size(); ++ii)
+    {
+        mEntries[ii].emitter->update(elapsed);
+    }
+}
+
+//===========================================================================//
+void ParticleSystem::render(Graphics& graphics)
+{
+    for (size_t ii = 0; ii < mEntries.size(); ++ii)
+    {
+        const Entry& entry = mEntries[ii];
+        const ParticleBuffer& particles = entry.emitter->getParticles();
+        const float* positionX = particles.getPositionX();
+        const float* positionY = particles.getPositionY();
+        const uint32_t* colors = particles.getColor();
+        const int32_t* frames = particles.getFrame();
+
+        // Streamed textures are marked as used every frame they are drawn
+        const sf::Texture& texture = entry.streamer ?
+                entry.streamer->use(entry.streamIndex) : *entry.texture;
+        sf::Vertex* quad = mBatch.allocate(texture, particles.size());
+        for (size_t jj = 0; jj < particles.size(); ++jj, quad += 4)
+        {
+            const sf::IntRect& rect = entry.frames[frames[jj]];
+            const Vector2F& halfSize = entry.halfSizes[frames[jj]];
+            const float halfWidth = halfSize.x;
+            const float halfHeight = halfSize.y;
+            const float left = positionX[jj] - halfWidth;
+            const float top = positionY[jj] - halfHeight;
+            const float right = positionX[jj] + halfWidth;
+            const float bottom = positionY[jj] + halfHeight;
+            quad[0].position = sf::Vector2f(left, top);
+            quad[1].position = sf::Vector2f(right, top);
+            quad[2].position = sf::Vector2f(right, bottom);
+            quad[3].position = sf::Vector2f(left, bottom);
+
+            const float u0 = static_cast<float>(rect.left);
+            const float v0 = static_cast<float>(rect.top);
+            const float u1 = static_cast<float>(rect.left + rect.width);
+            const float v1 = static_cast<float>(rect.top + rect.height);
+            quad[0].texCoords = sf::Vector2f(u0, v0);
+            quad[1].texCoords = sf::Vector2f(u1, v0);
+            quad[2].texCoords = sf::Vector2f(u1, v1);
+            quad[3].texCoords = sf::Vector2f(u0, v1);
+
+            const uint32_t packed = colors[jj];
+            const sf::Color color(packed >> 24,
+                                  (packed >> 16) & 0xFF,
+                                  (packed >> 8) & 0xFF,
+                                  packed & 0xFF);
+            quad[0].color = quad[1].color = quad[2].color = color;
+            quad[3].color = color;
+        }
+    }
+    mBatch.flush(graphics);
+}
+
+//===========================================================================//
+size_t ParticleSystem::getNumParticles() const
+{
+    size_t count = 0;
+    for (size_t ii = 0; ii < mEntries.size(); ++ii)
+    {
+        count += mEntries[ii].emitter->getParticles().size();
+    }
+    return count;
+}
+}
+}
@@ -0,0 +1,286 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/sfml/RenderLayer.h>
+#include <nyra/sfml/Convert.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+// The children are blended over transparent black, which leaves the
+// texture holding premultiplied colors. Drawing it back with this mode
+// gives the same pixels as drawing the children directly.
+const sf::BlendMode PREMULTIPLIED(sf::BlendMode::One,
+                                  sf::BlendMode::OneMinusSrcAlpha);
+}
+
+namespace nyra
+{
+namespace sfml
+{
+//===========================================================================//
+RenderLayer::Budget::Budget(size_t maxBytes) :
+    mMaxBytes(maxBytes),
+    mBytesResident(0),
+    mNumEvictions(0)
+{
+}
+
+//===========================================================================//
+void RenderLayer::Budget::setMaxBytes(size_t maxBytes)
+{
+    mMaxBytes = maxBytes;
+    while (mBytesResident > mMaxBytes && !mLayers.empty())
+    {
+        mLayers.back()->drop();
+        ++mNumEvictions;
+    }
+}
+
+//===========================================================================//
+RenderLayer::Budget& RenderLayer::Budget::getDefault()
+{
+    static Budget budget(64 * 1024 * 1024);
+    return budget;
+}
+
+//===========================================================================//
+bool RenderLayer::Budget::reserve(RenderLayer& layer, size_t bytes)
+{
+    if (bytes > mMaxBytes)
+    {
+        return false;
+    }
+
+    while (mBytesResident + bytes > mMaxBytes && !mLayers.empty())
+    {
+        mLayers.back()->drop();
+        ++mNumEvictions;
+    }
+
+    mBytesResident += bytes;
+    mLayers.push_front(&layer);
+    return true;
+}
+
+//===========================================================================//
+void RenderLayer::Budget::release(RenderLayer& layer, size_t bytes)
+{
+    mLayers.remove(&layer);
+    mBytesResident -= bytes;
+}
+
+//===========================================================================//
+void RenderLayer::Budget::touch(RenderLayer& layer)
+{
+    if (mLayers.front() != &layer)
+    {
+        mLayers.splice(mLayers.begin(), mLayers,
+                       std::find(mLayers.begin(), mLayers.end(), &layer));
+    }
+}
+
+//===========================================================================//
+RenderLayer::RenderLayer(const Vector2U& size, Budget& budget) :
+    mSize(size),
+    mBudget(budget),
+    mDirty(true),
+    mNativeResolution(false),
+    mNumRebuilds(0)
+{
+}
+
+//===========================================================================//
+RenderLayer::~RenderLayer()
+{
+    drop();
+}
+
+//===========================================================================//
+void RenderLayer::add(RenderableInterface& renderable, Transform& transform)
+{
+    Child child;
+    child.renderable = &renderable;
+    child.transform = &transform;
+    child.sprite = nullptr;
+    child.version = transform.getVersion();
+    child.frame = 0;
+    child.resident = true;
+    mChildren.push_back(child);
+    mDirty = true;
+}
+
+//===========================================================================//
+void RenderLayer::add(Sprite& sprite, Transform& transform)
+{
+    add(static_cast<RenderableInterface&>(sprite), transform);
+    mChildren.back().sprite = &sprite;
+    mChildren.back().frame = sprite.getFrame();
+}
+
+//===========================================================================//
+void RenderLayer::remove(const RenderableInterface& renderable)
+{
+    mChildren.erase(std::remove_if(mChildren.begin(), mChildren.end(),
+            [&renderable](const Child& child)
+            {
+                return child.renderable == &renderable;
+            }), mChildren.end());
+    mDirty = true;
+}
+
+//===========================================================================//
+void RenderLayer::clear()
+{
+    mChildren.clear();
+    mDirty = true;
+}
+
+//===========================================================================//
+void RenderLayer::render(const Matrix& matrix, Graphics& graphics)
+{
+    if (mNativeResolution && graphics.isRenderScaled())
+    {
+        graphics.renderNative(*this, matrix);
+        return;
+    }
+
+    if (updateChildren() || !mTexture)
+    {
+        rebuild(graphics);
+    }
+
+    if (mTexture)
+    {
+        mBudget.touch(*this);
+        sf::RenderStates states(toTransform(matrix));
+        states.blendMode = PREMULTIPLIED;
+        graphics.draw(sf::Sprite(mTexture->getTexture()), states);
+    }
+    else
+    {
+        // Over budget, so fall back to drawing every child
+        for (size_t ii = 0; ii < mChildren.size(); ++ii)
+        {
+            const Child& child = mChildren[ii];
+            child.renderable->render(
+                    matrix * child.transform->getMatrix(), graphics);
+        }
+    }
+}
+
+//===========================================================================//
+Vector2U RenderLayer::getSize() const
+{
+    return mSize;
+}
+
+//===========================================================================//
+bool RenderLayer::updateChildren()
+{
+    bool changed = mDirty;
+    mDirty = false;
+    for (size_t ii = 0; ii < mChildren.size(); ++ii)
+    {
+        Child& child = mChildren[ii];
+        const size_t version = child.transform->getVersion();
+        const size_t frame = child.sprite ? child.sprite->getFrame() : 0;
+        if (version != child.version || frame != child.frame)
+        {
+            child.version = version;
+            child.frame = frame;
+            changed = true;
+        }
+
+        // A cached layer does not render its children, so streamed
+        // textures are marked as used here. Pixels baked in while the
+        // placeholder was drawn are replaced once the texture arrives.
+        TextureStreamer* streamer =
+                child.sprite ? child.sprite->getStreamer() : nullptr;
+        if (streamer)
+        {
+            const size_t index = child.sprite->getStreamIndex();
+            streamer->use(index);
+            if (!child.resident && streamer->isResident(index))
+            {
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+//===========================================================================//
+void RenderLayer::rebuild(Graphics& graphics)
+{
+    if (!mTexture)
+    {
+        if (!mBudget.reserve(*this, getNumBytes()))
+        {
+            return;
+        }
+
+        mTexture.reset(new sf::RenderTexture());
+        if (!mTexture->create(mSize.x, mSize.y))
+        {
+            drop();
+            throw std::runtime_error("Unable to create render layer texture");
+        }
+    }
+
+    mTexture->clear(sf::Color::Transparent);
+    sf::RenderTarget& previous = graphics.setRenderTarget(*mTexture);
+    try
+    {
+        for (size_t ii = 0; ii < mChildren.size(); ++ii)
+        {
+            Child& child = mChildren[ii];
+            TextureStreamer* streamer =
+                    child.sprite ? child.sprite->getStreamer() : nullptr;
+            child.resident = !streamer ||
+                    streamer->isResident(child.sprite->getStreamIndex());
+            child.renderable->render(child.transform->getMatrix(), graphics);
+        }
+    }
+    catch (...)
+    {
+        graphics.setRenderTarget(previous);
+        throw;
+    }
+    graphics.setRenderTarget(previous);
+    mTexture->display();
+    ++mNumRebuilds;
+}
+
+//===========================================================================//
+void RenderLayer::drop()
+{
+    if (mTexture)
+    {
+        mTexture.reset();
+        mBudget.release(*this, getNumBytes());
+    }
+}
+}
+}
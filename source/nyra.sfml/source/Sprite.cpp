@@ -23,7 +23,15 @@
  */
 #include <nyra/sfml/Sprite.h>
 #include <exception>
-#include <nyra/sfml/Graphics.h>
+
+namespace
+{
+//===========================================================================//
+int scalePixels(uint32_t value, float scale)
+{
+    return static_cast<int>((value * scale) + 0.5f);
+}
+}
 
 namespace nyra
 {
@@ -31,55 +39,185 @@ namespace sfml
 {
 //===========================================================================//
 Sprite::Sprite(const std::string& pathname,
-               const Vector2U& numFrames) :
-    mNumFrames(numFrames)
+               const Vector2U& numFrames,
+               TextureCache& cache,
+               const AssetResolver& resolver) :
+    mStreamer(nullptr),
+    mStreamIndex(0),
+    mFrame(0)
 {
-    // Ensure there is at least one frame in each direction
-    if (mNumFrames.product() < 1)
+    const AssetResolver::Variant variant = resolver.resolve(pathname);
+    mTexture = cache.load(variant.pathname);
+    mTextureId = mTexture->id;
+    mTextureScale = variant.scale;
+
+    const Vector2U textureSize(mTexture->texture.getSize());
+    mSprite.setTexture(mTexture->texture);
+    buildGrid(textureSize, numFrames);
+    buildFrames(textureSize, mTexture->mask);
+}
+
+//===========================================================================//
+Sprite::Sprite(const SpriteSheet& sheet,
+               TextureCache& cache,
+               const AssetResolver& resolver) :
+    mStreamer(nullptr),
+    mStreamIndex(0),
+    mFrame(0)
+{
+    const AssetResolver::Variant variant =
+            resolver.resolve(sheet.getTexturePathname());
+    mTexture = cache.load(variant.pathname);
+    mTextureId = mTexture->id;
+    mTextureScale = variant.scale;
+
+    mSprite.setTexture(mTexture->texture);
+    buildSheet(sheet);
+    buildFrames(Vector2U(mTexture->texture.getSize()), mTexture->mask);
+}
+
+//===========================================================================//
+Sprite::Sprite(const std::string& pathname,
+               const Vector2U& numFrames,
+               TextureStreamer& streamer,
+               const AssetResolver& resolver) :
+    mStreamer(&streamer),
+    mFrame(0)
+{
+    const AssetResolver::Variant variant = resolver.resolve(pathname);
+    mStreamIndex = streamer.add(variant.pathname);
+    mTextureId = streamer.getTextureId(mStreamIndex);
+    mTextureScale = variant.scale;
+
+    mSprite.setTexture(streamer.use(mStreamIndex));
+    buildGrid(streamer.getSize(mStreamIndex), numFrames);
+    buildFrames(streamer.getSize(mStreamIndex),
+                streamer.getMask(mStreamIndex));
+}
+
+//===========================================================================//
+Sprite::Sprite(const SpriteSheet& sheet,
+               TextureStreamer& streamer,
+               const AssetResolver& resolver) :
+    mStreamer(&streamer),
+    mFrame(0)
+{
+    const AssetResolver::Variant variant =
+            resolver.resolve(sheet.getTexturePathname());
+    mStreamIndex = streamer.add(variant.pathname);
+    mTextureId = streamer.getTextureId(mStreamIndex);
+    mTextureScale = variant.scale;
+
+    mSprite.setTexture(streamer.use(mStreamIndex));
+    buildSheet(sheet);
+    buildFrames(streamer.getSize(mStreamIndex),
+                streamer.getMask(mStreamIndex));
+}
+
+//===========================================================================//
+Vector2U Sprite::getSize() const
+{
+    return mFrameSizes[mFrame];
+}
+//===========================================================================//
+void Sprite::setFrame(size_t index)
+{
+    if (index >= mFrameRects.size())
     {
-        throw std::runtime_error("You must have at least one sprite frame");
+        throw std::runtime_error("Frame index out of bounds");
     }
 
-    if (!mTexture.loadFromFile(pathname))
+    mSprite.setTextureRect(mFrameRects[index]);
+    mFrame = index;
+}
+
+//===========================================================================//
+void Sprite::setFrame(const std::string& name)
+{
+    auto iter = mFrameNames.find(name);
+    if (iter == mFrameNames.end())
     {
-        throw std::runtime_error("Unable to load texture: " + pathname);
+        throw std::runtime_error("Sprite has no frame " + name);
     }
-    mSprite.setTexture(mTexture);
-    mFrameSize = Vector2U(mTexture.getSize()) / mNumFrames;
-    setFrame(0);
+    setFrame(iter->second);
 }
 
 //===========================================================================//
-void Sprite::render(const Matrix& matrix,
-                    GraphicsInterface& graphics)
+void Sprite::buildGrid(const Vector2U& textureSize,
+                       const Vector2U& numFrames)
 {
-    const sf::Transform sfmlMatrix(matrix(0, 0), matrix(0, 1), matrix(0, 2),
-                                   matrix(1, 0), matrix(1, 1), matrix(1, 2),
-                                   matrix(2, 0), matrix(2, 1), matrix(2, 2));
-    Graphics& sfmlGraphics(dynamic_cast<Graphics&>(graphics));
-    sfmlGraphics.getRenderTarget().draw(mSprite, sfmlMatrix);
+    // Ensure there is at least one frame in each direction
+    if (numFrames.product() < 1)
+    {
+        throw std::runtime_error("You must have at least one sprite frame");
+    }
+
+    // The grid is cut from the variant, the frames keep their 1x size
+    const Vector2U frameSize = textureSize / numFrames;
+    const Vector2U logicalSize(scalePixels(frameSize.x, 1.0f / mTextureScale),
+                               scalePixels(frameSize.y, 1.0f / mTextureScale));
+    for (size_t ii = 0; ii < numFrames.product(); ++ii)
+    {
+        mFrameRects.push_back(sf::IntRect((ii % numFrames.x) * frameSize.x,
+                                          (ii / numFrames.x) * frameSize.y,
+                                          frameSize.x,
+                                          frameSize.y));
+        mFrameSizes.push_back(logicalSize);
+        mFramePivots.push_back(Vector2F(0.5f, 0.5f));
+    }
 }
 
 //===========================================================================//
-Vector2U Sprite::getSize() const
+void Sprite::buildSheet(const SpriteSheet& sheet)
 {
-    return mFrameSize;
+    if (sheet.getNumFrames() < 1)
+    {
+        throw std::runtime_error("You must have at least one sprite frame");
+    }
+
+    for (size_t ii = 0; ii < sheet.getNumFrames(); ++ii)
+    {
+        // Sheets describe the 1x texture
+        const SpriteSheet::Frame& frame = sheet.getFrame(ii);
+        mFrameRects.push_back(sf::IntRect(
+                scalePixels(frame.position.x, mTextureScale),
+                scalePixels(frame.position.y, mTextureScale),
+                scalePixels(frame.size.x, mTextureScale),
+                scalePixels(frame.size.y, mTextureScale)));
+        mFrameSizes.push_back(frame.size);
+        mFramePivots.push_back(frame.pivot);
+        mFrameNames[frame.name] = ii;
+    }
 }
 
 //===========================================================================//
-void Sprite::setFrame(size_t index)
+void Sprite::buildFrames(const Vector2U& textureSize,
+                         const CollisionMask& sheetMask)
 {
-    if (index >= mNumFrames.product())
+    // The sheet mask is shared through the cache, only the frames are cut
+    mFrameMasks.reserve(mFrameRects.size());
+    for (size_t ii = 0; ii < mFrameRects.size(); ++ii)
     {
-        throw std::runtime_error("Frame index out of bounds");
+        const sf::IntRect& rect = mFrameRects[ii];
+        if (rect.left + rect.width > static_cast<int>(textureSize.x) ||
+            rect.top + rect.height > static_cast<int>(textureSize.y))
+        {
+            throw std::runtime_error("Sprite frame is outside the texture");
+        }
+        mFrameMasks.push_back(CollisionMask(
+                sheetMask,
+                Vector2U(rect.left, rect.top),
+                Vector2U(rect.width, rect.height)));
+        if (mFrameMasks.back().getSize() != mFrameSizes[ii])
+        {
+            mFrameMasks.back() =
+                    mFrameMasks.back().resample(mFrameSizes[ii]);
+        }
     }
 
-    const size_t xStart = (index % mNumFrames.x) * mFrameSize.x;
-    const size_t yStart = (index / mNumFrames.x) * mFrameSize.y;
-    mSprite.setTextureRect(sf::IntRect(xStart,
-                                       yStart,
-                                       mFrameSize.x,
-                                       mFrameSize.y));
+    // Draw the variant at the size of the 1x texture
+    mSprite.setScale(1.0f / mTextureScale, 1.0f / mTextureScale);
+    setFrame(0);
+}
 }
 }
-}
\ No newline at end of file
@@ -0,0 +1,206 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/sfml/SpriteBatch.h>
+#include <utility>
+
+namespace
+{
+//===========================================================================//
+inline sf::Vector2f transformPoint(const nyra::Matrix& matrix,
+                                   float x,
+                                   float y)
+{
+    return sf::Vector2f(
+            (matrix(0, 0) * x) + (matrix(0, 1) * y) + matrix(0, 2),
+            (matrix(1, 0) * x) + (matrix(1, 1) * y) + matrix(1, 2));
+}
+}
+
+namespace nyra
+{
+namespace sfml
+{
+const size_t SpriteBatch::MAX_IDLE_FLUSHES;
+
+//===========================================================================//
+SpriteBatch::SpriteBatch() :
+    mLastBatch(0),
+    mSpriteCount(0),
+    mDrawCalls(0)
+{
+}
+
+//===========================================================================//
+void SpriteBatch::add(const Sprite& sprite, const Matrix& matrix)
+{
+    // Quads are sized in logical pixels whichever variant is loaded
+    const sf::IntRect& rect = sprite.getTextureRect();
+    const Vector2U size = sprite.getSize();
+    const float width = static_cast<float>(size.x);
+    const float height = static_cast<float>(size.y);
+    const float left = static_cast<float>(rect.left);
+    const float top = static_cast<float>(rect.top);
+    const float right = static_cast<float>(rect.left + rect.width);
+    const float bottom = static_cast<float>(rect.top + rect.height);
+
+    std::vector<sf::Vertex>& vertices = getVertices(sprite.acquireTexture());
+    const size_t start = vertices.size();
+    vertices.resize(start + 4);
+    sf::Vertex* quad = &vertices[start];
+
+    quad[0].position = transformPoint(matrix, 0.0f, 0.0f);
+    quad[1].position = transformPoint(matrix, width, 0.0f);
+    quad[2].position = transformPoint(matrix, width, height);
+    quad[3].position = transformPoint(matrix, 0.0f, height);
+
+    quad[0].texCoords = sf::Vector2f(left, top);
+    quad[1].texCoords = sf::Vector2f(right, top);
+    quad[2].texCoords = sf::Vector2f(right, bottom);
+    quad[3].texCoords = sf::Vector2f(left, bottom);
+    ++mSpriteCount;
+}
+
+//===========================================================================//
+sf::Vertex* SpriteBatch::allocate(const sf::Texture& texture,
+                                  size_t numQuads)
+{
+    std::vector<sf::Vertex>& vertices = getVertices(texture);
+    const size_t start = vertices.size();
+    vertices.resize(start + numQuads * 4);
+    mSpriteCount += numQuads;
+    return vertices.data() + start;
+}
+
+//===========================================================================//
+void SpriteBatch::append(const SpriteBatch& other)
+{
+    for (size_t ii = 0; ii < other.mBatches.size(); ++ii)
+    {
+        const Batch& batch = other.mBatches[ii];
+        if (!batch.vertices.empty())
+        {
+            std::vector<sf::Vertex>& vertices = getVertices(*batch.texture);
+            vertices.insert(vertices.end(),
+                            batch.vertices.begin(),
+                            batch.vertices.end());
+        }
+    }
+    mSpriteCount += other.mSpriteCount;
+}
+
+//===========================================================================//
+void SpriteBatch::clear()
+{
+    prune();
+    for (size_t ii = 0; ii < mBatches.size(); ++ii)
+    {
+        mBatches[ii].vertices.clear();
+    }
+    mSpriteCount = 0;
+}
+
+//===========================================================================//
+void SpriteBatch::flush(Graphics& graphics)
+{
+    prune();
+    mDrawCalls = 0;
+    for (size_t ii = 0; ii < mBatches.size(); ++ii)
+    {
+        std::vector<sf::Vertex>& vertices = mBatches[ii].vertices;
+        if (vertices.empty())
+        {
+            continue;
+        }
+
+        graphics.draw(vertices.data(),
+                      vertices.size(),
+                      sf::Quads,
+                      sf::RenderStates(mBatches[ii].texture));
+        ++mDrawCalls;
+
+        // Keep the capacity around for the next frame
+        vertices.clear();
+    }
+    mSpriteCount = 0;
+}
+
+//===========================================================================//
+std::vector<sf::Vertex>& SpriteBatch::getVertices(const sf::Texture& texture)
+{
+    // Sprites tend to arrive in runs that share a texture
+    if (mLastBatch < mBatches.size() &&
+        mBatches[mLastBatch].texture == &texture)
+    {
+        return mBatches[mLastBatch].vertices;
+    }
+
+    auto iter = mLookup.find(&texture);
+    if (iter == mLookup.end())
+    {
+        Batch batch;
+        batch.texture = &texture;
+        batch.idle = 0;
+        mBatches.push_back(batch);
+        iter = mLookup.insert(std::make_pair(&texture,
+                                             mBatches.size() - 1)).first;
+    }
+
+    mLastBatch = iter->second;
+    return mBatches[mLastBatch].vertices;
+}
+
+//===========================================================================//
+void SpriteBatch::prune()
+{
+    // Textures come and go with caching and streaming, so buffers for
+    // ones that stopped being drawn are let go. Their addresses may even
+    // be reused by new textures.
+    size_t kept = 0;
+    for (size_t ii = 0; ii < mBatches.size(); ++ii)
+    {
+        Batch& batch = mBatches[ii];
+        batch.idle = batch.vertices.empty() ? batch.idle + 1 : 0;
+        if (batch.idle <= MAX_IDLE_FLUSHES)
+        {
+            if (kept != ii)
+            {
+                mBatches[kept] = std::move(batch);
+            }
+            ++kept;
+        }
+    }
+
+    if (kept != mBatches.size())
+    {
+        mBatches.erase(mBatches.begin() + kept, mBatches.end());
+        mLookup.clear();
+        for (size_t ii = 0; ii < mBatches.size(); ++ii)
+        {
+            mLookup[mBatches[ii].texture] = ii;
+        }
+        mLastBatch = 0;
+    }
+}
+}
+}
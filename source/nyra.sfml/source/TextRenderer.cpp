@@ -0,0 +1,264 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/sfml/TextRenderer.h>
+#include <algorithm>
+
+namespace
+{
+//===========================================================================//
+inline sf::Vector2f transformPoint(const nyra::Matrix& matrix,
+                                   float x,
+                                   float y)
+{
+    return sf::Vector2f(
+            (matrix(0, 0) * x) + (matrix(0, 1) * y) + matrix(0, 2),
+            (matrix(1, 0) * x) + (matrix(1, 1) * y) + matrix(1, 2));
+}
+
+//===========================================================================//
+uint32_t decodeUtf8(const std::string& text, size_t& index)
+{
+    // Anything malformed comes out as the replacement character
+    const uint8_t lead = static_cast<uint8_t>(text[index++]);
+    size_t count = 0;
+    uint32_t codepoint = 0;
+    if (lead < 0x80)
+    {
+        return lead;
+    }
+    else if ((lead & 0xE0) == 0xC0)
+    {
+        count = 1;
+        codepoint = lead & 0x1F;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        count = 2;
+        codepoint = lead & 0x0F;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        count = 3;
+        codepoint = lead & 0x07;
+    }
+    else
+    {
+        return 0xFFFD;
+    }
+
+    for (size_t ii = 0; ii < count; ++ii)
+    {
+        if (index >= text.size() ||
+            (static_cast<uint8_t>(text[index]) & 0xC0) != 0x80)
+        {
+            return 0xFFFD;
+        }
+        codepoint = (codepoint << 6) |
+                (static_cast<uint8_t>(text[index++]) & 0x3F);
+    }
+    return codepoint;
+}
+}
+
+namespace nyra
+{
+namespace sfml
+{
+//===========================================================================//
+TextRenderer::TextRenderer(GlyphAtlas& atlas, size_t maxRuns) :
+    mAtlas(atlas),
+    mMaxRuns(std::max<size_t>(maxRuns, 1)),
+    mNumLayouts(0)
+{
+}
+
+//===========================================================================//
+void TextRenderer::add(SpriteBatch& batch,
+                       const sf::Font& font,
+                       uint32_t size,
+                       const std::string& text,
+                       const Matrix& matrix,
+                       const sf::Color& color)
+{
+    Run& run = getRun(font, size, text);
+    resolve(run);
+    if (run.glyphs.empty())
+    {
+        return;
+    }
+
+    sf::Vertex* quad = batch.allocate(mAtlas.getTexture(),
+                                      run.glyphs.size());
+    for (size_t ii = 0; ii < run.glyphs.size(); ++ii, quad += 4)
+    {
+        const Glyph& glyph = run.glyphs[ii];
+        const sf::IntRect& rect = mAtlas.getTextureRect(glyph.cell);
+        const float left = glyph.bounds.left;
+        const float top = glyph.bounds.top;
+        const float right = left + glyph.bounds.width;
+        const float bottom = top + glyph.bounds.height;
+        const float u0 = static_cast<float>(rect.left);
+        const float v0 = static_cast<float>(rect.top);
+        const float u1 = static_cast<float>(rect.left + rect.width);
+        const float v1 = static_cast<float>(rect.top + rect.height);
+
+        quad[0].position = transformPoint(matrix, left, top);
+        quad[1].position = transformPoint(matrix, right, top);
+        quad[2].position = transformPoint(matrix, right, bottom);
+        quad[3].position = transformPoint(matrix, left, bottom);
+
+        quad[0].texCoords = sf::Vector2f(u0, v0);
+        quad[1].texCoords = sf::Vector2f(u1, v0);
+        quad[2].texCoords = sf::Vector2f(u1, v1);
+        quad[3].texCoords = sf::Vector2f(u0, v1);
+
+        quad[0].color = color;
+        quad[1].color = color;
+        quad[2].color = color;
+        quad[3].color = color;
+    }
+}
+
+//===========================================================================//
+Vector2F TextRenderer::measure(const sf::Font& font,
+                               uint32_t size,
+                               const std::string& text)
+{
+    return getRun(font, size, text).extent;
+}
+
+//===========================================================================//
+TextRenderer::Run& TextRenderer::getRun(const sf::Font& font,
+                                        uint32_t size,
+                                        const std::string& text)
+{
+    // The key is reused so a cache hit does not allocate
+    const sf::Font* fontPtr = &font;
+    mKey.assign(reinterpret_cast<const char*>(&fontPtr), sizeof(fontPtr));
+    mKey.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    mKey.append(text);
+
+    auto iter = mLookup.find(mKey);
+    if (iter != mLookup.end())
+    {
+        mRuns.splice(mRuns.begin(), mRuns, iter->second);
+        return mRuns.front();
+    }
+
+    if (mLookup.size() >= mMaxRuns)
+    {
+        mLookup.erase(mRuns.back().key);
+        mRuns.pop_back();
+    }
+
+    mRuns.push_front(Run());
+    Run& run = mRuns.front();
+    run.key = mKey;
+    run.font = &font;
+    run.size = size;
+    layout(run, text);
+    mLookup[run.key] = mRuns.begin();
+    ++mNumLayouts;
+    return run;
+}
+
+//===========================================================================//
+void TextRenderer::layout(Run& run, const std::string& text)
+{
+    const sf::Font& font = *run.font;
+    const float lineSpacing = font.getLineSpacing(run.size);
+    float x = 0.0f;
+    float y = static_cast<float>(run.size);
+    float width = 0.0f;
+    size_t numLines = 1;
+    uint32_t previous = 0;
+
+    for (size_t ii = 0; ii < text.size();)
+    {
+        const uint32_t codepoint = decodeUtf8(text, ii);
+        if (codepoint == '\n')
+        {
+            x = 0.0f;
+            y += lineSpacing;
+            ++numLines;
+            previous = 0;
+            continue;
+        }
+
+        x += font.getKerning(previous, codepoint, run.size);
+        previous = codepoint;
+
+        // This also rasterizes the glyph into the font texture
+        const sf::Glyph& info = font.getGlyph(codepoint, run.size, false);
+        if (info.textureRect.width > 0 && info.textureRect.height > 0)
+        {
+            Glyph glyph;
+            glyph.codepoint = codepoint;
+            glyph.bounds = sf::FloatRect(
+                    x + info.bounds.left,
+                    y + info.bounds.top,
+                    static_cast<float>(info.textureRect.width),
+                    static_cast<float>(info.textureRect.height));
+            glyph.cell = GlyphAtlas::NO_CELL;
+            glyph.generation = 0;
+            run.glyphs.push_back(glyph);
+        }
+
+        x += info.advance;
+        width = std::max(width, x);
+    }
+
+    run.extent = Vector2F(width, numLines * lineSpacing);
+}
+
+//===========================================================================//
+void TextRenderer::resolve(Run& run)
+{
+    for (size_t ii = 0; ii < run.glyphs.size(); ++ii)
+    {
+        Glyph& glyph = run.glyphs[ii];
+        if (glyph.cell != GlyphAtlas::NO_CELL &&
+            mAtlas.getGeneration(glyph.cell) == glyph.generation)
+        {
+            mAtlas.touch(glyph.cell);
+            continue;
+        }
+
+        // Missing glyphs are copied from the font texture on the GPU
+        glyph.cell = mAtlas.find(*run.font, glyph.codepoint, run.size);
+        if (glyph.cell == GlyphAtlas::NO_CELL)
+        {
+            const sf::Glyph& info = run.font->getGlyph(
+                    glyph.codepoint, run.size, false);
+            glyph.cell = mAtlas.insert(*run.font,
+                                       glyph.codepoint,
+                                       run.size,
+                                       run.font->getTexture(run.size),
+                                       info.textureRect);
+        }
+        glyph.generation = mAtlas.getGeneration(glyph.cell);
+    }
+}
+}
+}
@@ -0,0 +1,107 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/sfml/TextureCache.h>
+#include <atomic>
+#include <stdexcept>
+#include <nyra/ImageView.h>
+
+namespace
+{
+//===========================================================================//
+std::unique_ptr<nyra::sfml::Texture> loadTexture(const std::string& pathname)
+{
+    static std::atomic<uint32_t> nextId(1);
+
+    // The alpha mask comes from the same decode as the texture
+    std::unique_ptr<nyra::sfml::Texture> texture(new nyra::sfml::Texture());
+    sf::Image image;
+    if (!image.loadFromFile(pathname) ||
+        !texture->texture.loadFromImage(image))
+    {
+        throw std::runtime_error("Unable to load texture: " + pathname);
+    }
+    const nyra::Vector2U size(image.getSize());
+    texture->mask = nyra::CollisionMask(nyra::ConstImageView(
+            image.getPixelsPtr(), size, size.x * 4));
+    texture->pathname = pathname;
+    texture->id = nextId++;
+    return texture;
+}
+
+//===========================================================================//
+size_t getTextureBytes(const nyra::sfml::Texture& texture)
+{
+    const sf::Vector2u size = texture.texture.getSize();
+    return size.x * size.y * 4;
+}
+}
+
+namespace nyra
+{
+namespace sfml
+{
+//===========================================================================//
+TextureCache::TextureCache() :
+    mCache(loadTexture, getTextureBytes)
+{
+}
+
+//===========================================================================//
+TextureCache::Handle TextureCache::load(const std::string& pathname)
+{
+    return mCache.load(pathname);
+}
+
+//===========================================================================//
+size_t TextureCache::getHits() const
+{
+    return mCache.getHits();
+}
+
+//===========================================================================//
+size_t TextureCache::getMisses() const
+{
+    return mCache.getMisses();
+}
+
+//===========================================================================//
+size_t TextureCache::getNumResident() const
+{
+    return mCache.getNumResident();
+}
+
+//===========================================================================//
+size_t TextureCache::getBytesResident() const
+{
+    return mCache.getBytesResident();
+}
+
+//===========================================================================//
+TextureCache& TextureCache::getDefault()
+{
+    static TextureCache cache;
+    return cache;
+}
+}
+}
@@ -0,0 +1,273 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/sfml/TextureStreamer.h>
+#include <stdexcept>
+#include <nyra/ImageView.h>
+
+namespace
+{
+const unsigned int PLACEHOLDER_SIZE = 8;
+
+//===========================================================================//
+size_t getTextureBytes(const nyra::Vector2U& size)
+{
+    return static_cast<size_t>(size.x) * size.y * 4;
+}
+}
+
+namespace nyra
+{
+namespace sfml
+{
+//===========================================================================//
+TextureStreamer::TextureStreamer(size_t maxBytes) :
+    mMaxBytes(maxBytes),
+    mBytesResident(0),
+    mFrame(0),
+    mThrashFrames(60),
+    mNumPending(0),
+    mNumEvictions(0),
+    mNumReloads(0),
+    mNumThrashes(0),
+    mNumPlaceholderDraws(0),
+    mStop(false)
+{
+    // A checkerboard that is obviously not part of the art
+    sf::Image image;
+    image.create(PLACEHOLDER_SIZE, PLACEHOLDER_SIZE, sf::Color::Black);
+    for (unsigned int y = 0; y < PLACEHOLDER_SIZE; ++y)
+    {
+        for (unsigned int x = 0; x < PLACEHOLDER_SIZE; ++x)
+        {
+            if ((x < PLACEHOLDER_SIZE / 2) == (y < PLACEHOLDER_SIZE / 2))
+            {
+                image.setPixel(x, y, sf::Color::Magenta);
+            }
+        }
+    }
+    if (!mPlaceholder.loadFromImage(image))
+    {
+        throw std::runtime_error("Unable to create placeholder texture");
+    }
+    mPlaceholder.setRepeated(true);
+
+    mThread = std::thread(&TextureStreamer::work, this);
+}
+
+//===========================================================================//
+TextureStreamer::~TextureStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+    mThread.join();
+}
+
+//===========================================================================//
+size_t TextureStreamer::add(const std::string& pathname)
+{
+    auto iter = mIndices.find(pathname);
+    if (iter != mIndices.end())
+    {
+        return iter->second;
+    }
+
+    sf::Image image;
+    if (!image.loadFromFile(pathname))
+    {
+        throw std::runtime_error("Unable to load texture: " + pathname);
+    }
+
+    const size_t index = mEntries.size();
+    mEntries.push_back(Entry());
+    Entry& entry = mEntries.back();
+    entry.pathname = pathname;
+    entry.size = Vector2U(image.getSize());
+    entry.mask = CollisionMask(ConstImageView(image.getPixelsPtr(),
+                                              entry.size,
+                                              entry.size.x * 4));
+    entry.id = static_cast<uint32_t>(index + 1);
+    entry.resident = false;
+    entry.loading = false;
+    entry.lastUsed = mFrame;
+    entry.evictedFrame = 0;
+    if (!entry.texture.loadFromImage(image))
+    {
+        mEntries.pop_back();
+        throw std::runtime_error("Unable to load texture: " + pathname);
+    }
+    mIndices[pathname] = index;
+    makeResident(index);
+    return index;
+}
+
+//===========================================================================//
+const sf::Texture& TextureStreamer::use(size_t index)
+{
+    Entry& entry = mEntries[index];
+    if (entry.resident)
+    {
+        // Only the first use in a frame moves the texture in the list
+        if (entry.lastUsed != mFrame)
+        {
+            entry.lastUsed = mFrame;
+            mLru.splice(mLru.begin(), mLru, entry.lru);
+        }
+        return entry.texture;
+    }
+
+    entry.lastUsed = mFrame;
+    if (!entry.loading)
+    {
+        entry.loading = true;
+        ++mNumPending;
+        ++mNumReloads;
+        if (mFrame - entry.evictedFrame <= mThrashFrames)
+        {
+            ++mNumThrashes;
+        }
+
+        Load load;
+        load.index = index;
+        load.pathname = entry.pathname;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mRequests.push_back(std::move(load));
+        }
+        mWake.notify_one();
+    }
+    ++mNumPlaceholderDraws;
+    return mPlaceholder;
+}
+
+//===========================================================================//
+void TextureStreamer::update()
+{
+    std::vector<Load> finished;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        finished.swap(mFinished);
+    }
+
+    std::string failed;
+    for (size_t ii = 0; ii < finished.size(); ++ii)
+    {
+        Load& load = finished[ii];
+        Entry& entry = mEntries[load.index];
+        entry.loading = false;
+        --mNumPending;
+        if (!load.image || !entry.texture.loadFromImage(*load.image))
+        {
+            failed = load.pathname;
+            continue;
+        }
+        makeResident(load.index);
+    }
+
+    // Textures used this frame stay even if that breaks the budget,
+    // evicting them would only reload them next frame.
+    while (mBytesResident > mMaxBytes && !mLru.empty())
+    {
+        Entry& entry = mEntries[mLru.back()];
+        if (entry.lastUsed == mFrame)
+        {
+            break;
+        }
+
+        entry.texture = sf::Texture();
+        entry.resident = false;
+        entry.evictedFrame = mFrame;
+        mBytesResident -= getTextureBytes(entry.size);
+        mLru.pop_back();
+        ++mNumEvictions;
+    }
+    ++mFrame;
+
+    if (!failed.empty())
+    {
+        throw std::runtime_error("Unable to load texture: " + failed);
+    }
+}
+
+//===========================================================================//
+void TextureStreamer::waitForLoads()
+{
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDone.wait(lock, [this]()
+        {
+            return mFinished.size() == mNumPending;
+        });
+    }
+    update();
+}
+
+//===========================================================================//
+void TextureStreamer::work()
+{
+    while (true)
+    {
+        Load load;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWake.wait(lock, [this]()
+            {
+                return mStop || !mRequests.empty();
+            });
+            if (mStop)
+            {
+                return;
+            }
+            load = std::move(mRequests.front());
+            mRequests.pop_front();
+        }
+
+        // Only decoding happens here, uploads need the render thread
+        load.image.reset(new sf::Image());
+        if (!load.image->loadFromFile(load.pathname))
+        {
+            load.image.reset();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mFinished.push_back(std::move(load));
+        }
+        mDone.notify_all();
+    }
+}
+
+//===========================================================================//
+void TextureStreamer::makeResident(size_t index)
+{
+    Entry& entry = mEntries[index];
+    entry.resident = true;
+    mLru.push_front(index);
+    entry.lru = mLru.begin();
+    mBytesResident += getTextureBytes(entry.size);
+}
+}
+}
@@ -22,7 +22,7 @@
  * IN THE SOFTWARE.
  */
 #include <nyra/sfml/TileMap.h>
-#include <nyra/sfml/Graphics.h>
+#include <stdexcept>
 
 namespace nyra
 {
@@ -32,18 +32,33 @@ namespace sfml
 TileMap::TileMap(const Vector2U& numTiles,
                  const Vector2U& tileSize,
                  const std::string& pathname,
-                 const uint16_t* tiles) :
+                 const uint16_t* tiles,
+                 MemoryResource& resource,
+                 TextureCache& cache,
+                 const AssetResolver& resolver) :
     mNumTiles(numTiles),
-    mTileSize(tileSize)
+    mTileSize(tileSize),
+    mVertices(Allocator<sf::Vertex>(resource))
 {
-    // load the tileset texture
-    if (!mTexture.loadFromFile(pathname))
+    if (mTileSize.x == 0 || mTileSize.y == 0)
     {
-        throw std::runtime_error("Unable to load texture: " + pathname);
+        throw std::runtime_error("Tile size must not be zero");
+    }
+
+    const AssetResolver::Variant variant = resolver.resolve(pathname);
+    mTexture = cache.load(variant.pathname);
+    const sf::Vector2u textureSize = mTexture->texture.getSize();
+
+    // Tiles are placed in logical pixels but cut from the variant
+    const float texelX = mTileSize.x * variant.scale;
+    const float texelY = mTileSize.y * variant.scale;
+    const size_t tilesPerRow = static_cast<size_t>(textureSize.x / texelX);
+    if (tilesPerRow == 0)
+    {
+        throw std::runtime_error("Tileset is smaller than a tile");
     }
 
     // resize the vertex array to fit the level size
-    mVertices.setPrimitiveType(sf::Quads);
     mVertices.resize(mNumTiles.product() * 4);
 
     // populate the vertex array, with one quad per tile
@@ -55,8 +70,8 @@ TileMap::TileMap(const Vector2U& numTiles,
             const size_t tileNumber = tiles[ii + jj * mNumTiles.x];
 
             // find its position in the tileset texture
-            const size_t tu = tileNumber % (mTexture.getSize().x / mTileSize.x);
-            const size_t tv = tileNumber / (mTexture.getSize().x / mTileSize.x);
+            const size_t tu = tileNumber % tilesPerRow;
+            const size_t tv = tileNumber / tilesPerRow;
 
             // get a pointer to the current tile's quad
             sf::Vertex* quad = &mVertices[(ii + jj * mNumTiles.x) * 4];
@@ -73,35 +88,21 @@ TileMap::TileMap(const Vector2U& numTiles,
 
             // define its 4 texture coordinates
             quad[0].texCoords = sf::Vector2f(
-                    tu * mTileSize.x, tv * mTileSize.y);
+                    tu * texelX, tv * texelY);
             quad[1].texCoords = sf::Vector2f(
-                    (tu + 1) * mTileSize.x, tv * mTileSize.y);
+                    (tu + 1) * texelX, tv * texelY);
             quad[2].texCoords = sf::Vector2f(
-                    (tu + 1) * mTileSize.x, (tv + 1) * mTileSize.y);
+                    (tu + 1) * texelX, (tv + 1) * texelY);
             quad[3].texCoords = sf::Vector2f(
-                    tu * mTileSize.x, (tv + 1) * mTileSize.y);
+                    tu * texelX, (tv + 1) * texelY);
         }
     }
 }
 
 //===========================================================================//
-void TileMap::render(const Matrix& matrix,
-                     GraphicsInterface& graphics)
+Vector2U TileMap::getSize() const
 {
-
-    const sf::Transform sfmlMatrix(matrix(0, 0), matrix(0, 1), matrix(0, 2),
-                                   matrix(1, 0), matrix(1, 1), matrix(1, 2),
-                                   matrix(2, 0), matrix(2, 1), matrix(2, 2));
-
-    // apply the transform
-    mRenderState.transform = sfmlMatrix;
-
-    // apply the tileset texture
-    mRenderState.texture = &mTexture;
-
-    // draw the vertex array
-    Graphics& sfmlGraphics(dynamic_cast<Graphics&>(graphics));
-    sfmlGraphics.getRenderTarget().draw(mVertices, mRenderState);
+    return mNumTiles * mTileSize;
 }
 }
 }
\ No newline at end of file
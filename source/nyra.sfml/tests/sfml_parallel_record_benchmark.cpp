@@ -0,0 +1,132 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+#include <nyra/Constants.h>
+#include <nyra/ParallelRecorder.h>
+#include <nyra/Transform.h>
+#include <nyra/sfml/Window.h>
+#include <nyra/sfml/Graphics.h>
+#include <nyra/sfml/Sprite.h>
+#include <nyra/sfml/SpriteBatch.h>
+
+namespace
+{
+typedef std::chrono::high_resolution_clock Clock;
+
+//===========================================================================//
+double milliseconds(const Clock::time_point& start)
+{
+    const std::chrono::duration<double, std::milli> elapsed =
+            Clock::now() - start;
+    return elapsed.count();
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        const nyra::Vector2U windowSize(1280, 720);
+        nyra::sfml::Window window("Parallel record benchmark",
+                                  windowSize,
+                                  nyra::Vector2I(0, 0),
+                                  false);
+        nyra::sfml::Graphics graphics;
+        nyra::sfml::Sprite sprite(
+                nyra::Constants::APP_PATH +
+                "../data/unittests/sfml_sprite_animation.png",
+                nyra::Vector2U(6, 3));
+        const size_t count = 200000;
+        const size_t frames = 20;
+
+        std::vector<nyra::Transform> transforms(count);
+        for (size_t ii = 0; ii < count; ++ii)
+        {
+            transforms[ii].setPosition(nyra::Vector2F(
+                    rand() % windowSize.x, rand() % windowSize.y));
+            transforms[ii].setSize(sprite.getSize());
+        }
+
+        // Moving every object each frame keeps the matrix math honest
+        const auto recordRange = [&transforms, &sprite](
+                nyra::sfml::SpriteBatch& batch,
+                size_t begin,
+                size_t end)
+        {
+            for (size_t ii = begin; ii < end; ++ii)
+            {
+                transforms[ii].setRotation(
+                        transforms[ii].getRotation() + 1.0f);
+                batch.add(sprite, transforms[ii].getMatrix());
+            }
+        };
+
+        const size_t maxThreads =
+                std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        for (size_t threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            nyra::ParallelRecorder<nyra::sfml::SpriteBatch> recorder(
+                    threads);
+            nyra::sfml::SpriteBatch merged;
+            double recordTime = 0.0;
+            double mergeTime = 0.0;
+            for (size_t frame = 0; frame < frames && window.update(); ++frame)
+            {
+                graphics.clear(window.getHandle());
+                const auto recordStart = Clock::now();
+                recorder.record(count, recordRange);
+                recordTime += milliseconds(recordStart);
+
+                const auto mergeStart = Clock::now();
+                for (size_t ii = 0; ii < recorder.getNumLists(); ++ii)
+                {
+                    merged.append(recorder.getList(ii));
+                }
+                merged.flush(graphics);
+                mergeTime += milliseconds(mergeStart);
+                graphics.present();
+            }
+
+            std::cout << threads << " threads\n"
+                      << "    record: " << recordTime / frames
+                      << " ms per frame\n"
+                      << "    merge and submit: " << mergeTime / frames
+                      << " ms per frame\n";
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Caught standard exception from " <<
+            ex.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Caught unnamed Unwanted exception" << std::endl;
+    }
+}
@@ -0,0 +1,141 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <nyra/Constants.h>
+#include <nyra/ParticleEmitter.h>
+#include <nyra/sfml/Window.h>
+#include <nyra/sfml/Graphics.h>
+#include <nyra/sfml/Sprite.h>
+#include <nyra/sfml/ParticleSystem.h>
+
+namespace
+{
+typedef std::chrono::high_resolution_clock Clock;
+
+//===========================================================================//
+double milliseconds(const Clock::time_point& start)
+{
+    const std::chrono::duration<double, std::milli> elapsed =
+            Clock::now() - start;
+    return elapsed.count();
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        const nyra::Vector2U windowSize(1280, 720);
+        nyra::sfml::Window window("Particle benchmark",
+                                  windowSize,
+                                  nyra::Vector2I(0, 0),
+                                  false);
+        nyra::sfml::Graphics graphics;
+        nyra::sfml::Sprite sprite(
+                nyra::Constants::APP_PATH +
+                "../data/unittests/sfml_sprite_animation.png",
+                nyra::Vector2U(6, 3));
+        const size_t frames = 60;
+        const float elapsed = 1.0f / 60.0f;
+        const size_t counts[] = {100000, 1000000};
+
+        for (size_t count : counts)
+        {
+            // Spawn as many particles per second as die so the count holds
+            nyra::ParticleEmitter::Settings settings;
+            settings.capacity = count;
+            settings.minLifetime = 1.0f;
+            settings.maxLifetime = 3.0f;
+            settings.rate = count / 2.0f;
+            settings.minSpeed = 20.0f;
+            settings.maxSpeed = 300.0f;
+            settings.acceleration = nyra::Vector2F(0.0f, 50.0f);
+            settings.numFrames = sprite.getNumFrames();
+            nyra::ParticleEmitter emitter(settings);
+            emitter.setPosition(nyra::Vector2F(windowSize.x / 2.0f,
+                                               windowSize.y / 2.0f));
+            emitter.emit(count);
+
+            nyra::sfml::ParticleSystem system;
+            system.add(emitter, sprite);
+
+            // The SIMD and scalar update on their own
+            nyra::ParticleBuffer simd(emitter.getParticles());
+            nyra::ParticleBuffer reference(emitter.getParticles());
+            auto start = Clock::now();
+            for (size_t frame = 0; frame < frames; ++frame)
+            {
+                simd.update(elapsed, settings.acceleration, 18);
+            }
+            const double simdTime = milliseconds(start);
+            start = Clock::now();
+            for (size_t frame = 0; frame < frames; ++frame)
+            {
+                reference.updateReference(elapsed, settings.acceleration, 18);
+            }
+            const double referenceTime = milliseconds(start);
+
+            // The whole system including spawning and drawing
+            double updateTime = 0.0;
+            double renderTime = 0.0;
+            size_t particles = 0;
+            for (size_t frame = 0; frame < frames && window.update(); ++frame)
+            {
+                start = Clock::now();
+                system.update(elapsed);
+                updateTime += milliseconds(start);
+                particles += system.getNumParticles();
+
+                graphics.clear(window.getHandle());
+                start = Clock::now();
+                system.render(graphics);
+                renderTime += milliseconds(start);
+                graphics.present();
+            }
+
+            std::cout << count << " particles\n"
+                      << "    scalar update: " << referenceTime / frames
+                      << " ms per frame\n"
+                      << "    SIMD update: " << simdTime / frames
+                      << " ms per frame\n"
+                      << "    system update: " << updateTime / frames
+                      << " ms per frame, " << particles / frames
+                      << " particles on average\n"
+                      << "    render: " << renderTime / frames
+                      << " ms CPU per frame, " << system.getDrawCalls()
+                      << " draw calls\n";
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Caught standard exception from " <<
+            ex.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Caught unnamed Unwanted exception" << std::endl;
+    }
+}
@@ -0,0 +1,126 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <stdlib.h>
+#include <vector>
+#include <nyra/Constants.h>
+#include <nyra/Matrix.h>
+#include <nyra/sfml/Window.h>
+#include <nyra/sfml/Graphics.h>
+#include <nyra/sfml/Sprite.h>
+
+namespace
+{
+typedef std::chrono::high_resolution_clock Clock;
+
+//===========================================================================//
+double milliseconds(const Clock::time_point& start)
+{
+    const std::chrono::duration<double, std::milli> elapsed =
+            Clock::now() - start;
+    return elapsed.count();
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        const nyra::Vector2U windowSize(1280, 720);
+        nyra::sfml::Window window("Render dispatch benchmark",
+                                  windowSize,
+                                  nyra::Vector2I(0, 0),
+                                  false);
+        nyra::sfml::Graphics graphics;
+        nyra::sfml::Sprite sprite(
+                nyra::Constants::APP_PATH +
+                "../data/unittests/sfml-logo-small.png");
+        const size_t frames = 20;
+        const size_t counts[] = {1000, 10000, 100000};
+
+        // Both paths draw the same object, only the binding differs
+        nyra::RenderableInterface& dynamicSprite = sprite;
+        nyra::GraphicsInterface& dynamicGraphics = graphics;
+
+        for (size_t count : counts)
+        {
+            std::vector<nyra::Matrix> matrices;
+            matrices.reserve(count);
+            for (size_t ii = 0; ii < count; ++ii)
+            {
+                matrices.push_back(nyra::Matrix(
+                        nyra::Vector2F(rand() % windowSize.x,
+                                       rand() % windowSize.y),
+                        nyra::Vector2F(-32.0f, -32.0f),
+                        nyra::Vector2F(1.0f, 1.0f),
+                        rand() % 360));
+            }
+
+            // Virtual render through the interfaces
+            double dynamicTime = 0.0;
+            for (size_t frame = 0; frame < frames && window.update(); ++frame)
+            {
+                graphics.clear(window.getHandle());
+                const auto start = Clock::now();
+                for (size_t ii = 0; ii < count; ++ii)
+                {
+                    dynamicSprite.render(matrices[ii], dynamicGraphics);
+                }
+                dynamicTime += milliseconds(start);
+                graphics.present();
+            }
+
+            // Statically bound render on the concrete types
+            double staticTime = 0.0;
+            for (size_t frame = 0; frame < frames && window.update(); ++frame)
+            {
+                graphics.clear(window.getHandle());
+                const auto start = Clock::now();
+                for (size_t ii = 0; ii < count; ++ii)
+                {
+                    sprite.render(matrices[ii], graphics);
+                }
+                staticTime += milliseconds(start);
+                graphics.present();
+            }
+
+            std::cout << count << " sprites\n"
+                      << "    virtual: " << dynamicTime / frames
+                      << " ms CPU per frame\n"
+                      << "    static: " << staticTime / frames
+                      << " ms CPU per frame\n";
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Caught standard exception from " <<
+            ex.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Caught unnamed Unwanted exception" << std::endl;
+    }
+}
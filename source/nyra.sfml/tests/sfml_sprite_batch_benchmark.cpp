@@ -0,0 +1,127 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <stdlib.h>
+#include <vector>
+#include <nyra/Constants.h>
+#include <nyra/Matrix.h>
+#include <nyra/sfml/Window.h>
+#include <nyra/sfml/Graphics.h>
+#include <nyra/sfml/Sprite.h>
+#include <nyra/sfml/SpriteBatch.h>
+
+namespace
+{
+typedef std::chrono::high_resolution_clock Clock;
+
+//===========================================================================//
+double milliseconds(const Clock::time_point& start)
+{
+    const std::chrono::duration<double, std::milli> elapsed =
+            Clock::now() - start;
+    return elapsed.count();
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        const nyra::Vector2U windowSize(1280, 720);
+        nyra::sfml::Window window("Sprite batch benchmark",
+                                  windowSize,
+                                  nyra::Vector2I(0, 0),
+                                  false);
+        nyra::sfml::Graphics graphics;
+        nyra::sfml::Sprite sprite(
+                nyra::Constants::APP_PATH +
+                "../data/unittests/sfml_sprite_animation.png",
+                nyra::Vector2U(6, 3));
+        nyra::sfml::SpriteBatch batch;
+        const size_t frames = 20;
+        const size_t counts[] = {1000, 10000, 100000};
+
+        for (size_t count : counts)
+        {
+            std::vector<nyra::Matrix> matrices;
+            matrices.reserve(count);
+            for (size_t ii = 0; ii < count; ++ii)
+            {
+                matrices.push_back(nyra::Matrix(
+                        nyra::Vector2F(rand() % windowSize.x,
+                                       rand() % windowSize.y),
+                        nyra::Vector2F(-32.0f, -32.0f),
+                        nyra::Vector2F(1.0f, 1.0f),
+                        rand() % 360));
+            }
+
+            // One draw call per sprite
+            double individualTime = 0.0;
+            for (size_t frame = 0; frame < frames && window.update(); ++frame)
+            {
+                const auto start = Clock::now();
+                graphics.clear(window.getHandle());
+                for (size_t ii = 0; ii < count; ++ii)
+                {
+                    sprite.render(matrices[ii], graphics);
+                }
+                individualTime += milliseconds(start);
+                graphics.present();
+            }
+
+            // One draw call per texture
+            double batchTime = 0.0;
+            for (size_t frame = 0; frame < frames && window.update(); ++frame)
+            {
+                const auto start = Clock::now();
+                graphics.clear(window.getHandle());
+                for (size_t ii = 0; ii < count; ++ii)
+                {
+                    batch.add(sprite, matrices[ii]);
+                }
+                batch.flush(graphics);
+                batchTime += milliseconds(start);
+                graphics.present();
+            }
+
+            std::cout << count << " sprites\n"
+                      << "    individual: " << count << " draw calls, "
+                      << individualTime / frames << " ms CPU per frame\n"
+                      << "    batched: " << batch.getDrawCalls()
+                      << " draw calls, " << batchTime / frames
+                      << " ms CPU per frame\n";
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Caught standard exception from " <<
+            ex.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Caught unnamed Unwanted exception" << std::endl;
+    }
+}
@@ -0,0 +1,152 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <stdlib.h>
+#include <vector>
+#include <nyra/Constants.h>
+#include <nyra/Matrix.h>
+#include <nyra/sfml/Sprite.h>
+#include <nyra/sfml/SpriteBatch.h>
+
+namespace
+{
+typedef std::chrono::high_resolution_clock Clock;
+
+//===========================================================================//
+double milliseconds(const Clock::time_point& start)
+{
+    const std::chrono::duration<double, std::milli> elapsed =
+            Clock::now() - start;
+    return elapsed.count();
+}
+
+//===========================================================================//
+template <typename GetSpriteT>
+double recordFrames(size_t count,
+                    size_t frames,
+                    const std::vector<nyra::Matrix>& matrices,
+                    nyra::sfml::SpriteBatch& batch,
+                    GetSpriteT getSprite)
+{
+    // Only the CPU side is timed, the batch is never submitted
+    const auto start = Clock::now();
+    for (size_t frame = 0; frame < frames; ++frame)
+    {
+        for (size_t ii = 0; ii < count; ++ii)
+        {
+            nyra::sfml::Sprite& sprite = getSprite(ii);
+            sprite.setFrame((frame + ii) % sprite.getNumFrames());
+            batch.add(sprite, matrices[ii]);
+        }
+        batch.clear();
+    }
+    return milliseconds(start) / frames;
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        const std::string pathname(
+                nyra::Constants::APP_PATH +
+                "../data/unittests/sfml_sprite_animation.png");
+        const size_t frames = 50;
+        const size_t counts[] = {1000, 5000, 10000};
+        nyra::sfml::SpriteBatch batch;
+
+        for (size_t count : counts)
+        {
+            std::vector<nyra::Matrix> matrices;
+            matrices.reserve(count);
+            for (size_t ii = 0; ii < count; ++ii)
+            {
+                matrices.push_back(nyra::Matrix(
+                        nyra::Vector2F(rand() % 1280, rand() % 720),
+                        nyra::Vector2F(-32.0f, -32.0f),
+                        nyra::Vector2F(1.0f, 1.0f),
+                        rand() % 360));
+            }
+
+            // Sprites created one at a time over the life of a level end
+            // up scattered between other allocations.
+            std::vector<std::unique_ptr<nyra::sfml::Sprite> > pointers;
+            std::vector<std::unique_ptr<char[]> > clutter;
+            for (size_t ii = 0; ii < count; ++ii)
+            {
+                pointers.push_back(std::unique_ptr<nyra::sfml::Sprite>(
+                        new nyra::sfml::Sprite(pathname,
+                                               nyra::Vector2U(6, 3))));
+                clutter.push_back(std::unique_ptr<char[]>(
+                        new char[64 + rand() % 4096]));
+            }
+
+            std::vector<nyra::sfml::Sprite> values;
+            values.reserve(count);
+            for (size_t ii = 0; ii < count; ++ii)
+            {
+                values.push_back(std::move(*pointers[ii]));
+            }
+            pointers.clear();
+            for (size_t ii = 0; ii < count; ++ii)
+            {
+                pointers.push_back(std::unique_ptr<nyra::sfml::Sprite>(
+                        new nyra::sfml::Sprite(values[ii])));
+                clutter.push_back(std::unique_ptr<char[]>(
+                        new char[64 + rand() % 4096]));
+            }
+
+            const double pointerTime = recordFrames(
+                    count, frames, matrices, batch,
+                    [&pointers](size_t index) -> nyra::sfml::Sprite&
+                    {
+                        return *pointers[index];
+                    });
+            const double valueTime = recordFrames(
+                    count, frames, matrices, batch,
+                    [&values](size_t index) -> nyra::sfml::Sprite&
+                    {
+                        return values[index];
+                    });
+
+            std::cout << count << " sprites\n"
+                      << "    heap allocated: " << pointerTime
+                      << " ms CPU per frame\n"
+                      << "    contiguous: " << valueTime
+                      << " ms CPU per frame\n";
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Caught standard exception from " <<
+            ex.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Caught unnamed Unwanted exception" << std::endl;
+    }
+}
@@ -24,8 +24,10 @@
 #include <gtest/gtest.h>
 #include <nyra/sfml/Window.h>
 #include <nyra/sfml/Graphics.h>
+#include <nyra/sfml/Sprite.h>
 #include <nyra/Constants.h>
 #include <nyra/Image.h>
+#include <nyra/Transform.h>
 
 TEST(WindowSFMLTest, Screenshot)
 {
@@ -52,4 +54,38 @@ TEST(WindowSFMLTest, Screenshot)
 
     // Make sure the images are the same
     EXPECT_EQ(screenshotImage, truthImage);
-}
\ No newline at end of file
+}
+TEST(WindowSFMLTest, TiledScreenshot)
+{
+    // The window is much smaller than the capture so the sprite straddles
+    // several tiles.
+    nyra::sfml::Window window("Test window",
+                              nyra::Vector2U(160, 96),
+                              nyra::Vector2I(0, 0),
+                              false);
+    nyra::sfml::Graphics graphics;
+    nyra::sfml::Sprite sprite(nyra::Constants::APP_PATH +
+                              "../data/unittests/sfml-logo-small.png");
+    nyra::Transform transform;
+    transform.setSize(sprite.getSize());
+    transform.setPosition(nyra::Vector2F(200.0f, 200.0f));
+
+    window.update();
+    graphics.clear(window.getHandle());
+    const std::string screenshotPathname(
+            nyra::Constants::APP_PATH +
+            "../data/unittests/sfml_graphics_tiled_test.png");
+    graphics.screenshot(screenshotPathname,
+                        nyra::Vector2U(400, 400),
+                        [&]()
+                        {
+                            sprite.render(transform.getMatrix(), graphics);
+                        });
+
+    // The stitched image should match a single render of the same scene
+    nyra::Image screenshotImage(screenshotPathname);
+    nyra::Image truthImage(
+            nyra::Constants::APP_PATH +
+            "../data/unittests/sfml_sprite_centered_truth.png");
+    EXPECT_EQ(screenshotImage, truthImage);
+}
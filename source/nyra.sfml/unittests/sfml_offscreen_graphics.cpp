@@ -0,0 +1,236 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include <nyra/sfml/OffscreenGraphics.h>
+#include <nyra/sfml/Sprite.h>
+#include <nyra/sfml/RenderLayer.h>
+#include <nyra/Constants.h>
+#include <nyra/Image.h>
+#include <nyra/Transform.h>
+#include <nyra/RenderStats.h>
+#include <nyra/DynamicResolution.h>
+
+namespace
+{
+//===========================================================================//
+nyra::Image capture(const nyra::sfml::OffscreenGraphics& graphics,
+                    const std::string& name)
+{
+    const std::string pathname(nyra::Constants::APP_PATH +
+            "../data/unittests/sfml_offscreen_" + name + ".png");
+    graphics.screenshot(pathname);
+    return nyra::Image(pathname);
+}
+}
+
+//===========================================================================//
+TEST(OffscreenGraphicsSFMLTest, MatchesWindow)
+{
+    // The same scenes as the window tests must give the same pixels
+    nyra::sfml::OffscreenGraphics graphics(nyra::Vector2U(400, 400));
+    EXPECT_EQ(graphics.getSize(), nyra::Vector2U(400, 400));
+    nyra::sfml::Sprite sprite(nyra::Constants::APP_PATH +
+                              "../data/unittests/sfml-logo-small.png");
+    nyra::Transform transform;
+    transform.setSize(sprite.getSize());
+    transform.setPosition(nyra::Vector2F(200.0f, 200.0f));
+
+    graphics.clear(0);
+    sprite.render(transform.getMatrix(), graphics);
+    graphics.present();
+    EXPECT_EQ(capture(graphics, "centered"),
+              nyra::Image(nyra::Constants::APP_PATH +
+                          "../data/unittests/sfml_sprite_centered_truth.png"));
+
+    transform.setRotation(33.33f);
+    graphics.clear(0);
+    sprite.render(transform.getMatrix(), graphics);
+    graphics.present();
+    EXPECT_EQ(capture(graphics, "rotated"),
+              nyra::Image(nyra::Constants::APP_PATH +
+                          "../data/unittests/sfml_sprite_rotated_truth.png"));
+
+    // Reading back directly gives the same pixels as the saved file
+    const nyra::Image image = graphics.getImage();
+    EXPECT_EQ(image.getSize(), nyra::Vector2U(400, 400));
+    EXPECT_EQ(image.getPixelSize(), 4);
+    EXPECT_EQ(image, capture(graphics, "rotated"));
+}
+
+//===========================================================================//
+TEST(OffscreenGraphicsSFMLTest, Scissor)
+{
+    nyra::sfml::OffscreenGraphics graphics(nyra::Vector2U(64, 64));
+    nyra::sfml::Sprite sprite(nyra::Constants::APP_PATH +
+                              "../data/unittests/sfml_sprite_animation.png",
+                              nyra::Vector2U(6, 3));
+    nyra::Transform transform;
+    transform.setSize(sprite.getSize());
+    transform.setPivot(0.0f, 0.0f);
+
+    graphics.clear(0);
+    sprite.render(transform.getMatrix(), graphics);
+    graphics.present();
+    const nyra::Image full = graphics.getImage();
+
+    // Clearing a scissor area keeps everything outside of it
+    graphics.setScissor(nyra::RectI(nyra::Vector2I(16, 16),
+                                    nyra::Vector2I(48, 48)));
+    graphics.clear(0);
+    graphics.resetScissor();
+    graphics.present();
+    const nyra::Image cut = graphics.getImage();
+    for (uint32_t y = 0; y < 64; ++y)
+    {
+        for (uint32_t x = 0; x < 64; ++x)
+        {
+            const size_t index = ((y * 64) + x) * 4;
+            const bool inside = x >= 16 && x < 48 && y >= 16 && y < 48;
+            for (size_t ii = 0; ii < 3; ++ii)
+            {
+                EXPECT_EQ(cut.getBuffer()[index + ii],
+                          inside ? 0 : full.getBuffer()[index + ii]);
+            }
+        }
+    }
+}
+
+//===========================================================================//
+TEST(OffscreenGraphicsSFMLTest, Stats)
+{
+    nyra::sfml::OffscreenGraphics graphics(nyra::Vector2U(64, 64));
+    nyra::sfml::Sprite logo(nyra::Constants::APP_PATH +
+                            "../data/unittests/sfml-logo-small.png");
+    nyra::sfml::Sprite animation(nyra::Constants::APP_PATH +
+                                 "../data/unittests/sfml_sprite_animation.png",
+                                 nyra::Vector2U(6, 3));
+    const nyra::Matrix matrix;
+
+    graphics.clear(0);
+    logo.render(matrix, graphics);
+    logo.render(matrix, graphics);
+    animation.render(matrix, graphics);
+    graphics.setScissor(nyra::RectI(nyra::Vector2I(0, 0),
+                                    nyra::Vector2I(32, 32)));
+    graphics.resetScissor();
+    sf::RenderTexture texture;
+    texture.create(8, 8);
+    sf::RenderTarget& previous = graphics.setRenderTarget(texture);
+    graphics.setRenderTarget(previous);
+    graphics.present();
+
+    const nyra::RenderStats& stats = graphics.getStats();
+    ASSERT_EQ(stats.getNumFrames(), 1);
+    EXPECT_EQ(stats.getLast().drawCalls, 3);
+    EXPECT_EQ(stats.getLast().vertices, 12);
+    EXPECT_EQ(stats.getLast().textureSwitches, 2);
+    EXPECT_EQ(stats.getLast().stateChanges, 2);
+    EXPECT_EQ(stats.getLast().offscreenPasses, 1);
+    EXPECT_GE(stats.getLast().clearTime, 0.0);
+    EXPECT_GE(stats.getLast().presentTime, 0.0);
+
+    graphics.clear(0);
+    graphics.present();
+    EXPECT_EQ(stats.getNumFrames(), 2);
+    EXPECT_EQ(stats.getLast().drawCalls, 0);
+}
+
+//===========================================================================//
+TEST(OffscreenGraphicsSFMLTest, RenderScale)
+{
+    nyra::sfml::OffscreenGraphics graphics(nyra::Vector2U(64, 64));
+    EXPECT_THROW(graphics.setRenderScale(0.0f), std::runtime_error);
+    EXPECT_THROW(graphics.setRenderScale(1.5f), std::runtime_error);
+
+    nyra::sfml::Sprite sprite(nyra::Constants::APP_PATH +
+                              "../data/unittests/sfml_sprite_animation.png",
+                              nyra::Vector2U(6, 3));
+    nyra::Transform transform;
+    transform.setSize(sprite.getSize());
+    transform.setPivot(0.0f, 0.0f);
+    nyra::sfml::RenderLayer::Budget budget(1024 * 1024);
+    nyra::sfml::RenderLayer layer(nyra::Vector2U(64, 64), budget);
+    layer.add(sprite, transform);
+    layer.setNativeResolution(true);
+    const nyra::Matrix matrix;
+
+    graphics.clear(0);
+    EXPECT_FALSE(graphics.isRenderScaled());
+    layer.render(matrix, graphics);
+    graphics.present();
+    const nyra::Image full = graphics.getImage();
+
+    // The scene shrinks but the framebuffer keeps its size
+    graphics.setRenderScale(0.5f);
+    graphics.clear(0);
+    EXPECT_TRUE(graphics.isRenderScaled());
+    EXPECT_EQ(graphics.getRenderSize(), nyra::Vector2U(32, 32));
+    layer.render(matrix, graphics);
+    graphics.present();
+    EXPECT_EQ(graphics.getStats().getLast().offscreenPasses, 1);
+    const nyra::Image scaled = graphics.getImage();
+    EXPECT_EQ(scaled.getSize(), nyra::Vector2U(64, 64));
+
+    // A native layer over an empty scene is untouched by the scale
+    EXPECT_EQ(scaled, full);
+
+    // Other scales render into part of the same target
+    graphics.setRenderScale(0.75f);
+    graphics.clear(0);
+    EXPECT_EQ(graphics.getRenderSize(), nyra::Vector2U(48, 48));
+    layer.render(matrix, graphics);
+    graphics.present();
+    EXPECT_EQ(graphics.getImage(), full);
+
+    // Going back to full resolution draws straight to the framebuffer
+    graphics.setRenderScale(1.0f);
+    graphics.clear(0);
+    EXPECT_FALSE(graphics.isRenderScaled());
+    EXPECT_EQ(graphics.getRenderSize(), nyra::Vector2U(64, 64));
+    graphics.present();
+    EXPECT_EQ(graphics.getStats().getLast().offscreenPasses, 0);
+}
+
+//===========================================================================//
+TEST(OffscreenGraphicsSFMLTest, ResolutionController)
+{
+    // An impossible frame time pushes the scale down to the minimum
+    nyra::sfml::OffscreenGraphics graphics(nyra::Vector2U(64, 64));
+    nyra::DynamicResolution controller(1.0e-9, 0.5f, 1.0f);
+    graphics.setResolutionController(&controller);
+    for (size_t ii = 0; ii < 200; ++ii)
+    {
+        graphics.clear(0);
+        graphics.present();
+    }
+    EXPECT_FLOAT_EQ(graphics.getRenderScale(), 0.5f);
+    EXPECT_FLOAT_EQ(controller.getScale(), 0.5f);
+
+    graphics.setResolutionController(nullptr);
+    graphics.setRenderScale(1.0f);
+    graphics.clear(0);
+    graphics.present();
+    EXPECT_FLOAT_EQ(graphics.getRenderScale(), 1.0f);
+}
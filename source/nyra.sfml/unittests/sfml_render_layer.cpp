@@ -0,0 +1,194 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <nyra/sfml/RenderLayer.h>
+#include <nyra/sfml/OffscreenGraphics.h>
+#include <nyra/sfml/Sprite.h>
+#include <nyra/sfml/TextureStreamer.h>
+#include <nyra/Constants.h>
+#include <nyra/Image.h>
+#include <nyra/Transform.h>
+
+namespace
+{
+//===========================================================================//
+class RenderLayerSFMLTest : public ::testing::Test
+{
+protected:
+    RenderLayerSFMLTest() :
+        graphics(nyra::Vector2U(128, 128)),
+        sprite(nyra::Constants::APP_PATH +
+               "../data/unittests/sfml_sprite_animation.png",
+               nyra::Vector2U(6, 3))
+    {
+        transform.setSize(sprite.getSize());
+        transform.setPivot(0.0f, 0.0f);
+        transform.setPosition(nyra::Vector2F(10.0f, 20.0f));
+        layerTransform.setSize(nyra::Vector2F(64.0f, 64.0f));
+        layerTransform.setPivot(0.0f, 0.0f);
+        layerTransform.setPosition(nyra::Vector2F(30.0f, 40.0f));
+    }
+
+    nyra::Image renderDirect()
+    {
+        graphics.clear(0);
+        sprite.render(layerTransform.getMatrix() * transform.getMatrix(),
+                      graphics);
+        graphics.present();
+        return graphics.getImage();
+    }
+
+    nyra::Image renderLayer(nyra::sfml::RenderLayer& layer)
+    {
+        graphics.clear(0);
+        layer.render(layerTransform.getMatrix(), graphics);
+        graphics.present();
+        return graphics.getImage();
+    }
+
+    nyra::sfml::OffscreenGraphics graphics;
+    nyra::sfml::Sprite sprite;
+    nyra::Transform transform;
+    nyra::Transform layerTransform;
+};
+}
+
+//===========================================================================//
+TEST_F(RenderLayerSFMLTest, MatchesDirect)
+{
+    nyra::sfml::RenderLayer::Budget budget(1024 * 1024);
+    nyra::sfml::RenderLayer layer(nyra::Vector2U(64, 64), budget);
+    layer.add(sprite, transform);
+    EXPECT_EQ(layer.getSize(), nyra::Vector2U(64, 64));
+    EXPECT_FALSE(layer.isCached());
+
+    EXPECT_EQ(renderLayer(layer), renderDirect());
+    EXPECT_TRUE(layer.isCached());
+    EXPECT_EQ(budget.getBytesResident(), layer.getNumBytes());
+}
+
+//===========================================================================//
+TEST_F(RenderLayerSFMLTest, Rebuild)
+{
+    nyra::sfml::RenderLayer::Budget budget(1024 * 1024);
+    nyra::sfml::RenderLayer layer(nyra::Vector2U(64, 64), budget);
+    layer.add(sprite, transform);
+    renderLayer(layer);
+    renderLayer(layer);
+    EXPECT_EQ(layer.getNumRebuilds(), 1);
+
+    // Moving the layer itself does not need a rebuild
+    layerTransform.setPosition(nyra::Vector2F(50.0f, 50.0f));
+    EXPECT_EQ(renderLayer(layer), renderDirect());
+    EXPECT_EQ(layer.getNumRebuilds(), 1);
+
+    transform.setPosition(nyra::Vector2F(0.0f, 0.0f));
+    EXPECT_EQ(renderLayer(layer), renderDirect());
+    EXPECT_EQ(layer.getNumRebuilds(), 2);
+
+    sprite.setFrame(4);
+    EXPECT_EQ(renderLayer(layer), renderDirect());
+    EXPECT_EQ(layer.getNumRebuilds(), 3);
+
+    layer.invalidate();
+    renderLayer(layer);
+    EXPECT_EQ(layer.getNumRebuilds(), 4);
+
+    layer.clear();
+    graphics.clear(0);
+    graphics.present();
+    EXPECT_EQ(renderLayer(layer), graphics.getImage());
+    EXPECT_EQ(layer.getNumRebuilds(), 5);
+}
+
+//===========================================================================//
+TEST_F(RenderLayerSFMLTest, Streaming)
+{
+    // Nothing uses the texture for a frame, so it starts out evicted
+    nyra::sfml::TextureStreamer streamer(0);
+    nyra::sfml::Sprite streamed(nyra::Constants::APP_PATH +
+                                "../data/unittests/sfml_sprite_animation.png",
+                                nyra::Vector2U(6, 3),
+                                streamer);
+    const size_t index = streamed.getStreamIndex();
+    streamer.update();
+    streamer.update();
+    EXPECT_FALSE(streamer.isResident(index));
+
+    nyra::sfml::RenderLayer::Budget budget(1024 * 1024);
+    nyra::sfml::RenderLayer layer(nyra::Vector2U(64, 64), budget);
+    layer.add(streamed, transform);
+    renderLayer(layer);
+    renderLayer(layer);
+    EXPECT_EQ(layer.getNumRebuilds(), 1);
+
+    // The placeholder baked into the layer is replaced once loaded
+    streamer.waitForLoads();
+    EXPECT_EQ(renderLayer(layer), renderDirect());
+    EXPECT_EQ(layer.getNumRebuilds(), 2);
+
+    // Drawing from the cache keeps the texture in use
+    for (size_t ii = 0; ii < 3; ++ii)
+    {
+        renderLayer(layer);
+        streamer.update();
+        EXPECT_TRUE(streamer.isResident(index));
+    }
+    EXPECT_EQ(layer.getNumRebuilds(), 2);
+}
+
+//===========================================================================//
+TEST_F(RenderLayerSFMLTest, Budget)
+{
+    // Room for exactly one 64x64 layer
+    nyra::sfml::RenderLayer::Budget budget(64 * 64 * 4);
+    nyra::sfml::RenderLayer first(nyra::Vector2U(64, 64), budget);
+    nyra::sfml::RenderLayer second(nyra::Vector2U(64, 64), budget);
+    first.add(sprite, transform);
+    second.add(sprite, transform);
+
+    renderLayer(first);
+    EXPECT_TRUE(first.isCached());
+    renderLayer(second);
+    EXPECT_TRUE(second.isCached());
+    EXPECT_FALSE(first.isCached());
+    EXPECT_EQ(budget.getNumEvictions(), 1);
+    EXPECT_EQ(budget.getBytesResident(), budget.getMaxBytes());
+
+    // Coming back rebuilds the evicted layer
+    renderLayer(first);
+    EXPECT_TRUE(first.isCached());
+    EXPECT_EQ(first.getNumRebuilds(), 2);
+
+    // A layer that can never fit still renders, just without a cache
+    nyra::sfml::RenderLayer large(nyra::Vector2U(128, 128), budget);
+    large.add(sprite, transform);
+    EXPECT_EQ(renderLayer(large), renderDirect());
+    EXPECT_FALSE(large.isCached());
+    EXPECT_EQ(large.getNumRebuilds(), 0);
+
+    budget.setMaxBytes(0);
+    EXPECT_FALSE(first.isCached());
+    EXPECT_EQ(budget.getBytesResident(), 0);
+}
@@ -22,12 +22,20 @@
  * IN THE SOFTWARE.
  */
 #include <gtest/gtest.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <nyra/sfml/Window.h>
 #include <nyra/sfml/Graphics.h>
+#include <nyra/sfml/OffscreenGraphics.h>
+#include <nyra/sfml/TileMap.h>
 #include <nyra/Constants.h>
 #include <nyra/sfml/Sprite.h>
 #include <nyra/Transform.h>
 #include <nyra/Image.h>
+#include <nyra/AssetResolver.h>
+#include <nyra/Arena.h>
+#include <nyra/EngineBase.h>
 
 namespace
 {
@@ -75,6 +83,58 @@ private:
     nyra::sfml::Graphics mGraphics;
     nyra::sfml::Sprite mSprite;
 };
+
+//===========================================================================//
+bool writeDoubled(const std::string& pathname)
+{
+    sf::Image image;
+    if (!image.loadFromFile(pathname))
+    {
+        return false;
+    }
+    sf::Image doubled;
+    doubled.create(image.getSize().x * 2, image.getSize().y * 2);
+    for (unsigned int y = 0; y < doubled.getSize().y; ++y)
+    {
+        for (unsigned int x = 0; x < doubled.getSize().x; ++x)
+        {
+            doubled.setPixel(x, y, image.getPixel(x / 2, y / 2));
+        }
+    }
+    return doubled.saveToFile(
+            nyra::AssetResolver::getVariantPathname(pathname, 2.0f));
+}
+
+//===========================================================================//
+class EngineWindow
+{
+public:
+    EngineWindow(const std::string& /* title */,
+                 const nyra::Vector2U& size,
+                 const nyra::Vector2I& /* position */,
+                 bool /* fullscreen */) :
+        mSize(size)
+    {
+    }
+
+    bool update()
+    {
+        return false;
+    }
+
+    nyra::Vector2U getSize() const
+    {
+        return mSize;
+    }
+
+    nyra::WindowsHandle getHandle() const
+    {
+        return 0;
+    }
+
+private:
+    const nyra::Vector2U mSize;
+};
 }
 
 //===========================================================================//
@@ -127,4 +187,198 @@ TEST(SpriteSFMLTest, Animations)
     {
         test(transform, "anim_" + std::to_string(ii), ii);
     }
-}
\ No newline at end of file
+}
+//===========================================================================//
+TEST(SpriteSFMLTest, CollisionMasks)
+{
+    nyra::sfml::Sprite sprite(nyra::Constants::APP_PATH +
+                              "../data/unittests/sfml_sprite_animation.png",
+                              nyra::Vector2U(6, 3));
+    for (size_t ii = 0; ii < 18; ++ii)
+    {
+        sprite.setFrame(ii);
+        const nyra::CollisionMask& mask = sprite.getCollisionMask();
+        EXPECT_EQ(mask.getSize(), sprite.getSize());
+
+        // Every frame has something drawn in it, so it should always
+        // collide with itself but never once it is moved off.
+        EXPECT_TRUE(mask.overlaps(mask, nyra::Vector2I(0, 0)));
+        EXPECT_FALSE(mask.overlaps(mask,
+                                   nyra::Vector2I(mask.getSize().x, 0)));
+    }
+}
+
+//===========================================================================//
+TEST(SpriteSFMLTest, SpriteSheet)
+{
+    // The sheet describes the same 6x3 grid, so the frames must match
+    const std::string path(nyra::Constants::APP_PATH + "../data/unittests/");
+    const nyra::sfml::Sprite grid(path + "sfml_sprite_animation.png",
+                                  nyra::Vector2U(6, 3));
+    nyra::sfml::Sprite sheet(
+            nyra::SpriteSheet(path + "sfml_sprite_animation.json"));
+    ASSERT_EQ(sheet.getNumFrames(), grid.getNumFrames());
+    for (size_t ii = 0; ii < grid.getNumFrames(); ++ii)
+    {
+        EXPECT_EQ(sheet.getFrameRect(ii), grid.getFrameRect(ii));
+    }
+
+    sheet.setFrame("frame_7");
+    EXPECT_EQ(sheet.getFrame(), 7);
+    EXPECT_EQ(sheet.getSize(), nyra::Vector2F(64.0f, 64.0f));
+    EXPECT_THROW(sheet.setFrame("frame_18"), std::runtime_error);
+}
+
+//===========================================================================//
+TEST(SpriteSFMLTest, Movable)
+{
+    static_assert(std::is_move_constructible<nyra::sfml::Sprite>::value &&
+                  std::is_move_assignable<nyra::sfml::Sprite>::value,
+                  "Sprites must be movable");
+    static_assert(std::is_move_constructible<nyra::sfml::TileMap>::value &&
+                  std::is_move_assignable<nyra::sfml::TileMap>::value,
+                  "Tile maps must be movable");
+
+    // Growing the vector moves every sprite several times
+    const std::string pathname(nyra::Constants::APP_PATH +
+                               "../data/unittests/sfml-logo-small.png");
+    std::vector<nyra::sfml::Sprite> sprites;
+    for (size_t ii = 0; ii < 20; ++ii)
+    {
+        sprites.push_back(nyra::sfml::Sprite(pathname));
+    }
+    sprites[0] = std::move(sprites[19]);
+
+    nyra::Transform transform;
+    transform.setSize(sprites[0].getSize());
+    transform.setPosition(nyra::Vector2F(200.0f, 200.0f));
+    nyra::sfml::OffscreenGraphics graphics(nyra::Vector2U(400, 400));
+    const nyra::Image truth(nyra::Constants::APP_PATH +
+            "../data/unittests/sfml_sprite_centered_truth.png");
+    for (size_t ii = 0; ii < 2; ++ii)
+    {
+        graphics.clear(0);
+        sprites[ii].render(transform.getMatrix(), graphics);
+        graphics.present();
+        EXPECT_EQ(graphics.getImage(), truth);
+    }
+
+    // Assigning between maps from different resources moves the vertices
+    // one by one, since the allocator does not propagate.
+    const uint16_t tiles[] = {0, 1, 2, 3};
+    const uint16_t blank[] = {0};
+    nyra::Arena arena;
+    nyra::sfml::TileMap map(nyra::Vector2U(1, 1),
+                            nyra::Vector2U(16, 16),
+                            pathname,
+                            blank);
+    std::vector<nyra::sfml::TileMap> maps;
+    maps.push_back(nyra::sfml::TileMap(nyra::Vector2U(2, 2),
+                                       nyra::Vector2U(16, 16),
+                                       pathname,
+                                       tiles,
+                                       arena));
+    transform.setSize(maps[0].getSize());
+    graphics.clear(0);
+    maps[0].render(transform.getMatrix(), graphics);
+    graphics.present();
+    const nyra::Image before = graphics.getImage();
+
+    map = std::move(maps[0]);
+    maps.clear();
+    EXPECT_EQ(map.getSize(), nyra::Vector2U(32, 32));
+    graphics.clear(0);
+    map.render(transform.getMatrix(), graphics);
+    graphics.present();
+    EXPECT_EQ(graphics.getImage(), before);
+}
+
+//===========================================================================//
+TEST(SpriteSFMLTest, Variants)
+{
+    // Write a double resolution copy of the animation next to it
+    const std::string path(nyra::Constants::APP_PATH + "../data/unittests/");
+    const std::string pathname(path + "sfml_sprite_animation.png");
+    ASSERT_TRUE(writeDoubled(pathname));
+
+    // The default resolver still picks the 1x texture for a 720p window
+    const nyra::sfml::Sprite normal(pathname, nyra::Vector2U(6, 3));
+    EXPECT_FLOAT_EQ(normal.getTextureScale(), 1.0f);
+
+    nyra::AssetResolver resolver;
+    resolver.setWindowSize(nyra::Vector2U(2560, 1440));
+    nyra::sfml::Sprite sharp(pathname,
+                             nyra::Vector2U(6, 3),
+                             nyra::sfml::TextureCache::getDefault(),
+                             resolver);
+    EXPECT_FLOAT_EQ(sharp.getTextureScale(), 2.0f);
+    EXPECT_EQ(nyra::Vector2U(sharp.getTexture().getSize()),
+              nyra::Vector2U(normal.getTexture().getSize()) * 2.0);
+
+    const nyra::sfml::Sprite sheet(
+            nyra::SpriteSheet(path + "sfml_sprite_animation.json"),
+            nyra::sfml::TextureCache::getDefault(),
+            resolver);
+    for (size_t ii = 0; ii < normal.getNumFrames(); ++ii)
+    {
+        const sf::IntRect& rect = normal.getFrameRect(ii);
+        EXPECT_EQ(sharp.getFrameRect(ii),
+                  sf::IntRect(rect.left * 2, rect.top * 2,
+                              rect.width * 2, rect.height * 2));
+        EXPECT_EQ(sheet.getFrameRect(ii), sharp.getFrameRect(ii));
+        EXPECT_EQ(sharp.getFrameSize(ii), normal.getFrameSize(ii));
+    }
+
+    // Game code sees the same sizes and masks
+    nyra::sfml::OffscreenGraphics graphics(nyra::Vector2U(128, 128));
+    nyra::Transform transform;
+    transform.setPosition(nyra::Vector2F(64.0f, 64.0f));
+    sharp.setFrame(4);
+    EXPECT_EQ(sharp.getSize(), nyra::Vector2U(64, 64));
+    const nyra::CollisionMask& mask = sharp.getCollisionMask();
+    ASSERT_EQ(mask.getSize(), sharp.getSize());
+
+    nyra::sfml::Sprite reference(pathname, nyra::Vector2U(6, 3));
+    reference.setFrame(4);
+    const nyra::CollisionMask& truthMask = reference.getCollisionMask();
+    for (int64_t y = 0; y < mask.getSize().y; ++y)
+    {
+        for (int64_t x = 0; x < mask.getSize().x; ++x)
+        {
+            EXPECT_EQ(mask.isSolid(x, y), truthMask.isSolid(x, y));
+        }
+    }
+
+    transform.setSize(reference.getSize());
+    graphics.clear(0);
+    reference.render(transform.getMatrix(), graphics);
+    graphics.present();
+    const nyra::Image truth = graphics.getImage();
+
+    transform.setSize(sharp.getSize());
+    graphics.clear(0);
+    sharp.render(transform.getMatrix(), graphics);
+    graphics.present();
+    EXPECT_EQ(graphics.getImage(), truth);
+}
+
+//===========================================================================//
+TEST(SpriteSFMLTest, EngineVariants)
+{
+    const std::string pathname(nyra::Constants::APP_PATH +
+                               "../data/unittests/sfml_sprite_animation.png");
+    ASSERT_TRUE(writeDoubled(pathname));
+
+    // Sprites built with default arguments follow an installed engine
+    const nyra::AssetResolver saved = nyra::AssetResolver::getDefault();
+    nyra::EngineBase<EngineWindow, nyra::sfml::OffscreenGraphics> engine(
+            "Test", nyra::Vector2U(2560, 1440));
+    const nyra::sfml::Sprite before(pathname, nyra::Vector2U(6, 3));
+    EXPECT_FLOAT_EQ(before.getTextureScale(), 1.0f);
+
+    engine.installAssetResolver();
+    const nyra::sfml::Sprite after(pathname, nyra::Vector2U(6, 3));
+    EXPECT_FLOAT_EQ(after.getTextureScale(), 2.0f);
+    EXPECT_EQ(after.getSize(), before.getSize());
+    nyra::AssetResolver::getDefault() = saved;
+}
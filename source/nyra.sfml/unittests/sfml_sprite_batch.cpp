@@ -0,0 +1,148 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <nyra/sfml/Window.h>
+#include <nyra/sfml/Graphics.h>
+#include <nyra/sfml/OffscreenGraphics.h>
+#include <nyra/sfml/Sprite.h>
+#include <nyra/sfml/SpriteBatch.h>
+#include <nyra/Constants.h>
+#include <nyra/Transform.h>
+#include <nyra/Image.h>
+
+//===========================================================================//
+TEST(SpriteBatchSFMLTest, MatchesSprite)
+{
+    nyra::sfml::Window window("Test window",
+                              nyra::Vector2U(400, 400),
+                              nyra::Vector2I(0, 0),
+                              false);
+    nyra::sfml::Graphics graphics;
+    nyra::sfml::Sprite sprite(nyra::Constants::APP_PATH +
+                              "../data/unittests/sfml-logo-small.png");
+    nyra::sfml::SpriteBatch batch;
+    nyra::Transform transform;
+    transform.setSize(sprite.getSize());
+
+    const char* names[] = {"default", "centered"};
+    for (size_t ii = 0; ii < 2; ++ii)
+    {
+        if (ii == 1)
+        {
+            transform.setPosition(nyra::Vector2F(200.0f, 200.0f));
+        }
+
+        window.update();
+        graphics.clear(window.getHandle());
+        batch.add(sprite, transform.getMatrix());
+        EXPECT_EQ(batch.getSpriteCount(), 1);
+        batch.flush(graphics);
+        EXPECT_EQ(batch.getSpriteCount(), 0);
+        EXPECT_EQ(batch.getDrawCalls(), 1);
+        graphics.present();
+
+        const std::string imageName(nyra::Constants::APP_PATH +
+                "../data/unittests/sfml_sprite_" + names[ii]);
+        graphics.screenshot(imageName + "_batch.png");
+        EXPECT_EQ(nyra::Image(imageName + "_batch.png"),
+                  nyra::Image(imageName + "_truth.png"));
+    }
+
+    // Many sprites from the same texture are still one draw call
+    for (size_t ii = 0; ii < 100; ++ii)
+    {
+        batch.add(sprite, transform.getMatrix());
+    }
+    batch.flush(graphics);
+    EXPECT_EQ(batch.getDrawCalls(), 1);
+}
+
+//===========================================================================//
+TEST(SpriteBatchSFMLTest, Append)
+{
+    nyra::sfml::Window window("Test window",
+                              nyra::Vector2U(400, 400),
+                              nyra::Vector2I(0, 0),
+                              false);
+    nyra::sfml::Graphics graphics;
+    nyra::sfml::Sprite sprite(nyra::Constants::APP_PATH +
+                              "../data/unittests/sfml-logo-small.png");
+    nyra::Transform transform;
+    transform.setSize(sprite.getSize());
+    transform.setPosition(nyra::Vector2F(200.0f, 200.0f));
+
+    // Batches recorded separately still merge into one draw per texture
+    nyra::sfml::SpriteBatch first;
+    nyra::sfml::SpriteBatch second;
+    first.add(sprite, transform.getMatrix());
+    second.add(sprite, transform.getMatrix());
+    second.add(sprite, transform.getMatrix());
+
+    nyra::sfml::SpriteBatch merged;
+    merged.append(first);
+    merged.append(second);
+    EXPECT_EQ(merged.getSpriteCount(), 3);
+    EXPECT_EQ(second.getSpriteCount(), 2);
+
+    window.update();
+    graphics.clear(window.getHandle());
+    merged.flush(graphics);
+    EXPECT_EQ(merged.getDrawCalls(), 1);
+
+    second.clear();
+    EXPECT_EQ(second.getSpriteCount(), 0);
+}
+
+//===========================================================================//
+TEST(SpriteBatchSFMLTest, Prune)
+{
+    nyra::sfml::OffscreenGraphics graphics(nyra::Vector2U(64, 64));
+    nyra::sfml::Sprite logo(nyra::Constants::APP_PATH +
+                            "../data/unittests/sfml-logo-small.png");
+    nyra::sfml::Sprite animation(nyra::Constants::APP_PATH +
+            "../data/unittests/sfml_sprite_animation.png",
+            nyra::Vector2U(6, 3));
+    nyra::sfml::SpriteBatch batch;
+    const nyra::Matrix matrix;
+    batch.add(logo, matrix);
+    batch.add(animation, matrix);
+    batch.flush(graphics);
+    EXPECT_EQ(batch.getNumBatches(), 2);
+
+    // A texture that stops being drawn loses its buffer after a while
+    for (size_t ii = 0; ii <= nyra::sfml::SpriteBatch::MAX_IDLE_FLUSHES; ++ii)
+    {
+        EXPECT_EQ(batch.getNumBatches(), 2);
+        batch.add(logo, matrix);
+        batch.flush(graphics);
+    }
+    EXPECT_EQ(batch.getNumBatches(), 1);
+
+    // Both still draw correctly afterwards
+    batch.add(animation, matrix);
+    batch.add(logo, matrix);
+    batch.flush(graphics);
+    EXPECT_EQ(batch.getDrawCalls(), 2);
+    EXPECT_EQ(batch.getNumBatches(), 2);
+}
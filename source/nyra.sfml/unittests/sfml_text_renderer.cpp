@@ -0,0 +1,188 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <nyra/sfml/TextRenderer.h>
+#include <nyra/sfml/GlyphAtlas.h>
+#include <nyra/sfml/SpriteBatch.h>
+#include <nyra/sfml/OffscreenGraphics.h>
+#include <nyra/sfml/Sprite.h>
+#include <nyra/Constants.h>
+#include <nyra/Image.h>
+#include <nyra/Transform.h>
+
+namespace
+{
+//===========================================================================//
+class TextRendererSFMLTest : public ::testing::Test
+{
+protected:
+    TextRendererSFMLTest()
+    {
+        if (!font.loadFromFile(nyra::Constants::APP_PATH +
+                "../data/unittests/DejaVuSansMono.ttf"))
+        {
+            throw std::runtime_error("Unable to load font");
+        }
+    }
+
+    sf::Font font;
+};
+
+//===========================================================================//
+nyra::Matrix translate(float x, float y)
+{
+    nyra::Transform transform;
+    transform.setPivot(0.0f, 0.0f);
+    transform.setPosition(nyra::Vector2F(x, y));
+    return transform.getMatrix();
+}
+}
+
+//===========================================================================//
+TEST(GlyphAtlasSFMLTest, Eviction)
+{
+    // Room for two 8x8 glyphs
+    nyra::sfml::GlyphAtlas atlas(nyra::Vector2U(8, 8),
+                                 nyra::Vector2U(2, 1));
+    EXPECT_EQ(atlas.getCapacity(), 2);
+    sf::Font font;
+    sf::Image pixels;
+    pixels.create(16, 16, sf::Color::White);
+    sf::Texture page;
+    ASSERT_TRUE(page.loadFromImage(pixels));
+    const sf::IntRect rect(0, 0, 6, 7);
+
+    EXPECT_EQ(atlas.find(font, 'a', 10), nyra::sfml::GlyphAtlas::NO_CELL);
+    const size_t a = atlas.insert(font, 'a', 10, page, rect);
+    const size_t b = atlas.insert(font, 'b', 10, page, rect);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(atlas.find(font, 'a', 10), a);
+    EXPECT_EQ(atlas.find(font, 'a', 12), nyra::sfml::GlyphAtlas::NO_CELL);
+    EXPECT_EQ(atlas.getTextureRect(a).width, 6);
+    EXPECT_EQ(atlas.getTextureRect(a).height, 7);
+    EXPECT_EQ(atlas.getNumGlyphs(), 2);
+
+    // Glyphs used this frame cannot be evicted
+    EXPECT_THROW(atlas.insert(font, 'c', 10, page, rect),
+                 std::runtime_error);
+
+    // The least recently used glyph makes room
+    atlas.beginFrame();
+    atlas.find(font, 'a', 10);
+    const uint32_t generation = atlas.getGeneration(b);
+    EXPECT_EQ(atlas.insert(font, 'c', 10, page, rect), b);
+    EXPECT_NE(atlas.getGeneration(b), generation);
+    EXPECT_EQ(atlas.find(font, 'b', 10), nyra::sfml::GlyphAtlas::NO_CELL);
+    EXPECT_EQ(atlas.find(font, 'a', 10), a);
+    EXPECT_EQ(atlas.getNumEvictions(), 1);
+    EXPECT_EQ(atlas.getNumGlyphs(), 2);
+
+    EXPECT_THROW(atlas.insert(font, 'd', 10, page, sf::IntRect(0, 0, 9, 8)),
+                 std::runtime_error);
+}
+
+//===========================================================================//
+TEST_F(TextRendererSFMLTest, MatchesText)
+{
+    const std::string text("Hello, World!\nnyra 1.0");
+    nyra::sfml::OffscreenGraphics graphics(nyra::Vector2U(256, 64));
+    sf::Text reference(text, font, 18);
+    reference.setPosition(10.0f, 5.0f);
+    graphics.clear(0);
+    graphics.getRenderTarget().draw(reference);
+    graphics.present();
+    const nyra::Image expected = graphics.getImage();
+
+    nyra::sfml::GlyphAtlas atlas;
+    nyra::sfml::TextRenderer renderer(atlas);
+    nyra::sfml::SpriteBatch batch;
+    graphics.clear(0);
+    renderer.beginFrame();
+    renderer.add(batch, font, 18, text, translate(10.0f, 5.0f));
+    batch.flush(graphics);
+    graphics.present();
+    EXPECT_EQ(graphics.getImage(), expected);
+}
+
+//===========================================================================//
+TEST_F(TextRendererSFMLTest, Batching)
+{
+    nyra::sfml::OffscreenGraphics graphics(nyra::Vector2U(256, 256));
+    nyra::sfml::Sprite sprite(nyra::Constants::APP_PATH +
+                              "../data/unittests/sfml-logo-small.png");
+    nyra::sfml::GlyphAtlas atlas;
+    nyra::sfml::TextRenderer renderer(atlas);
+    nyra::sfml::SpriteBatch batch;
+
+    for (size_t frame = 0; frame < 2; ++frame)
+    {
+        renderer.beginFrame();
+        graphics.clear(0);
+        batch.add(sprite, translate(0.0f, 0.0f));
+        for (size_t ii = 0; ii < 2000; ++ii)
+        {
+            renderer.add(batch, font, 12,
+                         "Score: " + std::to_string(ii % 10),
+                         translate(ii % 200, ii / 10),
+                         sf::Color(255, 200, 0));
+        }
+
+        // Each label has seven glyphs, the space does not need a quad
+        EXPECT_EQ(batch.getSpriteCount(), 1 + (2000 * 7));
+        batch.flush(graphics);
+        graphics.present();
+
+        // One call for the sprite texture and one for all of the text
+        EXPECT_EQ(batch.getDrawCalls(), 2);
+    }
+
+    // Only the distinct strings were laid out, and only once
+    EXPECT_EQ(renderer.getNumLayouts(), 10);
+    EXPECT_EQ(renderer.getNumRuns(), 10);
+}
+
+//===========================================================================//
+TEST_F(TextRendererSFMLTest, Measure)
+{
+    nyra::sfml::TextRenderer renderer(nyra::sfml::GlyphAtlas::getDefault(),
+                                      2);
+    const nyra::Vector2F single = renderer.measure(font, 16, "ab");
+    EXPECT_GT(single.x, 0.0f);
+    EXPECT_FLOAT_EQ(single.y, font.getLineSpacing(16));
+
+    const nyra::Vector2F multi = renderer.measure(font, 16, "ab\na");
+    EXPECT_FLOAT_EQ(multi.x, single.x);
+    EXPECT_FLOAT_EQ(multi.y, font.getLineSpacing(16) * 2.0f);
+
+    // UTF-8 sequences are a single character
+    const nyra::Vector2F accent = renderer.measure(font, 16, "\xC3\xA9");
+    EXPECT_FLOAT_EQ(accent.x, renderer.measure(font, 16, "e").x);
+
+    // Only the most recent strings are kept
+    EXPECT_EQ(renderer.getNumRuns(), 2);
+    EXPECT_EQ(renderer.getNumLayouts(), 4);
+    renderer.measure(font, 16, "e");
+    EXPECT_EQ(renderer.getNumLayouts(), 4);
+}
@@ -0,0 +1,120 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <nyra/sfml/TextureCache.h>
+#include <nyra/sfml/Sprite.h>
+#include <nyra/Constants.h>
+
+//===========================================================================//
+TEST(TextureCacheSFMLTest, SharesTextures)
+{
+    const std::string pathname(nyra::Constants::APP_PATH +
+                               "../data/unittests/sfml-logo-small.png");
+    nyra::sfml::TextureCache cache;
+    EXPECT_EQ(cache.getNumResident(), 0);
+    EXPECT_EQ(cache.getBytesResident(), 0);
+
+    {
+        nyra::sfml::TextureCache::Handle first = cache.load(pathname);
+        const sf::Vector2u size = first->texture.getSize();
+        EXPECT_EQ(cache.getMisses(), 1);
+        EXPECT_EQ(cache.getHits(), 0);
+        EXPECT_EQ(cache.getNumResident(), 1);
+        EXPECT_EQ(cache.getBytesResident(), size.x * size.y * 4);
+
+        // A different spelling of the same file is still a hit
+        nyra::sfml::TextureCache::Handle second = cache.load(
+                nyra::Constants::APP_PATH +
+                "../data//unittests/../unittests/./sfml-logo-small.png");
+        EXPECT_EQ(first, second);
+        EXPECT_EQ(cache.getMisses(), 1);
+        EXPECT_EQ(cache.getHits(), 1);
+
+        // Sprites share the texture with the handles
+        nyra::sfml::Sprite sprite(pathname, nyra::Vector2U(1, 1), cache);
+        EXPECT_EQ(&sprite.getTexture(), &first->texture);
+        EXPECT_EQ(cache.getHits(), 2);
+        EXPECT_EQ(cache.getNumResident(), 1);
+    }
+
+    // Dropping the last handle evicts the texture
+    EXPECT_EQ(cache.getNumResident(), 0);
+    EXPECT_EQ(cache.getBytesResident(), 0);
+
+    cache.load(pathname);
+    EXPECT_EQ(cache.getMisses(), 2);
+}
+
+//===========================================================================//
+TEST(TextureCacheSFMLTest, OutlivesCache)
+{
+    nyra::sfml::TextureCache::Handle handle;
+    {
+        nyra::sfml::TextureCache cache;
+        handle = cache.load(nyra::Constants::APP_PATH +
+                            "../data/unittests/sfml-logo-small.png");
+    }
+    EXPECT_GT(handle->texture.getSize().x, 0);
+    handle.reset();
+}
+
+//===========================================================================//
+TEST(TextureCacheSFMLTest, MissingFile)
+{
+    nyra::sfml::TextureCache cache;
+    EXPECT_THROW(cache.load("not_a_texture.png"), std::runtime_error);
+    EXPECT_EQ(cache.getNumResident(), 0);
+}
+
+//===========================================================================//
+TEST(TextureCacheSFMLTest, Threads)
+{
+    const std::string pathname(nyra::Constants::APP_PATH +
+                               "../data/unittests/sfml-logo-small.png");
+    nyra::sfml::TextureCache cache;
+    std::vector<nyra::sfml::TextureCache::Handle> handles(8);
+    std::vector<std::thread> threads;
+    for (size_t ii = 0; ii < handles.size(); ++ii)
+    {
+        threads.push_back(std::thread([&cache, &handles, &pathname, ii]()
+        {
+            handles[ii] = cache.load(pathname);
+        }));
+    }
+    for (size_t ii = 0; ii < threads.size(); ++ii)
+    {
+        threads[ii].join();
+    }
+
+    // Only the first load decodes, the others wait for it
+    EXPECT_EQ(cache.getMisses(), 1);
+    EXPECT_EQ(cache.getHits(), handles.size() - 1);
+    EXPECT_EQ(cache.getNumResident(), 1);
+    for (size_t ii = 1; ii < handles.size(); ++ii)
+    {
+        EXPECT_EQ(handles[ii], handles[0]);
+    }
+}
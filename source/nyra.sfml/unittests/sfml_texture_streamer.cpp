@@ -0,0 +1,151 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <nyra/sfml/TextureStreamer.h>
+#include <nyra/sfml/OffscreenGraphics.h>
+#include <nyra/sfml/Sprite.h>
+#include <nyra/sfml/SpriteBatch.h>
+#include <nyra/Constants.h>
+
+namespace
+{
+//===========================================================================//
+size_t getBytes(const nyra::Vector2U& size)
+{
+    return size.x * size.y * 4;
+}
+}
+
+//===========================================================================//
+TEST(TextureStreamerSFMLTest, Eviction)
+{
+    const std::string logoPathname(nyra::Constants::APP_PATH +
+            "../data/unittests/sfml-logo-small.png");
+    const std::string animationPathname(nyra::Constants::APP_PATH +
+            "../data/unittests/sfml_sprite_animation.png");
+    nyra::sfml::TextureStreamer streamer(0);
+    const size_t logo = streamer.add(logoPathname);
+    const size_t animation = streamer.add(animationPathname);
+    EXPECT_EQ(streamer.add(logoPathname), logo);
+    EXPECT_EQ(streamer.getNumTextures(), 2);
+    const size_t logoBytes = getBytes(streamer.getSize(logo));
+    const size_t animationBytes = getBytes(streamer.getSize(animation));
+
+    // Only one texture fits, but both were used this frame
+    streamer.setMaxBytes(std::max(logoBytes, animationBytes));
+    EXPECT_EQ(streamer.getMaxBytes(), std::max(logoBytes, animationBytes));
+    streamer.update();
+    EXPECT_EQ(streamer.getNumResident(), 2);
+    EXPECT_EQ(streamer.getBytesResident(), logoBytes + animationBytes);
+
+    // The one that was not used next frame goes
+    EXPECT_EQ(&streamer.use(logo), &streamer.use(logo));
+    streamer.update();
+    EXPECT_TRUE(streamer.isResident(logo));
+    EXPECT_FALSE(streamer.isResident(animation));
+    EXPECT_EQ(streamer.getBytesResident(), logoBytes);
+    EXPECT_EQ(streamer.getNumEvictions(), 1);
+
+    // The size and mask stay around while evicted
+    EXPECT_GT(streamer.getSize(animation).x, 0);
+    EXPECT_EQ(streamer.getMask(animation).getSize(),
+              streamer.getSize(animation));
+
+    // Using it again draws the placeholder until it is back
+    EXPECT_EQ(&streamer.use(animation), &streamer.getPlaceholder());
+    EXPECT_EQ(&streamer.use(animation), &streamer.getPlaceholder());
+    EXPECT_EQ(streamer.getNumPending(), 1);
+    EXPECT_EQ(streamer.getNumReloads(), 1);
+    EXPECT_EQ(streamer.getNumThrashes(), 1);
+    EXPECT_EQ(streamer.getNumPlaceholderDraws(), 2);
+    streamer.waitForLoads();
+    EXPECT_EQ(streamer.getNumPending(), 0);
+    EXPECT_TRUE(streamer.isResident(animation));
+    EXPECT_FALSE(streamer.isResident(logo));
+    EXPECT_EQ(streamer.getNumEvictions(), 2);
+    EXPECT_NE(&streamer.use(animation), &streamer.getPlaceholder());
+    EXPECT_EQ(streamer.use(animation).getSize().x,
+              streamer.getSize(animation).x);
+}
+
+//===========================================================================//
+TEST(TextureStreamerSFMLTest, Sprite)
+{
+    nyra::sfml::TextureStreamer streamer(0);
+    nyra::sfml::Sprite sprite(nyra::Constants::APP_PATH +
+                              "../data/unittests/sfml_sprite_animation.png",
+                              nyra::Vector2U(6, 3),
+                              streamer);
+    nyra::sfml::OffscreenGraphics graphics(nyra::Vector2U(64, 64));
+    const nyra::Matrix matrix;
+    EXPECT_EQ(sprite.getNumFrames(), 18);
+
+    // Nothing is drawn for a frame so the texture is evicted
+    streamer.update();
+    streamer.update();
+    EXPECT_EQ(streamer.getNumResident(), 0);
+
+    graphics.clear(0);
+    sprite.render(matrix, graphics);
+    graphics.present();
+    EXPECT_EQ(&sprite.getTexture(), &streamer.getPlaceholder());
+
+    // Once reloaded the sprite draws its own texture again
+    streamer.waitForLoads();
+    graphics.clear(0);
+    sprite.render(matrix, graphics);
+    graphics.present();
+    EXPECT_NE(&sprite.getTexture(), &streamer.getPlaceholder());
+    EXPECT_EQ(sprite.getTextureRect().width, sprite.getSize().x);
+}
+
+//===========================================================================//
+TEST(TextureStreamerSFMLTest, Batching)
+{
+    nyra::sfml::TextureStreamer streamer(0);
+    nyra::sfml::Sprite sprite(nyra::Constants::APP_PATH +
+                              "../data/unittests/sfml-logo-small.png",
+                              nyra::Vector2U(1, 1),
+                              streamer);
+    nyra::sfml::OffscreenGraphics graphics(nyra::Vector2U(64, 64));
+    nyra::sfml::SpriteBatch batch;
+    const nyra::Matrix matrix;
+
+    // Drawing through a batch counts as a use, so it is never evicted
+    for (size_t ii = 0; ii < 3; ++ii)
+    {
+        graphics.clear(0);
+        batch.add(sprite, matrix);
+        batch.flush(graphics);
+        graphics.present();
+        streamer.update();
+        EXPECT_TRUE(streamer.isResident(sprite.getStreamIndex()));
+    }
+
+    // Once evicted the batch draws the placeholder rather than nothing
+    streamer.update();
+    EXPECT_FALSE(streamer.isResident(sprite.getStreamIndex()));
+    EXPECT_EQ(&sprite.acquireTexture(), &streamer.getPlaceholder());
+}
@@ -0,0 +1,315 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_SOFT_GRAPHICS_H_
+#define NYRA_SOFT_GRAPHICS_H_
+
+#include <vector>
+#include <nyra/GraphicsInterface.h>
+#include <nyra/Image.h>
+#include <nyra/Matrix.h>
+#include <nyra/ParallelRecorder.h>
+#include <nyra/soft/Texture.h>
+
+namespace nyra
+{
+namespace soft
+{
+/*
+ *  \enum Sampling
+ *  \brief How texels are picked when a textured quad is drawn.
+ *
+ *  NEAREST - The texel under the pixel center. This matches SFML textures
+ *            that are not smoothed.
+ *  BILINEAR - A blend of the four nearest texels.
+ */
+enum class Sampling
+{
+    NEAREST,
+    BILINEAR
+};
+
+/*
+ *  \struct OverdrawStats
+ *  \brief How many times the pixels of a frame were drawn over.
+ *
+ *  mean - The average number of writes per pixel.
+ *  p95 - 95% of pixels were written this many times or fewer.
+ *  max - The most writes to a single pixel.
+ */
+struct OverdrawStats
+{
+    double mean;
+    uint32_t p95;
+    uint32_t max;
+};
+
+/*
+ *  \class Graphics
+ *  \brief Renders on the CPU into an RGBA framebuffer without any GPU or
+ *         display. Draws are recorded and rasterized when the frame is
+ *         presented. The framebuffer is split into tiles that are
+ *         rasterized in parallel, each tile draws its commands in the
+ *         order they were recorded so the result does not depend on the
+ *         number of threads. Blending matches SFML alpha blending.
+ */
+class Graphics : public GraphicsInterface
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Sets up an empty framebuffer.
+     *
+     *  \param numThreads The number of threads to rasterize with,
+     *         including the calling thread. Zero uses one per core.
+     */
+    explicit Graphics(size_t numThreads = 0);
+
+    /*
+     *  \fn clear
+     *  \brief Starts a frame by clearing to opaque black.
+     *
+     *  \param handle The handle of a soft::Window whose size the
+     *         framebuffer should match, or 0 to keep the current size.
+     */
+    void clear(WindowsHandle handle) override;
+
+    /*
+     *  \fn present
+     *  \brief Rasterizes everything drawn since the last present and makes
+     *         it the visible framebuffer.
+     */
+    void present() override;
+
+    /*
+     *  \fn screenshot
+     *  \brief Saves the framebuffer as of the last present.
+     *
+     *  \param pathname The pathname of the location to save to. Only PNG
+     *         is supported.
+     */
+    void screenshot(const std::string& pathname) const override;
+
+    /*
+     *  \fn setScissor
+     *  \brief Limits clears and draws recorded after this to an area.
+     *
+     *  \param area The area in pixels.
+     */
+    void setScissor(const RectI& area) override;
+
+    /*
+     *  \fn resetScissor
+     *  \brief Allows clears and draws to cover the entire framebuffer
+     *         again.
+     */
+    void resetScissor() override;
+
+    /*
+     *  \fn drawQuad
+     *  \brief Records a textured quad. The texture must stay alive until
+     *         the frame is presented.
+     *
+     *  \param texture The texture to sample from.
+     *  \param matrix Transforms the quad from local space to pixels.
+     *  \param source The area of the texture to draw. The quad is the
+     *         same size as this area in local space.
+     *  \param offset Where the top left corner of the quad is in local
+     *         space.
+     */
+    void drawQuad(const Texture& texture,
+                  const Matrix& matrix,
+                  const RectI& source,
+                  const Vector2F& offset = Vector2F(0.0f, 0.0f));
+
+    /*
+     *  \fn setSize
+     *  \brief Resizes the framebuffer. This is only needed when rendering
+     *         without a window. Pending draws are dropped.
+     *
+     *  \param size The size in pixels.
+     */
+    void setSize(const Vector2U& size);
+
+    /*
+     *  \fn getSize
+     *  \brief Gets the size of the framebuffer.
+     *
+     *  \return The size in pixels.
+     */
+    inline const Vector2U& getSize() const
+    {
+        return mSize;
+    }
+
+    /*
+     *  \fn setSampling
+     *  \brief Sets how quads recorded after this sample their texture.
+     *
+     *  \param sampling The sampling mode.
+     */
+    inline void setSampling(Sampling sampling)
+    {
+        mSampling = sampling;
+    }
+
+    /*
+     *  \fn getImage
+     *  \brief Gets the framebuffer as of the last present.
+     *
+     *  \return The framebuffer as an RGBA image.
+     */
+    inline const Image& getImage() const
+    {
+        return mFront;
+    }
+
+    /*
+     *  \fn getNumPixelsDrawn
+     *  \brief Gets how many pixels were written during the last present,
+     *         counting every time a pixel is written.
+     *
+     *  \return The number of pixel writes.
+     */
+    inline size_t getNumPixelsDrawn() const
+    {
+        return mNumPixelsDrawn;
+    }
+
+    /*
+     *  \fn getNumThreads
+     *  \brief Gets the number of threads used to rasterize.
+     *
+     *  \return The number of threads.
+     */
+    inline size_t getNumThreads() const
+    {
+        return mRecorder.getNumLists();
+    }
+
+    /*
+     *  \fn setOverdrawAnalysis
+     *  \brief Turns on counting how many times each pixel is written
+     *         during a present. Every covered pixel of a quad counts, even
+     *         where the texture is transparent, since it is still paid
+     *         for. Clears are not counted.
+     *
+     *  \param enabled True to count writes.
+     */
+    void setOverdrawAnalysis(bool enabled);
+
+    /*
+     *  \fn isOverdrawAnalysis
+     *  \brief Checks if writes to each pixel are being counted.
+     *
+     *  \return True if overdraw is being counted.
+     */
+    inline bool isOverdrawAnalysis() const
+    {
+        return mAnalyzeOverdraw;
+    }
+
+    /*
+     *  \fn getOverdraw
+     *  \brief Gets how many times a pixel was written during the last
+     *         present. Overdraw analysis must be on.
+     *
+     *  \param x The column of the pixel.
+     *  \param y The row of the pixel.
+     *  \return The number of writes.
+     */
+    inline uint32_t getOverdraw(size_t x, size_t y) const
+    {
+        return mOverdraw[(y * mSize.x) + x];
+    }
+
+    /*
+     *  \fn getOverdrawStats
+     *  \brief Gets the summary of the last present. Overdraw analysis
+     *         must be on.
+     *
+     *  \return The overdraw over the whole framebuffer.
+     */
+    inline const OverdrawStats& getOverdrawStats() const
+    {
+        return mOverdrawStats;
+    }
+
+    /*
+     *  \fn getOverdrawHeatmap
+     *  \brief Colors each pixel of the last present by its overdraw, from
+     *         black for none through blue, green and yellow to red.
+     *
+     *  \param saturation The number of writes that is shown as red. Any
+     *         more are red as well.
+     *  \return The heatmap as an RGBA image.
+     */
+    Image getOverdrawHeatmap(uint32_t saturation = 8) const;
+
+    static const int32_t TILE_SIZE = 64;
+
+private:
+    struct Command
+    {
+        const Texture* texture;
+        RectI source;
+        RectI bounds;
+        float inverse[6];
+        Sampling sampling;
+    };
+
+    struct TileStats
+    {
+        void clear()
+        {
+            pixels = 0;
+        }
+
+        size_t pixels;
+    };
+
+    RectI getClip() const;
+    void updateOverdrawStats();
+    void rasterize(const Command& command,
+                   const RectI& tile,
+                   TileStats& stats);
+
+    Vector2U mSize;
+    Vector2U mNumTiles;
+    Image mBack;
+    Image mFront;
+    RectI mScissor;
+    bool mHasScissor;
+    Sampling mSampling;
+    std::vector<Command> mCommands;
+    std::vector<std::vector<uint32_t> > mBins;
+    ParallelRecorder<TileStats> mRecorder;
+    size_t mNumPixelsDrawn;
+    bool mAnalyzeOverdraw;
+    std::vector<uint32_t> mOverdraw;
+    OverdrawStats mOverdrawStats;
+};
+}
+}
+
+#endif
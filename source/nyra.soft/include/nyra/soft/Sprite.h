@@ -0,0 +1,166 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_SOFT_SPRITE_H_
+#define NYRA_SOFT_SPRITE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <nyra/RenderableBase.h>
+#include <nyra/SpriteInterface.h>
+#include <nyra/SpriteSheet.h>
+#include <nyra/soft/Texture.h>
+#include <nyra/soft/Graphics.h>
+
+namespace nyra
+{
+namespace soft
+{
+/*
+ *  \class Sprite
+ *  \brief Represents a single drawable sprite for the software renderer.
+ */
+class Sprite : public RenderableBase<Sprite, Graphics>,
+               public SpriteInterface
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates a sprite object.
+     *
+     *  \param pathname The pathname to the texture on disk.
+     *  \param numFrames The number of frames in the x and y direction.
+     */
+    Sprite(const std::string& pathname,
+           const Vector2U& numFrames = Vector2U(1, 1));
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates a sprite from the frames of a sprite sheet.
+     *
+     *  \param sheet The sheet describing the texture and its frames.
+     */
+    Sprite(const SpriteSheet& sheet);
+
+    using RenderableBase<Sprite, Graphics>::render;
+
+    /*
+     *  \fn render
+     *  \brief Records the sprite with the software graphics.
+     *
+     *  \param matrix The positional information about the object.
+     *  \param graphics The graphics to render to.
+     */
+    inline void render(const Matrix& matrix,
+                       Graphics& graphics)
+    {
+        graphics.drawQuad(*mTexture, matrix, mFrameRects[mFrame]);
+    }
+
+    /*
+     *  \fn getSize
+     *  \brief Gets the overall size of the object when it is at its
+     *         default starting dimensions and rotation.
+     *
+     *  \return The size of the object.
+     */
+    Vector2U getSize() const override;
+
+    /*
+     *  \fn setFrame
+     *  \brief Sets a portion of the sprite as the current frame.
+     *
+     *  \param index The frame number to use for rendering.
+     */
+    void setFrame(size_t index) override;
+
+    /*
+     *  \fn setFrame
+     *  \brief Sets a named frame from the sprite sheet as the current
+     *         frame.
+     *
+     *  \param name The name of the frame.
+     */
+    void setFrame(const std::string& name);
+
+    /*
+     *  \fn getNumFrames
+     *  \brief Gets the number of frames in the sprite sheet.
+     *
+     *  \return The number of frames.
+     */
+    inline size_t getNumFrames() const
+    {
+        return mFrameRects.size();
+    }
+
+    /*
+     *  \fn getFrame
+     *  \brief Gets the frame currently being shown.
+     *
+     *  \return The frame index.
+     */
+    inline size_t getFrame() const
+    {
+        return mFrame;
+    }
+
+    /*
+     *  \fn getFrameRect
+     *  \brief Gets the area of the texture used by any frame.
+     *
+     *  \param index The frame number.
+     *  \return The frame rectangle in pixels.
+     */
+    inline const RectI& getFrameRect(size_t index) const
+    {
+        return mFrameRects[index];
+    }
+
+    /*
+     *  \fn getPivot
+     *  \brief Gets the pivot of the current frame, normalized to the frame
+     *         size. This can be handed to Transform::setPivot.
+     *
+     *  \return The pivot.
+     */
+    inline const Vector2F& getPivot() const
+    {
+        return mFramePivots[mFrame];
+    }
+
+private:
+    void validateFrames() const;
+
+    std::shared_ptr<const Texture> mTexture;
+    std::vector<RectI> mFrameRects;
+    std::vector<Vector2F> mFramePivots;
+    std::unordered_map<std::string, size_t> mFrameNames;
+    size_t mFrame;
+};
+}
+}
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_SOFT_TEXTURE_H_
+#define NYRA_SOFT_TEXTURE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <nyra/Vector2.h>
+
+namespace nyra
+{
+namespace soft
+{
+/*
+ *  \class Texture
+ *  \brief Pixels a sprite or tile map samples from. Every pixel is stored
+ *         as 32 bit RGBA with the bytes in that order in memory, which is
+ *         the same layout as the framebuffer.
+ */
+class Texture
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Loads a texture from disk. RGB images are given an opaque
+     *         alpha channel.
+     *
+     *  \param pathname The pathname to the image on disk.
+     */
+    Texture(const std::string& pathname);
+
+    /*
+     *  \fn load
+     *  \brief Loads a texture that is shared by everything that loads the
+     *         same file while any of them are alive, see ResourceCache.
+     *
+     *  \param pathname The pathname to the image on disk.
+     *  \return The shared texture.
+     */
+    static std::shared_ptr<const Texture> load(const std::string& pathname);
+
+    /*
+     *  \fn getSize
+     *  \brief Gets the size of the texture.
+     *
+     *  \return The size in pixels.
+     */
+    inline const Vector2U& getSize() const
+    {
+        return mSize;
+    }
+
+    /*
+     *  \fn getPixels
+     *  \brief Gets the pixels row by row.
+     *
+     *  \return The first pixel.
+     */
+    inline const uint32_t* getPixels() const
+    {
+        return mPixels.data();
+    }
+
+private:
+    Vector2U mSize;
+    std::vector<uint32_t> mPixels;
+};
+}
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_SOFT_TILE_MAP_H_
+#define NYRA_SOFT_TILE_MAP_H_
+
+#include <memory>
+#include <vector>
+#include <nyra/TileMapInterface.h>
+#include <nyra/RenderableBase.h>
+#include <nyra/Allocator.h>
+#include <nyra/soft/Texture.h>
+#include <nyra/soft/Graphics.h>
+
+namespace nyra
+{
+namespace soft
+{
+/*
+ *  \class TileMap
+ *  \brief A grid of tiles from a single tileset for the software
+ *         renderer. Each cell is recorded as its own quad so cells that
+ *         end up off screen are dropped before rasterizing.
+ */
+class TileMap : public TileMapInterface,
+                public RenderableBase<TileMap, Graphics>
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Looks up the tileset area of every cell.
+     *
+     *  \param numTiles The number of tiles in the x and y direction.
+     *  \param tileSize The size of a single tile in pixels. Neither side
+     *         can be zero.
+     *  \param pathname The pathname to the tileset texture on disk.
+     *  \param tiles The tile index of each cell, stored row by row.
+     *  \param resource Where the cell data is allocated from.
+     */
+    TileMap(const Vector2U& numTiles,
+            const Vector2U& tileSize,
+            const std::string& pathname,
+            const uint16_t* tiles,
+            MemoryResource& resource = MemoryResource::getDefault());
+
+    using RenderableBase<TileMap, Graphics>::render;
+
+    /*
+     *  \fn render
+     *  \brief Records every cell with the software graphics.
+     *
+     *  \param matrix The positional information about the object.
+     *  \param graphics The graphics to render to.
+     */
+    void render(const Matrix& matrix, Graphics& graphics);
+
+    /*
+     *  \fn getSize
+     *  \brief Gets the overall size of the object when it is at its
+     *         default starting dimensions and rotation.
+     *
+     *  \return The size of the object.
+     */
+    Vector2U getSize() const override;
+
+private:
+    typedef std::vector<RectI, Allocator<RectI> > CellBuffer;
+
+    Vector2U mNumTiles;
+    Vector2U mTileSize;
+    CellBuffer mCells;
+    std::shared_ptr<const Texture> mTexture;
+};
+}
+}
+#endif
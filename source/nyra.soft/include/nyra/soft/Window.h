@@ -0,0 +1,162 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_SOFT_WINDOW_H_
+#define NYRA_SOFT_WINDOW_H_
+
+#include <nyra/WindowInterface.h>
+
+namespace nyra
+{
+namespace soft
+{
+/*
+ *  \class Window
+ *  \brief A window that only exists in memory. It gives the software
+ *         graphics a size to render at and stays open until it is closed,
+ *         so it runs on machines without a display.
+ */
+class Window : public WindowInterface
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates an open window.
+     *
+     *  \param title The title of the window.
+     *  \param size The size of the framebuffer in pixels.
+     *  \param position The position of the window. This is only stored.
+     *  \param fullscreen The fullscreen setting. This is only stored.
+     */
+    Window(const std::string& title,
+           const Vector2U& size,
+           const Vector2I& position,
+           bool fullscreen);
+
+    /*
+     *  \fn update
+     *  \brief There are no messages to poll.
+     *
+     *  \return False once the window has been closed.
+     */
+    bool update() override;
+
+    /*
+     *  \fn getTitle
+     *  \brief Returns the title of the window.
+     *
+     *  \return The current title.
+     */
+    std::string getTitle() const override;
+
+    /*
+     *  \fn setTitle
+     *  \brief Sets the window title.
+     *
+     *  \param title The desired title.
+     */
+    void setTitle(const std::string& title) override;
+
+    /*
+     *  \fn getSize
+     *  \brief Returns the window size.
+     *
+     *  \return The current window size.
+     */
+    Vector2U getSize() const override;
+
+    /*
+     *  \fn setSize
+     *  \brief Sets the window size. The graphics picks this up on the next
+     *         clear.
+     *
+     *  \param size The desired window size.
+     */
+    void setSize(const Vector2U& size) override;
+
+    /*
+     *  \fn getPosition
+     *  \brief Gets the stored position of the window.
+     *
+     *  \return The current window position.
+     */
+    Vector2I getPosition() const override;
+
+    /*
+     *  \fn setPosition
+     *  \brief Stores a new window position.
+     *
+     *  \param position The desired window position.
+     */
+    void setPosition(const Vector2I& position) override;
+
+    /*
+     *  \fn isOpen
+     *  \brief Used to determine if the window is opened. A closed window
+     *         should be treated as invalid.
+     *
+     *  \return True if the window is still open.
+     */
+    bool isOpen() const override;
+
+    /*
+     *  \fn getFullscreen
+     *  \brief Gets the stored fullscreen setting.
+     *
+     *  \return True if the window is in fullscreen mode.
+     */
+    bool getFullscreen() const override;
+
+    /*
+     *  \fn setFullscreen
+     *  \brief Stores a new fullscreen setting.
+     *
+     *  \param fullscreen The desired fullscreen setting.
+     */
+    void setFullscreen(bool fullscreen) override;
+
+    /*
+     *  \fn getHandle
+     *  \brief Gets a handle that soft::Graphics uses to find the window.
+     *
+     *  \return A pointer to this window or 0 if the window is closed.
+     */
+    WindowsHandle getHandle() const override;
+
+    /*
+     *  \fn close
+     *  \brief Closes the window so the next update ends the engine loop.
+     */
+    void close();
+
+private:
+    std::string mTitle;
+    Vector2U mSize;
+    Vector2I mPosition;
+    bool mFullscreen;
+    bool mOpen;
+};
+}
+}
+
+#endif
@@ -0,0 +1,643 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/soft/Graphics.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <nyra/soft/Window.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+// Opaque black with the bytes in RGBA order
+const uint32_t CLEAR_COLOR = 0xFF000000;
+
+//===========================================================================//
+inline uint32_t divide255(uint32_t value)
+{
+    // Exact rounded division for anything up to 255 * 255
+    value += 128;
+    return (value + (value >> 8)) >> 8;
+}
+
+//===========================================================================//
+inline uint32_t blend(uint32_t source, uint32_t dest)
+{
+    // Color uses the source alpha, the alpha channel itself uses one
+    // (the same as sf::BlendAlpha).
+    const uint32_t alpha = source >> 24;
+    if (alpha == 255)
+    {
+        return source;
+    }
+    const uint32_t inverse = 255 - alpha;
+    uint32_t ret = 0;
+    for (uint32_t shift = 0; shift < 24; shift += 8)
+    {
+        const uint32_t value = (((source >> shift) & 0xFF) * alpha) +
+                (((dest >> shift) & 0xFF) * inverse);
+        ret |= divide255(value) << shift;
+    }
+    const uint32_t destAlpha = (dest >> 24) * inverse;
+    return ret | (divide255((alpha * 255) + destAlpha) << 24);
+}
+
+#ifdef __SSE2__
+//===========================================================================//
+inline __m128i divide255(__m128i value)
+{
+    value = _mm_add_epi16(value, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+}
+
+//===========================================================================//
+inline __m128i blendHalf(__m128i source, __m128i dest)
+{
+    // Each half holds two pixels as 16 bit channels
+    const __m128i alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    __m128i alpha = _mm_shufflelo_epi16(source, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+    const __m128i factor = _mm_or_si128(
+            _mm_andnot_si128(alphaMask, alpha),
+            _mm_and_si128(alphaMask, _mm_set1_epi16(255)));
+    return divide255(_mm_add_epi16(_mm_mullo_epi16(source, factor),
+                                   _mm_mullo_epi16(dest, inverse)));
+}
+
+//===========================================================================//
+inline void blend4(const uint32_t* source, uint32_t* dest)
+{
+    const __m128i src = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(source));
+    const __m128i alpha = _mm_srli_epi32(src, 24);
+    const int opaque = _mm_movemask_epi8(
+            _mm_cmpeq_epi32(alpha, _mm_set1_epi32(255)));
+    if (opaque == 0xFFFF)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), src);
+        return;
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, _mm_setzero_si128())) ==
+        0xFFFF)
+    {
+        return;
+    }
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i dst = _mm_loadu_si128(reinterpret_cast<__m128i*>(dest));
+    const __m128i low = blendHalf(_mm_unpacklo_epi8(src, zero),
+                                  _mm_unpacklo_epi8(dst, zero));
+    const __m128i high = blendHalf(_mm_unpackhi_epi8(src, zero),
+                                   _mm_unpackhi_epi8(dst, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest),
+                     _mm_packus_epi16(low, high));
+}
+#endif
+
+//===========================================================================//
+inline uint32_t lerp(uint32_t first, uint32_t second, uint32_t weight)
+{
+    // Red and blue then green and alpha are blended two channels at a time
+    const uint32_t inverse = 256 - weight;
+    const uint32_t rb = ((((first & 0x00FF00FF) * inverse) +
+            ((second & 0x00FF00FF) * weight)) >> 8) & 0x00FF00FF;
+    const uint32_t ga = ((((first >> 8) & 0x00FF00FF) * inverse) +
+            (((second >> 8) & 0x00FF00FF) * weight)) & 0xFF00FF00;
+    return rb | ga;
+}
+
+//===========================================================================//
+bool clipSpan(float start, float step, float low, float high,
+              int32_t& begin, int32_t& end)
+{
+    // Narrows [begin, end) to the x values where low <= start + step * x
+    // is less than high.
+    if (std::abs(step) < 1e-12f)
+    {
+        return start >= low && start < high;
+    }
+
+    if (step > 0.0f)
+    {
+        begin = std::max(begin, static_cast<int32_t>(
+                std::ceil((low - start) / step)));
+        end = std::min(end, static_cast<int32_t>(
+                std::ceil((high - start) / step)));
+    }
+    else
+    {
+        begin = std::max(begin, static_cast<int32_t>(
+                std::floor((high - start) / step)) + 1);
+        end = std::min(end, static_cast<int32_t>(
+                std::floor((low - start) / step)) + 1);
+    }
+    return begin < end;
+}
+//===========================================================================//
+class NearestSampler
+{
+public:
+    NearestSampler(const nyra::soft::Texture& texture,
+                   const nyra::RectI& source) :
+        mStride(texture.getSize().x),
+        mFirst(texture.getPixels() + (source.min.y * mStride) +
+               source.min.x),
+        mMaxX(source.getSize().x - 1),
+        mMaxY(source.getSize().y - 1)
+    {
+    }
+
+    inline uint32_t operator()(int32_t u, int32_t v) const
+    {
+        // Pixel centers that land exactly on a texel edge go to the lower
+        // texel like GPUs do. Rounding at the span edges can also land
+        // just outside.
+        const int32_t x = std::min(std::max((u - 1) >> 16, 0), mMaxX);
+        const int32_t y = std::min(std::max((v - 1) >> 16, 0), mMaxY);
+        return mFirst[(y * mStride) + x];
+    }
+
+private:
+    const int32_t mStride;
+    const uint32_t* const mFirst;
+    const int32_t mMaxX;
+    const int32_t mMaxY;
+};
+
+//===========================================================================//
+class BilinearSampler
+{
+public:
+    BilinearSampler(const nyra::soft::Texture& texture,
+                    const nyra::RectI& source) :
+        mStride(texture.getSize().x),
+        mFirst(texture.getPixels() + (source.min.y * mStride) +
+               source.min.x),
+        mMaxX(source.getSize().x - 1),
+        mMaxY(source.getSize().y - 1)
+    {
+    }
+
+    inline uint32_t operator()(int32_t u, int32_t v) const
+    {
+        // Sample between texel centers, clamped to the source area so
+        // neighboring frames in a sheet never bleed in.
+        const int32_t fu = u - HALF;
+        const int32_t fv = v - HALF;
+        const int32_t x0 = fu >> 16;
+        const int32_t y0 = fv >> 16;
+        const uint32_t wx = (fu >> 8) & 0xFF;
+        const uint32_t wy = (fv >> 8) & 0xFF;
+        const int32_t left = std::min(std::max(x0, 0), mMaxX);
+        const int32_t right = std::min(std::max(x0 + 1, 0), mMaxX);
+        const uint32_t* top =
+                mFirst + (std::min(std::max(y0, 0), mMaxY) * mStride);
+        const uint32_t* bottom =
+                mFirst + (std::min(std::max(y0 + 1, 0), mMaxY) * mStride);
+        return lerp(lerp(top[left], top[right], wx),
+                    lerp(bottom[left], bottom[right], wx),
+                    wy);
+    }
+
+private:
+    static const int32_t HALF = 1 << 15;
+
+    const int32_t mStride;
+    const uint32_t* const mFirst;
+    const int32_t mMaxX;
+    const int32_t mMaxY;
+};
+
+//===========================================================================//
+template <typename SamplerT>
+size_t drawSpans(const SamplerT& sampler,
+                 const float* inverse,
+                 const nyra::Vector2I& size,
+                 const nyra::RectI& area,
+                 uint32_t* framebuffer,
+                 uint32_t* overdraw,
+                 int32_t width)
+{
+    // Texture coordinates step along each span in 16.16 fixed point so
+    // the inner loop has no float conversions.
+    const float one = 65536.0f;
+    const int32_t stepU = static_cast<int32_t>(std::floor(
+            (inverse[0] * one) + 0.5f));
+    const int32_t stepV = static_cast<int32_t>(std::floor(
+            (inverse[3] * one) + 0.5f));
+
+    size_t numPixels = 0;
+    for (int32_t y = area.min.y; y < area.max.y; ++y)
+    {
+        // Texture coordinates are linear along the row
+        const float centerY = y + 0.5f;
+        const float rowU = (inverse[0] * 0.5f) +
+                (inverse[1] * centerY) + inverse[2];
+        const float rowV = (inverse[3] * 0.5f) +
+                (inverse[4] * centerY) + inverse[5];
+        int32_t begin = area.min.x;
+        int32_t end = area.max.x;
+        if (!clipSpan(rowU, inverse[0], 0.0f, size.x, begin, end) ||
+            !clipSpan(rowV, inverse[3], 0.0f, size.y, begin, end))
+        {
+            continue;
+        }
+
+        uint32_t* dest = framebuffer + (y * width);
+        numPixels += end - begin;
+        if (overdraw)
+        {
+            uint32_t* counts = overdraw + (y * width);
+            for (int32_t x = begin; x < end; ++x)
+            {
+                ++counts[x];
+            }
+        }
+        int32_t u = static_cast<int32_t>(std::floor(
+                ((rowU + (inverse[0] * begin)) * one) + 0.5f));
+        int32_t v = static_cast<int32_t>(std::floor(
+                ((rowV + (inverse[3] * begin)) * one) + 0.5f));
+
+        // Texels are gathered four at a time then blended together
+        int32_t x = begin;
+#ifdef __SSE2__
+        uint32_t texels[4];
+        for (; x + 4 <= end; x += 4)
+        {
+            for (int32_t ii = 0; ii < 4; ++ii)
+            {
+                texels[ii] = sampler(u, v);
+                u += stepU;
+                v += stepV;
+            }
+            blend4(texels, dest + x);
+        }
+#endif
+        for (; x < end; ++x)
+        {
+            dest[x] = blend(sampler(u, v), dest[x]);
+            u += stepU;
+            v += stepV;
+        }
+    }
+    return numPixels;
+}
+
+//===========================================================================//
+uint32_t heatColor(uint32_t count, uint32_t saturation)
+{
+    // Black, blue, green, yellow then red with the bytes in RGBA order
+    static const uint32_t STOPS[] = {0xFF000000, 0xFFFF0000, 0xFF00FF00,
+                                     0xFF00FFFF, 0xFF0000FF};
+    const uint32_t numSegments = 4;
+    const uint32_t position =
+            (std::min(count, saturation) * numSegments * 256) / saturation;
+    const uint32_t segment = std::min(position >> 8, numSegments - 1);
+    const uint32_t weight = position - (segment * 256);
+    return lerp(STOPS[segment], STOPS[segment + 1], weight);
+}
+}
+
+namespace nyra
+{
+namespace soft
+{
+//===========================================================================//
+Graphics::Graphics(size_t numThreads) :
+    mBack(Vector2U(0, 0), 4),
+    mFront(Vector2U(0, 0), 4),
+    mHasScissor(false),
+    mSampling(Sampling::NEAREST),
+    mRecorder(numThreads),
+    mNumPixelsDrawn(0),
+    mAnalyzeOverdraw(false)
+{
+    mOverdrawStats.mean = 0.0;
+    mOverdrawStats.p95 = 0;
+    mOverdrawStats.max = 0;
+}
+
+//===========================================================================//
+void Graphics::clear(WindowsHandle handle)
+{
+    getStats().beginClear();
+    if (handle != 0)
+    {
+        const Window* window = reinterpret_cast<const Window*>(handle);
+        if (window->getSize() != mSize)
+        {
+            setSize(window->getSize());
+        }
+    }
+
+    Command command;
+    command.texture = nullptr;
+    command.bounds = getClip();
+    mCommands.push_back(command);
+    getStats().endClear();
+}
+
+//===========================================================================//
+void Graphics::present()
+{
+    getStats().beginPresent();
+
+    // Bin every command into the tiles it touches, keeping draw order
+    for (size_t ii = 0; ii < mBins.size(); ++ii)
+    {
+        mBins[ii].clear();
+    }
+    for (size_t ii = 0; ii < mCommands.size(); ++ii)
+    {
+        const RectI& bounds = mCommands[ii].bounds;
+        if (bounds.isEmpty())
+        {
+            continue;
+        }
+        const int32_t tileMaxX = (bounds.max.x - 1) / TILE_SIZE;
+        const int32_t tileMaxY = (bounds.max.y - 1) / TILE_SIZE;
+        for (int32_t y = bounds.min.y / TILE_SIZE; y <= tileMaxY; ++y)
+        {
+            for (int32_t x = bounds.min.x / TILE_SIZE; x <= tileMaxX; ++x)
+            {
+                mBins[(y * mNumTiles.x) + x].push_back(ii);
+            }
+        }
+    }
+
+    if (mAnalyzeOverdraw)
+    {
+        std::fill(mOverdraw.begin(), mOverdraw.end(), 0);
+    }
+
+    mRecorder.record(mBins.size(),
+                     [this](TileStats& stats, size_t begin, size_t end)
+    {
+        for (size_t ii = begin; ii < end; ++ii)
+        {
+            const int32_t x = (ii % mNumTiles.x) * TILE_SIZE;
+            const int32_t y = (ii / mNumTiles.x) * TILE_SIZE;
+            const RectI tile(
+                    Vector2I(x, y),
+                    Vector2I(std::min<int32_t>(x + TILE_SIZE, mSize.x),
+                             std::min<int32_t>(y + TILE_SIZE, mSize.y)));
+            const std::vector<uint32_t>& bin = mBins[ii];
+            for (size_t jj = 0; jj < bin.size(); ++jj)
+            {
+                rasterize(mCommands[bin[jj]], tile, stats);
+            }
+        }
+    });
+
+    mNumPixelsDrawn = 0;
+    for (size_t ii = 0; ii < mRecorder.getNumLists(); ++ii)
+    {
+        mNumPixelsDrawn += mRecorder.getList(ii).pixels;
+    }
+    if (mAnalyzeOverdraw)
+    {
+        updateOverdrawStats();
+    }
+    mCommands.clear();
+    std::swap(mFront, mBack);
+    getStats().endPresent();
+}
+
+//===========================================================================//
+void Graphics::screenshot(const std::string& pathname) const
+{
+    mFront.write(pathname);
+}
+
+//===========================================================================//
+void Graphics::setScissor(const RectI& area)
+{
+    mScissor = area;
+    mHasScissor = true;
+}
+
+//===========================================================================//
+void Graphics::resetScissor()
+{
+    mHasScissor = false;
+}
+
+//===========================================================================//
+void Graphics::drawQuad(const Texture& texture,
+                        const Matrix& matrix,
+                        const RectI& source,
+                        const Vector2F& offset)
+{
+    getStats().addDraw(&texture, 4);
+    const float a = matrix(0, 0);
+    const float b = matrix(0, 1);
+    const float c = matrix(0, 2);
+    const float d = matrix(1, 0);
+    const float e = matrix(1, 1);
+    const float f = matrix(1, 2);
+    const float determinant = (a * e) - (b * d);
+    if (std::abs(determinant) < 1e-12f || source.isEmpty())
+    {
+        return;
+    }
+
+    // Maps pixel centers back to the quad, relative to its top left
+    Command command;
+    command.texture = &texture;
+    command.source = source;
+    command.sampling = mSampling;
+    command.inverse[0] = e / determinant;
+    command.inverse[1] = -b / determinant;
+    command.inverse[2] = (((b * f) - (c * e)) / determinant) - offset.x;
+    command.inverse[3] = -d / determinant;
+    command.inverse[4] = a / determinant;
+    command.inverse[5] = (((c * d) - (a * f)) / determinant) - offset.y;
+
+    // A pixel is covered when its center is inside the quad
+    const Vector2I size = source.getSize();
+    const float xs[] = {offset.x, offset.x + size.x};
+    const float ys[] = {offset.y, offset.y + size.y};
+    RectF bounds;
+    for (size_t ii = 0; ii < 4; ++ii)
+    {
+        const float x = xs[ii % 2];
+        const float y = ys[ii / 2];
+        const Vector2F corner((a * x) + (b * y) + c, (d * x) + (e * y) + f);
+        if (ii == 0)
+        {
+            bounds.min = bounds.max = corner;
+        }
+        else
+        {
+            bounds.min.x = std::min(bounds.min.x, corner.x);
+            bounds.min.y = std::min(bounds.min.y, corner.y);
+            bounds.max.x = std::max(bounds.max.x, corner.x);
+            bounds.max.y = std::max(bounds.max.y, corner.y);
+        }
+    }
+    const RectI pixels(
+            Vector2I(static_cast<int32_t>(std::ceil(bounds.min.x - 0.5f)),
+                     static_cast<int32_t>(std::ceil(bounds.min.y - 0.5f))),
+            Vector2I(static_cast<int32_t>(std::ceil(bounds.max.x - 0.5f)),
+                     static_cast<int32_t>(std::ceil(bounds.max.y - 0.5f))));
+    command.bounds = pixels.getIntersection(getClip());
+    if (!command.bounds.isEmpty())
+    {
+        mCommands.push_back(command);
+    }
+}
+
+//===========================================================================//
+void Graphics::setOverdrawAnalysis(bool enabled)
+{
+    mAnalyzeOverdraw = enabled;
+    if (enabled)
+    {
+        mOverdraw.assign(mSize.product(), 0);
+    }
+    else
+    {
+        std::vector<uint32_t>().swap(mOverdraw);
+    }
+}
+
+//===========================================================================//
+Image Graphics::getOverdrawHeatmap(uint32_t saturation) const
+{
+    if (!mAnalyzeOverdraw)
+    {
+        throw std::runtime_error("Overdraw analysis is not enabled");
+    }
+    if (saturation == 0)
+    {
+        throw std::runtime_error("Heatmap saturation must be positive");
+    }
+
+    Image heatmap(mSize, 4);
+    uint32_t* pixels = reinterpret_cast<uint32_t*>(heatmap.getBuffer());
+    for (size_t ii = 0; ii < mOverdraw.size(); ++ii)
+    {
+        pixels[ii] = heatColor(mOverdraw[ii], saturation);
+    }
+    return heatmap;
+}
+
+//===========================================================================//
+void Graphics::setSize(const Vector2U& size)
+{
+    mSize = size;
+    mNumTiles = Vector2U((size.x + TILE_SIZE - 1) / TILE_SIZE,
+                         (size.y + TILE_SIZE - 1) / TILE_SIZE);
+    mBins.resize(mNumTiles.product());
+    mBack = Image(size, 4);
+    mFront = Image(size, 4);
+    mCommands.clear();
+    if (mAnalyzeOverdraw)
+    {
+        mOverdraw.assign(size.product(), 0);
+    }
+}
+
+//===========================================================================//
+RectI Graphics::getClip() const
+{
+    const RectI screen(Vector2I(0, 0), Vector2I(mSize));
+    return mHasScissor ? mScissor.getIntersection(screen) : screen;
+}
+
+//===========================================================================//
+void Graphics::updateOverdrawStats()
+{
+    // Counts are small, so a histogram gives the percentile in one pass
+    mOverdrawStats.max = 0;
+    uint64_t total = 0;
+    for (size_t ii = 0; ii < mOverdraw.size(); ++ii)
+    {
+        mOverdrawStats.max = std::max(mOverdrawStats.max, mOverdraw[ii]);
+        total += mOverdraw[ii];
+    }
+    std::vector<size_t> histogram(mOverdrawStats.max + 1, 0);
+    for (size_t ii = 0; ii < mOverdraw.size(); ++ii)
+    {
+        ++histogram[mOverdraw[ii]];
+    }
+
+    const size_t numPixels = mOverdraw.size();
+    mOverdrawStats.mean = numPixels ?
+            static_cast<double>(total) / numPixels : 0.0;
+    mOverdrawStats.p95 = 0;
+    const size_t target = ((numPixels * 95) + 99) / 100;
+    size_t covered = histogram[0];
+    while (covered < target)
+    {
+        covered += histogram[++mOverdrawStats.p95];
+    }
+}
+
+//===========================================================================//
+void Graphics::rasterize(const Command& command,
+                         const RectI& tile,
+                         TileStats& stats)
+{
+    const RectI area = command.bounds.getIntersection(tile);
+    if (area.isEmpty())
+    {
+        return;
+    }
+
+    uint32_t* framebuffer = reinterpret_cast<uint32_t*>(mBack.getBuffer());
+    if (!command.texture)
+    {
+        for (int32_t y = area.min.y; y < area.max.y; ++y)
+        {
+            std::fill(framebuffer + (y * mSize.x) + area.min.x,
+                      framebuffer + (y * mSize.x) + area.max.x,
+                      CLEAR_COLOR);
+        }
+        stats.pixels += area.getSize().product();
+        return;
+    }
+
+    const Texture& texture = *command.texture;
+    uint32_t* overdraw = mAnalyzeOverdraw ? mOverdraw.data() : nullptr;
+    if (command.sampling == Sampling::BILINEAR)
+    {
+        stats.pixels += drawSpans(BilinearSampler(texture, command.source),
+                                  command.inverse, command.source.getSize(),
+                                  area, framebuffer, overdraw, mSize.x);
+    }
+    else
+    {
+        stats.pixels += drawSpans(NearestSampler(texture, command.source),
+                                  command.inverse, command.source.getSize(),
+                                  area, framebuffer, overdraw, mSize.x);
+    }
+}
+}
+}
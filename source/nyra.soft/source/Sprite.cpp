@@ -0,0 +1,119 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/soft/Sprite.h>
+#include <stdexcept>
+
+namespace nyra
+{
+namespace soft
+{
+//===========================================================================//
+Sprite::Sprite(const std::string& pathname,
+               const Vector2U& numFrames) :
+    mTexture(Texture::load(pathname)),
+    mFrame(0)
+{
+    // Ensure there is at least one frame in each direction
+    if (numFrames.product() < 1)
+    {
+        throw std::runtime_error("You must have at least one sprite frame");
+    }
+
+    const Vector2U frameSize = mTexture->getSize() / numFrames;
+    for (size_t ii = 0; ii < numFrames.product(); ++ii)
+    {
+        const Vector2I min((ii % numFrames.x) * frameSize.x,
+                           (ii / numFrames.x) * frameSize.y);
+        mFrameRects.push_back(RectI(min,
+                                    Vector2I(min.x + frameSize.x,
+                                             min.y + frameSize.y)));
+        mFramePivots.push_back(Vector2F(0.5f, 0.5f));
+    }
+    validateFrames();
+}
+
+//===========================================================================//
+Sprite::Sprite(const SpriteSheet& sheet) :
+    mTexture(Texture::load(sheet.getTexturePathname())),
+    mFrame(0)
+{
+    if (sheet.getNumFrames() < 1)
+    {
+        throw std::runtime_error("You must have at least one sprite frame");
+    }
+
+    for (size_t ii = 0; ii < sheet.getNumFrames(); ++ii)
+    {
+        const SpriteSheet::Frame& frame = sheet.getFrame(ii);
+        const Vector2I min(frame.position);
+        mFrameRects.push_back(RectI(min,
+                                    Vector2I(min.x + frame.size.x,
+                                             min.y + frame.size.y)));
+        mFramePivots.push_back(frame.pivot);
+        mFrameNames[frame.name] = ii;
+    }
+    validateFrames();
+}
+
+//===========================================================================//
+Vector2U Sprite::getSize() const
+{
+    return Vector2U(mFrameRects[mFrame].getSize());
+}
+
+//===========================================================================//
+void Sprite::setFrame(size_t index)
+{
+    if (index >= mFrameRects.size())
+    {
+        throw std::runtime_error("Frame index out of bounds");
+    }
+    mFrame = index;
+}
+
+//===========================================================================//
+void Sprite::setFrame(const std::string& name)
+{
+    auto iter = mFrameNames.find(name);
+    if (iter == mFrameNames.end())
+    {
+        throw std::runtime_error("Sprite has no frame " + name);
+    }
+    setFrame(iter->second);
+}
+
+//===========================================================================//
+void Sprite::validateFrames() const
+{
+    const RectI texture(Vector2I(0, 0), Vector2I(mTexture->getSize()));
+    for (size_t ii = 0; ii < mFrameRects.size(); ++ii)
+    {
+        if (!texture.contains(mFrameRects[ii]))
+        {
+            throw std::runtime_error("Sprite frame is outside the texture");
+        }
+    }
+}
+}
+}
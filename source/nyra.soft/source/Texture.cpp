@@ -0,0 +1,69 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/soft/Texture.h>
+#include <stdexcept>
+#include <string.h>
+#include <nyra/Image.h>
+#include <nyra/ResourceCache.h>
+
+namespace nyra
+{
+namespace soft
+{
+//===========================================================================//
+Texture::Texture(const std::string& pathname)
+{
+    const Image image(pathname);
+    mSize = image.getSize();
+    mPixels.resize(mSize.product());
+
+    const uint8_t* source = image.getBuffer();
+    uint8_t* dest = reinterpret_cast<uint8_t*>(mPixels.data());
+    switch (image.getPixelSize())
+    {
+    case 4:
+        memcpy(dest, source, mPixels.size() * 4);
+        break;
+    case 3:
+        for (size_t ii = 0; ii < mPixels.size(); ++ii)
+        {
+            dest[ii * 4] = source[ii * 3];
+            dest[(ii * 4) + 1] = source[(ii * 3) + 1];
+            dest[(ii * 4) + 2] = source[(ii * 3) + 2];
+            dest[(ii * 4) + 3] = 255;
+        }
+        break;
+    default:
+        throw std::runtime_error("Unsupported texture format: " + pathname);
+    }
+}
+
+//===========================================================================//
+std::shared_ptr<const Texture> Texture::load(const std::string& pathname)
+{
+    static ResourceCache<Texture> cache;
+    return cache.load(pathname);
+}
+}
+}
@@ -0,0 +1,87 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/soft/TileMap.h>
+#include <stdexcept>
+
+namespace nyra
+{
+namespace soft
+{
+//===========================================================================//
+TileMap::TileMap(const Vector2U& numTiles,
+                 const Vector2U& tileSize,
+                 const std::string& pathname,
+                 const uint16_t* tiles,
+                 MemoryResource& resource) :
+    mNumTiles(numTiles),
+    mTileSize(tileSize),
+    mCells(Allocator<RectI>(resource)),
+    mTexture(Texture::load(pathname))
+{
+    if (mTileSize.x == 0 || mTileSize.y == 0)
+    {
+        throw std::runtime_error("Tile size must not be zero");
+    }
+
+    const Vector2U& textureSize = mTexture->getSize();
+    const size_t tilesPerRow = textureSize.x / mTileSize.x;
+    if (tilesPerRow == 0)
+    {
+        throw std::runtime_error("Tileset is smaller than a tile");
+    }
+
+    mCells.resize(mNumTiles.product());
+    for (size_t ii = 0; ii < mCells.size(); ++ii)
+    {
+        // find its position in the tileset texture
+        const size_t tu = tiles[ii] % tilesPerRow;
+        const size_t tv = tiles[ii] / tilesPerRow;
+        mCells[ii] = RectI(Vector2I(tu * mTileSize.x, tv * mTileSize.y),
+                           Vector2I((tu + 1) * mTileSize.x,
+                                    (tv + 1) * mTileSize.y));
+        if ((tv + 1) * mTileSize.y > textureSize.y)
+        {
+            throw std::runtime_error("Tile index is outside the tileset");
+        }
+    }
+}
+
+//===========================================================================//
+void TileMap::render(const Matrix& matrix, Graphics& graphics)
+{
+    for (size_t ii = 0; ii < mCells.size(); ++ii)
+    {
+        const Vector2F offset((ii % mNumTiles.x) * mTileSize.x,
+                              (ii / mNumTiles.x) * mTileSize.y);
+        graphics.drawQuad(*mTexture, matrix, mCells[ii], offset);
+    }
+}
+
+//===========================================================================//
+Vector2U TileMap::getSize() const
+{
+    return mNumTiles * mTileSize;
+}
+}
+}
@@ -0,0 +1,126 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <nyra/Constants.h>
+#include <nyra/Transform.h>
+#include <nyra/soft/Graphics.h>
+#include <nyra/soft/Sprite.h>
+
+namespace
+{
+typedef std::chrono::high_resolution_clock Clock;
+
+//===========================================================================//
+double milliseconds(const Clock::time_point& start)
+{
+    const std::chrono::duration<double, std::milli> elapsed =
+            Clock::now() - start;
+    return elapsed.count();
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        const nyra::Vector2U size(1920, 1080);
+        const size_t numSprites = 5000;
+        const size_t frames = 10;
+        nyra::soft::Sprite sprite(
+                nyra::Constants::APP_PATH +
+                "../data/unittests/sfml_sprite_animation.png",
+                nyra::Vector2U(6, 3));
+
+        // Rotated and scaled sprites spread over the whole frame
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> x(0.0f, size.x);
+        std::uniform_real_distribution<float> y(0.0f, size.y);
+        std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+        std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+        std::vector<nyra::Matrix> matrices;
+        for (size_t ii = 0; ii < numSprites; ++ii)
+        {
+            nyra::Transform transform;
+            transform.setSize(sprite.getSize());
+            transform.setPosition(x(random), y(random));
+            transform.setRotation(angle(random));
+            const float factor = scale(random);
+            transform.setScale(nyra::Vector2F(factor, factor));
+            matrices.push_back(transform.getMatrix());
+        }
+
+        const size_t cores = std::max<size_t>(
+                std::thread::hardware_concurrency(), 1);
+        const size_t threads[] = {1, cores};
+        const nyra::soft::Sampling samplings[] = {
+                nyra::soft::Sampling::NEAREST,
+                nyra::soft::Sampling::BILINEAR};
+        for (nyra::soft::Sampling sampling : samplings)
+        {
+            for (size_t numThreads : threads)
+            {
+                nyra::soft::Graphics graphics(numThreads);
+                graphics.setSize(size);
+                graphics.setSampling(sampling);
+
+                double time = 0.0;
+                for (size_t frame = 0; frame < frames; ++frame)
+                {
+                    const auto start = Clock::now();
+                    graphics.clear(0);
+                    for (size_t ii = 0; ii < matrices.size(); ++ii)
+                    {
+                        sprite.setFrame(ii % sprite.getNumFrames());
+                        sprite.render(matrices[ii], graphics);
+                    }
+                    graphics.present();
+                    time += milliseconds(start);
+                }
+
+                std::cout << numSprites << " sprites at " << size.x << "x"
+                          << size.y << ", "
+                          << (sampling == nyra::soft::Sampling::NEAREST ?
+                              "nearest" : "bilinear")
+                          << ", " << numThreads << " threads: "
+                          << time / frames << " ms per frame, "
+                          << graphics.getNumPixelsDrawn()
+                          << " pixels written\n";
+            }
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Caught standard exception from " <<
+            ex.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Caught unnamed Unwanted exception" << std::endl;
+    }
+}
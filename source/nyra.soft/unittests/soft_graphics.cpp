@@ -0,0 +1,350 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <string.h>
+#include <utility>
+#include <vector>
+#include <nyra/soft/Window.h>
+#include <nyra/soft/Graphics.h>
+#include <nyra/soft/Sprite.h>
+#include <nyra/soft/TileMap.h>
+#include <nyra/Arena.h>
+#include <nyra/Constants.h>
+#include <nyra/EngineBase.h>
+#include <nyra/Image.h>
+#include <nyra/Transform.h>
+
+namespace
+{
+//===========================================================================//
+// Compares against the SFML goldens. Edges are allowed to differ since
+// GPUs and this rasterizer round pixel centers a little differently.
+void expectClose(const nyra::Image& image, const std::string& truthName)
+{
+    const nyra::Image truth(nyra::Constants::APP_PATH +
+                            "../data/unittests/" + truthName);
+    ASSERT_EQ(image.getSize(), truth.getSize());
+    const size_t numPixels = image.getSize().product();
+    size_t numDifferent = 0;
+    for (size_t ii = 0; ii < numPixels; ++ii)
+    {
+        for (size_t jj = 0; jj < 3; ++jj)
+        {
+            const int32_t diff =
+                    image.getBuffer()[(ii * image.getPixelSize()) + jj] -
+                    truth.getBuffer()[(ii * truth.getPixelSize()) + jj];
+            if (std::abs(diff) > 16)
+            {
+                ++numDifferent;
+                break;
+            }
+        }
+    }
+    EXPECT_LT(numDifferent, numPixels / 100) << truthName;
+}
+
+//===========================================================================//
+class RunTest
+{
+public:
+    RunTest(const std::string& sprite,
+            const nyra::Vector2U& windowSize,
+            const nyra::Vector2U& frames) :
+        mWindow("Test window", windowSize, nyra::Vector2I(0, 0), false),
+        mSprite(nyra::Constants::APP_PATH + "../data/unittests/" + sprite,
+                frames)
+    {
+    }
+
+    nyra::Vector2F getSize()
+    {
+        return mSprite.getSize();
+    }
+
+    void operator()(nyra::Transform& transform,
+                    const std::string& subname,
+                    size_t frame = 0)
+    {
+        mSprite.setFrame(frame);
+        mGraphics.clear(mWindow.getHandle());
+        mSprite.render(transform.getMatrix(), mGraphics);
+        mGraphics.present();
+        expectClose(mGraphics.getImage(),
+                    "sfml_sprite_" + subname + "_truth.png");
+    }
+
+private:
+    nyra::soft::Window mWindow;
+    nyra::soft::Graphics mGraphics;
+    nyra::soft::Sprite mSprite;
+};
+}
+
+//===========================================================================//
+TEST(SoftGraphicsTest, Transforms)
+{
+    RunTest test("sfml-logo-small.png",
+                 nyra::Vector2U(400, 400),
+                 nyra::Vector2U(1, 1));
+    nyra::Transform transform;
+    transform.setSize(test.getSize());
+    test(transform, "default");
+
+    transform.setPosition(nyra::Vector2F(200.0f, 200.0f));
+    test(transform, "centered");
+
+    transform.setRotation(33.33f);
+    test(transform, "rotated");
+    transform.setRotation(0.0f);
+
+    transform.setScale(nyra::Vector2F(1.33f, 1.25f));
+    test(transform, "scaled");
+
+    transform.setScale(nyra::Vector2F(-1.0f, -1.0f));
+    test(transform, "flipped");
+    transform.setScale(nyra::Vector2F(1.0f, 1.0f));
+
+    transform.setPivot(nyra::Vector2F(0.34f, 0.75f));
+    test(transform, "pivot");
+
+    transform.setPosition(nyra::Vector2F(187.89f, 213.56f));
+    transform.setPivot(nyra::Vector2F(0.52f, 0.41f));
+    transform.setScale(nyra::Vector2F(-1.1f, 0.89f));
+    transform.setRotation(-24.654f);
+    test(transform, "complex");
+}
+
+//===========================================================================//
+TEST(SoftGraphicsTest, Animations)
+{
+    RunTest test("sfml_sprite_animation.png",
+                 nyra::Vector2U(64, 64),
+                 nyra::Vector2U(6, 3));
+    nyra::Transform transform;
+    transform.setSize(test.getSize());
+    transform.setPivot(0.0f, 0.0f);
+    for (size_t ii = 0; ii < 18; ++ii)
+    {
+        test(transform, "anim_" + std::to_string(ii), ii);
+    }
+}
+
+//===========================================================================//
+TEST(SoftGraphicsTest, Threads)
+{
+    // Tiles must give the same pixels no matter how many threads run
+    nyra::soft::Sprite sprite(nyra::Constants::APP_PATH +
+                              "../data/unittests/sfml-logo-small.png");
+    nyra::Transform transform;
+    transform.setSize(sprite.getSize());
+    transform.setPosition(nyra::Vector2F(211.3f, 187.6f));
+    transform.setRotation(41.0f);
+    transform.setScale(nyra::Vector2F(1.7f, 1.4f));
+
+    nyra::soft::Graphics single(1);
+    nyra::soft::Graphics multi(4);
+    EXPECT_EQ(multi.getNumThreads(), 4);
+    nyra::soft::Graphics* graphics[] = {&single, &multi};
+    for (size_t ii = 0; ii < 2; ++ii)
+    {
+        graphics[ii]->setSize(nyra::Vector2U(400, 400));
+        graphics[ii]->setSampling(nyra::soft::Sampling::BILINEAR);
+        graphics[ii]->clear(0);
+        sprite.render(transform.getMatrix(), *graphics[ii]);
+        graphics[ii]->present();
+    }
+    EXPECT_EQ(single.getImage(), multi.getImage());
+    EXPECT_EQ(single.getNumPixelsDrawn(), multi.getNumPixelsDrawn());
+    EXPECT_GT(single.getNumPixelsDrawn(), 400 * 400);
+}
+
+//===========================================================================//
+TEST(SoftGraphicsTest, TileMap)
+{
+    // Rebuilding the top left of the sheet from 64x64 tiles gives back
+    // the same pixels.
+    const std::string pathname(nyra::Constants::APP_PATH +
+                               "../data/unittests/sfml_sprite_animation.png");
+    const uint16_t tiles[] = {0, 1, 6, 7};
+    const uint16_t blank[] = {0};
+    nyra::soft::TileMap map(nyra::Vector2U(1, 1),
+                            nyra::Vector2U(64, 64),
+                            pathname,
+                            blank);
+
+    // Maps are stored by value, so they must survive being moved. The
+    // allocator does not propagate, so assigning from a map in an Arena
+    // copies its cells into the default resource.
+    nyra::Arena arena;
+    std::vector<nyra::soft::TileMap> maps;
+    maps.push_back(nyra::soft::TileMap(nyra::Vector2U(2, 2),
+                                       nyra::Vector2U(64, 64),
+                                       pathname,
+                                       tiles,
+                                       arena));
+    map = std::move(maps.back());
+    maps.clear();
+    EXPECT_EQ(map.getSize(), nyra::Vector2U(128, 128));
+    EXPECT_THROW(nyra::soft::TileMap(nyra::Vector2U(1, 1),
+                                     nyra::Vector2U(64, 0),
+                                     pathname,
+                                     blank),
+                 std::runtime_error);
+
+    nyra::soft::Graphics graphics;
+    graphics.setSize(nyra::Vector2U(128, 128));
+    graphics.clear(0);
+    nyra::Transform transform;
+    transform.setSize(map.getSize());
+    transform.setPivot(0.0f, 0.0f);
+    map.render(transform.getMatrix(), graphics);
+    graphics.present();
+
+    const nyra::soft::Texture texture(pathname);
+    const uint32_t* image =
+            reinterpret_cast<const uint32_t*>(graphics.getImage().getBuffer());
+    for (uint32_t y = 0; y < 128; ++y)
+    {
+        for (uint32_t x = 0; x < 128; ++x)
+        {
+            // Every texel is opaque or fully transparent over black
+            const uint32_t texel =
+                    texture.getPixels()[(y * texture.getSize().x) + x];
+            const uint32_t expected = (texel >> 24) == 255 ?
+                    texel : 0xFF000000;
+            ASSERT_EQ(image[(y * 128) + x], expected) << x << ", " << y;
+        }
+    }
+}
+
+//===========================================================================//
+TEST(SoftGraphicsTest, Engine)
+{
+    // The software backend runs the engine without any display
+    nyra::EngineBase<nyra::soft::Window, nyra::soft::Graphics> engine(
+            "Soft", nyra::Vector2U(96, 64));
+    EXPECT_TRUE(engine.renderFrame());
+    EXPECT_EQ(engine.getGraphics().getImage().getSize(),
+              nyra::Vector2U(96, 64));
+    engine.getWindow().close();
+    engine.run();
+
+    // Scissored clears keep the rest of the last frame
+    nyra::soft::Graphics graphics(2);
+    nyra::soft::Sprite sprite(nyra::Constants::APP_PATH +
+                              "../data/unittests/sfml-logo-small.png");
+    nyra::Transform transform;
+    transform.setSize(sprite.getSize());
+    transform.setPivot(0.0f, 0.0f);
+    graphics.setSize(sprite.getSize());
+    for (size_t ii = 0; ii < 2; ++ii)
+    {
+        graphics.clear(0);
+        sprite.render(transform.getMatrix(), graphics);
+        graphics.present();
+    }
+    nyra::Image full(graphics.getImage().getSize(), 4);
+    memcpy(full.getBuffer(),
+           graphics.getImage().getBuffer(),
+           full.getSize().product() * 4);
+
+    graphics.setScissor(nyra::RectI(nyra::Vector2I(10, 10),
+                                    nyra::Vector2I(20, 20)));
+    graphics.clear(0);
+    graphics.resetScissor();
+    graphics.present();
+    EXPECT_EQ(graphics.getNumPixelsDrawn(), 100);
+    const uint32_t* before =
+            reinterpret_cast<const uint32_t*>(full.getBuffer());
+    const uint32_t* after =
+            reinterpret_cast<const uint32_t*>(graphics.getImage().getBuffer());
+    const uint32_t width = full.getSize().x;
+    EXPECT_EQ(after[(15 * width) + 15], 0xFF000000);
+    EXPECT_EQ(after[(5 * width) + 5], before[(5 * width) + 5]);
+    EXPECT_EQ(after[(25 * width) + 25], before[(25 * width) + 25]);
+}
+
+//===========================================================================//
+TEST(SoftGraphicsTest, Overdraw)
+{
+    // Three 64x64 quads stacked so each quarter of the screen is drawn
+    // over 2, 3, 1 and 0 times.
+    const nyra::soft::Texture texture(nyra::Constants::APP_PATH +
+            "../data/unittests/sfml_sprite_animation.png");
+    const nyra::RectI source(nyra::Vector2I(0, 0), nyra::Vector2I(64, 64));
+    const float positions[] = {0.0f, 32.0f, 0.0f};
+
+    nyra::soft::Graphics single(1);
+    nyra::soft::Graphics multi(4);
+    nyra::soft::Graphics* graphics[] = {&single, &multi};
+    for (size_t ii = 0; ii < 2; ++ii)
+    {
+        graphics[ii]->setSize(nyra::Vector2U(128, 64));
+        graphics[ii]->setOverdrawAnalysis(true);
+        EXPECT_TRUE(graphics[ii]->isOverdrawAnalysis());
+        graphics[ii]->clear(0);
+        for (size_t jj = 0; jj < 3; ++jj)
+        {
+            nyra::Transform transform;
+            transform.setSize(nyra::Vector2F(64.0f, 64.0f));
+            transform.setPivot(0.0f, 0.0f);
+            transform.setPosition(nyra::Vector2F(positions[jj], 0.0f));
+            graphics[ii]->drawQuad(texture, transform.getMatrix(), source);
+        }
+        graphics[ii]->present();
+    }
+
+    const uint32_t expected[] = {2, 3, 1, 0};
+    for (uint32_t y = 0; y < 64; y += 7)
+    {
+        for (uint32_t x = 0; x < 128; ++x)
+        {
+            ASSERT_EQ(single.getOverdraw(x, y), expected[x / 32]);
+            ASSERT_EQ(multi.getOverdraw(x, y), expected[x / 32]);
+        }
+    }
+
+    // Clears are drawn but are not overdraw
+    const nyra::soft::OverdrawStats& stats = single.getOverdrawStats();
+    EXPECT_DOUBLE_EQ(stats.mean, 1.5);
+    EXPECT_EQ(stats.p95, 3);
+    EXPECT_EQ(stats.max, 3);
+    EXPECT_EQ(single.getNumPixelsDrawn(), (128 * 64) + (3 * 64 * 64));
+    EXPECT_DOUBLE_EQ(multi.getOverdrawStats().mean, stats.mean);
+    EXPECT_EQ(multi.getOverdrawStats().p95, stats.p95);
+
+    const nyra::Image heatmap = single.getOverdrawHeatmap(4);
+    ASSERT_EQ(heatmap.getSize(), nyra::Vector2U(128, 64));
+    const uint32_t* pixels =
+            reinterpret_cast<const uint32_t*>(heatmap.getBuffer());
+    EXPECT_EQ(pixels[0], 0xFF00FF00);
+    EXPECT_EQ(pixels[32], 0xFF00FFFF);
+    EXPECT_EQ(pixels[64], 0xFFFF0000);
+    EXPECT_EQ(pixels[96], 0xFF000000);
+    EXPECT_EQ(single.getOverdrawHeatmap(3).getBuffer()[32 * 4], 255);
+
+    single.setOverdrawAnalysis(false);
+    EXPECT_THROW(single.getOverdrawHeatmap(), std::runtime_error);
+}
@@ -0,0 +1,131 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_ALLOCATOR_H_
+#define NYRA_ALLOCATOR_H_
+
+#include <cstddef>
+#include <nyra/MemoryResource.h>
+
+namespace nyra
+{
+/*
+ *  \class Allocator
+ *  \brief Adapts a MemoryResource so it can be used by standard containers.
+ *         Copies of an allocator share the same resource.
+ *
+ *  \tparam TypeT The type being allocated.
+ */
+template <typename TypeT>
+class Allocator
+{
+public:
+    typedef TypeT value_type;
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates an allocator that uses a given resource.
+     *
+     *  \param resource The resource to allocate from. This must outlive
+     *         every container that uses the allocator.
+     */
+    Allocator(MemoryResource& resource = MemoryResource::getDefault()) :
+        mResource(&resource)
+    {
+    }
+
+    /*
+     *  \fn Constructor
+     *  \brief Rebinds an allocator of another type.
+     *
+     *  \tparam OtherT The type of the other allocator.
+     *  \param other The allocator to copy the resource from.
+     */
+    template <typename OtherT>
+    Allocator(const Allocator<OtherT>& other) :
+        mResource(&other.getResource())
+    {
+    }
+
+    /*
+     *  \fn allocate
+     *  \brief Allocates storage for a number of objects.
+     *
+     *  \param count The number of objects.
+     *  \return The uninitialized storage.
+     */
+    TypeT* allocate(size_t count)
+    {
+        return static_cast<TypeT*>(mResource->allocate(
+                count * sizeof(TypeT), alignof(TypeT)));
+    }
+
+    /*
+     *  \fn deallocate
+     *  \brief Returns storage to the resource.
+     *
+     *  \param ptr The storage to release.
+     *  \param count The number of objects that were allocated.
+     */
+    void deallocate(TypeT* ptr, size_t count)
+    {
+        mResource->deallocate(ptr, count * sizeof(TypeT), alignof(TypeT));
+    }
+
+    /*
+     *  \fn getResource
+     *  \brief Returns the resource backing this allocator.
+     *
+     *  \return The memory resource.
+     */
+    inline MemoryResource& getResource() const
+    {
+        return *mResource;
+    }
+
+private:
+    MemoryResource* mResource;
+};
+
+/*
+ *  \fn Equality Operator
+ *  \brief Allocators are equal if memory from one can be freed by the other.
+ */
+template <typename LhsT, typename RhsT>
+bool operator==(const Allocator<LhsT>& lhs, const Allocator<RhsT>& rhs)
+{
+    return &lhs.getResource() == &rhs.getResource();
+}
+
+/*
+ *  \fn Inequality Operator
+ *  \brief Allocators are equal if memory from one can be freed by the other.
+ */
+template <typename LhsT, typename RhsT>
+bool operator!=(const Allocator<LhsT>& lhs, const Allocator<RhsT>& rhs)
+{
+    return !(lhs == rhs);
+}
+}
+
+#endif
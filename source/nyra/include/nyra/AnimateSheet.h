@@ -0,0 +1,99 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_ANIMATE_SHEET_H_
+#define NYRA_ANIMATE_SHEET_H_
+
+#include <vector>
+#include <nyra/AnimateInterface.h>
+#include <nyra/SpriteInterface.h>
+#include <nyra/SpriteSheet.h>
+
+namespace nyra
+{
+/*
+ *  \class AnimateSheet
+ *  \brief Plays a named animation from a sprite sheet. Each frame is shown
+ *         for its own duration and the sheet decides how the animation
+ *         repeats.
+ */
+class AnimateSheet : public AnimateInterface
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Sets up the animation. The sheet is only read here so it
+     *         does not need to outlive the animation.
+     *
+     *  \param sheet The sheet that has the animation.
+     *  \param name The name of the animation.
+     */
+    AnimateSheet(const SpriteSheet& sheet, const std::string& name);
+
+    /*
+     *  \fn inject
+     *  \brief Sets the sprite that will play the animations.
+     *
+     *  \param The sprite to animate.
+     */
+    inline void inject(SpriteInterface& sprite)
+    {
+        if (!mSpriteInjection)
+        {
+            mSpriteInjection = &sprite;
+            mSpriteInjection->setFrame(getFrame());
+        }
+    }
+
+    /*
+     *  \fn update
+     *  \brief Updates the animation object.
+     *
+     *  \param deltaTime The time since the last update.
+     *  \return false if the animation is finished and should be removed.
+     */
+    bool update(double deltaTime) override;
+
+    /*
+     *  \fn getFrame
+     *  \brief Gets the sheet index of the frame being shown.
+     *
+     *  \return The frame index.
+     */
+    inline size_t getFrame() const
+    {
+        return mFrames[mCurrent];
+    }
+
+private:
+    std::vector<size_t> mFrames;
+    std::vector<double> mDurations;
+    const AnimateMode mMode;
+    size_t mCurrent;
+    int8_t mDirection;
+    double mElapsedTime;
+    SpriteInterface* mSpriteInjection;
+};
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_ARENA_H_
+#define NYRA_ARENA_H_
+
+#include <vector>
+#include <nyra/MemoryResource.h>
+
+namespace nyra
+{
+/*
+ *  \class Arena
+ *  \brief A bump allocator meant to hold everything that belongs to a
+ *         single level. Allocation just advances a pointer inside large
+ *         blocks and deallocate does nothing. All of the memory is returned
+ *         at once with release, typically when the level unloads.
+ *
+ *  \note Anything allocated from the arena must be destroyed before
+ *        release is called or the arena is destroyed.
+ */
+class Arena : public MemoryResource
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Sets up an empty arena. No memory is reserved until the
+     *         first allocation.
+     *
+     *  \param blockSize The size of each block requested from upstream.
+     *         Allocations larger than this get a block of their own.
+     *  \param upstream Where the blocks come from.
+     */
+    Arena(size_t blockSize = 1024 * 1024,
+          MemoryResource& upstream = MemoryResource::getDefault());
+
+    /*
+     *  \fn Destructor
+     *  \brief Releases all blocks.
+     */
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /*
+     *  \fn allocate
+     *  \brief Allocates from the current block, starting a new block if
+     *         there is not enough room left.
+     *
+     *  \param bytes The number of bytes to allocate.
+     *  \param alignment The required alignment.
+     *  \return The allocated memory.
+     */
+    void* allocate(size_t bytes,
+                   size_t alignment = alignof(std::max_align_t)) override;
+
+    /*
+     *  \fn deallocate
+     *  \brief Does nothing. Memory is only returned by release.
+     */
+    void deallocate(void* ptr,
+                    size_t bytes,
+                    size_t alignment = alignof(std::max_align_t)) override;
+
+    /*
+     *  \fn release
+     *  \brief Returns every block to upstream in one shot.
+     */
+    void release();
+
+    /*
+     *  \fn getBytesAllocated
+     *  \brief Returns the bytes handed out since the last release. This
+     *         does not include padding.
+     *
+     *  \return The allocated bytes.
+     */
+    inline size_t getBytesAllocated() const
+    {
+        return mBytesAllocated;
+    }
+
+    /*
+     *  \fn getBytesReserved
+     *  \brief Returns the total size of all blocks held by the arena.
+     *
+     *  \return The reserved bytes.
+     */
+    inline size_t getBytesReserved() const
+    {
+        return mBytesReserved;
+    }
+
+private:
+    struct Block
+    {
+        uint8_t* memory;
+        size_t size;
+        size_t alignment;
+    };
+
+    const size_t mBlockSize;
+    MemoryResource& mUpstream;
+    std::vector<Block> mBlocks;
+    size_t mOffset;
+    size_t mBytesAllocated;
+    size_t mBytesReserved;
+};
+}
+
+#endif
@@ -0,0 +1,174 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_ASSET_RESOLVER_H_
+#define NYRA_ASSET_RESOLVER_H_
+
+#include <string>
+#include <nyra/Vector2.h>
+
+namespace nyra
+{
+/*
+ *  \class AssetResolver
+ *  \brief Picks which resolution of an asset to load. Art is authored at
+ *         a reference window size and may ship with half and double
+ *         resolution variants next to it, named by inserting @0.5x or @2x
+ *         before the extension (art.png, art@0.5x.png, art@2x.png). The
+ *         plain file is the 1x variant and always has to exist.
+ *
+ *         Loaders still work in logical units, which are pixels of the 1x
+ *         variant, and scale the texture by the variant scale. Only the
+ *         memory and upload cost of the texture change.
+ */
+class AssetResolver
+{
+public:
+    /*
+     *  \enum Quality
+     *  \brief How sharp assets should be for the window size. LOW halves
+     *         the resolution that would be picked and HIGH doubles it,
+     *         which suits views that are zoomed in.
+     */
+    enum class Quality
+    {
+        LOW,
+        MEDIUM,
+        HIGH
+    };
+
+    /*
+     *  \struct Variant
+     *  \brief A resolved asset.
+     */
+    struct Variant
+    {
+        std::string pathname;
+        float scale;
+    };
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates a resolver for a window the size of the reference.
+     *
+     *  \param referenceSize The window size the 1x art was made for.
+     */
+    AssetResolver(const Vector2U& referenceSize = Vector2U(1280, 720));
+
+    /*
+     *  \fn setWindowSize
+     *  \brief Sets the size of the window assets will be drawn to. This
+     *         only affects assets resolved afterwards.
+     *
+     *  \param windowSize The size in pixels.
+     */
+    inline void setWindowSize(const Vector2U& windowSize)
+    {
+        mWindowSize = windowSize;
+    }
+
+    /*
+     *  \fn getWindowSize
+     *  \brief Gets the size of the window assets will be drawn to.
+     *
+     *  \return The size in pixels.
+     */
+    inline const Vector2U& getWindowSize() const
+    {
+        return mWindowSize;
+    }
+
+    /*
+     *  \fn setQuality
+     *  \brief Sets how sharp assets should be. This only affects assets
+     *         resolved afterwards.
+     *
+     *  \param quality The quality setting.
+     */
+    inline void setQuality(Quality quality)
+    {
+        mQuality = quality;
+    }
+
+    /*
+     *  \fn getQuality
+     *  \brief Gets how sharp assets should be.
+     *
+     *  \return The quality setting.
+     */
+    inline Quality getQuality() const
+    {
+        return mQuality;
+    }
+
+    /*
+     *  \fn getDesiredScale
+     *  \brief Gets the texture pixels per logical pixel that would show
+     *         every detail at the window size and quality.
+     *
+     *  \return The desired scale.
+     */
+    float getDesiredScale() const;
+
+    /*
+     *  \fn resolve
+     *  \brief Picks the smallest variant of an asset that is at least the
+     *         desired scale, or the largest one if none are.
+     *
+     *  \param pathname The pathname of the 1x asset.
+     *  \return The pathname to load and its scale.
+     */
+    Variant resolve(const std::string& pathname) const;
+
+    /*
+     *  \fn getVariantPathname
+     *  \brief Gets where the variant of an asset at a scale would be.
+     *
+     *  \param pathname The pathname of the 1x asset.
+     *  \param scale The scale of the variant.
+     *  \return The pathname of the variant.
+     */
+    static std::string getVariantPathname(const std::string& pathname,
+                                          float scale);
+
+    /*
+     *  \fn getDefault
+     *  \brief Returns the resolver used when nothing else is requested.
+     *         Its window starts at the reference size and nothing resizes
+     *         it on its own, so every load resolves to 1x until it is
+     *         wired up. Either pass EngineBase::getAssetResolver to
+     *         each loader, or call EngineBase::installAssetResolver once
+     *         after creating the engine to copy its resolver here.
+     *
+     *  \return The default resolver.
+     */
+    static AssetResolver& getDefault();
+
+private:
+    Vector2U mReferenceSize;
+    Vector2U mWindowSize;
+    Quality mQuality;
+};
+}
+
+#endif
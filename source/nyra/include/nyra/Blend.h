@@ -0,0 +1,106 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_BLEND_H_
+#define NYRA_BLEND_H_
+
+#include <nyra/Vector2.h>
+#include <nyra/ImageView.h>
+
+namespace nyra
+{
+/*
+ *  \enum BlendMode
+ *  \brief Describes how source pixels are combined with the destination:
+ *         REPLACE - Copy the source over the destination.
+ *         SOURCE_OVER - Standard alpha blending.
+ *         ADDITIVE - Add the source to the destination.
+ *         MULTIPLY - Multiply the destination by the source as if the
+ *                    source was first composited over white. Destination
+ *                    alpha is left alone.
+ */
+enum class BlendMode
+{
+    REPLACE,
+    SOURCE_OVER,
+    ADDITIVE,
+    MULTIPLY
+};
+
+/*
+ *  \enum AlphaMode
+ *  \brief Describes how the color channels of the source relate to alpha:
+ *         STRAIGHT - Color is independent of alpha. This matches what is
+ *                    loaded from a png.
+ *         PREMULTIPLIED - Color has already been multiplied by alpha.
+ */
+enum class AlphaMode
+{
+    STRAIGHT,
+    PREMULTIPLIED
+};
+
+/*
+ *  \fn blit
+ *  \brief Composites one RGBA image onto another. The source is clipped
+ *         against the destination so any position is valid. This uses SIMD
+ *         when the target supports it and the results are bit identical to
+ *         blitReference.
+ *
+ *  \param source The pixels to draw.
+ *  \param destination The pixels to draw onto.
+ *  \param position The location of the top left corner of the source in
+ *         the destination. This can be negative.
+ *  \param mode The blend equation to use.
+ *  \param alpha How the source alpha should be interpreted.
+ *  \param opacity An extra opacity applied to the whole source from 0 to 1.
+ */
+void blit(const ConstImageView& source,
+          const ImageView& destination,
+          const Vector2I& position = Vector2I(0, 0),
+          BlendMode mode = BlendMode::SOURCE_OVER,
+          AlphaMode alpha = AlphaMode::STRAIGHT,
+          float opacity = 1.0f);
+
+/*
+ *  \fn blitReference
+ *  \brief A portable per pixel version of blit. This is mostly useful for
+ *         validating and benchmarking the optimized version.
+ *
+ *  \param source The pixels to draw.
+ *  \param destination The pixels to draw onto.
+ *  \param position The location of the top left corner of the source in
+ *         the destination. This can be negative.
+ *  \param mode The blend equation to use.
+ *  \param alpha How the source alpha should be interpreted.
+ *  \param opacity An extra opacity applied to the whole source from 0 to 1.
+ */
+void blitReference(const ConstImageView& source,
+                   const ImageView& destination,
+                   const Vector2I& position = Vector2I(0, 0),
+                   BlendMode mode = BlendMode::SOURCE_OVER,
+                   AlphaMode alpha = AlphaMode::STRAIGHT,
+                   float opacity = 1.0f);
+}
+
+#endif
@@ -0,0 +1,210 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_CAMERA_H_
+#define NYRA_CAMERA_H_
+
+#include <stddef.h>
+#include <nyra/Vector2.h>
+#include <nyra/Matrix.h>
+#include <nyra/Rect.h>
+
+namespace nyra
+{
+/*
+ *  \class Camera
+ *  \brief A view into the world that is applied once per pass instead of
+ *         being baked into the matrix of every object. The camera looks
+ *         at a world position, which ends up at the center of its
+ *         viewport. The units are the following.
+ *         Position - World pixels at the center of the viewport.
+ *         Zoom - Screen pixels per world pixel.
+ *         Rotation - Clockwise degrees, the world turns the other way.
+ *         Viewport - Normalized area of the render target, so split
+ *         screens follow the window size.
+ */
+class Camera
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates a camera that covers the whole render target.
+     *
+     *  \param position The world position at the center of the view.
+     */
+    Camera(const Vector2F& position = Vector2F(0.0f, 0.0f));
+
+    /*
+     *  \fn setPosition
+     *  \brief Sets the world position at the center of the view.
+     *
+     *  \param position The position in world pixels.
+     */
+    inline void setPosition(const Vector2F& position)
+    {
+        mPosition = position;
+        ++mVersion;
+    }
+
+    /*
+     *  \fn getPosition
+     *  \brief Gets the world position at the center of the view.
+     *
+     *  \return The position in world pixels.
+     */
+    inline const Vector2F& getPosition() const
+    {
+        return mPosition;
+    }
+
+    /*
+     *  \fn setZoom
+     *  \brief Sets how large the world appears. Values above 1 zoom in.
+     *
+     *  \param zoom Screen pixels per world pixel. This must be positive.
+     */
+    void setZoom(float zoom);
+
+    /*
+     *  \fn getZoom
+     *  \brief Gets how large the world appears.
+     *
+     *  \return Screen pixels per world pixel.
+     */
+    inline float getZoom() const
+    {
+        return mZoom;
+    }
+
+    /*
+     *  \fn setRotation
+     *  \brief Sets the rotation of the camera.
+     *
+     *  \param rotation The rotation in clockwise degrees.
+     */
+    inline void setRotation(float rotation)
+    {
+        mRotation = rotation;
+        ++mVersion;
+    }
+
+    /*
+     *  \fn getRotation
+     *  \brief Gets the rotation of the camera.
+     *
+     *  \return The rotation in clockwise degrees.
+     */
+    inline float getRotation() const
+    {
+        return mRotation;
+    }
+
+    /*
+     *  \fn setViewport
+     *  \brief Sets the area of the render target the camera draws to.
+     *
+     *  \param viewport The area where (0, 0) is the top left and (1, 1)
+     *         the bottom right of the target.
+     */
+    inline void setViewport(const RectF& viewport)
+    {
+        mViewport = viewport;
+        ++mVersion;
+    }
+
+    /*
+     *  \fn getViewport
+     *  \brief Gets the area of the render target the camera draws to.
+     *
+     *  \return The normalized area.
+     */
+    inline const RectF& getViewport() const
+    {
+        return mViewport;
+    }
+
+    /*
+     *  \fn getViewportPixels
+     *  \brief Gets the viewport in pixels of a render target. This is the
+     *         scissor area of the pass.
+     *
+     *  \param targetSize The size of the render target in pixels.
+     *  \return The area in pixels.
+     */
+    RectI getViewportPixels(const Vector2U& targetSize) const;
+
+    /*
+     *  \fn getMatrix
+     *  \brief Gets the matrix that takes world coordinates to render
+     *         target pixels. This goes in front of each object matrix.
+     *
+     *  \param targetSize The size of the render target in pixels.
+     *  \return The view matrix.
+     */
+    Matrix getMatrix(const Vector2U& targetSize) const;
+
+    /*
+     *  \fn getVisibleArea
+     *  \brief Gets the world area the camera can see, for culling. A
+     *         rotated camera sees a rotated rectangle, so this is the axis
+     *         aligned box around it.
+     *
+     *  \param targetSize The size of the render target in pixels.
+     *  \return The visible area in world coordinates.
+     */
+    RectF getVisibleArea(const Vector2U& targetSize) const;
+
+    /*
+     *  \fn screenToWorld
+     *  \brief Finds the world position under a render target pixel, for
+     *         example under the mouse.
+     *
+     *  \param point The position in render target pixels.
+     *  \param targetSize The size of the render target in pixels.
+     *  \return The position in world pixels.
+     */
+    Vector2F screenToWorld(const Vector2F& point,
+                           const Vector2U& targetSize) const;
+
+    /*
+     *  \fn getVersion
+     *  \brief Returns a number that changes every time the camera is
+     *         modified.
+     *
+     *  \return The current version.
+     */
+    inline size_t getVersion() const
+    {
+        return mVersion;
+    }
+
+private:
+    Vector2F mPosition;
+    float mZoom;
+    float mRotation;
+    RectF mViewport;
+    size_t mVersion;
+};
+}
+
+#endif
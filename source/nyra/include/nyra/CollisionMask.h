@@ -0,0 +1,144 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_COLLISION_MASK_H_
+#define NYRA_COLLISION_MASK_H_
+
+#include <vector>
+#include <nyra/Vector2.h>
+#include <nyra/ImageView.h>
+
+namespace nyra
+{
+/*
+ *  \class CollisionMask
+ *  \brief A one bit per pixel mask used for pixel perfect collision tests.
+ *         Each row is packed into 64 bit words with the left most pixel in
+ *         the lowest bit. Rows always start on a new word so overlap tests
+ *         can compare 64 pixels with a single AND.
+ *
+ *  \note Masks are in unscaled and unrotated image space.
+ */
+class CollisionMask
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates an empty mask.
+     */
+    CollisionMask();
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates a mask from the alpha channel of an RGBA image.
+     *
+     *  \param image The image to build from.
+     *  \param threshold A pixel is solid if its alpha is above this value.
+     */
+    CollisionMask(const ConstImageView& image, uint8_t threshold = 0);
+
+    /*
+     *  \fn Constructor
+     *  \brief Copies a rectangle out of another mask. This allows a sprite
+     *         sheet to be converted once and then split into frames.
+     *
+     *  \param source The mask to copy from.
+     *  \param offset The top left corner of the rectangle.
+     *  \param size The size of the rectangle. Anything outside of the
+     *         source is treated as empty.
+     */
+    CollisionMask(const CollisionMask& source,
+                  const Vector2U& offset,
+                  const Vector2U& size);
+
+    /*
+     *  \fn overlaps
+     *  \brief Checks if any solid pixels of two masks touch.
+     *
+     *  \param other The mask to test against.
+     *  \param offset The position of the top left corner of the other mask
+     *         relative to the top left corner of this one.
+     *  \return True if the masks overlap.
+     */
+    bool overlaps(const CollisionMask& other, const Vector2I& offset) const;
+
+    /*
+     *  \fn resample
+     *  \brief Creates a copy of the mask at another size. A pixel is solid
+     *         if any pixel of the source it covers is solid, so thin
+     *         features survive being shrunk.
+     *
+     *  \param size The size of the new mask.
+     *  \return The resampled mask.
+     */
+    CollisionMask resample(const Vector2U& size) const;
+
+    /*
+     *  \fn isSolid
+     *  \brief Checks a single pixel. Pixels outside of the mask are empty.
+     *
+     *  \param x The column of the pixel.
+     *  \param y The row of the pixel.
+     *  \return True if the pixel is solid.
+     */
+    inline bool isSolid(int64_t x, int64_t y) const
+    {
+        if (x < 0 || y < 0 || x >= mSize.x || y >= mSize.y)
+        {
+            return false;
+        }
+        return (mBits[(y * mWordsPerRow) + (x >> 6)] >> (x & 63)) & 1;
+    }
+
+    /*
+     *  \fn getSize
+     *  \brief Returns the size of the mask.
+     *
+     *  \return The size in pixels.
+     */
+    inline const Vector2U& getSize() const
+    {
+        return mSize;
+    }
+
+    /*
+     *  \fn getWordsPerRow
+     *  \brief Returns the number of 64 bit words used for each row.
+     *
+     *  \return The words in a row.
+     */
+    inline size_t getWordsPerRow() const
+    {
+        return mWordsPerRow;
+    }
+
+private:
+    uint64_t getWord(size_t row, int64_t bit) const;
+
+    Vector2U mSize;
+    size_t mWordsPerRow;
+    std::vector<uint64_t> mBits;
+};
+}
+
+#endif
@@ -0,0 +1,140 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_DYNAMIC_RESOLUTION_H_
+#define NYRA_DYNAMIC_RESOLUTION_H_
+
+#include <stddef.h>
+
+namespace nyra
+{
+/*
+ *  \class DynamicResolution
+ *  \brief Picks a render scale that holds a target frame time. Fill rate
+ *         grows with the number of pixels, which is the square of the
+ *         scale, so a slow frame is corrected in one step. Spare time is
+ *         taken back slowly to avoid oscillating. Scales are kept on a
+ *         grid of STEP so render targets are not recreated every frame.
+ */
+class DynamicResolution
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates a controller that starts at the largest scale.
+     *
+     *  \param targetFrameTime The frame time to hold in milliseconds.
+     *  \param minScale The smallest scale to use.
+     *  \param maxScale The largest scale to use.
+     */
+    DynamicResolution(double targetFrameTime = 1000.0 / 60.0,
+                      float minScale = 0.5f,
+                      float maxScale = 1.0f);
+
+    /*
+     *  \fn update
+     *  \brief Adds the time of the last frame and adjusts the scale.
+     *
+     *  \param frameTime The time the last frame took in milliseconds.
+     *  \return The scale to render the next frame at.
+     */
+    float update(double frameTime);
+
+    /*
+     *  \fn getScale
+     *  \brief Gets the current scale.
+     *
+     *  \return The scale of each axis.
+     */
+    inline float getScale() const
+    {
+        return mScale;
+    }
+
+    /*
+     *  \fn getMaxScale
+     *  \brief Gets the largest scale the controller picks.
+     *
+     *  \return The scale of each axis.
+     */
+    inline float getMaxScale() const
+    {
+        return mMaxScale;
+    }
+
+    /*
+     *  \fn setScale
+     *  \brief Forces a scale, for example after loading a level.
+     *
+     *  \param scale The scale. This is clamped to the allowed range.
+     */
+    void setScale(float scale);
+
+    /*
+     *  \fn getTargetFrameTime
+     *  \brief Gets the frame time being held.
+     *
+     *  \return The time in milliseconds.
+     */
+    inline double getTargetFrameTime() const
+    {
+        return mTargetFrameTime;
+    }
+
+    /*
+     *  \fn setTargetFrameTime
+     *  \brief Sets the frame time to hold.
+     *
+     *  \param targetFrameTime The time in milliseconds.
+     */
+    inline void setTargetFrameTime(double targetFrameTime)
+    {
+        mTargetFrameTime = targetFrameTime;
+    }
+
+    /*
+     *  \fn getAverageFrameTime
+     *  \brief Gets the smoothed frame time at the current scale.
+     *
+     *  \return The time in milliseconds.
+     */
+    inline double getAverageFrameTime() const
+    {
+        return mAverage;
+    }
+
+    static const float STEP;
+
+private:
+    float clamp(float scale) const;
+
+    double mTargetFrameTime;
+    float mMinScale;
+    float mMaxScale;
+    float mScale;
+    double mAverage;
+    size_t mNumSamples;
+};
+}
+
+#endif
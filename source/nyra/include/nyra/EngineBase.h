@@ -25,7 +25,17 @@
 #define NYRA_ENGINE_BASE_H_
 
 #include <string>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
 #include <nyra/Vector2.h>
+#include <nyra/Matrix.h>
+#include <nyra/Rect.h>
+#include <nyra/Scene.h>
+#include <nyra/RenderQueue.h>
+#include <nyra/Camera.h>
+#include <nyra/AssetResolver.h>
 
 namespace nyra
 {
@@ -55,6 +65,10 @@ public:
      *         corner in pixels.
      *  \param windowFullscreen Should the window be displayed in
      *         fullscreen mode?
+     *
+     *  \note The engine has its own AssetResolver sized to the window,
+     *        see getAssetResolver. The default resolver is not changed
+     *        until installAssetResolver is called.
      */
     EngineBase(const std::string& windowTitle = "Nyra Engine",
                const Vector2U& windowSize = Vector2U(1280, 720),
@@ -63,26 +77,390 @@ public:
         mWindow(windowTitle,
                 windowSize,
                 windowPosition,
-                windowFullscreen)
+                windowFullscreen),
+        mScene(nullptr),
+        mPartialRedraw(false),
+        mForceRedraw(true),
+        mIdleTime(1.0 / 60.0),
+        mNumFrames(0),
+        mNumSkippedFrames(0),
+        mNumSkippedPixels(0)
     {
+        mAssetResolver.setWindowSize(mWindow.getSize());
     }
 
     /*
      *  \fn run
      *  \brief Starts the engine. Note that this is a blocking function.
+     *         Frames without any damage are not presented, the engine
+     *         sleeps for the idle time instead.
      */
     void run()
     {
         while (mWindow.update())
+        {
+            if (!renderFrame())
+            {
+                std::this_thread::sleep_for(
+                        std::chrono::duration<double>(mIdleTime));
+            }
+        }
+    }
+
+    /*
+     *  \fn renderFrame
+     *  \brief Renders and presents a single frame. Without a scene every
+     *         frame is cleared and presented. With a scene the frame is
+     *         skipped when the scene has no damage on screen, and with
+     *         partial redraw only the damaged area is redrawn.
+     *
+     *  \return True if a frame was presented.
+     */
+    bool renderFrame()
+    {
+        const Vector2U size = mWindow.getSize();
+        const uint64_t screenPixels = static_cast<uint64_t>(size.x) * size.y;
+        if (!mScene)
         {
             mGraphics.clear(mWindow.getHandle());
             mGraphics.present();
+            ++mNumFrames;
+            return true;
+        }
+
+        if (size != mLastSize)
+        {
+            mLastSize = size;
+            mForceRedraw = true;
+        }
+
+        if (!mCameras.empty())
+        {
+            return renderCameras(size);
+        }
+
+        const RectF screen(Vector2F(0.0f, 0.0f), Vector2F(size));
+        mScene->update();
+        RectF damage = mForceRedraw ?
+                screen : mScene->getDamage().getIntersection(screen);
+        mScene->clearDamage();
+        if (damage.isEmpty())
+        {
+            ++mNumSkippedFrames;
+            mNumSkippedPixels += screenPixels;
+            return false;
         }
+
+        // The back buffer still holds the frame before the last one that
+        // was presented, so whatever changed in that frame is redrawn too.
+        RectF region = damage;
+        region.merge(mLastDamage);
+        mLastDamage = damage;
+        mForceRedraw = false;
+
+        const RectI pixels(
+                Vector2I(static_cast<int32_t>(std::floor(region.min.x)),
+                         static_cast<int32_t>(std::floor(region.min.y))),
+                Vector2I(static_cast<int32_t>(std::ceil(region.max.x)),
+                         static_cast<int32_t>(std::ceil(region.max.y))));
+        const uint64_t pixelsDrawn =
+                static_cast<uint64_t>(pixels.getSize().x) *
+                pixels.getSize().y;
+        const bool partial = mPartialRedraw && pixelsDrawn < screenPixels;
+
+        if (partial)
+        {
+            mGraphics.setScissor(pixels);
+        }
+        mGraphics.clear(mWindow.getHandle());
+        mScene->render(partial ? RectF(Vector2F(pixels.min),
+                                       Vector2F(pixels.max)) : screen,
+                       mGraphics);
+        if (partial)
+        {
+            mGraphics.resetScissor();
+            mNumSkippedPixels += screenPixels - pixelsDrawn;
+        }
+        mGraphics.present();
+        ++mNumFrames;
+        return true;
+    }
+
+    /*
+     *  \fn setScene
+     *  \brief Sets the scene that is rendered each frame. The scene is not
+     *         owned by the engine.
+     *
+     *  \param scene The scene to render or nullptr to clear and present
+     *         every frame without rendering anything.
+     */
+    inline void setScene(Scene* scene)
+    {
+        mScene = scene;
+        mForceRedraw = true;
+    }
+
+    /*
+     *  \fn addCamera
+     *  \brief Adds a view of the scene. Without cameras the scene is drawn
+     *         in window coordinates. With cameras every view is drawn each
+     *         frame anything they can see changes, sharing one cull of the
+     *         scene and one RenderQueue sorted by the keys the objects were
+     *         added with. Partial redraw is not used with cameras.
+     *
+     *  \param camera The camera to copy in.
+     *  \return The index to get the camera back with.
+     */
+    inline size_t addCamera(const Camera& camera)
+    {
+        mCameras.push_back(camera);
+        mCameraVersions.push_back(camera.getVersion());
+        mForceRedraw = true;
+        return mCameras.size() - 1;
+    }
+
+    /*
+     *  \fn getCamera
+     *  \brief Gets a camera so it can be moved. Changes are picked up on
+     *         the next frame.
+     *
+     *  \param index The index from addCamera.
+     *  \return The camera.
+     */
+    inline Camera& getCamera(size_t index)
+    {
+        return mCameras[index];
+    }
+
+    /*
+     *  \fn getNumCameras
+     *  \brief Gets the number of cameras.
+     *
+     *  \return The number of cameras.
+     */
+    inline size_t getNumCameras() const
+    {
+        return mCameras.size();
+    }
+
+    /*
+     *  \fn getAssetResolver
+     *  \brief Gets the resolver that picks asset variants for the engine
+     *         window. Pass it to loaders to get art that suits the window,
+     *         or call installAssetResolver to opt every loader in.
+     *
+     *  \return The asset resolver.
+     */
+    inline AssetResolver& getAssetResolver()
+    {
+        return mAssetResolver;
+    }
+
+    /*
+     *  \fn installAssetResolver
+     *  \brief Copies the engine resolver over AssetResolver::getDefault,
+     *         so sprites and tile maps built with default arguments pick
+     *         variants for the engine window. Call it once after creating
+     *         the engine, and again after changing the engine resolver.
+     */
+    void installAssetResolver()
+    {
+        AssetResolver::getDefault() = mAssetResolver;
+    }
+
+    /*
+     *  \fn getRenderQueue
+     *  \brief Gets the queue camera views are drawn through, for its
+     *         statistics.
+     *
+     *  \return The render queue.
+     */
+    inline const RenderQueue& getRenderQueue() const
+    {
+        return mQueue;
+    }
+
+    /*
+     *  \fn clearCameras
+     *  \brief Removes every camera so the scene is drawn in window
+     *         coordinates again.
+     */
+    inline void clearCameras()
+    {
+        mCameras.clear();
+        mCameraVersions.clear();
+        mForceRedraw = true;
+    }
+
+    /*
+     *  \fn setPartialRedraw
+     *  \brief Sets if only the damaged area of the window is redrawn. This
+     *         requires a graphics type that supports scissoring.
+     *
+     *  \param partial True to only redraw the damaged area.
+     */
+    inline void setPartialRedraw(bool partial)
+    {
+        mPartialRedraw = partial;
+        mForceRedraw = true;
+    }
+
+    /*
+     *  \fn setIdleTime
+     *  \brief Sets how long run sleeps after a skipped frame. Without it
+     *         an idle engine would spin since nothing waits on vsync.
+     *
+     *  \param seconds The time to sleep.
+     */
+    inline void setIdleTime(double seconds)
+    {
+        mIdleTime = seconds;
+    }
+
+    /*
+     *  \fn invalidate
+     *  \brief Forces the next frame to redraw the entire window.
+     */
+    inline void invalidate()
+    {
+        mForceRedraw = true;
+    }
+
+    /*
+     *  \fn getNumFrames
+     *  \brief Gets the number of frames that have been presented.
+     *
+     *  \return The number of frames.
+     */
+    inline size_t getNumFrames() const
+    {
+        return mNumFrames;
+    }
+
+    /*
+     *  \fn getNumSkippedFrames
+     *  \brief Gets the number of frames that were skipped because nothing
+     *         on screen changed.
+     *
+     *  \return The number of skipped frames.
+     */
+    inline size_t getNumSkippedFrames() const
+    {
+        return mNumSkippedFrames;
+    }
+
+    /*
+     *  \fn getNumSkippedPixels
+     *  \brief Gets the number of pixels that were not redrawn, either
+     *         because the frame was skipped or because they were outside
+     *         of the damaged area.
+     *
+     *  \return The number of skipped pixels.
+     */
+    inline uint64_t getNumSkippedPixels() const
+    {
+        return mNumSkippedPixels;
+    }
+
+    /*
+     *  \fn render
+     *  \brief Renders an object with the engine graphics. Because the
+     *         graphics type is known here, renderables that provide a
+     *         render overload for GraphicsT (see RenderableBase) are bound
+     *         at compile time and no casting or virtual dispatch happens.
+     *
+     *  \tparam RenderableT The type of object to render.
+     *  \param renderable The object to render.
+     *  \param matrix The positional information about the object.
+     */
+    template <typename RenderableT>
+    inline void render(RenderableT& renderable, const Matrix& matrix)
+    {
+        renderable.render(matrix, mGraphics);
+    }
+
+    /*
+     *  \fn getWindow
+     *  \brief Gets the engine window.
+     *
+     *  \return The window.
+     */
+    inline WindowT& getWindow()
+    {
+        return mWindow;
+    }
+
+    /*
+     *  \fn getGraphics
+     *  \brief Gets the engine graphics.
+     *
+     *  \return The graphics.
+     */
+    inline GraphicsT& getGraphics()
+    {
+        return mGraphics;
     }
 
 private:
+    bool renderCameras(const Vector2U& size)
+    {
+        // Any camera that moved or damage that a camera can see means
+        // every view is drawn again.
+        mScene->update();
+        bool changed = mForceRedraw;
+        for (size_t ii = 0; ii < mCameras.size(); ++ii)
+        {
+            if (mCameras[ii].getVersion() != mCameraVersions[ii])
+            {
+                mCameraVersions[ii] = mCameras[ii].getVersion();
+                changed = true;
+            }
+            else if (mScene->getDamage().intersects(
+                    mCameras[ii].getVisibleArea(size)))
+            {
+                changed = true;
+            }
+        }
+        mScene->clearDamage();
+
+        if (!changed)
+        {
+            ++mNumSkippedFrames;
+            mNumSkippedPixels += static_cast<uint64_t>(size.x) * size.y;
+            return false;
+        }
+
+        mForceRedraw = false;
+        mGraphics.clear(mWindow.getHandle());
+        const std::vector<size_t>& visible = mScene->cull(mCameras, size);
+        for (size_t ii = 0; ii < visible.size(); ++ii)
+        {
+            const size_t id = visible[ii];
+            mQueue.push(mScene->getRenderable(id),
+                        mScene->getTransform(id).getMatrix(),
+                        mScene->getKey(id));
+        }
+        mQueue.flush(mGraphics, mCameras, size);
+        mGraphics.present();
+        ++mNumFrames;
+        return true;
+    }
+
     WindowT mWindow;
     GraphicsT mGraphics;
+    AssetResolver mAssetResolver;
+    Scene* mScene;
+    std::vector<Camera> mCameras;
+    std::vector<size_t> mCameraVersions;
+    RenderQueue mQueue;
+    bool mPartialRedraw;
+    bool mForceRedraw;
+    double mIdleTime;
+    Vector2U mLastSize;
+    RectF mLastDamage;
+    size_t mNumFrames;
+    size_t mNumSkippedFrames;
+    uint64_t mNumSkippedPixels;
 };
 }
 
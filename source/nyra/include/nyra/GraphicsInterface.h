@@ -26,6 +26,8 @@
 
 #include <string>
 #include <nyra/Types.h>
+#include <nyra/Rect.h>
+#include <nyra/RenderStats.h>
 
 namespace nyra
 {
@@ -38,6 +40,30 @@ namespace nyra
 class GraphicsInterface
 {
 public:
+    /*
+     *  \fn Constructor
+     *  \brief Sets up empty statistics.
+     */
+    GraphicsInterface();
+
+    /*
+     *  \fn Copy Constructor
+     *  \brief Copies the statistics. The backend lookup is not copied
+     *         since it points at the original.
+     *
+     *  \param other The graphics to copy.
+     */
+    GraphicsInterface(const GraphicsInterface& other);
+
+    /*
+     *  \fn Assignment Operator
+     *  \brief Copies the statistics and keeps the backend lookup.
+     *
+     *  \param other The graphics to copy.
+     *  \return This object.
+     */
+    GraphicsInterface& operator=(const GraphicsInterface& other);
+
     /*
      *  \fn Destructor
      *  \brief Here for proper inheritance.
@@ -70,8 +96,80 @@ public:
      */
     virtual void screenshot(const std::string& pathname) const = 0;
 
+    /*
+     *  \fn setScissor
+     *  \brief Limits clears and draws to an area of the window until
+     *         resetScissor is called. This lets unchanged parts of a frame
+     *         be kept. Backends that cannot limit rendering ignore it and
+     *         draw everything, which still gives a correct frame.
+     *
+     *  \param area The area in pixels.
+     */
+    virtual void setScissor(const RectI& area);
+
+    /*
+     *  \fn resetScissor
+     *  \brief Allows clears and draws to cover the entire window again.
+     */
+    virtual void resetScissor();
+
+    /*
+     *  \fn getStats
+     *  \brief Gets the per frame statistics. Backends record into these
+     *         as they render, and finish a frame when it is presented.
+     *
+     *  \return The statistics.
+     */
+    inline RenderStats& getStats()
+    {
+        return mStats;
+    }
+
+    /*
+     *  \fn getStats
+     *  \brief Gets the per frame statistics.
+     *
+     *  \return The statistics.
+     */
+    inline const RenderStats& getStats() const
+    {
+        return mStats;
+    }
+
+    /*
+     *  \fn getBackend
+     *  \brief Gets this object as the graphics type of a backend. The
+     *         last lookup is kept, so renderables drawn through the
+     *         interface every frame only cast when the type they ask for
+     *         changes.
+     *
+     *  \tparam GraphicsT The graphics type of the backend.
+     *  \return This object, or nullptr if it is not a GraphicsT.
+     */
+    template <typename GraphicsT>
+    inline GraphicsT* getBackend()
+    {
+        const void* key = getBackendKey<GraphicsT>();
+        if (key != mBackendKey)
+        {
+            mBackend = dynamic_cast<GraphicsT*>(this);
+            mBackendKey = key;
+        }
+        return static_cast<GraphicsT*>(mBackend);
+    }
+
 private:
+    template <typename GraphicsT>
+    static const void* getBackendKey()
+    {
+        // Every instantiation has its own address
+        static const char key = 0;
+        return &key;
+    }
 
+    RenderStats mStats;
+    const void* mBackendKey;
+    void* mBackend;
 };
 }
 
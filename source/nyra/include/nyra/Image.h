@@ -27,6 +27,7 @@
 #include <string>
 #include <memory>
 #include <nyra/Vector2.h>
+#include <nyra/MemoryResource.h>
 
 namespace nyra
 {
@@ -48,8 +49,23 @@ public:
      *  \brief Creates an image from disk.
      *
      *  \param pathname The image on disk.
+     *  \param resource Where the pixel data is allocated from.
      */
-    Image(const std::string& pathname);
+    Image(const std::string& pathname,
+          MemoryResource& resource = MemoryResource::getDefault());
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates a blank image. All pixels start as zero, which is
+     *         transparent black for RGBA images.
+     *
+     *  \param size The size of the image in pixels.
+     *  \param pixelSize The number of bytes per pixel.
+     *  \param resource Where the pixel data is allocated from.
+     */
+    Image(const Vector2U& size,
+          size_t pixelSize,
+          MemoryResource& resource = MemoryResource::getDefault());
 
     /*
      *  \fn write
@@ -59,6 +75,52 @@ public:
      */
     void write(const std::string& pathname) const;
 
+    /*
+     *  \fn getSize
+     *  \brief Returns the dimensions of the image.
+     *
+     *  \return The size in pixels.
+     */
+    inline const Vector2U& getSize() const
+    {
+        return mSize;
+    }
+
+    /*
+     *  \fn getPixelSize
+     *  \brief Returns the number of bytes used to represent one pixel.
+     *
+     *  \return The bytes per pixel.
+     */
+    inline size_t getPixelSize() const
+    {
+        return mPixelSize;
+    }
+
+    /*
+     *  \fn getBuffer
+     *  \brief Returns the tightly packed pixel data. Rows are stored top
+     *         to bottom.
+     *
+     *  \return The start of the pixel data.
+     */
+    inline const uint8_t* getBuffer() const
+    {
+        return mBuffer.get();
+    }
+
+    /*
+     *  \fn getBuffer
+     *  \brief Returns the tightly packed pixel data. Rows are stored top
+     *         to bottom.
+     *
+     *  \return The start of the pixel data.
+     */
+    inline uint8_t* getBuffer()
+    {
+        return mBuffer.get();
+    }
+
     /*
      *  \fn Equality Operator
      *  \brief Compares to images. Note this is an expensive deep compare
@@ -83,8 +145,12 @@ public:
     }
 
 private:
+    typedef std::unique_ptr<uint8_t[], MemoryResource::Deleter> Buffer;
+
+    void allocate(MemoryResource& resource);
+
     size_t mPixelSize;
-    std::unique_ptr<uint8_t[]> mBuffer;
+    Buffer mBuffer;
     Vector2U mSize;
 };
 }
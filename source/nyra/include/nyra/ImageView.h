@@ -0,0 +1,202 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_IMAGE_VIEW_H_
+#define NYRA_IMAGE_VIEW_H_
+
+#include <algorithm>
+#include <nyra/Vector2.h>
+#include <nyra/Image.h>
+
+namespace nyra
+{
+/*
+ *  \class ImageViewBase
+ *  \brief A non owning window into pixel data. This can refer to an entire
+ *         Image, a sub rectangle of one, or memory that belongs to a third
+ *         party library. Rows do not need to be tightly packed.
+ *
+ *  \tparam ByteT The byte type. This controls if the pixels can be
+ *          modified through the view.
+ */
+template <typename ByteT>
+class ImageViewBase
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates a view of raw pixel data.
+     *
+     *  \param buffer The first byte of the top left pixel.
+     *  \param size The size of the view in pixels.
+     *  \param stride The number of bytes between the start of each row.
+     *  \param pixelSize The number of bytes per pixel.
+     */
+    ImageViewBase(ByteT* buffer,
+                  const Vector2U& size,
+                  size_t stride,
+                  size_t pixelSize = 4) :
+        mBuffer(buffer),
+        mSize(size),
+        mStride(stride),
+        mPixelSize(pixelSize)
+    {
+    }
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates a view of an entire image.
+     *
+     *  \param image The image to view.
+     */
+    ImageViewBase(Image& image) :
+        mBuffer(image.getBuffer()),
+        mSize(image.getSize()),
+        mStride(image.getSize().x * image.getPixelSize()),
+        mPixelSize(image.getPixelSize())
+    {
+    }
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates a view of an entire image. This is only usable by
+     *         views that cannot modify the image.
+     *
+     *  \param image The image to view.
+     */
+    ImageViewBase(const Image& image) :
+        mBuffer(image.getBuffer()),
+        mSize(image.getSize()),
+        mStride(image.getSize().x * image.getPixelSize()),
+        mPixelSize(image.getPixelSize())
+    {
+    }
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates a view from another view. This allows a mutable view
+     *         to be used where a const view is expected.
+     *
+     *  \tparam OtherT The byte type of the other view.
+     *  \param other The view to copy.
+     */
+    template <typename OtherT>
+    ImageViewBase(const ImageViewBase<OtherT>& other) :
+        mBuffer(other.getBuffer()),
+        mSize(other.getSize()),
+        mStride(other.getStride()),
+        mPixelSize(other.getPixelSize())
+    {
+    }
+
+    /*
+     *  \fn subView
+     *  \brief Creates a view of a rectangle inside of this view. The
+     *         rectangle is clipped to the bounds of this view.
+     *
+     *  \param offset The top left corner of the rectangle.
+     *  \param size The size of the rectangle.
+     *  \return The clipped view.
+     */
+    ImageViewBase<ByteT> subView(const Vector2U& offset,
+                                 const Vector2U& size) const
+    {
+        const Vector2U start(std::min(offset.x, mSize.x),
+                             std::min(offset.y, mSize.y));
+        const Vector2U clipped(std::min(size.x, mSize.x - start.x),
+                               std::min(size.y, mSize.y - start.y));
+        return ImageViewBase<ByteT>(mBuffer + (start.y * mStride) +
+                                            (start.x * mPixelSize),
+                                    clipped,
+                                    mStride,
+                                    mPixelSize);
+    }
+
+    /*
+     *  \fn getRow
+     *  \brief Returns the start of a row. No bounds checks are done.
+     *
+     *  \param row The row index.
+     *  \return The first byte of the row.
+     */
+    inline ByteT* getRow(size_t row) const
+    {
+        return mBuffer + (row * mStride);
+    }
+
+    /*
+     *  \fn getBuffer
+     *  \brief Returns the first byte of the top left pixel.
+     *
+     *  \return The buffer.
+     */
+    inline ByteT* getBuffer() const
+    {
+        return mBuffer;
+    }
+
+    /*
+     *  \fn getSize
+     *  \brief Returns the size of the view.
+     *
+     *  \return The size in pixels.
+     */
+    inline const Vector2U& getSize() const
+    {
+        return mSize;
+    }
+
+    /*
+     *  \fn getStride
+     *  \brief Returns the number of bytes between the start of each row.
+     *
+     *  \return The stride in bytes.
+     */
+    inline size_t getStride() const
+    {
+        return mStride;
+    }
+
+    /*
+     *  \fn getPixelSize
+     *  \brief Returns the number of bytes per pixel.
+     *
+     *  \return The bytes per pixel.
+     */
+    inline size_t getPixelSize() const
+    {
+        return mPixelSize;
+    }
+
+private:
+    ByteT* mBuffer;
+    Vector2U mSize;
+    size_t mStride;
+    size_t mPixelSize;
+};
+
+typedef ImageViewBase<uint8_t> ImageView;
+typedef ImageViewBase<const uint8_t> ConstImageView;
+}
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_IMAGE_WRITER_H_
+#define NYRA_IMAGE_WRITER_H_
+
+#include <string>
+#include <stdio.h>
+#include <nyra/Vector2.h>
+
+struct png_struct_def;
+struct png_info_def;
+
+namespace nyra
+{
+/*
+ *  \class ImageWriter
+ *  \brief Streams an image to disk one row at a time. This allows images
+ *         that are much larger than available memory to be written, since
+ *         only the rows currently being encoded need to exist.
+ *
+ *  \note This class currently only supports png.
+ */
+class ImageWriter
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Opens the file and writes the image header.
+     *
+     *  \param pathname The location on disk to write the image to.
+     *  \param size The final size of the image in pixels.
+     *  \param pixelSize The number of bytes per pixel. Only 3 (RGB) and
+     *         4 (RGBA) are supported.
+     */
+    ImageWriter(const std::string& pathname,
+                const Vector2U& size,
+                size_t pixelSize = 4);
+
+    /*
+     *  \fn Destructor
+     *  \brief Finishes the image if close was not called.
+     */
+    ~ImageWriter();
+
+    ImageWriter(const ImageWriter&) = delete;
+    ImageWriter& operator=(const ImageWriter&) = delete;
+
+    /*
+     *  \fn writeRows
+     *  \brief Encodes the next rows of the image.
+     *
+     *  \param buffer Tightly packed pixel data for the rows.
+     *  \param numRows The number of rows contained in the buffer.
+     */
+    void writeRows(const uint8_t* buffer, size_t numRows);
+
+    /*
+     *  \fn close
+     *  \brief Finishes the image and closes the file. Every row of the
+     *         image must have been written before this is called.
+     */
+    void close();
+
+    /*
+     *  \fn getRowsWritten
+     *  \brief Returns how many rows have been encoded so far.
+     *
+     *  \return The number of rows written.
+     */
+    inline size_t getRowsWritten() const
+    {
+        return mRowsWritten;
+    }
+
+private:
+    void destroy();
+
+    const Vector2U mSize;
+    const size_t mPixelSize;
+    size_t mRowsWritten;
+    FILE* mFile;
+    png_struct_def* mPngPtr;
+    png_info_def* mInfoPtr;
+};
+}
+
+#endif
@@ -0,0 +1,174 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_JSON_H_
+#define NYRA_JSON_H_
+
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace nyra
+{
+/*
+ *  \class JsonValue
+ *  \brief A parsed JSON document. This is meant for reading asset
+ *         descriptions, so values are read only and errors are reported
+ *         by throwing std::runtime_error.
+ */
+class JsonValue
+{
+public:
+    /*
+     *  \var MAX_DEPTH
+     *  \brief The deepest nesting of arrays and objects a document may
+     *         have. Deeper documents are rejected instead of running out
+     *         of stack.
+     */
+    static const size_t MAX_DEPTH = 256;
+
+    /*
+     *  \enum Type
+     *  \brief The kind of value stored.
+     */
+    enum class Type
+    {
+        NONE,
+        BOOLEAN,
+        NUMBER,
+        STRING,
+        ARRAY,
+        OBJECT
+    };
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates a null value.
+     */
+    JsonValue();
+
+    /*
+     *  \fn parse
+     *  \brief Parses a JSON document. Numbers must follow the JSON
+     *         grammar and be finite, whatever the current locale.
+     *
+     *  \param text The document.
+     *  \return The root value.
+     */
+    static JsonValue parse(const std::string& text);
+
+    /*
+     *  \fn load
+     *  \brief Reads and parses a JSON file.
+     *
+     *  \param pathname The pathname to the file on disk.
+     *  \return The root value.
+     */
+    static JsonValue load(const std::string& pathname);
+
+    /*
+     *  \fn getType
+     *  \brief Gets the kind of value stored.
+     *
+     *  \return The type.
+     */
+    inline Type getType() const
+    {
+        return mType;
+    }
+
+    /*
+     *  \fn asBool
+     *  \brief Gets a boolean value.
+     *
+     *  \return The value.
+     */
+    bool asBool() const;
+
+    /*
+     *  \fn asNumber
+     *  \brief Gets a number value.
+     *
+     *  \return The value.
+     */
+    double asNumber() const;
+
+    /*
+     *  \fn asString
+     *  \brief Gets a string value.
+     *
+     *  \return The value.
+     */
+    const std::string& asString() const;
+
+    /*
+     *  \fn size
+     *  \brief Gets the number of elements in an array or members in an
+     *         object.
+     *
+     *  \return The number of children.
+     */
+    size_t size() const;
+
+    /*
+     *  \fn Index Operator
+     *  \brief Gets an element of an array.
+     *
+     *  \param index The index of the element.
+     *  \return The element.
+     */
+    const JsonValue& operator[](size_t index) const;
+
+    /*
+     *  \fn Index Operator
+     *  \brief Gets a member of an object.
+     *
+     *  \param key The name of the member.
+     *  \return The member.
+     */
+    const JsonValue& operator[](const std::string& key) const;
+
+    /*
+     *  \fn has
+     *  \brief Checks if an object has a member.
+     *
+     *  \param key The name of the member.
+     *  \return True if the member exists.
+     */
+    bool has(const std::string& key) const;
+
+private:
+    friend class JsonParser;
+
+    void checkType(Type type) const;
+
+    Type mType;
+    bool mBool;
+    double mNumber;
+    std::string mString;
+    std::vector<JsonValue> mArray;
+    std::vector<std::pair<std::string, JsonValue> > mObject;
+};
+}
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_MEMORY_RESOURCE_H_
+#define NYRA_MEMORY_RESOURCE_H_
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace nyra
+{
+/*
+ *  \class MemoryResource
+ *  \brief Base class for anything that hands out raw memory. Buffers that
+ *         can grow large (images, tile maps) take one of these so callers
+ *         can control where the memory comes from.
+ */
+class MemoryResource
+{
+public:
+    /*
+     *  \fn Destructor
+     *  \brief Here for proper inheritance.
+     */
+    virtual ~MemoryResource();
+
+    /*
+     *  \fn allocate
+     *  \brief Allocates a block of memory.
+     *
+     *  \param bytes The number of bytes to allocate.
+     *  \param alignment The required alignment. This must be a power of
+     *         two. Both built in resources support alignments larger than
+     *         std::max_align_t.
+     *  \return The allocated memory. This throws on failure.
+     */
+    virtual void* allocate(size_t bytes,
+                           size_t alignment = alignof(std::max_align_t)) = 0;
+
+    /*
+     *  \fn deallocate
+     *  \brief Returns memory that was allocated from this resource.
+     *
+     *  \param ptr The memory to release.
+     *  \param bytes The size that was passed to allocate.
+     *  \param alignment The alignment that was passed to allocate.
+     */
+    virtual void deallocate(void* ptr,
+                            size_t bytes,
+                            size_t alignment = alignof(std::max_align_t)) = 0;
+
+    /*
+     *  \fn getDefault
+     *  \brief Returns the resource used when nothing else is requested.
+     *         This is a thin wrapper around the general heap.
+     *
+     *  \return The default resource.
+     */
+    static MemoryResource& getDefault();
+
+    /*
+     *  \class Deleter
+     *  \brief Used to return buffers held in a std::unique_ptr back to the
+     *         resource they came from.
+     */
+    struct Deleter
+    {
+        Deleter(MemoryResource* resource = nullptr, size_t bytes = 0) :
+            resource(resource),
+            bytes(bytes)
+        {
+        }
+
+        void operator()(uint8_t* ptr) const
+        {
+            if (ptr)
+            {
+                resource->deallocate(ptr, bytes);
+            }
+        }
+
+        MemoryResource* resource;
+        size_t bytes;
+    };
+};
+}
+
+#endif
@@ -0,0 +1,231 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_PARALLEL_RECORDER_H_
+#define NYRA_PARALLEL_RECORDER_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nyra
+{
+/*
+ *  \class ParallelRecorder
+ *  \brief Splits the recording of a frame across a pool of worker threads.
+ *         The items are divided into contiguous ranges and each range is
+ *         recorded into its own list, so no locking happens while
+ *         recording. Merging the lists in index order afterwards gives the
+ *         same result no matter how many threads were used. The calling
+ *         thread records the first range itself.
+ *
+ *  \tparam ListT The list type to record into, such as RenderCommandList
+ *          or a backend specific batch. It must have a clear method.
+ */
+template <typename ListT>
+class ParallelRecorder
+{
+public:
+    typedef std::function<void(ListT& list,
+                               size_t begin,
+                               size_t end)> RecordFunction;
+
+    /*
+     *  \fn Constructor
+     *  \brief Starts the worker threads.
+     *
+     *  \param numThreads The total number of threads to record with,
+     *         including the calling thread. Zero uses one per core.
+     */
+    explicit ParallelRecorder(size_t numThreads = 0) :
+        mFunction(nullptr),
+        mNumItems(0),
+        mGeneration(0),
+        mPending(0),
+        mStop(false)
+    {
+        if (numThreads == 0)
+        {
+            numThreads = std::max<size_t>(
+                    std::thread::hardware_concurrency(), 1);
+        }
+
+        mLists.resize(numThreads);
+        for (size_t ii = 1; ii < numThreads; ++ii)
+        {
+            mThreads.push_back(std::thread(&ParallelRecorder::work,
+                                           this,
+                                           ii));
+        }
+    }
+
+    ParallelRecorder(const ParallelRecorder&) = delete;
+    ParallelRecorder& operator=(const ParallelRecorder&) = delete;
+
+    /*
+     *  \fn Destructor
+     *  \brief Stops the worker threads.
+     */
+    ~ParallelRecorder()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mStart.notify_all();
+        for (size_t ii = 0; ii < mThreads.size(); ++ii)
+        {
+            mThreads[ii].join();
+        }
+    }
+
+    /*
+     *  \fn record
+     *  \brief Clears every list and records into them in parallel. This
+     *         blocks until all ranges are done. If any range throws, the
+     *         first exception is rethrown here once all threads finish.
+     *
+     *  \param numItems The number of items to split between the threads.
+     *  \param function Called once per list with the range of items to
+     *         record into it. This is called from several threads at once.
+     */
+    void record(size_t numItems, const RecordFunction& function)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mFunction = &function;
+            mNumItems = numItems;
+            mPending = mThreads.size();
+            mError = nullptr;
+            ++mGeneration;
+        }
+        mStart.notify_all();
+
+        std::exception_ptr error = run(0);
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDone.wait(lock, [this]() { return mPending == 0; });
+        mFunction = nullptr;
+        if (!error)
+        {
+            error = mError;
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /*
+     *  \fn getNumLists
+     *  \brief Gets the number of lists, which is also the number of
+     *         threads.
+     *
+     *  \return The number of lists.
+     */
+    inline size_t getNumLists() const
+    {
+        return mLists.size();
+    }
+
+    /*
+     *  \fn getList
+     *  \brief Gets a list filled by the last record. Lists should be
+     *         merged in index order to keep the output deterministic.
+     *
+     *  \param index The index of the list.
+     *  \return The list.
+     */
+    inline ListT& getList(size_t index)
+    {
+        return mLists[index];
+    }
+
+private:
+    std::exception_ptr run(size_t index)
+    {
+        const size_t begin = mNumItems * index / mLists.size();
+        const size_t end = mNumItems * (index + 1) / mLists.size();
+        try
+        {
+            mLists[index].clear();
+            (*mFunction)(mLists[index], begin, end);
+        }
+        catch (...)
+        {
+            return std::current_exception();
+        }
+        return nullptr;
+    }
+
+    void work(size_t index)
+    {
+        size_t generation = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mStart.wait(lock, [this, generation]()
+                {
+                    return mStop || mGeneration != generation;
+                });
+                if (mStop)
+                {
+                    return;
+                }
+                generation = mGeneration;
+            }
+
+            const std::exception_ptr error = run(index);
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (error && !mError)
+                {
+                    mError = error;
+                }
+                --mPending;
+            }
+            mDone.notify_one();
+        }
+    }
+
+    std::vector<ListT> mLists;
+    std::vector<std::thread> mThreads;
+    std::mutex mMutex;
+    std::condition_variable mStart;
+    std::condition_variable mDone;
+    const RecordFunction* mFunction;
+    size_t mNumItems;
+    size_t mGeneration;
+    size_t mPending;
+    bool mStop;
+    std::exception_ptr mError;
+};
+}
+
+#endif
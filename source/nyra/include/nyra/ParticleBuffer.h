@@ -0,0 +1,206 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_PARTICLE_BUFFER_H_
+#define NYRA_PARTICLE_BUFFER_H_
+
+#include <vector>
+#include <stdint.h>
+#include <nyra/Vector2.h>
+
+namespace nyra
+{
+/*
+ *  \class ParticleBuffer
+ *  \brief Stores particles as a structure of arrays so they can be updated
+ *         several at a time with SIMD. Dead particles are removed by moving
+ *         the last particle into their place, so the order of particles is
+ *         not preserved.
+ *
+ *         Colors are packed as 0xRRGGBBAA.
+ */
+class ParticleBuffer
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Allocates storage for all particles up front.
+     *
+     *  \param capacity The maximum number of live particles.
+     */
+    ParticleBuffer(size_t capacity);
+
+    /*
+     *  \fn spawn
+     *  \brief Adds a particle.
+     *
+     *  \param position The starting position.
+     *  \param velocity The starting velocity in pixels per second.
+     *  \param lifetime How long the particle lives in seconds.
+     *  \param color The color of the particle.
+     *  \return False if the buffer is full and nothing was added.
+     */
+    bool spawn(const Vector2F& position,
+               const Vector2F& velocity,
+               float lifetime,
+               uint32_t color);
+
+    /*
+     *  \fn update
+     *  \brief Moves and ages every particle, picks the frame for each one
+     *         from how far through its life it is and removes the ones
+     *         that died. This uses SIMD when the target supports it and
+     *         gives the same results as updateReference.
+     *
+     *  \param elapsed The time since the last update in seconds.
+     *  \param acceleration The acceleration applied to every particle in
+     *         pixels per second squared.
+     *  \param numFrames The number of animation frames to spread over the
+     *         life of each particle.
+     */
+    void update(float elapsed,
+                const Vector2F& acceleration,
+                uint32_t numFrames = 1);
+
+    /*
+     *  \fn updateReference
+     *  \brief A plain implementation of update that does one particle at a
+     *         time. This exists for testing and benchmarking.
+     *
+     *  \param elapsed The time since the last update in seconds.
+     *  \param acceleration The acceleration applied to every particle.
+     *  \param numFrames The number of animation frames.
+     */
+    void updateReference(float elapsed,
+                         const Vector2F& acceleration,
+                         uint32_t numFrames = 1);
+
+    /*
+     *  \fn clear
+     *  \brief Removes every particle.
+     */
+    inline void clear()
+    {
+        mSize = 0;
+    }
+
+    /*
+     *  \fn size
+     *  \brief Gets the number of live particles.
+     *
+     *  \return The number of particles.
+     */
+    inline size_t size() const
+    {
+        return mSize;
+    }
+
+    /*
+     *  \fn getCapacity
+     *  \brief Gets the maximum number of live particles.
+     *
+     *  \return The capacity.
+     */
+    inline size_t getCapacity() const
+    {
+        return mCapacity;
+    }
+
+    /*
+     *  \fn getPositionX
+     *  \brief Gets the x position of every particle.
+     *
+     *  \return An array of size() positions.
+     */
+    inline const float* getPositionX() const
+    {
+        return mPositionX.data();
+    }
+
+    /*
+     *  \fn getPositionY
+     *  \brief Gets the y position of every particle.
+     *
+     *  \return An array of size() positions.
+     */
+    inline const float* getPositionY() const
+    {
+        return mPositionY.data();
+    }
+
+    /*
+     *  \fn getAge
+     *  \brief Gets how long every particle has been alive in seconds.
+     *
+     *  \return An array of size() ages.
+     */
+    inline const float* getAge() const
+    {
+        return mAge.data();
+    }
+
+    /*
+     *  \fn getColor
+     *  \brief Gets the color of every particle.
+     *
+     *  \return An array of size() colors.
+     */
+    inline const uint32_t* getColor() const
+    {
+        return mColor.data();
+    }
+
+    /*
+     *  \fn getFrame
+     *  \brief Gets the animation frame of every particle as of the last
+     *         update.
+     *
+     *  \return An array of size() frame indices.
+     */
+    inline const int32_t* getFrame() const
+    {
+        return mFrame.data();
+    }
+
+private:
+    void integrate(size_t index,
+                   float elapsed,
+                   const Vector2F& acceleration,
+                   uint32_t numFrames);
+
+    void compact();
+
+    const size_t mCapacity;
+    size_t mSize;
+    std::vector<float> mPositionX;
+    std::vector<float> mPositionY;
+    std::vector<float> mVelocityX;
+    std::vector<float> mVelocityY;
+    std::vector<float> mAge;
+    std::vector<float> mLifetime;
+    std::vector<uint32_t> mColor;
+    std::vector<int32_t> mFrame;
+};
+}
+
+#endif
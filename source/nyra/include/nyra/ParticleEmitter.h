@@ -0,0 +1,163 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_PARTICLE_EMITTER_H_
+#define NYRA_PARTICLE_EMITTER_H_
+
+#include <random>
+#include <nyra/ParticleBuffer.h>
+
+namespace nyra
+{
+/*
+ *  \class ParticleEmitter
+ *  \brief Spawns particles from a point and keeps them updated. The
+ *         particles themselves live in a ParticleBuffer.
+ */
+class ParticleEmitter
+{
+public:
+    /*
+     *  \class Settings
+     *  \brief Describes the particles an emitter creates. Ranges are picked
+     *         uniformly per particle.
+     */
+    struct Settings
+    {
+        /*
+         *  \fn Constructor
+         *  \brief Sets up an emitter that sprays white particles in every
+         *         direction.
+         */
+        Settings();
+
+        // The maximum number of live particles
+        size_t capacity;
+
+        // New particles per second
+        float rate;
+        float minLifetime;
+        float maxLifetime;
+
+        // Speed in pixels per second
+        float minSpeed;
+        float maxSpeed;
+
+        // Clockwise degrees where 0 points along positive x
+        float direction;
+        float spread;
+
+        Vector2F acceleration;
+
+        // Packed as 0xRRGGBBAA
+        uint32_t color;
+
+        // Frames are played once over the life of each particle
+        uint32_t numFrames;
+    };
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates an emitter with no particles.
+     *
+     *  \param settings Describes the particles to create.
+     *  \param seed The seed for picking particle values. Emitters with
+     *         the same seed and settings behave the same way.
+     */
+    ParticleEmitter(const Settings& settings, uint32_t seed = 0);
+
+    /*
+     *  \fn update
+     *  \brief Updates the live particles and then spawns new ones based on
+     *         the rate.
+     *
+     *  \param elapsed The time since the last update in seconds.
+     */
+    void update(float elapsed);
+
+    /*
+     *  \fn emit
+     *  \brief Spawns a burst of particles. Particles that do not fit are
+     *         dropped.
+     *
+     *  \param count The number of particles to spawn.
+     */
+    void emit(size_t count);
+
+    /*
+     *  \fn setPosition
+     *  \brief Moves the point new particles spawn from. Existing particles
+     *         are not moved.
+     *
+     *  \param position The new position in pixels.
+     */
+    inline void setPosition(const Vector2F& position)
+    {
+        mPosition = position;
+    }
+
+    /*
+     *  \fn getPosition
+     *  \brief Gets the point new particles spawn from.
+     *
+     *  \return The position in pixels.
+     */
+    inline const Vector2F& getPosition() const
+    {
+        return mPosition;
+    }
+
+    /*
+     *  \fn getSettings
+     *  \brief Gets the settings the emitter was created with.
+     *
+     *  \return The settings.
+     */
+    inline const Settings& getSettings() const
+    {
+        return mSettings;
+    }
+
+    /*
+     *  \fn getParticles
+     *  \brief Gets the live particles.
+     *
+     *  \return The particle buffer.
+     */
+    inline const ParticleBuffer& getParticles() const
+    {
+        return mParticles;
+    }
+
+private:
+    float random(float min, float max);
+
+    const Settings mSettings;
+    ParticleBuffer mParticles;
+    Vector2F mPosition;
+    float mSpawnRemainder;
+    std::mt19937 mRandom;
+};
+}
+
+#endif
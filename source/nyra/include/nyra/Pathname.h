@@ -0,0 +1,56 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_PATHNAME_H_
+#define NYRA_PATHNAME_H_
+
+#include <string>
+
+namespace nyra
+{
+/*
+ *  \fn normalizePathname
+ *  \brief Turns different spellings of the same file into one key. Where
+ *         the platform can resolve the file on disk this follows symbolic
+ *         links, otherwise the pathname is cleaned up lexically, see
+ *         lexicallyNormalPathname.
+ *
+ *  \param pathname The pathname to normalize.
+ *  \return The normalized pathname.
+ */
+std::string normalizePathname(const std::string& pathname);
+
+/*
+ *  \fn lexicallyNormalPathname
+ *  \brief Removes "." components, duplicate separators and ".." components
+ *         that follow a named directory without touching the disk. Leading
+ *         ".." components of relative pathnames are kept and ".." above the
+ *         root of an absolute pathname is dropped.
+ *
+ *  \param pathname The pathname to clean up.
+ *  \return The cleaned up pathname, or "." if nothing is left.
+ */
+std::string lexicallyNormalPathname(const std::string& pathname);
+}
+
+#endif
@@ -0,0 +1,169 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_QUAD_TREE_H_
+#define NYRA_QUAD_TREE_H_
+
+#include <vector>
+#include <nyra/Rect.h>
+
+namespace nyra
+{
+/*
+ *  \class QuadTree
+ *  \brief A loose quadtree of bounding rectangles. Each cell accepts any
+ *         item whose center is inside it and whose size is no larger than
+ *         the cell, since the loose bounds of a cell are twice its size.
+ *         This means the cell for an item is found directly from its
+ *         center and size, and moving an item never requires searching.
+ *
+ *         Items are identified by ids chosen by the caller. Ids should be
+ *         small and reused, since storage grows to the largest id.
+ */
+class QuadTree
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates an empty tree.
+     *
+     *  \param world The area covered by the tree. Items outside of it are
+     *         still supported but are tested on every query.
+     *  \param maxDepth The number of times the world can be split.
+     */
+    QuadTree(const RectF& world, size_t maxDepth = 8);
+
+    /*
+     *  \fn insert
+     *  \brief Adds an item to the tree.
+     *
+     *  \param id The id of the item. This must not already be in use.
+     *  \param bounds The bounds of the item.
+     */
+    void insert(size_t id, const RectF& bounds);
+
+    /*
+     *  \fn update
+     *  \brief Changes the bounds of an item. This only moves the item if it
+     *         no longer belongs in the same cell.
+     *
+     *  \param id The id of the item.
+     *  \param bounds The new bounds of the item.
+     */
+    void update(size_t id, const RectF& bounds);
+
+    /*
+     *  \fn remove
+     *  \brief Removes an item from the tree.
+     *
+     *  \param id The id of the item.
+     */
+    void remove(size_t id);
+
+    /*
+     *  \fn query
+     *  \brief Finds every item that overlaps an area. The order of the
+     *         results depends on where items are in the tree.
+     *
+     *  \param area The area to search.
+     *  \param results Filled with the ids of the overlapping items. Any
+     *         previous contents are removed.
+     */
+    void query(const RectF& area, std::vector<size_t>& results) const;
+
+    /*
+     *  \fn query
+     *  \brief Finds every item that overlaps any of several areas in a
+     *         single traversal. Each item is reported once even if it
+     *         overlaps more than one area.
+     *
+     *  \param areas The areas to search.
+     *  \param results Filled with the ids of the overlapping items. Any
+     *         previous contents are removed.
+     */
+    void query(const std::vector<RectF>& areas,
+               std::vector<size_t>& results) const;
+
+    /*
+     *  \fn size
+     *  \brief Gets the number of items in the tree.
+     *
+     *  \return The number of items.
+     */
+    inline size_t size() const
+    {
+        return mNumItems;
+    }
+
+private:
+    struct Item
+    {
+        RectF bounds;
+        size_t cell;
+        size_t slot;
+        bool used;
+    };
+
+    size_t findCell(const RectF& bounds) const;
+
+    void link(size_t id, size_t cell);
+
+    void unlink(size_t id);
+
+    void updateCounts(size_t cell, bool added);
+
+    void queryCell(size_t level,
+                   size_t x,
+                   size_t y,
+                   const RectF* areas,
+                   size_t numAreas,
+                   std::vector<size_t>& results) const;
+
+    void queryItems(size_t cell,
+                    const RectF* areas,
+                    size_t numAreas,
+                    std::vector<size_t>& results) const;
+
+    static bool intersectsAny(const RectF& bounds,
+                              const RectF* areas,
+                              size_t numAreas);
+
+    inline size_t getCellIndex(size_t level, size_t x, size_t y) const
+    {
+        return mLevelOffsets[level] + (y << level) + x;
+    }
+
+    const RectF mWorld;
+    const size_t mMaxDepth;
+    const size_t mOutsideCell;
+    std::vector<size_t> mLevelOffsets;
+    std::vector<std::vector<size_t> > mCells;
+
+    // The number of items in each cell and all of its children
+    std::vector<size_t> mCounts;
+    std::vector<Item> mItems;
+    size_t mNumItems;
+};
+}
+
+#endif
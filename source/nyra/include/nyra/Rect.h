@@ -0,0 +1,229 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_RECT_H_
+#define NYRA_RECT_H_
+
+#include <algorithm>
+#include <nyra/Vector2.h>
+#include <nyra/Matrix.h>
+
+namespace nyra
+{
+/*
+ *  \class Rect
+ *  \brief An axis aligned rectangle stored as its minimum (top left) and
+ *         maximum (bottom right) corners.
+ *
+ *  \tparam TypeT The type of each coordinate.
+ */
+template <typename TypeT>
+class Rect
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates an empty rectangle at the origin.
+     */
+    Rect()
+    {
+    }
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates a rectangle from its corners.
+     *
+     *  \param min The top left corner.
+     *  \param max The bottom right corner.
+     */
+    Rect(const Vector2<TypeT>& min, const Vector2<TypeT>& max) :
+        min(min),
+        max(max)
+    {
+    }
+
+    /*
+     *  \fn Equality Operator
+     *  \brief Checks if two rectangles have the same corners.
+     *
+     *  \param other The rectangle to compare against.
+     *  \return True if they match.
+     */
+    bool operator==(const Rect<TypeT>& other) const
+    {
+        return min == other.min && max == other.max;
+    }
+
+    /*
+     *  \fn Inequality Operator
+     *  \brief Checks if two rectangles have different corners.
+     *
+     *  \param other The rectangle to compare against.
+     *  \return True if they do not match.
+     */
+    bool operator!=(const Rect<TypeT>& other) const
+    {
+        return !(*this == other);
+    }
+
+    /*
+     *  \fn getSize
+     *  \brief Gets the width and height of the rectangle.
+     *
+     *  \return The size.
+     */
+    Vector2<TypeT> getSize() const
+    {
+        return Vector2<TypeT>(max.x - min.x, max.y - min.y);
+    }
+
+    /*
+     *  \fn getCenter
+     *  \brief Gets the center point of the rectangle.
+     *
+     *  \return The center.
+     */
+    Vector2<TypeT> getCenter() const
+    {
+        return Vector2<TypeT>((min.x + max.x) / 2, (min.y + max.y) / 2);
+    }
+
+    /*
+     *  \fn isEmpty
+     *  \brief Checks if the rectangle has no area.
+     *
+     *  \return True if the width or height is not positive.
+     */
+    bool isEmpty() const
+    {
+        return max.x <= min.x || max.y <= min.y;
+    }
+
+    /*
+     *  \fn intersects
+     *  \brief Checks if two rectangles overlap. Touching edges do not
+     *         count as overlapping.
+     *
+     *  \param other The rectangle to test against.
+     *  \return True if they overlap.
+     */
+    bool intersects(const Rect<TypeT>& other) const
+    {
+        return min.x < other.max.x && other.min.x < max.x &&
+               min.y < other.max.y && other.min.y < max.y;
+    }
+
+    /*
+     *  \fn contains
+     *  \brief Checks if another rectangle is completely inside this one.
+     *
+     *  \param other The rectangle to test.
+     *  \return True if other is inside.
+     */
+    bool contains(const Rect<TypeT>& other) const
+    {
+        return min.x <= other.min.x && other.max.x <= max.x &&
+               min.y <= other.min.y && other.max.y <= max.y;
+    }
+
+    /*
+     *  \fn merge
+     *  \brief Grows the rectangle to cover another one. Merging into an
+     *         empty rectangle takes the other rectangle as is.
+     *
+     *  \param other The rectangle to cover.
+     */
+    void merge(const Rect<TypeT>& other)
+    {
+        if (isEmpty())
+        {
+            *this = other;
+        }
+        else if (!other.isEmpty())
+        {
+            min.x = std::min(min.x, other.min.x);
+            min.y = std::min(min.y, other.min.y);
+            max.x = std::max(max.x, other.max.x);
+            max.y = std::max(max.y, other.max.y);
+        }
+    }
+
+    /*
+     *  \fn getIntersection
+     *  \brief Gets the area covered by both rectangles.
+     *
+     *  \param other The rectangle to intersect with.
+     *  \return The overlapping area. This is empty if they do not overlap.
+     */
+    Rect<TypeT> getIntersection(const Rect<TypeT>& other) const
+    {
+        return Rect<TypeT>(Vector2<TypeT>(std::max(min.x, other.min.x),
+                                          std::max(min.y, other.min.y)),
+                           Vector2<TypeT>(std::min(max.x, other.max.x),
+                                          std::min(max.y, other.max.y)));
+    }
+
+    Vector2<TypeT> min;
+    Vector2<TypeT> max;
+};
+
+typedef Rect<float> RectF;
+typedef Rect<int32_t> RectI;
+
+/*
+ *  \fn transformBounds
+ *  \brief Gets the axis aligned bounds of an object after it has been
+ *         transformed.
+ *
+ *  \param matrix The transform of the object.
+ *  \param size The untransformed size of the object.
+ *  \return The bounds in the space the matrix transforms to.
+ */
+inline RectF transformBounds(const Matrix& matrix, const Vector2F& size)
+{
+    const float xs[] = {0.0f, size.x, size.x, 0.0f};
+    const float ys[] = {0.0f, 0.0f, size.y, size.y};
+    RectF bounds;
+    for (size_t ii = 0; ii < 4; ++ii)
+    {
+        const float x = (matrix(0, 0) * xs[ii]) +
+                (matrix(0, 1) * ys[ii]) + matrix(0, 2);
+        const float y = (matrix(1, 0) * xs[ii]) +
+                (matrix(1, 1) * ys[ii]) + matrix(1, 2);
+        if (ii == 0)
+        {
+            bounds.min = bounds.max = Vector2F(x, y);
+        }
+        else
+        {
+            bounds.min.x = std::min(bounds.min.x, x);
+            bounds.min.y = std::min(bounds.min.y, y);
+            bounds.max.x = std::max(bounds.max.x, x);
+            bounds.max.y = std::max(bounds.max.y, y);
+        }
+    }
+    return bounds;
+}
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_RENDER_COMMAND_LIST_H_
+#define NYRA_RENDER_COMMAND_LIST_H_
+
+#include <vector>
+#include <stdint.h>
+#include <nyra/Matrix.h>
+#include <nyra/RenderableInterface.h>
+
+namespace nyra
+{
+/*
+ *  \class RenderCommandList
+ *  \brief A list of render commands recorded by a single thread. Lists do
+ *         not touch the graphics at all so any number of them can be
+ *         filled at once. They are merged into a RenderQueue on the thread
+ *         that owns the graphics.
+ */
+class RenderCommandList
+{
+public:
+    struct Command
+    {
+        RenderableInterface* renderable;
+        Matrix matrix;
+        uint64_t key;
+    };
+
+    /*
+     *  \fn push
+     *  \brief Records a command. The renderable must stay alive until the
+     *         queue it is merged into is flushed.
+     *
+     *  \param renderable The object to render.
+     *  \param matrix The positional information about the object.
+     *  \param key The sort key from RenderQueue::makeKey.
+     */
+    void push(RenderableInterface& renderable,
+              const Matrix& matrix,
+              uint64_t key);
+
+    /*
+     *  \fn clear
+     *  \brief Removes all commands while keeping the memory around.
+     */
+    inline void clear()
+    {
+        mCommands.clear();
+    }
+
+    /*
+     *  \fn size
+     *  \brief Gets the number of recorded commands.
+     *
+     *  \return The number of commands.
+     */
+    inline size_t size() const
+    {
+        return mCommands.size();
+    }
+
+    /*
+     *  \fn Index Operator
+     *  \brief Gets a recorded command.
+     *
+     *  \param index The index of the command.
+     *  \return The command.
+     */
+    inline const Command& operator[](size_t index) const
+    {
+        return mCommands[index];
+    }
+
+private:
+    std::vector<Command> mCommands;
+};
+}
+
+#endif
@@ -0,0 +1,181 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_RENDER_QUEUE_H_
+#define NYRA_RENDER_QUEUE_H_
+
+#include <vector>
+#include <stdint.h>
+#include <nyra/Blend.h>
+#include <nyra/Camera.h>
+#include <nyra/Matrix.h>
+#include <nyra/RenderableInterface.h>
+#include <nyra/RenderCommandList.h>
+
+namespace nyra
+{
+/*
+ *  \class RenderQueue
+ *  \brief Collects render commands for a frame and submits them in an
+ *         order that minimizes state changes. Each command carries a 64 bit
+ *         sort key, see makeKey, and the keys are radix sorted once per
+ *         flush. The sort is stable, so commands with equal keys are drawn
+ *         in the order they were pushed.
+ */
+class RenderQueue
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates an empty queue.
+     */
+    RenderQueue();
+
+    /*
+     *  \fn makeKey
+     *  \brief Packs the sort criteria into a key. Commands are ordered by
+     *         layer first, then depth, then texture and finally blend mode.
+     *
+     *  \param layer The layer, lower layers are drawn first.
+     *  \param depth The depth within the layer, lower depths are drawn
+     *         first.
+     *  \param texture An id that is unique per texture.
+     *  \param blend The blend mode used to draw.
+     *  \return The sort key.
+     */
+    static uint64_t makeKey(uint8_t layer,
+                            uint16_t depth,
+                            uint32_t texture,
+                            BlendMode blend);
+
+    /*
+     *  \fn push
+     *  \brief Adds a command to the queue. The renderable must stay alive
+     *         until the next flush.
+     *
+     *  \param renderable The object to render.
+     *  \param matrix The positional information about the object.
+     *  \param key The sort key from makeKey.
+     */
+    void push(RenderableInterface& renderable,
+              const Matrix& matrix,
+              uint64_t key);
+
+    /*
+     *  \fn append
+     *  \brief Adds every command from a list, as if each was pushed in
+     *         order. Appending per thread lists in a fixed order keeps the
+     *         final draw order deterministic.
+     *
+     *  \param list The commands to add.
+     */
+    void append(const RenderCommandList& list);
+
+    /*
+     *  \fn flush
+     *  \brief Sorts the queued commands, renders them and empties the
+     *         queue.
+     *
+     *  \param graphics The graphics interface to render to.
+     */
+    void flush(GraphicsInterface& graphics);
+
+    /*
+     *  \fn flush
+     *  \brief Sorts the queued commands once and renders them through
+     *         every camera, clipped to each viewport. Commands outside of
+     *         a view are skipped for that view. The scissor is reset and
+     *         the queue is emptied afterwards.
+     *
+     *  \param graphics The graphics interface to render to.
+     *  \param cameras The cameras to render in order.
+     *  \param targetSize The size of the render target in pixels.
+     */
+    void flush(GraphicsInterface& graphics,
+               const std::vector<Camera>& cameras,
+               const Vector2U& targetSize);
+
+    /*
+     *  \fn getNumCommands
+     *  \brief Gets how many commands were rendered by the last flush.
+     *
+     *  \return The number of commands.
+     */
+    inline size_t getNumCommands() const
+    {
+        return mNumCommands;
+    }
+
+    /*
+     *  \fn getStateChangesBefore
+     *  \brief Gets how many texture or blend changes the last flush would
+     *         have needed if the commands were drawn in push order.
+     *
+     *  \return The number of state changes before sorting.
+     */
+    inline size_t getStateChangesBefore() const
+    {
+        return mStateChangesBefore;
+    }
+
+    /*
+     *  \fn getStateChangesAfter
+     *  \brief Gets how many texture or blend changes the last flush
+     *         actually made.
+     *
+     *  \return The number of state changes after sorting.
+     */
+    inline size_t getStateChangesAfter() const
+    {
+        return mStateChangesAfter;
+    }
+
+private:
+    struct Command
+    {
+        RenderableInterface* renderable;
+        Matrix matrix;
+    };
+
+    struct SortItem
+    {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    void prepare();
+    void sort();
+
+    static size_t countStateChanges(const std::vector<SortItem>& items);
+
+    std::vector<Command> mCommands;
+    std::vector<SortItem> mItems;
+    std::vector<SortItem> mScratch;
+    std::vector<RectF> mBounds;
+    size_t mNumCommands;
+    size_t mStateChangesBefore;
+    size_t mStateChangesAfter;
+};
+}
+
+#endif
@@ -0,0 +1,245 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_RENDER_STATS_H_
+#define NYRA_RENDER_STATS_H_
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace nyra
+{
+/*
+ *  \class FrameStats
+ *  \brief What the renderer was asked to do in a single frame. Times are
+ *         in milliseconds.
+ */
+struct FrameStats
+{
+    uint64_t frame;
+    uint32_t drawCalls;
+    uint64_t vertices;
+    uint32_t textureSwitches;
+    uint32_t stateChanges;
+    uint32_t offscreenPasses;
+    double clearTime;
+    double presentTime;
+    double frameTime;
+};
+
+/*
+ *  \class RenderStats
+ *  \brief Counts the work a graphics backend does each frame and keeps a
+ *         rolling history of the most recent frames. Backends record into
+ *         it as they draw, and a frame is finished by endPresent.
+ */
+class RenderStats
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates empty stats.
+     *
+     *  \param historySize The number of finished frames to keep.
+     */
+    RenderStats(size_t historySize = 300);
+
+    /*
+     *  \fn addDraw
+     *  \brief Records a draw call. Drawing with a different texture than
+     *         the last draw of the frame counts as a texture switch.
+     *
+     *  \param texture The backend texture the draw uses, or nullptr.
+     *  \param numVertices The number of vertices in the draw.
+     */
+    inline void addDraw(const void* texture, size_t numVertices)
+    {
+        ++mCurrent.drawCalls;
+        mCurrent.vertices += numVertices;
+        if (texture != mLastTexture)
+        {
+            ++mCurrent.textureSwitches;
+            mLastTexture = texture;
+        }
+    }
+
+    /*
+     *  \fn addStateChange
+     *  \brief Records a change to the render state, such as the blend mode
+     *         or the view.
+     */
+    inline void addStateChange()
+    {
+        ++mCurrent.stateChanges;
+    }
+
+    /*
+     *  \fn addOffscreenPass
+     *  \brief Records that rendering was redirected to an offscreen
+     *         target.
+     */
+    inline void addOffscreenPass()
+    {
+        ++mCurrent.offscreenPasses;
+    }
+
+    /*
+     *  \fn beginClear
+     *  \brief Starts timing a clear.
+     */
+    inline void beginClear()
+    {
+        mClearStart = Clock::now();
+    }
+
+    /*
+     *  \fn endClear
+     *  \brief Stops timing a clear. Several clears in a frame add up.
+     */
+    inline void endClear()
+    {
+        mCurrent.clearTime += milliseconds(mClearStart, Clock::now());
+    }
+
+    /*
+     *  \fn beginPresent
+     *  \brief Starts timing a present.
+     */
+    inline void beginPresent()
+    {
+        mPresentStart = Clock::now();
+    }
+
+    /*
+     *  \fn endPresent
+     *  \brief Stops timing a present and finishes the frame. The frame is
+     *         added to the history and counting starts over.
+     */
+    void endPresent();
+
+    /*
+     *  \fn getCurrent
+     *  \brief Gets the counts for the frame that is being rendered.
+     *
+     *  \return The unfinished frame.
+     */
+    inline const FrameStats& getCurrent() const
+    {
+        return mCurrent;
+    }
+
+    /*
+     *  \fn getNumFrames
+     *  \brief Gets how many finished frames are in the history.
+     *
+     *  \return The number of frames up to the history size.
+     */
+    inline size_t getNumFrames() const
+    {
+        return mHistory.size();
+    }
+
+    /*
+     *  \fn getFrame
+     *  \brief Gets a finished frame from the history.
+     *
+     *  \param index The index of the frame with 0 being the oldest.
+     *  \return The frame.
+     */
+    inline const FrameStats& getFrame(size_t index) const
+    {
+        return mHistory[(mNext + index) % mHistory.size()];
+    }
+
+    /*
+     *  \fn getLast
+     *  \brief Gets the most recently finished frame.
+     *
+     *  \throw std::runtime_error If no frame has finished.
+     *  \return The frame.
+     */
+    const FrameStats& getLast() const;
+
+    /*
+     *  \fn getAverage
+     *  \brief Averages every frame in the history.
+     *
+     *  \return The average frame. The frame number is the last one.
+     */
+    FrameStats getAverage() const;
+
+    /*
+     *  \fn clear
+     *  \brief Empties the history and the current frame.
+     */
+    void clear();
+
+    /*
+     *  \fn writeCSV
+     *  \brief Writes the history with a header row and one row per frame,
+     *         oldest first.
+     *
+     *  \param stream The stream to write to.
+     */
+    void writeCSV(std::ostream& stream) const;
+
+    /*
+     *  \fn writeJSON
+     *  \brief Writes the history as an array of objects, oldest first.
+     *
+     *  \param stream The stream to write to.
+     */
+    void writeJSON(std::ostream& stream) const;
+
+    /*
+     *  \fn save
+     *  \brief Saves the history to disk.
+     *
+     *  \param pathname The pathname to save to. The extension picks the
+     *         format and must be .csv or .json.
+     */
+    void save(const std::string& pathname) const;
+
+private:
+    typedef std::chrono::high_resolution_clock Clock;
+
+    static double milliseconds(const Clock::time_point& start,
+                               const Clock::time_point& end);
+    void reset();
+
+    std::vector<FrameStats> mHistory;
+    size_t mHistorySize;
+    size_t mNext;
+    FrameStats mCurrent;
+    const void* mLastTexture;
+    Clock::time_point mClearStart;
+    Clock::time_point mPresentStart;
+    Clock::time_point mLastPresent;
+    bool mHasPresented;
+};
+}
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_RENDERABLE_BASE_H_
+#define NYRA_RENDERABLE_BASE_H_
+
+#include <stdexcept>
+#include <nyra/RenderableInterface.h>
+
+namespace nyra
+{
+/*
+ *  \class RenderableBase
+ *  \brief Binds a renderable to the graphics type of its backend at compile
+ *         time. The derived class provides a non virtual
+ *         render(const Matrix&, GraphicsT&) which is what code that knows
+ *         its backend (such as EngineBase) calls directly. The virtual
+ *         render is only a thin adapter for code that needs runtime
+ *         polymorphism, such as Scene and RenderQueue. It finds the
+ *         backend through GraphicsInterface::getBackend, which only casts
+ *         when the backend type changes, so drawing a frame through the
+ *         interface does not cast once per object.
+ *
+ *         Derived classes should add
+ *         using RenderableBase<DerivedT, GraphicsT>::render;
+ *         so both overloads stay visible.
+ *
+ *  \tparam DerivedT The renderable being implemented.
+ *  \tparam GraphicsT The graphics type the renderable draws with.
+ */
+template <typename DerivedT,
+          typename GraphicsT>
+class RenderableBase : public RenderableInterface
+{
+public:
+    /*
+     *  \fn render
+     *  \brief Renders the object to a graphics interface. This forwards to
+     *         the statically bound render of the derived class.
+     *
+     *  \param matrix The positional information about the object.
+     *  \param graphics The graphics interface to render to. This must be
+     *         a GraphicsT.
+     */
+    void render(const Matrix& matrix,
+                GraphicsInterface& graphics) override
+    {
+        GraphicsT* backend = graphics.getBackend<GraphicsT>();
+        if (!backend)
+        {
+            throw std::runtime_error(
+                    "Renderable used with the wrong graphics backend");
+        }
+        static_cast<DerivedT&>(*this).render(matrix, *backend);
+    }
+};
+}
+
+#endif
@@ -0,0 +1,309 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_RESOURCE_CACHE_H_
+#define NYRA_RESOURCE_CACHE_H_
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <unordered_map>
+#include <nyra/Pathname.h>
+
+namespace nyra
+{
+/*
+ *  \class ResourceCache
+ *  \brief Loads each resource once and hands out shared handles to it.
+ *         Resources are keyed by their normalized pathname and are
+ *         released as soon as the last handle is dropped. A thread that
+ *         asks for a resource another thread is already loading waits for
+ *         that load instead of starting its own. All methods are thread
+ *         safe and handles may outlive the cache.
+ *
+ *  \tparam ResourceT The type of resource to cache.
+ */
+template <typename ResourceT>
+class ResourceCache
+{
+public:
+    typedef std::shared_ptr<const ResourceT> Handle;
+    typedef std::function<std::unique_ptr<ResourceT>(
+            const std::string& pathname)> Loader;
+    typedef std::function<size_t(const ResourceT& resource)> Sizer;
+
+    /*
+     *  \fn Constructor
+     *  \brief Creates an empty cache.
+     *
+     *  \param loader Creates a resource from its normalized pathname. This
+     *         is called without any lock held and should throw on failure.
+     *         By default the resource is constructed from the pathname.
+     *  \param sizer Gets the number of bytes a resource uses, for
+     *         getBytesResident. By default resources are not measured.
+     */
+    ResourceCache(const Loader& loader = construct,
+                  const Sizer& sizer = Sizer()) :
+        mState(std::make_shared<State>(loader, sizer))
+    {
+    }
+
+    ResourceCache(const ResourceCache&) = delete;
+    ResourceCache& operator=(const ResourceCache&) = delete;
+
+    /*
+     *  \fn load
+     *  \brief Gets a resource, loading it if nothing else is currently
+     *         holding it.
+     *
+     *  \param pathname The pathname of the resource.
+     *  \return A shared handle to the resource.
+     */
+    Handle load(const std::string& pathname)
+    {
+        const std::string key = normalizePathname(pathname);
+        std::unique_lock<std::mutex> lock(mState->mutex);
+        for (;;)
+        {
+            auto iter = mState->entries.find(key);
+            if (iter == mState->entries.end())
+            {
+                break;
+            }
+
+            Handle handle = iter->second.resource.lock();
+            if (handle)
+            {
+                ++mState->hits;
+                return handle;
+            }
+            if (!iter->second.loading)
+            {
+                break;
+            }
+            mState->loaded.wait(lock);
+        }
+
+        // Claim the key so other threads wait for this load
+        Entry& entry = mState->entries[key];
+        entry.resource.reset();
+        entry.raw = nullptr;
+        entry.loading = true;
+        ++mState->misses;
+        lock.unlock();
+
+        std::unique_ptr<ResourceT> resource;
+        size_t bytes = 0;
+        try
+        {
+            resource = mState->loader(key);
+            if (mState->sizer)
+            {
+                bytes = mState->sizer(*resource);
+            }
+        }
+        catch (...)
+        {
+            abandon(lock, key);
+            throw;
+        }
+
+        // The bytes are counted before the handle exists, since the
+        // deleter takes them off again even if the handle fails to build.
+        lock.lock();
+        mState->bytesResident += bytes;
+        lock.unlock();
+        const std::shared_ptr<State> state = mState;
+        Handle handle;
+        try
+        {
+            handle = Handle(resource.release(),
+                            [state, key, bytes](const ResourceT* ptr)
+            {
+                release(state, key, ptr, bytes);
+            });
+        }
+        catch (...)
+        {
+            abandon(lock, key);
+            throw;
+        }
+
+        lock.lock();
+        Entry& loaded = mState->entries[key];
+        loaded.resource = handle;
+        loaded.raw = handle.get();
+        loaded.loading = false;
+        mState->loaded.notify_all();
+        return handle;
+    }
+
+    /*
+     *  \fn getHits
+     *  \brief Returns how many loads were served from memory, including
+     *         loads that waited for another thread to finish.
+     *
+     *  \return The number of cache hits.
+     */
+    size_t getHits() const
+    {
+        std::lock_guard<std::mutex> lock(mState->mutex);
+        return mState->hits;
+    }
+
+    /*
+     *  \fn getMisses
+     *  \brief Returns how many loads had to create the resource.
+     *
+     *  \return The number of cache misses.
+     */
+    size_t getMisses() const
+    {
+        std::lock_guard<std::mutex> lock(mState->mutex);
+        return mState->misses;
+    }
+
+    /*
+     *  \fn getNumResident
+     *  \brief Returns how many resources are currently loaded.
+     *
+     *  \return The number of loaded resources.
+     */
+    size_t getNumResident() const
+    {
+        std::lock_guard<std::mutex> lock(mState->mutex);
+        size_t numResident = 0;
+        for (auto iter = mState->entries.begin();
+             iter != mState->entries.end();
+             ++iter)
+        {
+            if (!iter->second.resource.expired())
+            {
+                ++numResident;
+            }
+        }
+        return numResident;
+    }
+
+    /*
+     *  \fn getBytesResident
+     *  \brief Returns the bytes the sizer reported for every resource that
+     *         is currently loaded.
+     *
+     *  \return The resident size in bytes.
+     */
+    size_t getBytesResident() const
+    {
+        std::lock_guard<std::mutex> lock(mState->mutex);
+        return mState->bytesResident;
+    }
+
+    /*
+     *  \fn getNumEntries
+     *  \brief Returns how many keys the cache is tracking. Released
+     *         resources are forgotten, so this only counts resources that
+     *         are loaded or being loaded.
+     *
+     *  \return The number of entries.
+     */
+    size_t getNumEntries() const
+    {
+        std::lock_guard<std::mutex> lock(mState->mutex);
+        return mState->entries.size();
+    }
+
+private:
+    struct Entry
+    {
+        Entry() :
+            raw(nullptr),
+            loading(false)
+        {
+        }
+
+        std::weak_ptr<const ResourceT> resource;
+        const ResourceT* raw;
+        bool loading;
+    };
+
+    // Shared with the handle deleters so handles can outlive the cache
+    struct State
+    {
+        State(const Loader& loader, const Sizer& sizer) :
+            loader(loader),
+            sizer(sizer),
+            hits(0),
+            misses(0),
+            bytesResident(0)
+        {
+        }
+
+        mutable std::mutex mutex;
+        std::condition_variable loaded;
+        std::unordered_map<std::string, Entry> entries;
+        const Loader loader;
+        const Sizer sizer;
+        size_t hits;
+        size_t misses;
+        size_t bytesResident;
+    };
+
+    // Gives up a claimed key so waiting threads can try the load again
+    void abandon(std::unique_lock<std::mutex>& lock, const std::string& key)
+    {
+        lock.lock();
+        mState->entries.erase(key);
+        mState->loaded.notify_all();
+    }
+
+    static std::unique_ptr<ResourceT> construct(const std::string& pathname)
+    {
+        return std::unique_ptr<ResourceT>(new ResourceT(pathname));
+    }
+
+    static void release(const std::shared_ptr<State>& state,
+                        const std::string& key,
+                        const ResourceT* resource,
+                        size_t bytes)
+    {
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->bytesResident -= bytes;
+
+            // The entry may already belong to a newer load of the same key
+            auto iter = state->entries.find(key);
+            if (iter != state->entries.end() && iter->second.raw == resource)
+            {
+                state->entries.erase(iter);
+            }
+        }
+        delete resource;
+    }
+
+    std::shared_ptr<State> mState;
+};
+}
+
+#endif
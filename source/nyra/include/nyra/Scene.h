@@ -0,0 +1,342 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_SCENE_H_
+#define NYRA_SCENE_H_
+
+#include <vector>
+#include <stdint.h>
+#include <nyra/QuadTree.h>
+#include <nyra/Camera.h>
+#include <nyra/Transform.h>
+#include <nyra/RenderableInterface.h>
+
+namespace nyra
+{
+/*
+ *  \class Scene
+ *  \brief Keeps track of where renderables are so only the visible ones
+ *         need to be drawn. The bounds of each object come from its
+ *         Transform and RenderableInterface::getSize and are kept in a
+ *         loose quadtree. Objects whose transform or size changed must be
+ *         marked with markMoved, only those are moved in the tree so an
+ *         update costs nothing for objects that stay still.
+ *
+ *         The scene also tracks damage, the union of every area that
+ *         changed since the damage was last cleared. Objects that change
+ *         how they look without moving (for example a new animation frame)
+ *         must be marked with invalidate.
+ *
+ *         Several cameras can be rendered in one frame, for split screen
+ *         or a minimap. The tree is only traversed once for all of them
+ *         and each view then filters the shared visible set.
+ *
+ *         The scene does not own anything that is added to it, both the
+ *         renderable and the transform must outlive their time in the
+ *         scene.
+ */
+class Scene
+{
+public:
+    /*
+     *  \fn Constructor
+     *  \brief Creates an empty scene.
+     *
+     *  \param world The area the scene is expected to cover. Objects can
+     *         be placed outside of it but are slower to cull.
+     *  \param maxDepth The depth of the underlying quadtree.
+     */
+    Scene(const RectF& world, size_t maxDepth = 8);
+
+    /*
+     *  \fn add
+     *  \brief Adds an object to the scene.
+     *
+     *  \param renderable The object to render.
+     *  \param transform The positional information about the object.
+     *  \param key The RenderQueue sort key used when the scene is drawn
+     *         through a queue. Objects with equal keys keep their cull
+     *         order.
+     *  \return An id that refers to the object until it is removed. Ids of
+     *          removed objects are reused.
+     */
+    size_t add(RenderableInterface& renderable,
+               Transform& transform,
+               uint64_t key = 0);
+
+    /*
+     *  \fn remove
+     *  \brief Removes an object from the scene.
+     *
+     *  \param id The id returned from add.
+     */
+    void remove(size_t id);
+
+    /*
+     *  \fn markMoved
+     *  \brief Marks an object whose transform or size changed. Its bounds
+     *         are taken again on the next update. Marking an object more
+     *         than once before the update is cheap.
+     *
+     *  \param id The id of the object.
+     */
+    inline void markMoved(size_t id)
+    {
+        Object& object = mObjects[id];
+        if (!object.moved)
+        {
+            object.moved = true;
+            mMoved.push_back(id);
+        }
+    }
+
+    /*
+     *  \fn update
+     *  \brief Moves every object marked with markMoved since the last
+     *         update. This is called by cull, so it only needs to be called
+     *         directly if bounds are needed between culls.
+     */
+    void update();
+
+    /*
+     *  \fn invalidate
+     *  \brief Marks an object as needing to be redrawn even though its
+     *         transform has not changed. The bounds are taken again from
+     *         the renderable size, so a new frame of a different size is
+     *         culled and redrawn correctly.
+     *
+     *  \param id The id of the object.
+     */
+    void invalidate(size_t id);
+
+    /*
+     *  \fn invalidate
+     *  \brief Marks an area as needing to be redrawn.
+     *
+     *  \param area The area in world coordinates.
+     */
+    inline void invalidate(const RectF& area)
+    {
+        mDamage.merge(area);
+    }
+
+    /*
+     *  \fn getDamage
+     *  \brief Gets the union of everything that has changed since the last
+     *         call to clearDamage. Call update first to pick up moved
+     *         objects.
+     *
+     *  \return The damaged area. This is empty if nothing changed.
+     */
+    inline const RectF& getDamage() const
+    {
+        return mDamage;
+    }
+
+    /*
+     *  \fn clearDamage
+     *  \brief Resets the damage once it has been redrawn.
+     */
+    inline void clearDamage()
+    {
+        mDamage = RectF();
+    }
+
+    /*
+     *  \fn cull
+     *  \brief Finds the objects that overlap a view and updates the
+     *         visible and culled counts.
+     *
+     *  \param view The visible area in world coordinates.
+     *  \return The ids of the visible objects in increasing order so the
+     *          result does not depend on the layout of the tree.
+     */
+    const std::vector<size_t>& cull(const RectF& view);
+
+    /*
+     *  \fn render
+     *  \brief Culls against a view and renders what is visible.
+     *
+     *  \param view The visible area in world coordinates.
+     *  \param graphics The graphics interface to render to.
+     */
+    void render(const RectF& view, GraphicsInterface& graphics);
+
+    /*
+     *  \fn cull
+     *  \brief Finds the objects that any of the cameras can see with a
+     *         single traversal of the tree.
+     *
+     *  \param cameras The cameras of the frame.
+     *  \param targetSize The size of the render target in pixels.
+     *  \return The ids of the objects visible to at least one camera in
+     *          increasing order.
+     */
+    const std::vector<size_t>& cull(const std::vector<Camera>& cameras,
+                                    const Vector2U& targetSize);
+
+    /*
+     *  \fn render
+     *  \brief Culls against every camera and renders each view clipped to
+     *         its viewport. The scissor is reset afterwards.
+     *
+     *  \param cameras The cameras to render in order.
+     *  \param targetSize The size of the render target in pixels.
+     *  \param graphics The graphics interface to render to.
+     */
+    void render(const std::vector<Camera>& cameras,
+                const Vector2U& targetSize,
+                GraphicsInterface& graphics);
+
+    /*
+     *  \fn getViewArea
+     *  \brief Gets the world area a camera could see during the last
+     *         multi camera cull.
+     *
+     *  \param index The index of the camera.
+     *  \return The visible area in world coordinates.
+     */
+    inline const RectF& getViewArea(size_t index) const
+    {
+        return mViewAreas[index];
+    }
+
+    /*
+     *  \fn getRenderable
+     *  \brief Gets the renderable of an object.
+     *
+     *  \param id The id of the object.
+     *  \return The renderable.
+     */
+    inline RenderableInterface& getRenderable(size_t id) const
+    {
+        return *mObjects[id].renderable;
+    }
+
+    /*
+     *  \fn getTransform
+     *  \brief Gets the transform of an object.
+     *
+     *  \param id The id of the object.
+     *  \return The transform.
+     */
+    inline Transform& getTransform(size_t id) const
+    {
+        return *mObjects[id].transform;
+    }
+
+    /*
+     *  \fn getKey
+     *  \brief Gets the sort key of an object.
+     *
+     *  \param id The id of the object.
+     *  \return The key passed to add.
+     */
+    inline uint64_t getKey(size_t id) const
+    {
+        return mObjects[id].key;
+    }
+
+    /*
+     *  \fn getBounds
+     *  \brief Gets the bounds of an object as of the last update.
+     *
+     *  \param id The id of the object.
+     *  \return The world space bounds.
+     */
+    inline const RectF& getBounds(size_t id) const
+    {
+        return mObjects[id].bounds;
+    }
+
+    /*
+     *  \fn getNumObjects
+     *  \brief Gets the number of objects in the scene.
+     *
+     *  \return The number of objects.
+     */
+    inline size_t getNumObjects() const
+    {
+        return mTree.size();
+    }
+
+    /*
+     *  \fn getNumVisible
+     *  \brief Gets how many objects the last cull found.
+     *
+     *  \return The number of visible objects.
+     */
+    inline size_t getNumVisible() const
+    {
+        return mVisible.size();
+    }
+
+    /*
+     *  \fn getNumCulled
+     *  \brief Gets how many objects the last cull rejected.
+     *
+     *  \return The number of culled objects.
+     */
+    inline size_t getNumCulled() const
+    {
+        return mNumCulled;
+    }
+
+    /*
+     *  \fn getNumUpdated
+     *  \brief Gets how many marked objects the last update moved.
+     *
+     *  \return The number of updated objects.
+     */
+    inline size_t getNumUpdated() const
+    {
+        return mNumUpdated;
+    }
+
+private:
+    struct Object
+    {
+        RenderableInterface* renderable;
+        Transform* transform;
+        uint64_t key;
+        bool moved;
+        RectF bounds;
+    };
+
+    RectF computeBounds(const Object& object) const;
+
+    void refresh(size_t id);
+
+    QuadTree mTree;
+    std::vector<Object> mObjects;
+    std::vector<size_t> mFreeIds;
+    std::vector<size_t> mMoved;
+    std::vector<size_t> mVisible;
+    std::vector<RectF> mViewAreas;
+    size_t mNumCulled;
+    size_t mNumUpdated;
+    RectF mDamage;
+};
+}
+
+#endif
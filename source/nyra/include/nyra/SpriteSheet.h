@@ -0,0 +1,232 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_SPRITE_SHEET_H_
+#define NYRA_SPRITE_SHEET_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <nyra/Vector2.h>
+#include <nyra/AnimateInterface.h>
+
+namespace nyra
+{
+/*
+ *  \class SpriteSheet
+ *  \brief Describes the named frames and animations packed into a single
+ *         texture. Sheets are written by hand as JSON and can be compiled
+ *         to a binary form that loads without any parsing:
+ *
+ *         {
+ *             "texture": "hero.png",
+ *             "size": [256, 128],
+ *             "frames": [
+ *                 {"name": "run_0", "rect": [0, 0, 32, 48],
+ *                  "pivot": [0.5, 1.0], "duration": 0.1}
+ *             ],
+ *             "animations": [
+ *                 {"name": "run", "frames": ["run_0"], "mode": "loop"}
+ *             ]
+ *         }
+ *
+ *         The texture is relative to the sheet. Pivot defaults to the
+ *         center and duration to 0.1 seconds. Mode is one of "once",
+ *         "loop", "ping_pong_once" or "ping_pong_loop".
+ */
+class SpriteSheet
+{
+public:
+    /*
+     *  \class Frame
+     *  \brief A single frame of the sheet. The position and size are in
+     *         pixels and the pivot is normalized to the frame size.
+     */
+    struct Frame
+    {
+        std::string name;
+        Vector2U position;
+        Vector2U size;
+        Vector2F pivot;
+        float duration;
+    };
+
+    /*
+     *  \class FrameUV
+     *  \brief The texture coordinates of a frame, normalized to the
+     *         texture size.
+     */
+    struct FrameUV
+    {
+        float left;
+        float top;
+        float right;
+        float bottom;
+    };
+
+    /*
+     *  \class Animation
+     *  \brief A named sequence of frame indices.
+     */
+    struct Animation
+    {
+        std::string name;
+        std::vector<size_t> frames;
+        AnimateMode mode;
+    };
+
+    /*
+     *  \fn Constructor
+     *  \brief Loads a sheet. Pathnames ending in .json are parsed as the
+     *         source format, anything else is read as a compiled sheet.
+     *
+     *  \param pathname The pathname to the sheet on disk.
+     */
+    SpriteSheet(const std::string& pathname);
+
+    /*
+     *  \fn write
+     *  \brief Writes the compiled form of the sheet.
+     *
+     *  \param pathname The pathname to write to.
+     */
+    void write(const std::string& pathname) const;
+
+    /*
+     *  \fn getTexturePathname
+     *  \brief Gets the pathname to the texture, resolved against the
+     *         directory the sheet was loaded from.
+     *
+     *  \return The texture pathname.
+     */
+    inline const std::string& getTexturePathname() const
+    {
+        return mTexturePathname;
+    }
+
+    /*
+     *  \fn getTextureSize
+     *  \brief Gets the size of the texture in pixels.
+     *
+     *  \return The texture size.
+     */
+    inline const Vector2U& getTextureSize() const
+    {
+        return mTextureSize;
+    }
+
+    /*
+     *  \fn getNumFrames
+     *  \brief Gets the number of frames.
+     *
+     *  \return The number of frames.
+     */
+    inline size_t getNumFrames() const
+    {
+        return mFrames.size();
+    }
+
+    /*
+     *  \fn getFrame
+     *  \brief Gets a frame.
+     *
+     *  \param index The index of the frame.
+     *  \return The frame.
+     */
+    inline const Frame& getFrame(size_t index) const
+    {
+        return mFrames[index];
+    }
+
+    /*
+     *  \fn getUV
+     *  \brief Gets the precomputed texture coordinates of a frame.
+     *
+     *  \param index The index of the frame.
+     *  \return The texture coordinates.
+     */
+    inline const FrameUV& getUV(size_t index) const
+    {
+        return mUVs[index];
+    }
+
+    /*
+     *  \fn getFrameIndex
+     *  \brief Finds a frame by name.
+     *
+     *  \param name The name of the frame.
+     *  \return The index of the frame.
+     */
+    size_t getFrameIndex(const std::string& name) const;
+
+    /*
+     *  \fn getNumAnimations
+     *  \brief Gets the number of animations.
+     *
+     *  \return The number of animations.
+     */
+    inline size_t getNumAnimations() const
+    {
+        return mAnimations.size();
+    }
+
+    /*
+     *  \fn getAnimation
+     *  \brief Gets an animation.
+     *
+     *  \param index The index of the animation.
+     *  \return The animation.
+     */
+    inline const Animation& getAnimation(size_t index) const
+    {
+        return mAnimations[index];
+    }
+
+    /*
+     *  \fn getAnimation
+     *  \brief Finds an animation by name.
+     *
+     *  \param name The name of the animation.
+     *  \return The animation.
+     */
+    const Animation& getAnimation(const std::string& name) const;
+
+private:
+    void readJSON(const std::string& pathname);
+
+    void readBinary(const std::string& pathname);
+
+    void buildTables();
+
+    std::string mTextureName;
+    std::string mTexturePathname;
+    Vector2U mTextureSize;
+    std::vector<Frame> mFrames;
+    std::vector<FrameUV> mUVs;
+    std::vector<Animation> mAnimations;
+    std::unordered_map<std::string, size_t> mFrameLookup;
+    std::unordered_map<std::string, size_t> mAnimationLookup;
+};
+}
+
+#endif
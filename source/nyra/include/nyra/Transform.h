@@ -57,7 +57,7 @@ public:
     inline void setPosition(const Vector2F& position)
     {
         mPosition = position;
-        mNeedMatrixUpdate = true;
+        markDirty();
     }
 
     /*
@@ -94,7 +94,7 @@ public:
     inline void setScale(const Vector2F& scale)
     {
         mScale = scale;
-        mNeedMatrixUpdate = true;
+        markDirty();
     }
 
     /*
@@ -131,7 +131,7 @@ public:
     inline void setRotation(float rotation)
     {
         mRotation = rotation;
-        mNeedMatrixUpdate = true;
+        markDirty();
     }
 
     /*
@@ -155,7 +155,7 @@ public:
     inline void setPivot(const Vector2F& pivot)
     {
         mPivot = pivot;
-        mNeedMatrixUpdate = true;
+        markDirty();
     }
 
     /*
@@ -201,11 +201,32 @@ public:
       */
      void setSize(const Vector2U& size)
      {
-        mSize = size * -1.0f;
-        mNeedMatrixUpdate = true;
+        // Negate as signed values, size is unsigned
+        mSize = Vector2I(-static_cast<int32_t>(size.x),
+                         -static_cast<int32_t>(size.y));
+        markDirty();
      }
 
+    /*
+     *  \fn getVersion
+     *  \brief Returns a number that changes every time the transform is
+     *         modified. This lets other systems cheaply find out whether
+     *         anything that depends on the transform needs to be updated.
+     *
+     *  \return The current version.
+     */
+    inline size_t getVersion() const
+    {
+        return mVersion;
+    }
+
 private:
+    inline void markDirty()
+    {
+        mNeedMatrixUpdate = true;
+        ++mVersion;
+    }
+
     Vector2F mPosition;
     Vector2F mScale;
     float mRotation;
@@ -213,6 +234,7 @@ private:
     Matrix mMatrix;
     Vector2I mSize;
     bool mNeedMatrixUpdate;
+    size_t mVersion;
 };
 }
 #endif
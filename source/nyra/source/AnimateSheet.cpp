@@ -0,0 +1,103 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/AnimateSheet.h>
+#include <stdexcept>
+
+namespace nyra
+{
+//===========================================================================//
+AnimateSheet::AnimateSheet(const SpriteSheet& sheet,
+                           const std::string& name) :
+    mFrames(sheet.getAnimation(name).frames),
+    mMode(sheet.getAnimation(name).mode),
+    mCurrent(0),
+    mDirection(1),
+    mElapsedTime(0.0),
+    mSpriteInjection(nullptr)
+{
+    if (mFrames.empty())
+    {
+        throw std::runtime_error("Animation " + name + " has no frames");
+    }
+
+    for (size_t ii = 0; ii < mFrames.size(); ++ii)
+    {
+        mDurations.push_back(sheet.getFrame(mFrames[ii]).duration);
+    }
+}
+
+//===========================================================================//
+bool AnimateSheet::update(double deltaTime)
+{
+    mElapsedTime += deltaTime;
+    bool changed = false;
+    bool finished = false;
+
+    // Long updates can skip over several short frames. Sheets only allow
+    // positive durations, so this always ends.
+    while (!finished && mElapsedTime >= mDurations[mCurrent])
+    {
+        mElapsedTime -= mDurations[mCurrent];
+        const bool forward = mDirection > 0;
+        const bool atEnd = forward ? mCurrent + 1 == mFrames.size() :
+                                     mCurrent == 0;
+        if (!atEnd)
+        {
+            mCurrent += mDirection;
+            changed = true;
+            continue;
+        }
+
+        switch (mMode)
+        {
+        case AnimateMode::PLAY_ONCE:
+            finished = true;
+            continue;
+        case AnimateMode::LOOP:
+            mCurrent = 0;
+            break;
+        case AnimateMode::PING_PONG_ONCE:
+        case AnimateMode::PING_PONG_LOOP:
+            if (!forward && mMode == AnimateMode::PING_PONG_ONCE)
+            {
+                finished = true;
+                continue;
+            }
+            mDirection = -mDirection;
+            if (mFrames.size() > 1)
+            {
+                mCurrent += mDirection;
+            }
+            break;
+        }
+        changed = true;
+    }
+
+    if (changed && mSpriteInjection)
+    {
+        mSpriteInjection->setFrame(getFrame());
+    }
+    return !finished;
+}
+}
@@ -0,0 +1,113 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/Arena.h>
+#include <algorithm>
+
+namespace nyra
+{
+//===========================================================================//
+Arena::Arena(size_t blockSize, MemoryResource& upstream) :
+    mBlockSize(blockSize),
+    mUpstream(upstream),
+    mOffset(0),
+    mBytesAllocated(0),
+    mBytesReserved(0)
+{
+}
+
+//===========================================================================//
+Arena::~Arena()
+{
+    release();
+}
+
+//===========================================================================//
+void* Arena::allocate(size_t bytes, size_t alignment)
+{
+    if (!mBlocks.empty())
+    {
+        const Block& block = mBlocks.back();
+        const uintptr_t start =
+                reinterpret_cast<uintptr_t>(block.memory) + mOffset;
+        const size_t padding = (alignment - (start % alignment)) % alignment;
+        if (mOffset + padding + bytes <= block.size)
+        {
+            mOffset += padding + bytes;
+            mBytesAllocated += bytes;
+            return block.memory + mOffset - bytes;
+        }
+    }
+
+    // Make room for the block first. Once the memory is taken from
+    // upstream nothing may throw, or the block would leak.
+    if (mBlocks.size() == mBlocks.capacity())
+    {
+        mBlocks.reserve(std::max<size_t>(4, mBlocks.size() * 2));
+    }
+
+    // New blocks start at the requested alignment, so the allocation can
+    // sit at the front of the block.
+    Block block;
+    block.size = std::max(mBlockSize, bytes);
+    block.alignment = std::max(alignment, alignof(std::max_align_t));
+    block.memory = static_cast<uint8_t*>(
+            mUpstream.allocate(block.size, block.alignment));
+    mBytesReserved += block.size;
+    mBytesAllocated += bytes;
+
+    // Oversized allocations get a block of their own so the space left in
+    // the current block is not thrown away.
+    if (bytes > mBlockSize && !mBlocks.empty())
+    {
+        mBlocks.insert(mBlocks.end() - 1, block);
+        return block.memory;
+    }
+
+    mBlocks.push_back(block);
+    mOffset = bytes;
+    return block.memory;
+}
+
+//===========================================================================//
+void Arena::deallocate(void* /* ptr */,
+                       size_t /* bytes */,
+                       size_t /* alignment */)
+{
+}
+
+//===========================================================================//
+void Arena::release()
+{
+    for (size_t ii = 0; ii < mBlocks.size(); ++ii)
+    {
+        mUpstream.deallocate(mBlocks[ii].memory,
+                             mBlocks[ii].size,
+                             mBlocks[ii].alignment);
+    }
+    mBlocks.clear();
+    mOffset = 0;
+    mBytesAllocated = 0;
+    mBytesReserved = 0;
+}
+}
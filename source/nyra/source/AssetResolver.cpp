@@ -0,0 +1,135 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/AssetResolver.h>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+// Variants in increasing order, the 1x variant is the plain pathname
+const float SCALES[] = {0.5f, 1.0f, 2.0f};
+const char* const SUFFIXES[] = {"@0.5x", "", "@2x"};
+const size_t NUM_SCALES = sizeof(SCALES) / sizeof(SCALES[0]);
+
+//===========================================================================//
+bool exists(const std::string& pathname)
+{
+    return std::ifstream(pathname.c_str()).good();
+}
+}
+
+namespace nyra
+{
+//===========================================================================//
+AssetResolver::AssetResolver(const Vector2U& referenceSize) :
+    mReferenceSize(referenceSize),
+    mWindowSize(referenceSize),
+    mQuality(Quality::MEDIUM)
+{
+    if (referenceSize.product() == 0)
+    {
+        throw std::runtime_error("Asset reference size must not be empty");
+    }
+}
+
+//===========================================================================//
+float AssetResolver::getDesiredScale() const
+{
+    // The axis that needs the most detail decides
+    const float scale = std::max(
+            static_cast<float>(mWindowSize.x) / mReferenceSize.x,
+            static_cast<float>(mWindowSize.y) / mReferenceSize.y);
+    switch (mQuality)
+    {
+    case Quality::LOW:
+        return scale * 0.5f;
+    case Quality::HIGH:
+        return scale * 2.0f;
+    default:
+        return scale;
+    }
+}
+
+//===========================================================================//
+AssetResolver::Variant AssetResolver::resolve(
+        const std::string& pathname) const
+{
+    const float desired = getDesiredScale();
+    Variant variant;
+    variant.pathname = pathname;
+    variant.scale = 1.0f;
+    for (size_t ii = 0; ii < NUM_SCALES; ++ii)
+    {
+        const std::string candidate =
+                getVariantPathname(pathname, SCALES[ii]);
+        if (SCALES[ii] != 1.0f && !exists(candidate))
+        {
+            continue;
+        }
+
+        variant.pathname = candidate;
+        variant.scale = SCALES[ii];
+        if (SCALES[ii] >= desired)
+        {
+            break;
+        }
+    }
+    return variant;
+}
+
+//===========================================================================//
+std::string AssetResolver::getVariantPathname(const std::string& pathname,
+                                              float scale)
+{
+    size_t index = NUM_SCALES;
+    for (size_t ii = 0; ii < NUM_SCALES; ++ii)
+    {
+        if (SCALES[ii] == scale)
+        {
+            index = ii;
+        }
+    }
+    if (index == NUM_SCALES)
+    {
+        throw std::runtime_error("Unsupported asset variant scale");
+    }
+
+    // The suffix goes before the extension of the file name
+    const size_t slash = pathname.find_last_of("/\\");
+    const size_t dot = pathname.find_last_of('.');
+    const size_t insert = (dot == std::string::npos ||
+            (slash != std::string::npos && dot < slash)) ?
+                    pathname.size() : dot;
+    return pathname.substr(0, insert) + SUFFIXES[index] +
+           pathname.substr(insert);
+}
+
+//===========================================================================//
+AssetResolver& AssetResolver::getDefault()
+{
+    static AssetResolver resolver;
+    return resolver;
+}
+}
@@ -0,0 +1,323 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/Blend.h>
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+//===========================================================================//
+typedef void (*RowFunction)(const uint8_t* source,
+                            uint8_t* destination,
+                            size_t numPixels,
+                            uint32_t opacity);
+
+//===========================================================================//
+// Divides the product by 255 with correct rounding. The SIMD version
+// below uses the same trick so both paths produce the same results.
+inline uint32_t multiply255(uint32_t lhs, uint32_t rhs)
+{
+    const uint32_t temp = (lhs * rhs) + 128;
+    return (temp + (temp >> 8)) >> 8;
+}
+
+//===========================================================================//
+template <nyra::BlendMode ModeT, nyra::AlphaMode AlphaT>
+inline void blendPixel(const uint8_t* source,
+                       uint8_t* destination,
+                       uint32_t opacity)
+{
+    // Bring the source into a premultiplied form with the opacity applied.
+    const uint32_t alpha = multiply255(source[3], opacity);
+    uint32_t color[3];
+    for (size_t ii = 0; ii < 3; ++ii)
+    {
+        color[ii] = multiply255(source[ii],
+                AlphaT == nyra::AlphaMode::STRAIGHT ? alpha : opacity);
+    }
+
+    switch (ModeT)
+    {
+    case nyra::BlendMode::REPLACE:
+        for (size_t ii = 0; ii < 3; ++ii)
+        {
+            destination[ii] = AlphaT == nyra::AlphaMode::STRAIGHT ?
+                    source[ii] : color[ii];
+        }
+        destination[3] = alpha;
+        break;
+    case nyra::BlendMode::SOURCE_OVER:
+        for (size_t ii = 0; ii < 3; ++ii)
+        {
+            destination[ii] = std::min<uint32_t>(255, color[ii] +
+                    multiply255(destination[ii], 255 - alpha));
+        }
+        destination[3] = std::min<uint32_t>(255, alpha +
+                multiply255(destination[3], 255 - alpha));
+        break;
+    case nyra::BlendMode::ADDITIVE:
+        for (size_t ii = 0; ii < 3; ++ii)
+        {
+            destination[ii] = std::min<uint32_t>(255,
+                                                 color[ii] + destination[ii]);
+        }
+        destination[3] = std::min<uint32_t>(255, alpha + destination[3]);
+        break;
+    case nyra::BlendMode::MULTIPLY:
+        for (size_t ii = 0; ii < 3; ++ii)
+        {
+            destination[ii] = multiply255(destination[ii],
+                    std::min<uint32_t>(255, color[ii] + 255 - alpha));
+        }
+        break;
+    }
+}
+
+#ifdef __SSE2__
+//===========================================================================//
+inline __m128i multiply255(__m128i lhs, __m128i rhs)
+{
+    // Products of two bytes always fit into an unsigned 16 bit lane.
+    const __m128i temp = _mm_add_epi16(_mm_mullo_epi16(lhs, rhs),
+                                       _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(temp, _mm_srli_epi16(temp, 8)), 8);
+}
+
+//===========================================================================//
+inline __m128i broadcastAlpha(__m128i pixels)
+{
+    return _mm_shufflehi_epi16(
+            _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)),
+            _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+//===========================================================================//
+inline __m128i select(__m128i mask, __m128i lhs, __m128i rhs)
+{
+    return _mm_or_si128(_mm_and_si128(mask, lhs),
+                        _mm_andnot_si128(mask, rhs));
+}
+
+//===========================================================================//
+// Blends two pixels that have been widened to 16 bits per channel.
+template <nyra::BlendMode ModeT, nyra::AlphaMode AlphaT>
+inline __m128i blendPixels(__m128i source,
+                           __m128i destination,
+                           __m128i opacity,
+                           __m128i alphaMask)
+{
+    __m128i alpha;
+    __m128i color;
+    if (AlphaT == nyra::AlphaMode::STRAIGHT)
+    {
+        alpha = multiply255(broadcastAlpha(source), opacity);
+        color = select(alphaMask, alpha, multiply255(source, alpha));
+    }
+    else
+    {
+        color = multiply255(source, opacity);
+        alpha = broadcastAlpha(color);
+    }
+
+    const __m128i inverseAlpha = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+    switch (ModeT)
+    {
+    case nyra::BlendMode::REPLACE:
+        return AlphaT == nyra::AlphaMode::STRAIGHT ?
+                select(alphaMask, alpha, source) : color;
+    case nyra::BlendMode::SOURCE_OVER:
+        return _mm_add_epi16(color,
+                             multiply255(destination, inverseAlpha));
+    case nyra::BlendMode::ADDITIVE:
+        // Saturation is handled when packing back down to bytes
+        return _mm_add_epi16(color, destination);
+    case nyra::BlendMode::MULTIPLY:
+        return select(alphaMask,
+                      destination,
+                      multiply255(destination, _mm_min_epi16(
+                              _mm_add_epi16(color, inverseAlpha),
+                              _mm_set1_epi16(255))));
+    }
+    return destination;
+}
+#endif
+
+//===========================================================================//
+template <nyra::BlendMode ModeT, nyra::AlphaMode AlphaT>
+void blendRow(const uint8_t* source,
+              uint8_t* destination,
+              size_t numPixels,
+              uint32_t opacity)
+{
+    size_t ii = 0;
+
+#ifdef __SSE2__
+    // Four pixels at a time, split into two registers of two pixels.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opacityVector = _mm_set1_epi16(opacity);
+    const __m128i alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    for (; ii + 4 <= numPixels; ii += 4)
+    {
+        __m128i* output = reinterpret_cast<__m128i*>(destination + (ii * 4));
+        const __m128i src = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(source + (ii * 4)));
+        const __m128i dst = _mm_loadu_si128(output);
+        const __m128i low = blendPixels<ModeT, AlphaT>(
+                _mm_unpacklo_epi8(src, zero),
+                _mm_unpacklo_epi8(dst, zero),
+                opacityVector,
+                alphaMask);
+        const __m128i high = blendPixels<ModeT, AlphaT>(
+                _mm_unpackhi_epi8(src, zero),
+                _mm_unpackhi_epi8(dst, zero),
+                opacityVector,
+                alphaMask);
+        _mm_storeu_si128(output, _mm_packus_epi16(low, high));
+    }
+#endif
+
+    for (; ii < numPixels; ++ii)
+    {
+        blendPixel<ModeT, AlphaT>(source + (ii * 4),
+                                  destination + (ii * 4),
+                                  opacity);
+    }
+}
+
+//===========================================================================//
+template <nyra::BlendMode ModeT, nyra::AlphaMode AlphaT>
+void blendRowReference(const uint8_t* source,
+                       uint8_t* destination,
+                       size_t numPixels,
+                       uint32_t opacity)
+{
+    for (size_t ii = 0; ii < numPixels; ++ii)
+    {
+        blendPixel<ModeT, AlphaT>(source + (ii * 4),
+                                  destination + (ii * 4),
+                                  opacity);
+    }
+}
+
+//===========================================================================//
+template <nyra::AlphaMode AlphaT>
+RowFunction getRowFunction(nyra::BlendMode mode, bool reference)
+{
+    switch (mode)
+    {
+    case nyra::BlendMode::REPLACE:
+        return reference ?
+                blendRowReference<nyra::BlendMode::REPLACE, AlphaT> :
+                blendRow<nyra::BlendMode::REPLACE, AlphaT>;
+    case nyra::BlendMode::SOURCE_OVER:
+        return reference ?
+                blendRowReference<nyra::BlendMode::SOURCE_OVER, AlphaT> :
+                blendRow<nyra::BlendMode::SOURCE_OVER, AlphaT>;
+    case nyra::BlendMode::ADDITIVE:
+        return reference ?
+                blendRowReference<nyra::BlendMode::ADDITIVE, AlphaT> :
+                blendRow<nyra::BlendMode::ADDITIVE, AlphaT>;
+    case nyra::BlendMode::MULTIPLY:
+        return reference ?
+                blendRowReference<nyra::BlendMode::MULTIPLY, AlphaT> :
+                blendRow<nyra::BlendMode::MULTIPLY, AlphaT>;
+    }
+    throw std::runtime_error("Unknown blend mode");
+}
+
+//===========================================================================//
+void blitImpl(const nyra::ConstImageView& source,
+              const nyra::ImageView& destination,
+              const nyra::Vector2I& position,
+              nyra::BlendMode mode,
+              nyra::AlphaMode alpha,
+              float opacity,
+              bool reference)
+{
+    if (source.getPixelSize() != 4 || destination.getPixelSize() != 4)
+    {
+        throw std::runtime_error("Blending is only supported for RGBA");
+    }
+
+    // Clip the source rectangle against the destination
+    const int64_t left = std::max<int64_t>(0, position.x);
+    const int64_t top = std::max<int64_t>(0, position.y);
+    const int64_t right = std::min<int64_t>(
+            destination.getSize().x,
+            static_cast<int64_t>(position.x) + source.getSize().x);
+    const int64_t bottom = std::min<int64_t>(
+            destination.getSize().y,
+            static_cast<int64_t>(position.y) + source.getSize().y);
+    if (right <= left || bottom <= top)
+    {
+        return;
+    }
+
+    const uint32_t opacityByte = static_cast<uint32_t>(
+            std::min(std::max(opacity, 0.0f), 1.0f) * 255.0f + 0.5f);
+    const RowFunction function = alpha == nyra::AlphaMode::STRAIGHT ?
+            getRowFunction<nyra::AlphaMode::STRAIGHT>(mode, reference) :
+            getRowFunction<nyra::AlphaMode::PREMULTIPLIED>(mode, reference);
+
+    const size_t sourceX = left - position.x;
+    const size_t sourceY = top - position.y;
+    const size_t width = right - left;
+    for (int64_t row = top; row < bottom; ++row)
+    {
+        function(source.getRow(sourceY + (row - top)) + (sourceX * 4),
+                 destination.getRow(row) + (left * 4),
+                 width,
+                 opacityByte);
+    }
+}
+}
+
+namespace nyra
+{
+//===========================================================================//
+void blit(const ConstImageView& source,
+          const ImageView& destination,
+          const Vector2I& position,
+          BlendMode mode,
+          AlphaMode alpha,
+          float opacity)
+{
+    blitImpl(source, destination, position, mode, alpha, opacity, false);
+}
+
+//===========================================================================//
+void blitReference(const ConstImageView& source,
+                   const ImageView& destination,
+                   const Vector2I& position,
+                   BlendMode mode,
+                   AlphaMode alpha,
+                   float opacity)
+{
+    blitImpl(source, destination, position, mode, alpha, opacity, true);
+}
+}
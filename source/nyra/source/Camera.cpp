@@ -0,0 +1,112 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/Camera.h>
+#include <cmath>
+#include <stdexcept>
+#include <nyra/Constants.h>
+
+namespace nyra
+{
+//===========================================================================//
+Camera::Camera(const Vector2F& position) :
+    mPosition(position),
+    mZoom(1.0f),
+    mRotation(0.0f),
+    mViewport(Vector2F(0.0f, 0.0f), Vector2F(1.0f, 1.0f)),
+    mVersion(0)
+{
+}
+
+//===========================================================================//
+void Camera::setZoom(float zoom)
+{
+    if (zoom <= 0.0f)
+    {
+        throw std::runtime_error("Camera zoom must be positive");
+    }
+    mZoom = zoom;
+    ++mVersion;
+}
+
+//===========================================================================//
+RectI Camera::getViewportPixels(const Vector2U& targetSize) const
+{
+    return RectI(
+            Vector2I(static_cast<int32_t>(std::floor(
+                             mViewport.min.x * targetSize.x + 0.5f)),
+                     static_cast<int32_t>(std::floor(
+                             mViewport.min.y * targetSize.y + 0.5f))),
+            Vector2I(static_cast<int32_t>(std::floor(
+                             mViewport.max.x * targetSize.x + 0.5f)),
+                     static_cast<int32_t>(std::floor(
+                             mViewport.max.y * targetSize.y + 0.5f))));
+}
+
+//===========================================================================//
+Matrix Camera::getMatrix(const Vector2U& targetSize) const
+{
+    // Rotate and zoom about the camera position, then move it to the
+    // center of the viewport.
+    const RectI pixels = getViewportPixels(targetSize);
+    const float centerX = (pixels.min.x + pixels.max.x) / 2.0f;
+    const float centerY = (pixels.min.y + pixels.max.y) / 2.0f;
+    const float rad = mRotation * Constants::DEGREES_TO_RADIANS;
+    const float cos = mZoom * std::cos(rad);
+    const float sin = mZoom * std::sin(rad);
+    return Matrix(cos, sin,
+                  centerX - (cos * mPosition.x) - (sin * mPosition.y),
+                  -sin, cos,
+                  centerY + (sin * mPosition.x) - (cos * mPosition.y),
+                  0.0f, 0.0f, 1.0f);
+}
+
+//===========================================================================//
+RectF Camera::getVisibleArea(const Vector2U& targetSize) const
+{
+    const Vector2I size = getViewportPixels(targetSize).getSize();
+    const float halfX = size.x / (2.0f * mZoom);
+    const float halfY = size.y / (2.0f * mZoom);
+    const float rad = mRotation * Constants::DEGREES_TO_RADIANS;
+    const float cos = std::abs(std::cos(rad));
+    const float sin = std::abs(std::sin(rad));
+    const float extentX = (cos * halfX) + (sin * halfY);
+    const float extentY = (sin * halfX) + (cos * halfY);
+    return RectF(Vector2F(mPosition.x - extentX, mPosition.y - extentY),
+                 Vector2F(mPosition.x + extentX, mPosition.y + extentY));
+}
+
+//===========================================================================//
+Vector2F Camera::screenToWorld(const Vector2F& point,
+                               const Vector2U& targetSize) const
+{
+    const RectI pixels = getViewportPixels(targetSize);
+    const float x = (point.x - (pixels.min.x + pixels.max.x) / 2.0f) / mZoom;
+    const float y = (point.y - (pixels.min.y + pixels.max.y) / 2.0f) / mZoom;
+    const float rad = mRotation * Constants::DEGREES_TO_RADIANS;
+    const float cos = std::cos(rad);
+    const float sin = std::sin(rad);
+    return Vector2F(mPosition.x + (cos * x) - (sin * y),
+                    mPosition.y + (sin * x) + (cos * y));
+}
+}
@@ -0,0 +1,196 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/CollisionMask.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace nyra
+{
+//===========================================================================//
+CollisionMask::CollisionMask() :
+    mWordsPerRow(0)
+{
+}
+
+//===========================================================================//
+CollisionMask::CollisionMask(const ConstImageView& image,
+                             uint8_t threshold) :
+    mSize(image.getSize()),
+    mWordsPerRow((mSize.x + 63) / 64),
+    mBits(mWordsPerRow * mSize.y, 0)
+{
+    if (image.getPixelSize() != 4)
+    {
+        throw std::runtime_error("Collision masks require RGBA images");
+    }
+
+    for (size_t yy = 0; yy < mSize.y; ++yy)
+    {
+        const uint8_t* alpha = image.getRow(yy) + 3;
+        uint64_t* row = &mBits[yy * mWordsPerRow];
+        for (size_t xx = 0; xx < mSize.x; ++xx)
+        {
+            if (alpha[xx * 4] > threshold)
+            {
+                row[xx >> 6] |= static_cast<uint64_t>(1) << (xx & 63);
+            }
+        }
+    }
+}
+
+//===========================================================================//
+CollisionMask::CollisionMask(const CollisionMask& source,
+                             const Vector2U& offset,
+                             const Vector2U& size) :
+    mSize(size),
+    mWordsPerRow((mSize.x + 63) / 64),
+    mBits(mWordsPerRow * mSize.y, 0)
+{
+    if (mWordsPerRow == 0)
+    {
+        return;
+    }
+
+    // The last word of each row must not pick up pixels past the width.
+    const size_t remainder = mSize.x & 63;
+    const uint64_t lastMask = remainder ?
+            (static_cast<uint64_t>(1) << remainder) - 1 : ~0ull;
+
+    for (size_t yy = 0; yy < mSize.y; ++yy)
+    {
+        const size_t sourceRow = offset.y + yy;
+        if (sourceRow >= source.mSize.y)
+        {
+            break;
+        }
+
+        uint64_t* row = &mBits[yy * mWordsPerRow];
+        for (size_t ii = 0; ii < mWordsPerRow; ++ii)
+        {
+            row[ii] = source.getWord(sourceRow,
+                                     static_cast<int64_t>(offset.x) +
+                                             (ii * 64));
+        }
+        row[mWordsPerRow - 1] &= lastMask;
+    }
+}
+
+//===========================================================================//
+bool CollisionMask::overlaps(const CollisionMask& other,
+                             const Vector2I& offset) const
+{
+    // Only the intersection of the two masks needs to be tested
+    const int64_t left = std::max<int64_t>(0, offset.x);
+    const int64_t top = std::max<int64_t>(0, offset.y);
+    const int64_t right = std::min<int64_t>(
+            mSize.x, static_cast<int64_t>(offset.x) + other.mSize.x);
+    const int64_t bottom = std::min<int64_t>(
+            mSize.y, static_cast<int64_t>(offset.y) + other.mSize.y);
+    if (right <= left || bottom <= top)
+    {
+        return false;
+    }
+
+    const size_t firstWord = left >> 6;
+    const size_t lastWord = (right - 1) >> 6;
+    for (int64_t yy = top; yy < bottom; ++yy)
+    {
+        const uint64_t* row = &mBits[yy * mWordsPerRow];
+        const size_t otherRow = yy - offset.y;
+        for (size_t ii = firstWord; ii <= lastWord; ++ii)
+        {
+            // Shift the other row so its pixels line up with this word
+            if (row[ii] & other.getWord(otherRow,
+                                        static_cast<int64_t>(ii * 64) -
+                                                offset.x))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+//===========================================================================//
+CollisionMask CollisionMask::resample(const Vector2U& size) const
+{
+    CollisionMask mask;
+    mask.mSize = size;
+    mask.mWordsPerRow = (size.x + 63) / 64;
+    mask.mBits.assign(mask.mWordsPerRow * size.y, 0);
+    if (mSize.product() == 0)
+    {
+        return mask;
+    }
+
+    for (size_t yy = 0; yy < size.y; ++yy)
+    {
+        // Each output pixel covers at least one source pixel
+        const size_t top = (yy * mSize.y) / size.y;
+        const size_t bottom = std::max(top + 1,
+                                       ((yy + 1) * mSize.y) / size.y);
+        uint64_t* row = &mask.mBits[yy * mask.mWordsPerRow];
+        for (size_t xx = 0; xx < size.x; ++xx)
+        {
+            const size_t left = (xx * mSize.x) / size.x;
+            const size_t right = std::max(left + 1,
+                                          ((xx + 1) * mSize.x) / size.x);
+            bool solid = false;
+            for (size_t sy = top; sy < bottom && !solid; ++sy)
+            {
+                for (size_t sx = left; sx < right && !solid; ++sx)
+                {
+                    solid = isSolid(sx, sy);
+                }
+            }
+            if (solid)
+            {
+                row[xx >> 6] |= static_cast<uint64_t>(1) << (xx & 63);
+            }
+        }
+    }
+    return mask;
+}
+
+//===========================================================================//
+uint64_t CollisionMask::getWord(size_t row, int64_t bit) const
+{
+    // Floor the word index so negative offsets shift correctly
+    const int64_t index = bit >= 0 ? bit / 64 : -((63 - bit) / 64);
+    const int64_t shift = bit - (index * 64);
+    const int64_t wordsPerRow = static_cast<int64_t>(mWordsPerRow);
+    const uint64_t* words = mBits.data() + (row * mWordsPerRow);
+
+    const uint64_t low = (index >= 0 && index < wordsPerRow) ?
+            words[index] : 0;
+    if (shift == 0)
+    {
+        return low;
+    }
+
+    const uint64_t high = (index + 1 >= 0 && index + 1 < wordsPerRow) ?
+            words[index + 1] : 0;
+    return (low >> shift) | (high << (64 - shift));
+}
+}
@@ -38,8 +38,11 @@ namespace
 std::string getApplicationPath()
 {
     char buff[PATH_MAX];
-    ::readlink("/proc/self/exe", buff, sizeof(buff)-1);
-    std::string ret(buff);
+    const ssize_t length =
+            ::readlink("/proc/self/exe", buff, sizeof(buff)-1);
+
+    // readlink does not null terminate
+    std::string ret(buff, length > 0 ? length : 0);
     const size_t find = ret.find_last_of("/\\");
     return find != std::string::npos ? ret.substr(0, find + 1) : ret;
 }
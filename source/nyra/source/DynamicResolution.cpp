@@ -0,0 +1,107 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/DynamicResolution.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+// How much of each new frame time goes into the average
+const double SMOOTHING = 0.2;
+
+// Frames to measure at a new scale before changing it again
+const size_t SETTLE_FRAMES = 10;
+
+// The band around the target where the scale is left alone
+const double OVER_BUDGET = 1.05;
+const double UNDER_BUDGET = 0.8;
+}
+
+namespace nyra
+{
+const float DynamicResolution::STEP = 0.05f;
+
+//===========================================================================//
+DynamicResolution::DynamicResolution(double targetFrameTime,
+                                     float minScale,
+                                     float maxScale) :
+    mTargetFrameTime(targetFrameTime),
+    mMinScale(minScale),
+    mMaxScale(maxScale),
+    mScale(maxScale),
+    mAverage(0.0),
+    mNumSamples(0)
+{
+    if (minScale <= 0.0f || minScale > maxScale)
+    {
+        throw std::runtime_error("Invalid dynamic resolution scale range");
+    }
+}
+
+//===========================================================================//
+float DynamicResolution::update(double frameTime)
+{
+    mAverage = mNumSamples == 0 ?
+            frameTime : mAverage + ((frameTime - mAverage) * SMOOTHING);
+    if (++mNumSamples < SETTLE_FRAMES)
+    {
+        return mScale;
+    }
+
+    float scale = mScale;
+    if (mAverage > mTargetFrameTime * OVER_BUDGET)
+    {
+        // Round down so the new scale is at least as fast as needed
+        const float ideal = mScale * static_cast<float>(
+                std::sqrt(mTargetFrameTime / mAverage));
+        scale = std::floor((ideal / STEP) + 0.001f) * STEP;
+    }
+    else if (mAverage < mTargetFrameTime * UNDER_BUDGET)
+    {
+        scale = std::floor((mScale / STEP) + 1.5f) * STEP;
+    }
+
+    scale = clamp(scale);
+    if (scale != mScale)
+    {
+        setScale(scale);
+    }
+    return mScale;
+}
+
+//===========================================================================//
+void DynamicResolution::setScale(float scale)
+{
+    mScale = clamp(scale);
+    mAverage = 0.0;
+    mNumSamples = 0;
+}
+
+//===========================================================================//
+float DynamicResolution::clamp(float scale) const
+{
+    return std::min(std::max(scale, mMinScale), mMaxScale);
+}
+}
@@ -25,8 +25,41 @@
 
 namespace nyra
 {
+//===========================================================================//
+GraphicsInterface::GraphicsInterface() :
+    mBackendKey(nullptr),
+    mBackend(nullptr)
+{
+}
+
+//===========================================================================//
+GraphicsInterface::GraphicsInterface(const GraphicsInterface& other) :
+    mStats(other.mStats),
+    mBackendKey(nullptr),
+    mBackend(nullptr)
+{
+}
+
+//===========================================================================//
+GraphicsInterface& GraphicsInterface::operator=(
+        const GraphicsInterface& other)
+{
+    mStats = other.mStats;
+    return *this;
+}
+
 //===========================================================================//
 GraphicsInterface::~GraphicsInterface()
 {
 }
+
+//===========================================================================//
+void GraphicsInterface::setScissor(const RectI& /* area */)
+{
+}
+
+//===========================================================================//
+void GraphicsInterface::resetScissor()
+{
+}
 }
\ No newline at end of file
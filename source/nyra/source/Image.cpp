@@ -23,12 +23,14 @@
  */
 #include <nyra/Image.h>
 #include <exception>
+#include <string.h>
+#include <nyra/ImageWriter.h>
 #include <png.h>
 
 namespace nyra
 {
 //===========================================================================//
-Image::Image(const std::string& pathname) :
+Image::Image(const std::string& pathname, MemoryResource& resource) :
     mPixelSize(0)
 {
     FILE* filePtr = fopen(pathname.c_str(), "rb");
@@ -129,7 +131,7 @@ Image::Image(const std::string& pathname) :
     png_bytep* rowPtrs = static_cast<png_bytep*>(
             png_malloc(pngPtr, mSize.y * sizeof(png_bytep)));
 
-    mBuffer.reset(new uint8_t[mSize.product() * mPixelSize]);
+    allocate(resource);
 
     for (size_t ii = 0; ii < mSize.y; ++ii)
     {
@@ -137,91 +139,37 @@ Image::Image(const std::string& pathname) :
     }
 
     png_read_image(pngPtr, rowPtrs);
-    write("/home/clyde/lena.png");
+
+    png_free(pngPtr, rowPtrs);
+    png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+    fclose(filePtr);
 }
 
 //===========================================================================//
-void Image::write(const std::string& file) const
+Image::Image(const Vector2U& size,
+             size_t pixelSize,
+             MemoryResource& resource) :
+    mPixelSize(pixelSize),
+    mSize(size)
 {
-    FILE* filePtr = fopen(file.c_str(), "wb");
-    if (filePtr == NULL)
-    {
-        throw std::runtime_error("File not usable by PNG writer");
-    }
-
-    png_infop infoPtr;
-    png_structp  pngPtr = png_create_write_struct(
-            PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
-
-    if (pngPtr == NULL)
-    {
-        fclose(filePtr);
-        throw std::runtime_error("Create read struct failed");
-    }
-
-    infoPtr = png_create_info_struct(pngPtr);
-    if (infoPtr == NULL)
-    {
-        fclose(filePtr);
-        png_destroy_read_struct(&pngPtr, NULL, NULL);
-        throw std::runtime_error("Create create info struct failed");
-    }
-
-    if (setjmp(png_jmpbuf(pngPtr)))
-    {
-        png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
-        fclose(filePtr);
-        throw std::runtime_error("Read failed in image write.");
-    }
-
-    png_init_io(pngPtr, filePtr);
-    int colorType;
-    const size_t sampleDepth = (mPixelSize * 8) / mPixelSize;
-    switch (mPixelSize)
-    {
-    case 3:
-        colorType = PNG_COLOR_TYPE_RGB;
-        break;
-    case 4:
-        colorType = PNG_COLOR_TYPE_RGBA;
-        break;
-    default:
-        throw std::runtime_error("Only RGB and RGBA pngs are supported.");
-        break;
-    }
-
-    const int interlaceType = PNG_INTERLACE_NONE; //TODO default to None?
-
-    //set a bunch of parameters at once
-    png_set_IHDR(pngPtr,
-                 infoPtr,
-                 mSize.x,
-                 mSize.y,
-                 sampleDepth,
-                 colorType,
-                 interlaceType,
-                 PNG_COMPRESSION_TYPE_DEFAULT,
-                 PNG_FILTER_TYPE_DEFAULT);
-
-    // write it
-    png_write_info(pngPtr, infoPtr);
-
-    // let libpng take care of, e.g., bit-depth conversions
-    png_set_packing(pngPtr);
-
-    //get the data from the image
-    const size_t lineSize = mSize.x * mPixelSize;
-    for (size_t i = 0; i < mSize.y; i++)
-    {
-        // Read one row
-        png_write_row(pngPtr, (png_byte*) (mBuffer.get() + (i * lineSize)));
-    }
+    allocate(resource);
+    memset(mBuffer.get(), 0, mSize.product() * mPixelSize);
+}
 
-    png_write_end(pngPtr, infoPtr);
-    png_destroy_write_struct(&pngPtr, &infoPtr);
+//===========================================================================//
+void Image::allocate(MemoryResource& resource)
+{
+    const size_t bytes = mSize.product() * mPixelSize;
+    mBuffer = Buffer(static_cast<uint8_t*>(resource.allocate(bytes)),
+                     MemoryResource::Deleter(&resource, bytes));
+}
 
-    //clean up
-    fclose(filePtr);
+//===========================================================================//
+void Image::write(const std::string& pathname) const
+{
+    ImageWriter writer(pathname, mSize, mPixelSize);
+    writer.writeRows(mBuffer.get(), mSize.y);
+    writer.close();
 }
 
 //===========================================================================//
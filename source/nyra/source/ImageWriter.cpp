@@ -0,0 +1,180 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/ImageWriter.h>
+#include <stdexcept>
+#include <png.h>
+
+namespace nyra
+{
+//===========================================================================//
+ImageWriter::ImageWriter(const std::string& pathname,
+                         const Vector2U& size,
+                         size_t pixelSize) :
+    mSize(size),
+    mPixelSize(pixelSize),
+    mRowsWritten(0),
+    mFile(NULL),
+    mPngPtr(NULL),
+    mInfoPtr(NULL)
+{
+    int colorType;
+    switch (mPixelSize)
+    {
+    case 3:
+        colorType = PNG_COLOR_TYPE_RGB;
+        break;
+    case 4:
+        colorType = PNG_COLOR_TYPE_RGBA;
+        break;
+    default:
+        throw std::runtime_error("Only RGB and RGBA pngs are supported.");
+        break;
+    }
+
+    mFile = fopen(pathname.c_str(), "wb");
+    if (mFile == NULL)
+    {
+        throw std::runtime_error("File not usable by PNG writer");
+    }
+
+    mPngPtr = png_create_write_struct(
+            PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+    if (mPngPtr == NULL)
+    {
+        destroy();
+        throw std::runtime_error("Create write struct failed");
+    }
+
+    mInfoPtr = png_create_info_struct(mPngPtr);
+    if (mInfoPtr == NULL)
+    {
+        destroy();
+        throw std::runtime_error("Create create info struct failed");
+    }
+
+    if (setjmp(png_jmpbuf(mPngPtr)))
+    {
+        destroy();
+        throw std::runtime_error("Header write failed in image write.");
+    }
+
+    png_init_io(mPngPtr, mFile);
+    png_set_IHDR(mPngPtr,
+                 mInfoPtr,
+                 mSize.x,
+                 mSize.y,
+                 8,
+                 colorType,
+                 PNG_INTERLACE_NONE,
+                 PNG_COMPRESSION_TYPE_DEFAULT,
+                 PNG_FILTER_TYPE_DEFAULT);
+    png_write_info(mPngPtr, mInfoPtr);
+}
+
+//===========================================================================//
+ImageWriter::~ImageWriter()
+{
+    // Destructors cannot throw, so a failure here leaves a truncated file.
+    try
+    {
+        if (mPngPtr != NULL && mRowsWritten == mSize.y)
+        {
+            close();
+        }
+    }
+    catch (...)
+    {
+    }
+    destroy();
+}
+
+//===========================================================================//
+void ImageWriter::writeRows(const uint8_t* buffer, size_t numRows)
+{
+    if (mPngPtr == NULL)
+    {
+        throw std::runtime_error("Image writer is already closed");
+    }
+
+    if (mRowsWritten + numRows > mSize.y)
+    {
+        throw std::runtime_error("Too many rows written to image");
+    }
+
+    if (setjmp(png_jmpbuf(mPngPtr)))
+    {
+        destroy();
+        throw std::runtime_error("Row write failed in image write.");
+    }
+
+    const size_t lineSize = mSize.x * mPixelSize;
+    for (size_t ii = 0; ii < numRows; ++ii)
+    {
+        png_write_row(mPngPtr,
+                      const_cast<png_bytep>(buffer + (ii * lineSize)));
+    }
+    mRowsWritten += numRows;
+}
+
+//===========================================================================//
+void ImageWriter::close()
+{
+    if (mPngPtr == NULL)
+    {
+        return;
+    }
+
+    if (mRowsWritten != mSize.y)
+    {
+        destroy();
+        throw std::runtime_error("Image closed before all rows were written");
+    }
+
+    if (setjmp(png_jmpbuf(mPngPtr)))
+    {
+        destroy();
+        throw std::runtime_error("End write failed in image write.");
+    }
+
+    png_write_end(mPngPtr, mInfoPtr);
+    destroy();
+}
+
+//===========================================================================//
+void ImageWriter::destroy()
+{
+    if (mPngPtr != NULL)
+    {
+        png_destroy_write_struct(&mPngPtr, &mInfoPtr);
+        mPngPtr = NULL;
+        mInfoPtr = NULL;
+    }
+
+    if (mFile != NULL)
+    {
+        fclose(mFile);
+        mFile = NULL;
+    }
+}
+}
@@ -0,0 +1,510 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/Json.h>
+#include <cmath>
+#include <fstream>
+#include <locale>
+#include <sstream>
+#include <stdexcept>
+#include <stdint.h>
+#include <string.h>
+
+namespace nyra
+{
+/*
+ *  \class JsonParser
+ *  \brief Recursive descent parser that fills in JsonValue objects.
+ */
+class JsonParser
+{
+public:
+    JsonParser(const std::string& text) :
+        mText(text),
+        mPosition(0),
+        mDepth(0)
+    {
+    }
+
+    JsonValue parseDocument()
+    {
+        JsonValue value = parseValue();
+        skipWhitespace();
+        if (mPosition != mText.size())
+        {
+            error("Unexpected data after JSON document");
+        }
+        return value;
+    }
+
+private:
+    void error(const std::string& message) const
+    {
+        std::ostringstream stream;
+        stream << message << " at offset " << mPosition;
+        throw std::runtime_error(stream.str());
+    }
+
+    void skipWhitespace()
+    {
+        while (mPosition < mText.size() &&
+               strchr(" \t\r\n", mText[mPosition]))
+        {
+            ++mPosition;
+        }
+    }
+
+    char peek()
+    {
+        skipWhitespace();
+        if (mPosition >= mText.size())
+        {
+            error("Unexpected end of JSON");
+        }
+        return mText[mPosition];
+    }
+
+    void expect(char character)
+    {
+        if (peek() != character)
+        {
+            error(std::string("Expected '") + character + "'");
+        }
+        ++mPosition;
+    }
+
+    void enter()
+    {
+        // Nesting is parsed recursively, so bound it before the stack is
+        if (++mDepth > JsonValue::MAX_DEPTH)
+        {
+            error("JSON nesting is too deep");
+        }
+    }
+
+    bool consume(const char* word)
+    {
+        const size_t length = strlen(word);
+        if (mText.compare(mPosition, length, word) == 0)
+        {
+            mPosition += length;
+            return true;
+        }
+        return false;
+    }
+
+    JsonValue parseValue()
+    {
+        JsonValue value;
+        const char next = peek();
+        if (next == '{')
+        {
+            value.mType = JsonValue::Type::OBJECT;
+            enter();
+            parseObject(value);
+            --mDepth;
+        }
+        else if (next == '[')
+        {
+            value.mType = JsonValue::Type::ARRAY;
+            enter();
+            parseArray(value);
+            --mDepth;
+        }
+        else if (next == '"')
+        {
+            value.mType = JsonValue::Type::STRING;
+            value.mString = parseString();
+        }
+        else if (consume("true"))
+        {
+            value.mType = JsonValue::Type::BOOLEAN;
+            value.mBool = true;
+        }
+        else if (consume("false"))
+        {
+            value.mType = JsonValue::Type::BOOLEAN;
+            value.mBool = false;
+        }
+        else if (consume("null"))
+        {
+            value.mType = JsonValue::Type::NONE;
+        }
+        else
+        {
+            value.mType = JsonValue::Type::NUMBER;
+            value.mNumber = parseNumber();
+        }
+        return value;
+    }
+
+    void parseObject(JsonValue& value)
+    {
+        expect('{');
+        if (peek() == '}')
+        {
+            ++mPosition;
+            return;
+        }
+
+        while (true)
+        {
+            if (peek() != '"')
+            {
+                error("Expected a member name");
+            }
+            const std::string key = parseString();
+            expect(':');
+            value.mObject.push_back(std::make_pair(key, parseValue()));
+            if (peek() == '}')
+            {
+                ++mPosition;
+                return;
+            }
+            expect(',');
+        }
+    }
+
+    void parseArray(JsonValue& value)
+    {
+        expect('[');
+        if (peek() == ']')
+        {
+            ++mPosition;
+            return;
+        }
+
+        while (true)
+        {
+            value.mArray.push_back(parseValue());
+            if (peek() == ']')
+            {
+                ++mPosition;
+                return;
+            }
+            expect(',');
+        }
+    }
+
+    bool consumeDigits()
+    {
+        const size_t start = mPosition;
+        while (mPosition < mText.size() &&
+               mText[mPosition] >= '0' && mText[mPosition] <= '9')
+        {
+            ++mPosition;
+        }
+        return mPosition != start;
+    }
+
+    double parseNumber()
+    {
+        // Match the JSON grammar by hand, strtod also takes hex, nan,
+        // infinity and the decimal point of the current locale.
+        const size_t start = mPosition;
+        consume("-");
+        if (!consume("0") && !consumeDigits())
+        {
+            error("Invalid JSON value");
+        }
+        if (consume(".") && !consumeDigits())
+        {
+            error("Invalid JSON number");
+        }
+        if (consume("e") || consume("E"))
+        {
+            if (!consume("+"))
+            {
+                consume("-");
+            }
+            if (!consumeDigits())
+            {
+                error("Invalid JSON number");
+            }
+        }
+
+        std::istringstream stream(mText.substr(start, mPosition - start));
+        stream.imbue(std::locale::classic());
+        double number = 0.0;
+        stream >> number;
+        if (stream.fail() || !std::isfinite(number))
+        {
+            error("JSON number out of range");
+        }
+        return number;
+    }
+
+    uint32_t parseHex()
+    {
+        if (mPosition + 4 > mText.size())
+        {
+            error("Invalid unicode escape");
+        }
+        uint32_t code = 0;
+        for (size_t ii = 0; ii < 4; ++ii)
+        {
+            const char digit = mText[mPosition++];
+            code <<= 4;
+            if (digit >= '0' && digit <= '9')
+            {
+                code |= digit - '0';
+            }
+            else if (digit >= 'a' && digit <= 'f')
+            {
+                code |= digit - 'a' + 10;
+            }
+            else if (digit >= 'A' && digit <= 'F')
+            {
+                code |= digit - 'A' + 10;
+            }
+            else
+            {
+                error("Invalid unicode escape");
+            }
+        }
+        return code;
+    }
+
+    static void appendUTF8(uint32_t code, std::string& output)
+    {
+        if (code < 0x80)
+        {
+            output += static_cast<char>(code);
+        }
+        else if (code < 0x800)
+        {
+            output += static_cast<char>(0xC0 | (code >> 6));
+            output += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else if (code < 0x10000)
+        {
+            output += static_cast<char>(0xE0 | (code >> 12));
+            output += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            output += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else
+        {
+            output += static_cast<char>(0xF0 | (code >> 18));
+            output += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            output += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            output += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    std::string parseString()
+    {
+        expect('"');
+        std::string output;
+        while (true)
+        {
+            if (mPosition >= mText.size())
+            {
+                error("Unterminated string");
+            }
+
+            const char character = mText[mPosition++];
+            if (character == '"')
+            {
+                return output;
+            }
+            if (character != '\\')
+            {
+                output += character;
+                continue;
+            }
+
+            if (mPosition >= mText.size())
+            {
+                error("Unterminated string");
+            }
+            const char escape = mText[mPosition++];
+            switch (escape)
+            {
+            case '"':
+            case '\\':
+            case '/':
+                output += escape;
+                break;
+            case 'b':
+                output += '\b';
+                break;
+            case 'f':
+                output += '\f';
+                break;
+            case 'n':
+                output += '\n';
+                break;
+            case 'r':
+                output += '\r';
+                break;
+            case 't':
+                output += '\t';
+                break;
+            case 'u':
+            {
+                uint32_t code = parseHex();
+
+                // Characters outside the BMP come as surrogate pairs,
+                // either half on its own is not a character.
+                if (code >= 0xDC00 && code < 0xE000)
+                {
+                    error("Unpaired low surrogate");
+                }
+                if (code >= 0xD800 && code < 0xDC00)
+                {
+                    if (!consume("\\u"))
+                    {
+                        error("Unpaired high surrogate");
+                    }
+                    const uint32_t low = parseHex();
+                    if (low < 0xDC00 || low >= 0xE000)
+                    {
+                        error("Invalid low surrogate");
+                    }
+                    code = 0x10000 + ((code - 0xD800) << 10) +
+                            (low - 0xDC00);
+                }
+                appendUTF8(code, output);
+                break;
+            }
+            default:
+                error("Invalid escape in string");
+            }
+        }
+    }
+
+    const std::string& mText;
+    size_t mPosition;
+    size_t mDepth;
+};
+
+//===========================================================================//
+const size_t JsonValue::MAX_DEPTH;
+
+//===========================================================================//
+JsonValue::JsonValue() :
+    mType(Type::NONE),
+    mBool(false),
+    mNumber(0.0)
+{
+}
+
+//===========================================================================//
+JsonValue JsonValue::parse(const std::string& text)
+{
+    return JsonParser(text).parseDocument();
+}
+
+//===========================================================================//
+JsonValue JsonValue::load(const std::string& pathname)
+{
+    std::ifstream file(pathname.c_str(), std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Unable to open " + pathname);
+    }
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    return parse(stream.str());
+}
+
+//===========================================================================//
+bool JsonValue::asBool() const
+{
+    checkType(Type::BOOLEAN);
+    return mBool;
+}
+
+//===========================================================================//
+double JsonValue::asNumber() const
+{
+    checkType(Type::NUMBER);
+    return mNumber;
+}
+
+//===========================================================================//
+const std::string& JsonValue::asString() const
+{
+    checkType(Type::STRING);
+    return mString;
+}
+
+//===========================================================================//
+size_t JsonValue::size() const
+{
+    if (mType == Type::OBJECT)
+    {
+        return mObject.size();
+    }
+    checkType(Type::ARRAY);
+    return mArray.size();
+}
+
+//===========================================================================//
+const JsonValue& JsonValue::operator[](size_t index) const
+{
+    checkType(Type::ARRAY);
+    if (index >= mArray.size())
+    {
+        throw std::runtime_error("JSON array index out of bounds");
+    }
+    return mArray[index];
+}
+
+//===========================================================================//
+const JsonValue& JsonValue::operator[](const std::string& key) const
+{
+    checkType(Type::OBJECT);
+    for (size_t ii = 0; ii < mObject.size(); ++ii)
+    {
+        if (mObject[ii].first == key)
+        {
+            return mObject[ii].second;
+        }
+    }
+    throw std::runtime_error("JSON object has no member " + key);
+}
+
+//===========================================================================//
+bool JsonValue::has(const std::string& key) const
+{
+    checkType(Type::OBJECT);
+    for (size_t ii = 0; ii < mObject.size(); ++ii)
+    {
+        if (mObject[ii].first == key)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//===========================================================================//
+void JsonValue::checkType(Type type) const
+{
+    if (mType != type)
+    {
+        throw std::runtime_error("JSON value has the wrong type");
+    }
+}
+}
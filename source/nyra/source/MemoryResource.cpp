@@ -0,0 +1,86 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/MemoryResource.h>
+#include <new>
+#include <limits>
+#include <stdint.h>
+
+namespace
+{
+//===========================================================================//
+class HeapResource : public nyra::MemoryResource
+{
+public:
+    void* allocate(size_t bytes, size_t alignment) override
+    {
+        if (alignment <= alignof(std::max_align_t))
+        {
+            return ::operator new(bytes);
+        }
+
+        // Over-aligned requests get enough slack to align the start, with
+        // the pointer from operator new kept just in front of it.
+        const size_t slack = alignment + sizeof(void*);
+        if (bytes > std::numeric_limits<size_t>::max() - slack)
+        {
+            throw std::bad_alloc();
+        }
+        uint8_t* const raw = static_cast<uint8_t*>(
+                ::operator new(bytes + slack));
+        const uintptr_t start =
+                reinterpret_cast<uintptr_t>(raw) + sizeof(void*);
+        void** const aligned = reinterpret_cast<void**>(
+                (start + alignment - 1) & ~(uintptr_t(alignment) - 1));
+        aligned[-1] = raw;
+        return aligned;
+    }
+
+    void deallocate(void* ptr, size_t /* bytes */, size_t alignment) override
+    {
+        if (alignment <= alignof(std::max_align_t))
+        {
+            ::operator delete(ptr);
+        }
+        else
+        {
+            ::operator delete(static_cast<void**>(ptr)[-1]);
+        }
+    }
+};
+}
+
+namespace nyra
+{
+//===========================================================================//
+MemoryResource::~MemoryResource()
+{
+}
+
+//===========================================================================//
+MemoryResource& MemoryResource::getDefault()
+{
+    static HeapResource resource;
+    return resource;
+}
+}
@@ -0,0 +1,177 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/ParticleBuffer.h>
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace nyra
+{
+//===========================================================================//
+ParticleBuffer::ParticleBuffer(size_t capacity) :
+    mCapacity(capacity),
+    mSize(0),
+    mPositionX(capacity),
+    mPositionY(capacity),
+    mVelocityX(capacity),
+    mVelocityY(capacity),
+    mAge(capacity),
+    mLifetime(capacity),
+    mColor(capacity),
+    mFrame(capacity)
+{
+}
+
+//===========================================================================//
+bool ParticleBuffer::spawn(const Vector2F& position,
+                           const Vector2F& velocity,
+                           float lifetime,
+                           uint32_t color)
+{
+    if (mSize >= mCapacity)
+    {
+        return false;
+    }
+
+    mPositionX[mSize] = position.x;
+    mPositionY[mSize] = position.y;
+    mVelocityX[mSize] = velocity.x;
+    mVelocityY[mSize] = velocity.y;
+    mAge[mSize] = 0.0f;
+    mLifetime[mSize] = lifetime;
+    mColor[mSize] = color;
+    mFrame[mSize] = 0;
+    ++mSize;
+    return true;
+}
+
+//===========================================================================//
+void ParticleBuffer::update(float elapsed,
+                            const Vector2F& acceleration,
+                            uint32_t numFrames)
+{
+    numFrames = std::max<uint32_t>(numFrames, 1);
+    size_t ii = 0;
+    bool anyDead = false;
+#ifdef __SSE2__
+    const __m128 dt = _mm_set1_ps(elapsed);
+    const __m128 ax = _mm_set1_ps(acceleration.x * elapsed);
+    const __m128 ay = _mm_set1_ps(acceleration.y * elapsed);
+    const __m128 frames = _mm_set1_ps(static_cast<float>(numFrames));
+    const __m128 lastFrame = _mm_set1_ps(static_cast<float>(numFrames - 1));
+    for (; ii + 4 <= mSize; ii += 4)
+    {
+        const __m128 vx = _mm_add_ps(_mm_loadu_ps(&mVelocityX[ii]), ax);
+        const __m128 vy = _mm_add_ps(_mm_loadu_ps(&mVelocityY[ii]), ay);
+        _mm_storeu_ps(&mVelocityX[ii], vx);
+        _mm_storeu_ps(&mVelocityY[ii], vy);
+        _mm_storeu_ps(&mPositionX[ii], _mm_add_ps(
+                _mm_loadu_ps(&mPositionX[ii]), _mm_mul_ps(vx, dt)));
+        _mm_storeu_ps(&mPositionY[ii], _mm_add_ps(
+                _mm_loadu_ps(&mPositionY[ii]), _mm_mul_ps(vy, dt)));
+
+        const __m128 age = _mm_add_ps(_mm_loadu_ps(&mAge[ii]), dt);
+        const __m128 lifetime = _mm_loadu_ps(&mLifetime[ii]);
+        _mm_storeu_ps(&mAge[ii], age);
+
+        const __m128 frame = _mm_min_ps(
+                _mm_mul_ps(_mm_div_ps(age, lifetime), frames), lastFrame);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&mFrame[ii]),
+                         _mm_cvttps_epi32(frame));
+
+        // Only scan for dead particles if at least one died
+        anyDead |= _mm_movemask_ps(_mm_cmpge_ps(age, lifetime)) != 0;
+    }
+#endif
+
+    // Whatever is left over when the count is not a multiple of four
+    for (size_t jj = ii; jj < mSize; ++jj)
+    {
+        integrate(jj, elapsed, acceleration, numFrames);
+        anyDead |= mAge[jj] >= mLifetime[jj];
+    }
+
+    if (anyDead)
+    {
+        compact();
+    }
+}
+
+//===========================================================================//
+void ParticleBuffer::updateReference(float elapsed,
+                                     const Vector2F& acceleration,
+                                     uint32_t numFrames)
+{
+    numFrames = std::max<uint32_t>(numFrames, 1);
+    for (size_t ii = 0; ii < mSize; ++ii)
+    {
+        integrate(ii, elapsed, acceleration, numFrames);
+    }
+    compact();
+}
+
+//===========================================================================//
+void ParticleBuffer::integrate(size_t index,
+                               float elapsed,
+                               const Vector2F& acceleration,
+                               uint32_t numFrames)
+{
+    // Keep the operations in the same order as the SIMD version
+    mVelocityX[index] += acceleration.x * elapsed;
+    mVelocityY[index] += acceleration.y * elapsed;
+    mPositionX[index] += mVelocityX[index] * elapsed;
+    mPositionY[index] += mVelocityY[index] * elapsed;
+    mAge[index] += elapsed;
+    mFrame[index] = static_cast<int32_t>(std::min(
+            (mAge[index] / mLifetime[index]) * numFrames,
+            static_cast<float>(numFrames - 1)));
+}
+
+//===========================================================================//
+void ParticleBuffer::compact()
+{
+    size_t ii = 0;
+    while (ii < mSize)
+    {
+        if (mAge[ii] < mLifetime[ii])
+        {
+            ++ii;
+            continue;
+        }
+
+        // Move the last particle into the hole and check it next
+        --mSize;
+        mPositionX[ii] = mPositionX[mSize];
+        mPositionY[ii] = mPositionY[mSize];
+        mVelocityX[ii] = mVelocityX[mSize];
+        mVelocityY[ii] = mVelocityY[mSize];
+        mAge[ii] = mAge[mSize];
+        mLifetime[ii] = mLifetime[mSize];
+        mColor[ii] = mColor[mSize];
+        mFrame[ii] = mFrame[mSize];
+    }
+}
+}
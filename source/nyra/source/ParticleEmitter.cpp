@@ -0,0 +1,95 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/ParticleEmitter.h>
+#include <cmath>
+#include <nyra/Constants.h>
+
+namespace nyra
+{
+//===========================================================================//
+ParticleEmitter::Settings::Settings() :
+    capacity(1000),
+    rate(100.0f),
+    minLifetime(1.0f),
+    maxLifetime(1.0f),
+    minSpeed(50.0f),
+    maxSpeed(100.0f),
+    direction(0.0f),
+    spread(360.0f),
+    color(0xFFFFFFFF),
+    numFrames(1)
+{
+}
+
+//===========================================================================//
+ParticleEmitter::ParticleEmitter(const Settings& settings, uint32_t seed) :
+    mSettings(settings),
+    mParticles(settings.capacity),
+    mSpawnRemainder(0.0f),
+    mRandom(seed)
+{
+}
+
+//===========================================================================//
+void ParticleEmitter::update(float elapsed)
+{
+    mParticles.update(elapsed, mSettings.acceleration, mSettings.numFrames);
+
+    // Carry the fraction over so low rates still spawn at the right pace
+    mSpawnRemainder += mSettings.rate * elapsed;
+    const size_t count = static_cast<size_t>(mSpawnRemainder);
+    mSpawnRemainder -= count;
+    emit(count);
+}
+
+//===========================================================================//
+void ParticleEmitter::emit(size_t count)
+{
+    const float halfSpread = mSettings.spread * 0.5f;
+    for (size_t ii = 0; ii < count; ++ii)
+    {
+        const float angle = random(mSettings.direction - halfSpread,
+                                   mSettings.direction + halfSpread) *
+                Constants::DEGREES_TO_RADIANS;
+        const float speed = random(mSettings.minSpeed, mSettings.maxSpeed);
+        const Vector2F velocity(std::cos(angle) * speed,
+                                std::sin(angle) * speed);
+        if (!mParticles.spawn(mPosition,
+                              velocity,
+                              random(mSettings.minLifetime,
+                                     mSettings.maxLifetime),
+                              mSettings.color))
+        {
+            break;
+        }
+    }
+}
+
+//===========================================================================//
+float ParticleEmitter::random(float min, float max)
+{
+    // Avoids the distribution objects which differ between libraries
+    return min + (max - min) * (mRandom() / 4294967295.0f);
+}
+}
@@ -0,0 +1,102 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/Pathname.h>
+#include <vector>
+
+#ifdef __linux__
+#include <limits.h>
+#include <stdlib.h>
+#endif
+
+namespace nyra
+{
+//===========================================================================//
+std::string normalizePathname(const std::string& pathname)
+{
+#ifdef __linux__
+    char buff[PATH_MAX];
+    if (::realpath(pathname.c_str(), buff))
+    {
+        return std::string(buff);
+    }
+#endif
+    return lexicallyNormalPathname(pathname);
+}
+
+//===========================================================================//
+std::string lexicallyNormalPathname(const std::string& pathname)
+{
+    std::string path(pathname);
+#ifdef _WIN32
+    for (size_t ii = 0; ii < path.size(); ++ii)
+    {
+        if (path[ii] == '\\')
+        {
+            path[ii] = '/';
+        }
+    }
+#endif
+
+    const bool absolute = !path.empty() && path[0] == '/';
+    std::vector<std::string> parts;
+    size_t start = 0;
+    while (start <= path.size())
+    {
+        size_t end = path.find('/', start);
+        if (end == std::string::npos)
+        {
+            end = path.size();
+        }
+
+        const std::string part = path.substr(start, end - start);
+        if (part == "..")
+        {
+            if (!parts.empty() && parts.back() != "..")
+            {
+                parts.pop_back();
+            }
+            else if (!absolute)
+            {
+                parts.push_back(part);
+            }
+        }
+        else if (!part.empty() && part != ".")
+        {
+            parts.push_back(part);
+        }
+        start = end + 1;
+    }
+
+    std::string normal(absolute ? "/" : "");
+    for (size_t ii = 0; ii < parts.size(); ++ii)
+    {
+        if (ii > 0)
+        {
+            normal += '/';
+        }
+        normal += parts[ii];
+    }
+    return normal.empty() ? std::string(".") : normal;
+}
+}
@@ -0,0 +1,301 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/QuadTree.h>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+//===========================================================================//
+size_t getTotalCells(size_t maxDepth)
+{
+    size_t total = 0;
+    for (size_t level = 0; level <= maxDepth; ++level)
+    {
+        total += static_cast<size_t>(1) << (level * 2);
+    }
+    return total;
+}
+}
+
+namespace nyra
+{
+//===========================================================================//
+QuadTree::QuadTree(const RectF& world, size_t maxDepth) :
+    mWorld(world),
+    mMaxDepth(maxDepth),
+    mOutsideCell(getTotalCells(maxDepth)),
+    mCells(mOutsideCell + 1),
+    mCounts(mOutsideCell + 1, 0),
+    mNumItems(0)
+{
+    if (mWorld.isEmpty())
+    {
+        throw std::runtime_error("Quadtree world must have an area");
+    }
+
+    size_t offset = 0;
+    for (size_t level = 0; level <= mMaxDepth; ++level)
+    {
+        mLevelOffsets.push_back(offset);
+        offset += static_cast<size_t>(1) << (level * 2);
+    }
+}
+
+//===========================================================================//
+void QuadTree::insert(size_t id, const RectF& bounds)
+{
+    if (id >= mItems.size())
+    {
+        Item empty;
+        empty.cell = 0;
+        empty.slot = 0;
+        empty.used = false;
+        mItems.resize(id + 1, empty);
+    }
+
+    Item& item = mItems[id];
+    if (item.used)
+    {
+        throw std::runtime_error("Quadtree id is already in use");
+    }
+    item.bounds = bounds;
+    item.used = true;
+    link(id, findCell(bounds));
+    ++mNumItems;
+}
+
+//===========================================================================//
+void QuadTree::update(size_t id, const RectF& bounds)
+{
+    Item& item = mItems.at(id);
+    item.bounds = bounds;
+    const size_t cell = findCell(bounds);
+    if (cell != item.cell)
+    {
+        unlink(id);
+        link(id, cell);
+    }
+}
+
+//===========================================================================//
+void QuadTree::remove(size_t id)
+{
+    if (id >= mItems.size() || !mItems[id].used)
+    {
+        throw std::runtime_error("Quadtree id is not in use");
+    }
+    unlink(id);
+    mItems[id].used = false;
+    --mNumItems;
+}
+
+//===========================================================================//
+void QuadTree::query(const RectF& area, std::vector<size_t>& results) const
+{
+    results.clear();
+    queryItems(mOutsideCell, &area, 1, results);
+    queryCell(0, 0, 0, &area, 1, results);
+}
+
+//===========================================================================//
+void QuadTree::query(const std::vector<RectF>& areas,
+                     std::vector<size_t>& results) const
+{
+    results.clear();
+    if (areas.empty())
+    {
+        return;
+    }
+    queryItems(mOutsideCell, areas.data(), areas.size(), results);
+    queryCell(0, 0, 0, areas.data(), areas.size(), results);
+}
+
+//===========================================================================//
+size_t QuadTree::findCell(const RectF& bounds) const
+{
+    const Vector2F worldSize = mWorld.getSize();
+    const Vector2F center = bounds.getCenter();
+    const float u = (center.x - mWorld.min.x) / worldSize.x;
+    const float v = (center.y - mWorld.min.y) / worldSize.y;
+    const Vector2F size = bounds.getSize();
+    const float extent = std::max(size.x / worldSize.x,
+                                  size.y / worldSize.y);
+
+    // Items larger than the world do not fit in the loose bounds of the
+    // root, so they are always tested.
+    if (!(u >= 0.0f && u < 1.0f && v >= 0.0f && v < 1.0f) ||
+        !(extent <= 1.0f))
+    {
+        return mOutsideCell;
+    }
+
+    // Go as deep as possible while the item still fits in a cell
+    size_t level = 0;
+    float cellSize = 0.5f;
+    while (level < mMaxDepth && extent <= cellSize)
+    {
+        ++level;
+        cellSize *= 0.5f;
+    }
+
+    const size_t cellsPerSide = static_cast<size_t>(1) << level;
+    const size_t x = std::min(static_cast<size_t>(u * cellsPerSide),
+                              cellsPerSide - 1);
+    const size_t y = std::min(static_cast<size_t>(v * cellsPerSide),
+                              cellsPerSide - 1);
+    return getCellIndex(level, x, y);
+}
+
+//===========================================================================//
+void QuadTree::link(size_t id, size_t cell)
+{
+    Item& item = mItems[id];
+    item.cell = cell;
+    item.slot = mCells[cell].size();
+    mCells[cell].push_back(id);
+    updateCounts(cell, true);
+}
+
+//===========================================================================//
+void QuadTree::unlink(size_t id)
+{
+    const Item& item = mItems[id];
+    const size_t cell = item.cell;
+
+    // Swap the last item into the hole so removal is constant time
+    std::vector<size_t>& ids = mCells[cell];
+    ids[item.slot] = ids.back();
+    mItems[ids.back()].slot = item.slot;
+    ids.pop_back();
+    updateCounts(cell, false);
+}
+
+//===========================================================================//
+void QuadTree::updateCounts(size_t cell, bool added)
+{
+    if (cell == mOutsideCell)
+    {
+        mCounts[cell] = mCells[cell].size();
+        return;
+    }
+
+    size_t level = 0;
+    while (level < mMaxDepth && cell >= mLevelOffsets[level + 1])
+    {
+        ++level;
+    }
+    const size_t index = cell - mLevelOffsets[level];
+    size_t x = index & ((static_cast<size_t>(1) << level) - 1);
+    size_t y = index >> level;
+
+    // Walk back up to the root since every parent counts its children
+    while (true)
+    {
+        size_t& count = mCounts[getCellIndex(level, x, y)];
+        count = added ? count + 1 : count - 1;
+        if (level == 0)
+        {
+            break;
+        }
+        --level;
+        x >>= 1;
+        y >>= 1;
+    }
+}
+
+//===========================================================================//
+void QuadTree::queryCell(size_t level,
+                         size_t x,
+                         size_t y,
+                         const RectF* areas,
+                         size_t numAreas,
+                         std::vector<size_t>& results) const
+{
+    const size_t cell = getCellIndex(level, x, y);
+    if (mCounts[cell] == 0)
+    {
+        return;
+    }
+
+    // Loose bounds extend half a cell past each edge
+    const Vector2F worldSize = mWorld.getSize();
+    const float scale = 1.0f / (static_cast<size_t>(1) << level);
+    const float width = worldSize.x * scale;
+    const float height = worldSize.y * scale;
+    const RectF loose(Vector2F(mWorld.min.x + (x - 0.5f) * width,
+                               mWorld.min.y + (y - 0.5f) * height),
+                      Vector2F(mWorld.min.x + (x + 1.5f) * width,
+                               mWorld.min.y + (y + 1.5f) * height));
+    if (!intersectsAny(loose, areas, numAreas))
+    {
+        return;
+    }
+
+    queryItems(cell, areas, numAreas, results);
+    if (level < mMaxDepth)
+    {
+        for (size_t ii = 0; ii < 4; ++ii)
+        {
+            queryCell(level + 1,
+                      (x << 1) + (ii & 1),
+                      (y << 1) + (ii >> 1),
+                      areas,
+                      numAreas,
+                      results);
+        }
+    }
+}
+
+//===========================================================================//
+void QuadTree::queryItems(size_t cell,
+                          const RectF* areas,
+                          size_t numAreas,
+                          std::vector<size_t>& results) const
+{
+    const std::vector<size_t>& ids = mCells[cell];
+    for (size_t ii = 0; ii < ids.size(); ++ii)
+    {
+        if (intersectsAny(mItems[ids[ii]].bounds, areas, numAreas))
+        {
+            results.push_back(ids[ii]);
+        }
+    }
+}
+
+//===========================================================================//
+bool QuadTree::intersectsAny(const RectF& bounds,
+                             const RectF* areas,
+                             size_t numAreas)
+{
+    for (size_t ii = 0; ii < numAreas; ++ii)
+    {
+        if (bounds.intersects(areas[ii]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+}
@@ -0,0 +1,209 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/RenderQueue.h>
+
+namespace
+{
+const size_t LAYER_SHIFT = 56;
+const size_t DEPTH_SHIFT = 40;
+const size_t TEXTURE_SHIFT = 8;
+
+// Texture and blend mode are the bits that cause a state change
+const uint64_t STATE_MASK = (static_cast<uint64_t>(1) << DEPTH_SHIFT) - 1;
+const size_t RADIX_BITS = 8;
+const size_t RADIX_SIZE = 1 << RADIX_BITS;
+const size_t NUM_PASSES = 64 / RADIX_BITS;
+}
+
+namespace nyra
+{
+//===========================================================================//
+RenderQueue::RenderQueue() :
+    mNumCommands(0),
+    mStateChangesBefore(0),
+    mStateChangesAfter(0)
+{
+}
+
+//===========================================================================//
+uint64_t RenderQueue::makeKey(uint8_t layer,
+                              uint16_t depth,
+                              uint32_t texture,
+                              BlendMode blend)
+{
+    return (static_cast<uint64_t>(layer) << LAYER_SHIFT) |
+           (static_cast<uint64_t>(depth) << DEPTH_SHIFT) |
+           (static_cast<uint64_t>(texture) << TEXTURE_SHIFT) |
+           static_cast<uint64_t>(blend);
+}
+
+//===========================================================================//
+void RenderQueue::push(RenderableInterface& renderable,
+                       const Matrix& matrix,
+                       uint64_t key)
+{
+    SortItem item;
+    item.key = key;
+    item.index = static_cast<uint32_t>(mCommands.size());
+    mItems.push_back(item);
+
+    Command command;
+    command.renderable = &renderable;
+    command.matrix = matrix;
+    mCommands.push_back(command);
+}
+
+//===========================================================================//
+void RenderQueue::append(const RenderCommandList& list)
+{
+    for (size_t ii = 0; ii < list.size(); ++ii)
+    {
+        push(*list[ii].renderable, list[ii].matrix, list[ii].key);
+    }
+}
+
+//===========================================================================//
+void RenderQueue::flush(GraphicsInterface& graphics)
+{
+    prepare();
+    for (size_t ii = 0; ii < mItems.size(); ++ii)
+    {
+        const Command& command = mCommands[mItems[ii].index];
+        command.renderable->render(command.matrix, graphics);
+    }
+
+    // Keep the capacity around for the next frame
+    mCommands.clear();
+    mItems.clear();
+}
+
+//===========================================================================//
+void RenderQueue::flush(GraphicsInterface& graphics,
+                        const std::vector<Camera>& cameras,
+                        const Vector2U& targetSize)
+{
+    prepare();
+
+    // Bounds are found once and shared by every view
+    mBounds.resize(mCommands.size());
+    for (size_t ii = 0; ii < mCommands.size(); ++ii)
+    {
+        const Command& command = mCommands[ii];
+        mBounds[ii] = transformBounds(
+                command.matrix, Vector2F(command.renderable->getSize()));
+    }
+
+    for (size_t ii = 0; ii < cameras.size(); ++ii)
+    {
+        const Matrix view = cameras[ii].getMatrix(targetSize);
+        const RectF area = cameras[ii].getVisibleArea(targetSize);
+        graphics.setScissor(cameras[ii].getViewportPixels(targetSize));
+        for (size_t jj = 0; jj < mItems.size(); ++jj)
+        {
+            const uint32_t index = mItems[jj].index;
+            if (mBounds[index].intersects(area))
+            {
+                const Command& command = mCommands[index];
+                command.renderable->render(view * command.matrix, graphics);
+            }
+        }
+    }
+    graphics.resetScissor();
+
+    mCommands.clear();
+    mItems.clear();
+}
+
+//===========================================================================//
+void RenderQueue::prepare()
+{
+    mNumCommands = mCommands.size();
+    mStateChangesBefore = countStateChanges(mItems);
+    sort();
+    mStateChangesAfter = countStateChanges(mItems);
+}
+
+//===========================================================================//
+void RenderQueue::sort()
+{
+    // Build every histogram in a single pass over the keys
+    std::vector<size_t> counts(NUM_PASSES * RADIX_SIZE, 0);
+    for (size_t ii = 0; ii < mItems.size(); ++ii)
+    {
+        const uint64_t key = mItems[ii].key;
+        for (size_t pass = 0; pass < NUM_PASSES; ++pass)
+        {
+            ++counts[pass * RADIX_SIZE +
+                     ((key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1))];
+        }
+    }
+
+    mScratch.resize(mItems.size());
+    for (size_t pass = 0; pass < NUM_PASSES; ++pass)
+    {
+        size_t* count = &counts[pass * RADIX_SIZE];
+        const size_t shift = pass * RADIX_BITS;
+
+        // Most keys share their upper bytes, so skip passes where every
+        // key lands in the same bucket.
+        if (mItems.empty() ||
+            count[(mItems[0].key >> shift) & (RADIX_SIZE - 1)] ==
+                    mItems.size())
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t ii = 0; ii < RADIX_SIZE; ++ii)
+        {
+            const size_t bucketSize = count[ii];
+            count[ii] = offset;
+            offset += bucketSize;
+        }
+
+        // Items are scattered in order so each pass is stable
+        for (size_t ii = 0; ii < mItems.size(); ++ii)
+        {
+            const size_t bucket = (mItems[ii].key >> shift) & (RADIX_SIZE - 1);
+            mScratch[count[bucket]++] = mItems[ii];
+        }
+        mItems.swap(mScratch);
+    }
+}
+
+//===========================================================================//
+size_t RenderQueue::countStateChanges(const std::vector<SortItem>& items)
+{
+    size_t changes = 0;
+    for (size_t ii = 0; ii < items.size(); ++ii)
+    {
+        if (ii == 0 ||
+            (items[ii].key & STATE_MASK) != (items[ii - 1].key & STATE_MASK))
+        {
+            ++changes;
+        }
+    }
+    return changes;
+}
+}
@@ -0,0 +1,228 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/RenderStats.h>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+//===========================================================================//
+bool endsWith(const std::string& str, const std::string& suffix)
+{
+    return str.size() >= suffix.size() &&
+           str.compare(str.size() - suffix.size(), suffix.size(),
+                       suffix) == 0;
+}
+}
+
+namespace nyra
+{
+//===========================================================================//
+RenderStats::RenderStats(size_t historySize) :
+    mHistorySize(std::max<size_t>(historySize, 1)),
+    mNext(0),
+    mHasPresented(false)
+{
+    mHistory.reserve(mHistorySize);
+    reset();
+    mCurrent.frame = 0;
+}
+
+//===========================================================================//
+void RenderStats::endPresent()
+{
+    const Clock::time_point now = Clock::now();
+    mCurrent.presentTime += milliseconds(mPresentStart, now);
+    mCurrent.frameTime = mHasPresented ?
+            milliseconds(mLastPresent, now) : 0.0;
+    mLastPresent = now;
+    mHasPresented = true;
+
+    if (mHistory.size() < mHistorySize)
+    {
+        mHistory.push_back(mCurrent);
+    }
+    else
+    {
+        mHistory[mNext] = mCurrent;
+        mNext = (mNext + 1) % mHistorySize;
+    }
+
+    const uint64_t frame = mCurrent.frame;
+    reset();
+    mCurrent.frame = frame + 1;
+}
+
+//===========================================================================//
+const FrameStats& RenderStats::getLast() const
+{
+    if (mHistory.empty())
+    {
+        throw std::runtime_error("No frames have been rendered");
+    }
+    return getFrame(mHistory.size() - 1);
+}
+
+//===========================================================================//
+FrameStats RenderStats::getAverage() const
+{
+    FrameStats average = {};
+    if (mHistory.empty())
+    {
+        return average;
+    }
+
+    double drawCalls = 0.0;
+    double vertices = 0.0;
+    double textureSwitches = 0.0;
+    double stateChanges = 0.0;
+    double offscreenPasses = 0.0;
+    for (size_t ii = 0; ii < mHistory.size(); ++ii)
+    {
+        const FrameStats& frame = mHistory[ii];
+        drawCalls += frame.drawCalls;
+        vertices += frame.vertices;
+        textureSwitches += frame.textureSwitches;
+        stateChanges += frame.stateChanges;
+        offscreenPasses += frame.offscreenPasses;
+        average.clearTime += frame.clearTime;
+        average.presentTime += frame.presentTime;
+        average.frameTime += frame.frameTime;
+    }
+
+    const double count = static_cast<double>(mHistory.size());
+    average.frame = getLast().frame;
+    average.drawCalls = static_cast<uint32_t>(drawCalls / count + 0.5);
+    average.vertices = static_cast<uint64_t>(vertices / count + 0.5);
+    average.textureSwitches =
+            static_cast<uint32_t>(textureSwitches / count + 0.5);
+    average.stateChanges = static_cast<uint32_t>(stateChanges / count + 0.5);
+    average.offscreenPasses =
+            static_cast<uint32_t>(offscreenPasses / count + 0.5);
+    average.clearTime /= count;
+    average.presentTime /= count;
+    average.frameTime /= count;
+    return average;
+}
+
+//===========================================================================//
+void RenderStats::clear()
+{
+    mHistory.clear();
+    mNext = 0;
+    mHasPresented = false;
+    reset();
+    mCurrent.frame = 0;
+}
+
+//===========================================================================//
+void RenderStats::writeCSV(std::ostream& stream) const
+{
+    stream << "frame,draw_calls,vertices,texture_switches,state_changes,"
+           << "offscreen_passes,clear_ms,present_ms,frame_ms\n";
+    for (size_t ii = 0; ii < mHistory.size(); ++ii)
+    {
+        const FrameStats& frame = getFrame(ii);
+        stream << frame.frame << ","
+               << frame.drawCalls << ","
+               << frame.vertices << ","
+               << frame.textureSwitches << ","
+               << frame.stateChanges << ","
+               << frame.offscreenPasses << ","
+               << frame.clearTime << ","
+               << frame.presentTime << ","
+               << frame.frameTime << "\n";
+    }
+}
+
+//===========================================================================//
+void RenderStats::writeJSON(std::ostream& stream) const
+{
+    stream << "[";
+    for (size_t ii = 0; ii < mHistory.size(); ++ii)
+    {
+        const FrameStats& frame = getFrame(ii);
+        stream << (ii == 0 ? "\n" : ",\n")
+               << "  {\"frame\": " << frame.frame
+               << ", \"draw_calls\": " << frame.drawCalls
+               << ", \"vertices\": " << frame.vertices
+               << ", \"texture_switches\": " << frame.textureSwitches
+               << ", \"state_changes\": " << frame.stateChanges
+               << ", \"offscreen_passes\": " << frame.offscreenPasses
+               << ", \"clear_ms\": " << frame.clearTime
+               << ", \"present_ms\": " << frame.presentTime
+               << ", \"frame_ms\": " << frame.frameTime << "}";
+    }
+    stream << "\n]\n";
+}
+
+//===========================================================================//
+void RenderStats::save(const std::string& pathname) const
+{
+    const bool json = endsWith(pathname, ".json");
+    if (!json && !endsWith(pathname, ".csv"))
+    {
+        throw std::runtime_error("Render stats must be saved as .csv or "
+                                 ".json: " + pathname);
+    }
+
+    std::ofstream file(pathname.c_str());
+    if (!file)
+    {
+        throw std::runtime_error("Unable to open " + pathname);
+    }
+
+    if (json)
+    {
+        writeJSON(file);
+    }
+    else
+    {
+        writeCSV(file);
+    }
+}
+
+//===========================================================================//
+double RenderStats::milliseconds(const Clock::time_point& start,
+                                 const Clock::time_point& end)
+{
+    const std::chrono::duration<double, std::milli> elapsed = end - start;
+    return elapsed.count();
+}
+
+//===========================================================================//
+void RenderStats::reset()
+{
+    mCurrent.drawCalls = 0;
+    mCurrent.vertices = 0;
+    mCurrent.textureSwitches = 0;
+    mCurrent.stateChanges = 0;
+    mCurrent.offscreenPasses = 0;
+    mCurrent.clearTime = 0.0;
+    mCurrent.presentTime = 0.0;
+    mCurrent.frameTime = 0.0;
+    mLastTexture = nullptr;
+}
+}
@@ -0,0 +1,182 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/Scene.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace nyra
+{
+//===========================================================================//
+Scene::Scene(const RectF& world, size_t maxDepth) :
+    mTree(world, maxDepth),
+    mNumCulled(0),
+    mNumUpdated(0)
+{
+}
+
+//===========================================================================//
+size_t Scene::add(RenderableInterface& renderable,
+                  Transform& transform,
+                  uint64_t key)
+{
+    size_t id = mObjects.size();
+    if (mFreeIds.empty())
+    {
+        mObjects.push_back(Object());
+    }
+    else
+    {
+        id = mFreeIds.back();
+        mFreeIds.pop_back();
+    }
+
+    Object& object = mObjects[id];
+    object.renderable = &renderable;
+    object.transform = &transform;
+    object.key = key;
+    object.moved = false;
+    object.bounds = computeBounds(object);
+    mTree.insert(id, object.bounds);
+    mDamage.merge(object.bounds);
+    return id;
+}
+
+//===========================================================================//
+void Scene::remove(size_t id)
+{
+    mTree.remove(id);
+    mDamage.merge(mObjects[id].bounds);
+    mObjects[id].renderable = nullptr;
+    mObjects[id].transform = nullptr;
+    mObjects[id].moved = false;
+    mFreeIds.push_back(id);
+}
+
+//===========================================================================//
+void Scene::update()
+{
+    // Objects removed after being marked are no longer flagged
+    mNumUpdated = 0;
+    for (size_t ii = 0; ii < mMoved.size(); ++ii)
+    {
+        Object& object = mObjects[mMoved[ii]];
+        if (object.moved)
+        {
+            object.moved = false;
+            refresh(mMoved[ii]);
+            ++mNumUpdated;
+        }
+    }
+    mMoved.clear();
+}
+
+//===========================================================================//
+void Scene::invalidate(size_t id)
+{
+    // The new look may also have a new size
+    refresh(id);
+}
+
+//===========================================================================//
+void Scene::refresh(size_t id)
+{
+    // Both where it was and where it is now need to be redrawn
+    Object& object = mObjects[id];
+    mDamage.merge(object.bounds);
+    object.bounds = computeBounds(object);
+    mDamage.merge(object.bounds);
+    mTree.update(id, object.bounds);
+}
+
+//===========================================================================//
+const std::vector<size_t>& Scene::cull(const RectF& view)
+{
+    update();
+    mTree.query(view, mVisible);
+    std::sort(mVisible.begin(), mVisible.end());
+    mNumCulled = mTree.size() - mVisible.size();
+    return mVisible;
+}
+
+//===========================================================================//
+void Scene::render(const RectF& view, GraphicsInterface& graphics)
+{
+    cull(view);
+    for (size_t ii = 0; ii < mVisible.size(); ++ii)
+    {
+        const Object& object = mObjects[mVisible[ii]];
+        object.renderable->render(object.transform->getMatrix(), graphics);
+    }
+}
+
+//===========================================================================//
+const std::vector<size_t>& Scene::cull(const std::vector<Camera>& cameras,
+                                       const Vector2U& targetSize)
+{
+    mViewAreas.resize(cameras.size());
+    for (size_t ii = 0; ii < cameras.size(); ++ii)
+    {
+        mViewAreas[ii] = cameras[ii].getVisibleArea(targetSize);
+    }
+
+    // Views far apart, like a minimap, would pull in everything between
+    // them with a single merged area.
+    update();
+    mTree.query(mViewAreas, mVisible);
+    std::sort(mVisible.begin(), mVisible.end());
+    mNumCulled = mTree.size() - mVisible.size();
+    return mVisible;
+}
+
+//===========================================================================//
+void Scene::render(const std::vector<Camera>& cameras,
+                   const Vector2U& targetSize,
+                   GraphicsInterface& graphics)
+{
+    cull(cameras, targetSize);
+    for (size_t ii = 0; ii < cameras.size(); ++ii)
+    {
+        const Matrix view = cameras[ii].getMatrix(targetSize);
+        const RectF& area = mViewAreas[ii];
+        graphics.setScissor(cameras[ii].getViewportPixels(targetSize));
+        for (size_t jj = 0; jj < mVisible.size(); ++jj)
+        {
+            Object& object = mObjects[mVisible[jj]];
+            if (object.bounds.intersects(area))
+            {
+                object.renderable->render(
+                        view * object.transform->getMatrix(), graphics);
+            }
+        }
+    }
+    graphics.resetScissor();
+}
+
+//===========================================================================//
+RectF Scene::computeBounds(const Object& object) const
+{
+    return transformBounds(object.transform->getMatrix(),
+                           Vector2F(object.renderable->getSize()));
+}
+}
@@ -0,0 +1,412 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/SpriteSheet.h>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <stdint.h>
+#include <nyra/Json.h>
+
+namespace
+{
+const char MAGIC[] = {'N', 'Y', 'S', 'S'};
+const uint32_t VERSION = 1;
+
+const char* const MODE_NAMES[] =
+{
+    "once",
+    "loop",
+    "ping_pong_once",
+    "ping_pong_loop"
+};
+const size_t NUM_MODES = sizeof(MODE_NAMES) / sizeof(MODE_NAMES[0]);
+
+//===========================================================================//
+template <typename ValueT>
+void writeValue(std::ofstream& file, const ValueT& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+//===========================================================================//
+void writeString(std::ofstream& file, const std::string& value)
+{
+    writeValue(file, static_cast<uint32_t>(value.size()));
+    file.write(value.data(), value.size());
+}
+
+//===========================================================================//
+template <typename ValueT>
+ValueT readValue(std::ifstream& file)
+{
+    ValueT value;
+    if (!file.read(reinterpret_cast<char*>(&value), sizeof(value)))
+    {
+        throw std::runtime_error("Sprite sheet is truncated");
+    }
+    return value;
+}
+
+//===========================================================================//
+uint32_t readCount(std::ifstream& file, size_t entrySize)
+{
+    // Counts are checked against what is left of the file so a corrupt
+    // sheet cannot ask for a huge allocation.
+    const uint32_t count = readValue<uint32_t>(file);
+    const std::streampos position = file.tellg();
+    file.seekg(0, std::ios::end);
+    const std::streampos end = file.tellg();
+    file.seekg(position);
+    if (static_cast<uint64_t>(count) * entrySize >
+        static_cast<uint64_t>(end - position))
+    {
+        throw std::runtime_error("Sprite sheet is truncated");
+    }
+    return count;
+}
+
+//===========================================================================//
+std::string readString(std::ifstream& file)
+{
+    std::string value(readCount(file, 1), '\0');
+    if (!value.empty() && !file.read(&value[0], value.size()))
+    {
+        throw std::runtime_error("Sprite sheet is truncated");
+    }
+    return value;
+}
+
+//===========================================================================//
+nyra::Vector2F readPair(const nyra::JsonValue& value)
+{
+    if (value.size() != 2)
+    {
+        throw std::runtime_error("Expected a pair of numbers");
+    }
+    return nyra::Vector2F(value[0].asNumber(), value[1].asNumber());
+}
+
+//===========================================================================//
+uint32_t readUnsigned(const nyra::JsonValue& value)
+{
+    const double number = value.asNumber();
+    if (!(number >= 0.0 && number <= 4294967295.0))
+    {
+        throw std::runtime_error("Expected a positive number");
+    }
+    return static_cast<uint32_t>(number);
+}
+
+//===========================================================================//
+bool endsWith(const std::string& value, const std::string& suffix)
+{
+    return value.size() >= suffix.size() &&
+           value.compare(value.size() - suffix.size(),
+                         suffix.size(),
+                         suffix) == 0;
+}
+}
+
+namespace nyra
+{
+//===========================================================================//
+SpriteSheet::SpriteSheet(const std::string& pathname)
+{
+    if (endsWith(pathname, ".json"))
+    {
+        readJSON(pathname);
+    }
+    else
+    {
+        readBinary(pathname);
+    }
+
+    // Textures are stored relative to the sheet
+    const size_t slash = pathname.find_last_of('/');
+    if (slash == std::string::npos ||
+        (!mTextureName.empty() && mTextureName[0] == '/'))
+    {
+        mTexturePathname = mTextureName;
+    }
+    else
+    {
+        mTexturePathname = pathname.substr(0, slash + 1) + mTextureName;
+    }
+
+    buildTables();
+}
+
+//===========================================================================//
+void SpriteSheet::write(const std::string& pathname) const
+{
+    std::ofstream file(pathname.c_str(), std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Unable to open " + pathname);
+    }
+
+    file.write(MAGIC, sizeof(MAGIC));
+    writeValue(file, VERSION);
+    writeString(file, mTextureName);
+    writeValue(file, mTextureSize.x);
+    writeValue(file, mTextureSize.y);
+
+    writeValue(file, static_cast<uint32_t>(mFrames.size()));
+    for (size_t ii = 0; ii < mFrames.size(); ++ii)
+    {
+        const Frame& frame = mFrames[ii];
+        writeString(file, frame.name);
+        writeValue(file, frame.position.x);
+        writeValue(file, frame.position.y);
+        writeValue(file, frame.size.x);
+        writeValue(file, frame.size.y);
+        writeValue(file, frame.pivot.x);
+        writeValue(file, frame.pivot.y);
+        writeValue(file, frame.duration);
+    }
+
+    writeValue(file, static_cast<uint32_t>(mAnimations.size()));
+    for (size_t ii = 0; ii < mAnimations.size(); ++ii)
+    {
+        const Animation& animation = mAnimations[ii];
+        writeString(file, animation.name);
+        writeValue(file, static_cast<uint32_t>(animation.mode));
+        writeValue(file, static_cast<uint32_t>(animation.frames.size()));
+        for (size_t jj = 0; jj < animation.frames.size(); ++jj)
+        {
+            writeValue(file, static_cast<uint32_t>(animation.frames[jj]));
+        }
+    }
+
+    if (!file)
+    {
+        throw std::runtime_error("Unable to write " + pathname);
+    }
+}
+
+//===========================================================================//
+size_t SpriteSheet::getFrameIndex(const std::string& name) const
+{
+    auto iter = mFrameLookup.find(name);
+    if (iter == mFrameLookup.end())
+    {
+        throw std::runtime_error("Sprite sheet has no frame " + name);
+    }
+    return iter->second;
+}
+
+//===========================================================================//
+const SpriteSheet::Animation& SpriteSheet::getAnimation(
+        const std::string& name) const
+{
+    auto iter = mAnimationLookup.find(name);
+    if (iter == mAnimationLookup.end())
+    {
+        throw std::runtime_error("Sprite sheet has no animation " + name);
+    }
+    return mAnimations[iter->second];
+}
+
+//===========================================================================//
+void SpriteSheet::readJSON(const std::string& pathname)
+{
+    const JsonValue root = JsonValue::load(pathname);
+    mTextureName = root["texture"].asString();
+    const JsonValue& size = root["size"];
+    if (size.size() != 2)
+    {
+        throw std::runtime_error("Expected a pair of numbers");
+    }
+    mTextureSize = Vector2U(readUnsigned(size[0]), readUnsigned(size[1]));
+
+    const JsonValue& frames = root["frames"];
+    std::unordered_map<std::string, size_t> names;
+    for (size_t ii = 0; ii < frames.size(); ++ii)
+    {
+        const JsonValue& source = frames[ii];
+        const JsonValue& rect = source["rect"];
+        if (rect.size() != 4)
+        {
+            throw std::runtime_error("Frame rect needs four values");
+        }
+
+        Frame frame;
+        frame.name = source["name"].asString();
+        frame.position = Vector2U(readUnsigned(rect[0]),
+                                  readUnsigned(rect[1]));
+        frame.size = Vector2U(readUnsigned(rect[2]), readUnsigned(rect[3]));
+        frame.pivot = source.has("pivot") ? readPair(source["pivot"]) :
+                                            Vector2F(0.5f, 0.5f);
+        frame.duration = source.has("duration") ?
+                source["duration"].asNumber() : 0.1f;
+        names[frame.name] = ii;
+        mFrames.push_back(frame);
+    }
+
+    if (!root.has("animations"))
+    {
+        return;
+    }
+
+    const JsonValue& animations = root["animations"];
+    for (size_t ii = 0; ii < animations.size(); ++ii)
+    {
+        const JsonValue& source = animations[ii];
+        Animation animation;
+        animation.name = source["name"].asString();
+        animation.mode = AnimateMode::PLAY_ONCE;
+        if (source.has("mode"))
+        {
+            const std::string& mode = source["mode"].asString();
+            size_t jj = 0;
+            while (jj < NUM_MODES && mode != MODE_NAMES[jj])
+            {
+                ++jj;
+            }
+            if (jj == NUM_MODES)
+            {
+                throw std::runtime_error("Unknown animation mode " + mode);
+            }
+            animation.mode = static_cast<AnimateMode>(jj);
+        }
+
+        const JsonValue& sequence = source["frames"];
+        for (size_t jj = 0; jj < sequence.size(); ++jj)
+        {
+            auto iter = names.find(sequence[jj].asString());
+            if (iter == names.end())
+            {
+                throw std::runtime_error("Animation " + animation.name +
+                        " uses unknown frame " + sequence[jj].asString());
+            }
+            animation.frames.push_back(iter->second);
+        }
+        mAnimations.push_back(animation);
+    }
+}
+
+//===========================================================================//
+void SpriteSheet::readBinary(const std::string& pathname)
+{
+    std::ifstream file(pathname.c_str(), std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Unable to open " + pathname);
+    }
+
+    char magic[sizeof(MAGIC)];
+    if (!file.read(magic, sizeof(magic)) ||
+        !std::equal(magic, magic + sizeof(magic), MAGIC) ||
+        readValue<uint32_t>(file) != VERSION)
+    {
+        throw std::runtime_error(pathname + " is not a compiled sprite sheet");
+    }
+
+    mTextureName = readString(file);
+    mTextureSize.x = readValue<uint32_t>(file);
+    mTextureSize.y = readValue<uint32_t>(file);
+
+    // The smallest frame is an empty name and seven 4 byte values
+    mFrames.resize(readCount(file, 32));
+    for (size_t ii = 0; ii < mFrames.size(); ++ii)
+    {
+        Frame& frame = mFrames[ii];
+        frame.name = readString(file);
+        frame.position.x = readValue<uint32_t>(file);
+        frame.position.y = readValue<uint32_t>(file);
+        frame.size.x = readValue<uint32_t>(file);
+        frame.size.y = readValue<uint32_t>(file);
+        frame.pivot.x = readValue<float>(file);
+        frame.pivot.y = readValue<float>(file);
+        frame.duration = readValue<float>(file);
+    }
+
+    mAnimations.resize(readCount(file, 12));
+    for (size_t ii = 0; ii < mAnimations.size(); ++ii)
+    {
+        Animation& animation = mAnimations[ii];
+        animation.name = readString(file);
+        const uint32_t mode = readValue<uint32_t>(file);
+        if (mode >= NUM_MODES)
+        {
+            throw std::runtime_error("Unknown animation mode");
+        }
+        animation.mode = static_cast<AnimateMode>(mode);
+        animation.frames.resize(readCount(file, 4));
+        for (size_t jj = 0; jj < animation.frames.size(); ++jj)
+        {
+            animation.frames[jj] = readValue<uint32_t>(file);
+            if (animation.frames[jj] >= mFrames.size())
+            {
+                throw std::runtime_error("Animation frame out of bounds");
+            }
+        }
+    }
+}
+
+//===========================================================================//
+void SpriteSheet::buildTables()
+{
+    mUVs.resize(mFrames.size());
+    for (size_t ii = 0; ii < mFrames.size(); ++ii)
+    {
+        const Frame& frame = mFrames[ii];
+        if (static_cast<uint64_t>(frame.position.x) + frame.size.x >
+                    mTextureSize.x ||
+            static_cast<uint64_t>(frame.position.y) + frame.size.y >
+                    mTextureSize.y)
+        {
+            throw std::runtime_error("Frame " + frame.name +
+                                     " is outside of the texture");
+        }
+        if (!(frame.duration > 0.0f))
+        {
+            throw std::runtime_error("Frame " + frame.name +
+                                     " must have a positive duration");
+        }
+        if (!mFrameLookup.insert(std::make_pair(frame.name, ii)).second)
+        {
+            throw std::runtime_error("Duplicate frame " + frame.name);
+        }
+
+        FrameUV& uv = mUVs[ii];
+        uv.left = frame.position.x / static_cast<float>(mTextureSize.x);
+        uv.top = frame.position.y / static_cast<float>(mTextureSize.y);
+        uv.right = (frame.position.x + frame.size.x) /
+                static_cast<float>(mTextureSize.x);
+        uv.bottom = (frame.position.y + frame.size.y) /
+                static_cast<float>(mTextureSize.y);
+    }
+
+    for (size_t ii = 0; ii < mAnimations.size(); ++ii)
+    {
+        if (!mAnimationLookup.insert(
+                std::make_pair(mAnimations[ii].name, ii)).second)
+        {
+            throw std::runtime_error("Duplicate animation " +
+                                     mAnimations[ii].name);
+        }
+    }
+}
+}
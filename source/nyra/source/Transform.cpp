@@ -30,7 +30,8 @@ Transform::Transform() :
     mScale(1.0f, 1.0f),
     mRotation(0.0f),
     mPivot(0.5f, 0.5f),
-    mNeedMatrixUpdate(false)
+    mNeedMatrixUpdate(false),
+    mVersion(0)
 {
 }
 
@@ -44,6 +45,7 @@ const Matrix& Transform::getMatrix()
                          mPivot * mSize,
                          mScale,
                          mRotation);
+        mNeedMatrixUpdate = false;
     }
     return mMatrix;
 }
@@ -0,0 +1,113 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <stdlib.h>
+#include <nyra/Blend.h>
+#include <nyra/Image.h>
+
+namespace
+{
+//===========================================================================//
+nyra::Image randomImage(const nyra::Vector2U& size)
+{
+    nyra::Image image(size, 4);
+    uint8_t* buffer = image.getBuffer();
+    for (size_t ii = 0; ii < size.product() * 4; ++ii)
+    {
+        buffer[ii] = static_cast<uint8_t>(rand());
+    }
+    return image;
+}
+
+//===========================================================================//
+template <typename BlitT>
+double megapixelsPerSecond(BlitT blitFunction,
+                           const nyra::Image& source,
+                           nyra::Image& destination,
+                           nyra::BlendMode mode,
+                           nyra::AlphaMode alpha)
+{
+    const size_t iterations = 50;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (size_t ii = 0; ii < iterations; ++ii)
+    {
+        blitFunction(source, destination, nyra::Vector2I(0, 0),
+                     mode, alpha, 0.8f);
+    }
+    const std::chrono::duration<double> elapsed =
+            std::chrono::high_resolution_clock::now() - start;
+    return (source.getSize().product() * iterations) /
+            (elapsed.count() * 1000000.0);
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        const nyra::Vector2U size(1024, 1024);
+        const nyra::Image source = randomImage(size);
+        nyra::Image destination = randomImage(size);
+
+        const char* modeNames[] = {"replace", "source over",
+                                   "additive", "multiply"};
+        const nyra::BlendMode modes[] = {nyra::BlendMode::REPLACE,
+                                         nyra::BlendMode::SOURCE_OVER,
+                                         nyra::BlendMode::ADDITIVE,
+                                         nyra::BlendMode::MULTIPLY};
+        const char* alphaNames[] = {"straight", "premultiplied"};
+        const nyra::AlphaMode alphas[] = {nyra::AlphaMode::STRAIGHT,
+                                          nyra::AlphaMode::PREMULTIPLIED};
+
+        std::cout << "Blending " << size.x << "x" << size.y
+                  << " RGBA images (megapixels per second)\n";
+        for (size_t ii = 0; ii < 4; ++ii)
+        {
+            for (size_t jj = 0; jj < 2; ++jj)
+            {
+                const double reference = megapixelsPerSecond(
+                        nyra::blitReference, source, destination,
+                        modes[ii], alphas[jj]);
+                const double optimized = megapixelsPerSecond(
+                        nyra::blit, source, destination,
+                        modes[ii], alphas[jj]);
+                std::cout << modeNames[ii] << " " << alphaNames[jj]
+                          << ": reference " << reference
+                          << " optimized " << optimized
+                          << " speedup " << optimized / reference << "\n";
+            }
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Caught standard exception from " <<
+            ex.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Caught unnamed Unwanted exception" << std::endl;
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <nyra/AssetResolver.h>
+#include <nyra/Constants.h>
+
+namespace
+{
+//===========================================================================//
+void touch(const std::string& pathname)
+{
+    std::ofstream(pathname.c_str()) << "variant";
+}
+}
+
+//===========================================================================//
+TEST(AssetResolverTest, VariantPathname)
+{
+    EXPECT_EQ(nyra::AssetResolver::getVariantPathname("a/hero.png", 2.0f),
+              "a/hero@2x.png");
+    EXPECT_EQ(nyra::AssetResolver::getVariantPathname("a/hero.png", 0.5f),
+              "a/hero@0.5x.png");
+    EXPECT_EQ(nyra::AssetResolver::getVariantPathname("a/hero.png", 1.0f),
+              "a/hero.png");
+    EXPECT_EQ(nyra::AssetResolver::getVariantPathname("a.b/hero", 2.0f),
+              "a.b/hero@2x");
+    EXPECT_THROW(nyra::AssetResolver::getVariantPathname("hero.png", 3.0f),
+                 std::runtime_error);
+}
+
+//===========================================================================//
+TEST(AssetResolverTest, DesiredScale)
+{
+    nyra::AssetResolver resolver(nyra::Vector2U(1280, 720));
+    EXPECT_FLOAT_EQ(resolver.getDesiredScale(), 1.0f);
+    resolver.setWindowSize(nyra::Vector2U(640, 360));
+    EXPECT_FLOAT_EQ(resolver.getDesiredScale(), 0.5f);
+    resolver.setWindowSize(nyra::Vector2U(2560, 1080));
+    EXPECT_FLOAT_EQ(resolver.getDesiredScale(), 2.0f);
+
+    resolver.setQuality(nyra::AssetResolver::Quality::LOW);
+    EXPECT_FLOAT_EQ(resolver.getDesiredScale(), 1.0f);
+    resolver.setQuality(nyra::AssetResolver::Quality::HIGH);
+    EXPECT_FLOAT_EQ(resolver.getDesiredScale(), 4.0f);
+
+    EXPECT_THROW(nyra::AssetResolver(nyra::Vector2U(0, 720)),
+                 std::runtime_error);
+}
+
+//===========================================================================//
+TEST(AssetResolverTest, Resolve)
+{
+    const std::string pathname(nyra::Constants::APP_PATH +
+            "../data/unittests/asset_resolver_test.png");
+    const std::string half =
+            nyra::AssetResolver::getVariantPathname(pathname, 0.5f);
+    const std::string twice =
+            nyra::AssetResolver::getVariantPathname(pathname, 2.0f);
+    touch(pathname);
+    touch(twice);
+    std::remove(half.c_str());
+
+    nyra::AssetResolver resolver(nyra::Vector2U(1280, 720));
+    EXPECT_EQ(resolver.resolve(pathname).pathname, pathname);
+    EXPECT_FLOAT_EQ(resolver.resolve(pathname).scale, 1.0f);
+
+    // Between tiers the sharper one is picked
+    resolver.setWindowSize(nyra::Vector2U(1920, 1080));
+    EXPECT_EQ(resolver.resolve(pathname).pathname, twice);
+    EXPECT_FLOAT_EQ(resolver.resolve(pathname).scale, 2.0f);
+
+    // Past the largest tier the largest one is used
+    resolver.setQuality(nyra::AssetResolver::Quality::HIGH);
+    EXPECT_EQ(resolver.resolve(pathname).pathname, twice);
+
+    // Missing variants fall back to the 1x asset
+    resolver.setWindowSize(nyra::Vector2U(640, 360));
+    resolver.setQuality(nyra::AssetResolver::Quality::LOW);
+    EXPECT_EQ(resolver.resolve(pathname).pathname, pathname);
+    touch(half);
+    EXPECT_EQ(resolver.resolve(pathname).pathname, half);
+    EXPECT_FLOAT_EQ(resolver.resolve(pathname).scale, 0.5f);
+}
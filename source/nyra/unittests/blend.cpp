@@ -0,0 +1,193 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <nyra/Blend.h>
+#include <nyra/Image.h>
+
+namespace
+{
+//===========================================================================//
+nyra::Image solidImage(const nyra::Vector2U& size,
+                       uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+    nyra::Image image(size, 4);
+    uint8_t* buffer = image.getBuffer();
+    for (size_t ii = 0; ii < size.product(); ++ii)
+    {
+        buffer[ii * 4 + 0] = r;
+        buffer[ii * 4 + 1] = g;
+        buffer[ii * 4 + 2] = b;
+        buffer[ii * 4 + 3] = a;
+    }
+    return image;
+}
+
+//===========================================================================//
+nyra::Image randomImage(const nyra::Vector2U& size)
+{
+    nyra::Image image(size, 4);
+    uint8_t* buffer = image.getBuffer();
+    for (size_t ii = 0; ii < size.product() * 4; ++ii)
+    {
+        buffer[ii] = static_cast<uint8_t>(rand());
+    }
+    return image;
+}
+
+//===========================================================================//
+void expectPixel(const nyra::Image& image, size_t x, size_t y,
+                 uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+    const uint8_t* pixel =
+            image.getBuffer() + ((y * image.getSize().x) + x) * 4;
+    EXPECT_EQ(pixel[0], r);
+    EXPECT_EQ(pixel[1], g);
+    EXPECT_EQ(pixel[2], b);
+    EXPECT_EQ(pixel[3], a);
+}
+}
+
+//===========================================================================//
+TEST(Blend, Modes)
+{
+    const nyra::Image source = solidImage(nyra::Vector2U(1, 1),
+                                          255, 0, 0, 128);
+    {
+        nyra::Image destination = solidImage(nyra::Vector2U(1, 1),
+                                             0, 0, 255, 255);
+        nyra::blit(source, destination);
+        expectPixel(destination, 0, 0, 128, 0, 127, 255);
+    }
+
+    {
+        nyra::Image destination = solidImage(nyra::Vector2U(1, 1),
+                                             0, 0, 255, 255);
+        nyra::blit(source, destination, nyra::Vector2I(0, 0),
+                   nyra::BlendMode::REPLACE);
+        expectPixel(destination, 0, 0, 255, 0, 0, 128);
+    }
+
+    {
+        nyra::Image destination = solidImage(nyra::Vector2U(1, 1),
+                                             100, 0, 255, 200);
+        nyra::blit(source, destination, nyra::Vector2I(0, 0),
+                   nyra::BlendMode::ADDITIVE);
+        expectPixel(destination, 0, 0, 228, 0, 255, 255);
+    }
+
+    {
+        nyra::Image destination = solidImage(nyra::Vector2U(1, 1),
+                                             200, 200, 200, 200);
+        nyra::blit(source, destination, nyra::Vector2I(0, 0),
+                   nyra::BlendMode::MULTIPLY);
+        expectPixel(destination, 0, 0, 200, 100, 100, 200);
+    }
+
+    // Premultiplied half transparent red and half opacity
+    {
+        const nyra::Image premultiplied = solidImage(nyra::Vector2U(1, 1),
+                                                     128, 0, 0, 128);
+        nyra::Image destination = solidImage(nyra::Vector2U(1, 1),
+                                             0, 0, 255, 255);
+        nyra::blit(premultiplied, destination, nyra::Vector2I(0, 0),
+                   nyra::BlendMode::SOURCE_OVER,
+                   nyra::AlphaMode::PREMULTIPLIED,
+                   0.5f);
+        expectPixel(destination, 0, 0, 64, 0, 191, 255);
+    }
+}
+
+//===========================================================================//
+TEST(Blend, Clipping)
+{
+    const nyra::Image source = solidImage(nyra::Vector2U(4, 4),
+                                          255, 255, 255, 255);
+    nyra::Image destination(nyra::Vector2U(4, 4), 4);
+    nyra::blit(source, destination, nyra::Vector2I(-2, 3));
+    for (size_t y = 0; y < 4; ++y)
+    {
+        for (size_t x = 0; x < 4; ++x)
+        {
+            const uint8_t value = (x < 2 && y == 3) ? 255 : 0;
+            expectPixel(destination, x, y, value, value, value, value);
+        }
+    }
+
+    // Completely outside should be ignored
+    nyra::blit(source, destination, nyra::Vector2I(4, 0));
+    nyra::blit(source, destination, nyra::Vector2I(-4, -4));
+
+    // Sub views should only touch their own area
+    nyra::Image target(nyra::Vector2U(4, 4), 4);
+    nyra::ImageView view(target);
+    nyra::blit(source, view.subView(nyra::Vector2U(1, 1),
+                                    nyra::Vector2U(2, 2)));
+    for (size_t y = 0; y < 4; ++y)
+    {
+        for (size_t x = 0; x < 4; ++x)
+        {
+            const uint8_t value =
+                    (x >= 1 && x <= 2 && y >= 1 && y <= 2) ? 255 : 0;
+            expectPixel(target, x, y, value, value, value, value);
+        }
+    }
+}
+
+//===========================================================================//
+TEST(Blend, MatchesReference)
+{
+    const nyra::BlendMode modes[] = {nyra::BlendMode::REPLACE,
+                                     nyra::BlendMode::SOURCE_OVER,
+                                     nyra::BlendMode::ADDITIVE,
+                                     nyra::BlendMode::MULTIPLY};
+    const nyra::AlphaMode alphas[] = {nyra::AlphaMode::STRAIGHT,
+                                      nyra::AlphaMode::PREMULTIPLIED};
+    const float opacities[] = {1.0f, 0.73f, 0.0f};
+
+    srand(1234);
+    const nyra::Image source = randomImage(nyra::Vector2U(37, 23));
+    const nyra::Image original = randomImage(nyra::Vector2U(41, 29));
+    for (nyra::BlendMode mode : modes)
+    {
+        for (nyra::AlphaMode alpha : alphas)
+        {
+            for (float opacity : opacities)
+            {
+                nyra::Image optimized(original.getSize(), 4);
+                nyra::Image reference(original.getSize(), 4);
+                nyra::blit(original, optimized, nyra::Vector2I(0, 0),
+                           nyra::BlendMode::REPLACE);
+                nyra::blit(original, reference, nyra::Vector2I(0, 0),
+                           nyra::BlendMode::REPLACE);
+
+                nyra::blit(source, optimized, nyra::Vector2I(7, -3),
+                           mode, alpha, opacity);
+                nyra::blitReference(source, reference, nyra::Vector2I(7, -3),
+                                    mode, alpha, opacity);
+                EXPECT_EQ(optimized, reference);
+            }
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <nyra/Camera.h>
+
+namespace
+{
+//===========================================================================//
+nyra::Vector2F transform(const nyra::Matrix& matrix,
+                         const nyra::Vector2F& point)
+{
+    return nyra::Vector2F(
+            (matrix(0, 0) * point.x) + (matrix(0, 1) * point.y) +
+                    matrix(0, 2),
+            (matrix(1, 0) * point.x) + (matrix(1, 1) * point.y) +
+                    matrix(1, 2));
+}
+}
+
+//===========================================================================//
+TEST(CameraTest, Matrix)
+{
+    const nyra::Vector2U target(200, 100);
+    nyra::Camera camera(nyra::Vector2F(500.0f, 500.0f));
+
+    // The camera position lands in the center of the target
+    nyra::Vector2F point = transform(camera.getMatrix(target),
+                                     nyra::Vector2F(500.0f, 500.0f));
+    EXPECT_FLOAT_EQ(point.x, 100.0f);
+    EXPECT_FLOAT_EQ(point.y, 50.0f);
+    EXPECT_EQ(camera.getVisibleArea(target),
+              nyra::RectF(nyra::Vector2F(400.0f, 450.0f),
+                          nyra::Vector2F(600.0f, 550.0f)));
+
+    // Zooming in shows less of the world
+    camera.setZoom(2.0f);
+    point = transform(camera.getMatrix(target),
+                      nyra::Vector2F(510.0f, 500.0f));
+    EXPECT_FLOAT_EQ(point.x, 120.0f);
+    EXPECT_FLOAT_EQ(point.y, 50.0f);
+    EXPECT_EQ(camera.getVisibleArea(target),
+              nyra::RectF(nyra::Vector2F(450.0f, 475.0f),
+                          nyra::Vector2F(550.0f, 525.0f)));
+    EXPECT_THROW(camera.setZoom(0.0f), std::runtime_error);
+
+    // Turning the camera clockwise turns the world the other way
+    camera.setZoom(1.0f);
+    camera.setRotation(90.0f);
+    point = transform(camera.getMatrix(target),
+                      nyra::Vector2F(510.0f, 500.0f));
+    EXPECT_NEAR(point.x, 100.0f, 0.001f);
+    EXPECT_NEAR(point.y, 40.0f, 0.001f);
+    const nyra::RectF area = camera.getVisibleArea(target);
+    EXPECT_NEAR(area.min.x, 450.0f, 0.001f);
+    EXPECT_NEAR(area.min.y, 400.0f, 0.001f);
+    EXPECT_NEAR(area.max.x, 550.0f, 0.001f);
+    EXPECT_NEAR(area.max.y, 600.0f, 0.001f);
+
+    // Going back from the screen gives the same world position
+    const nyra::Vector2F world = camera.screenToWorld(point, target);
+    EXPECT_NEAR(world.x, 510.0f, 0.001f);
+    EXPECT_NEAR(world.y, 500.0f, 0.001f);
+}
+
+//===========================================================================//
+TEST(CameraTest, Viewport)
+{
+    // The right half of the target
+    const nyra::Vector2U target(200, 100);
+    nyra::Camera camera(nyra::Vector2F(0.0f, 0.0f));
+    const size_t version = camera.getVersion();
+    camera.setViewport(nyra::RectF(nyra::Vector2F(0.5f, 0.0f),
+                                   nyra::Vector2F(1.0f, 1.0f)));
+    EXPECT_NE(camera.getVersion(), version);
+    EXPECT_EQ(camera.getViewportPixels(target),
+              nyra::RectI(nyra::Vector2I(100, 0),
+                          nyra::Vector2I(200, 100)));
+
+    const nyra::Vector2F point = transform(camera.getMatrix(target),
+                                           nyra::Vector2F(0.0f, 0.0f));
+    EXPECT_FLOAT_EQ(point.x, 150.0f);
+    EXPECT_FLOAT_EQ(point.y, 50.0f);
+    EXPECT_EQ(camera.getVisibleArea(target),
+              nyra::RectF(nyra::Vector2F(-50.0f, -50.0f),
+                          nyra::Vector2F(50.0f, 50.0f)));
+}
@@ -0,0 +1,152 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <nyra/CollisionMask.h>
+#include <nyra/Image.h>
+
+namespace
+{
+//===========================================================================//
+nyra::Image randomAlpha(const nyra::Vector2U& size)
+{
+    nyra::Image image(size, 4);
+    uint8_t* buffer = image.getBuffer();
+    for (size_t ii = 0; ii < size.product(); ++ii)
+    {
+        // Keep the masks sparse so not every offset collides
+        buffer[ii * 4 + 3] = (rand() % 16) == 0 ? 255 : 0;
+    }
+    return image;
+}
+
+//===========================================================================//
+bool bruteForceOverlaps(const nyra::CollisionMask& lhs,
+                        const nyra::CollisionMask& rhs,
+                        const nyra::Vector2I& offset)
+{
+    for (int64_t y = 0; y < lhs.getSize().y; ++y)
+    {
+        for (int64_t x = 0; x < lhs.getSize().x; ++x)
+        {
+            if (lhs.isSolid(x, y) &&
+                rhs.isSolid(x - offset.x, y - offset.y))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+}
+
+//===========================================================================//
+TEST(CollisionMask, Construction)
+{
+    nyra::Image image(nyra::Vector2U(70, 2), 4);
+    image.getBuffer()[(0 * 70 + 0) * 4 + 3] = 255;
+    image.getBuffer()[(0 * 70 + 65) * 4 + 3] = 10;
+    image.getBuffer()[(1 * 70 + 69) * 4 + 3] = 200;
+
+    const nyra::CollisionMask mask(image, 50);
+    EXPECT_EQ(mask.getSize(), nyra::Vector2U(70, 2));
+    EXPECT_EQ(mask.getWordsPerRow(), 2);
+    EXPECT_TRUE(mask.isSolid(0, 0));
+    EXPECT_FALSE(mask.isSolid(65, 0));
+    EXPECT_TRUE(mask.isSolid(69, 1));
+    EXPECT_FALSE(mask.isSolid(70, 1));
+    EXPECT_FALSE(mask.isSolid(-1, 0));
+
+    // Frames cut out of a sheet
+    const nyra::CollisionMask frame(mask, nyra::Vector2U(66, 1),
+                                    nyra::Vector2U(4, 1));
+    EXPECT_EQ(frame.getSize(), nyra::Vector2U(4, 1));
+    EXPECT_TRUE(frame.isSolid(3, 0));
+    EXPECT_FALSE(frame.isSolid(0, 0));
+}
+
+//===========================================================================//
+TEST(CollisionMask, Overlaps)
+{
+    nyra::Image image(nyra::Vector2U(1, 1), 4);
+    image.getBuffer()[3] = 255;
+    const nyra::CollisionMask pixel(image);
+
+    nyra::Image wideImage(nyra::Vector2U(130, 1), 4);
+    wideImage.getBuffer()[129 * 4 + 3] = 255;
+    const nyra::CollisionMask wide(wideImage);
+
+    EXPECT_TRUE(wide.overlaps(pixel, nyra::Vector2I(129, 0)));
+    EXPECT_FALSE(wide.overlaps(pixel, nyra::Vector2I(128, 0)));
+    EXPECT_FALSE(wide.overlaps(pixel, nyra::Vector2I(130, 0)));
+    EXPECT_TRUE(pixel.overlaps(wide, nyra::Vector2I(-129, 0)));
+    EXPECT_FALSE(pixel.overlaps(wide, nyra::Vector2I(-129, 1)));
+}
+
+//===========================================================================//
+TEST(CollisionMask, MatchesBruteForce)
+{
+    srand(4321);
+    const nyra::Image lhsImage = randomAlpha(nyra::Vector2U(77, 13));
+    const nyra::Image rhsImage = randomAlpha(nyra::Vector2U(150, 9));
+    const nyra::CollisionMask lhs(lhsImage);
+    const nyra::CollisionMask rhs(rhsImage);
+
+    for (int32_t y = -10; y <= 14; y += 3)
+    {
+        for (int32_t x = -152; x <= 78; ++x)
+        {
+            const nyra::Vector2I offset(x, y);
+            EXPECT_EQ(lhs.overlaps(rhs, offset),
+                      bruteForceOverlaps(lhs, rhs, offset));
+            EXPECT_EQ(rhs.overlaps(lhs, offset * -1.0),
+                      lhs.overlaps(rhs, offset));
+        }
+    }
+}
+
+//===========================================================================//
+TEST(CollisionMask, Resample)
+{
+    nyra::Image image(nyra::Vector2U(8, 4), 4);
+    image.getBuffer()[(1 * 8 + 5) * 4 + 3] = 255;
+    const nyra::CollisionMask mask(image);
+
+    // Any solid pixel in the footprint keeps the smaller pixel solid
+    const nyra::CollisionMask half = mask.resample(nyra::Vector2U(4, 2));
+    EXPECT_EQ(half.getSize(), nyra::Vector2U(4, 2));
+    for (int64_t y = 0; y < 2; ++y)
+    {
+        for (int64_t x = 0; x < 4; ++x)
+        {
+            EXPECT_EQ(half.isSolid(x, y), x == 2 && y == 0);
+        }
+    }
+
+    const nyra::CollisionMask twice = mask.resample(nyra::Vector2U(16, 8));
+    EXPECT_TRUE(twice.isSolid(10, 2));
+    EXPECT_TRUE(twice.isSolid(11, 3));
+    EXPECT_FALSE(twice.isSolid(12, 3));
+    EXPECT_FALSE(twice.isSolid(9, 2));
+}
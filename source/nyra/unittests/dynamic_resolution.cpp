@@ -0,0 +1,91 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <nyra/DynamicResolution.h>
+
+namespace
+{
+//===========================================================================//
+float run(nyra::DynamicResolution& controller,
+          double fullFrameTime,
+          size_t numFrames)
+{
+    // Frames are fill bound, so the time follows the number of pixels
+    for (size_t ii = 0; ii < numFrames; ++ii)
+    {
+        const double scale = controller.getScale();
+        controller.update(fullFrameTime * scale * scale);
+    }
+    return controller.getScale();
+}
+}
+
+//===========================================================================//
+TEST(DynamicResolutionTest, Converges)
+{
+    // Twice the budget at full resolution settles near 1 / sqrt(2)
+    nyra::DynamicResolution controller(16.0, 0.5f, 1.0f);
+    EXPECT_FLOAT_EQ(controller.getScale(), 1.0f);
+    const float scale = run(controller, 32.0, 500);
+    EXPECT_GE(scale, 0.6f);
+    EXPECT_LE(scale, 0.75f);
+    EXPECT_LE(controller.getAverageFrameTime(), 16.0 * 1.05);
+
+    // Once the load goes away the full resolution comes back
+    EXPECT_FLOAT_EQ(run(controller, 10.0, 500), 1.0f);
+
+    // A load that cannot be met stops at the smallest scale
+    EXPECT_FLOAT_EQ(run(controller, 1000.0, 500), 0.5f);
+}
+
+//===========================================================================//
+TEST(DynamicResolutionTest, Stable)
+{
+    // Frames inside the band never change the scale
+    nyra::DynamicResolution controller(16.0, 0.5f, 1.0f);
+    controller.setScale(0.75f);
+    for (size_t ii = 0; ii < 200; ++ii)
+    {
+        EXPECT_FLOAT_EQ(controller.update(ii % 2 ? 14.0 : 16.5), 0.75f);
+    }
+
+    // The scale stays on the grid and inside the range
+    controller.setScale(2.0f);
+    EXPECT_FLOAT_EQ(controller.getScale(), 1.0f);
+    controller.setScale(0.1f);
+    EXPECT_FLOAT_EQ(controller.getScale(), 0.5f);
+    for (size_t ii = 0; ii < 100; ++ii)
+    {
+        const float steps = controller.update(5.0) /
+                nyra::DynamicResolution::STEP;
+        EXPECT_NEAR(steps, std::floor(steps + 0.5f), 1e-4f);
+    }
+
+    EXPECT_THROW(nyra::DynamicResolution(16.0, 0.0f, 1.0f),
+                 std::runtime_error);
+    EXPECT_THROW(nyra::DynamicResolution(16.0, 0.8f, 0.5f),
+                 std::runtime_error);
+}
@@ -0,0 +1,303 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <nyra/EngineBase.h>
+
+namespace
+{
+//===========================================================================//
+class TestWindow
+{
+public:
+    TestWindow(const std::string& title,
+               const nyra::Vector2U& size,
+               const nyra::Vector2I& position,
+               bool fullscreen) :
+        mSize(size),
+        mFramesLeft(0)
+    {
+    }
+
+    bool update()
+    {
+        if (mFramesLeft == 0)
+        {
+            return false;
+        }
+        --mFramesLeft;
+        return true;
+    }
+
+    nyra::Vector2U getSize() const
+    {
+        return mSize;
+    }
+
+    nyra::WindowsHandle getHandle() const
+    {
+        return 1;
+    }
+
+    nyra::Vector2U mSize;
+    size_t mFramesLeft;
+};
+
+//===========================================================================//
+class TestGraphics : public nyra::GraphicsInterface
+{
+public:
+    TestGraphics() :
+        mPresents(0),
+        mDraws(0),
+        mScissored(false)
+    {
+    }
+
+    void clear(nyra::WindowsHandle handle) override
+    {
+    }
+
+    void present() override
+    {
+        ++mPresents;
+    }
+
+    void screenshot(const std::string& pathname) const override
+    {
+    }
+
+    void setScissor(const nyra::RectI& area) override
+    {
+        mScissor = area;
+        mScissored = true;
+    }
+
+    void resetScissor() override
+    {
+        mScissored = false;
+    }
+
+    size_t mPresents;
+    size_t mDraws;
+    nyra::RectI mScissor;
+    bool mScissored;
+};
+
+//===========================================================================//
+class TestRenderable : public nyra::RenderableInterface
+{
+public:
+    TestRenderable() :
+        mRenders(0),
+        mOrder(0)
+    {
+    }
+
+    void render(const nyra::Matrix& matrix,
+                nyra::GraphicsInterface& graphics) override
+    {
+        ++mRenders;
+        TestGraphics& test = dynamic_cast<TestGraphics&>(graphics);
+        mOrder = ++test.mDraws;
+        mScissor = test.mScissored ? test.mScissor : nyra::RectI();
+    }
+
+    nyra::Vector2U getSize() const override
+    {
+        return nyra::Vector2U(10, 10);
+    }
+
+    size_t mRenders;
+    size_t mOrder;
+    nyra::RectI mScissor;
+};
+
+typedef nyra::EngineBase<TestWindow, TestGraphics> TestEngine;
+}
+
+//===========================================================================//
+TEST(EngineBaseTest, NoScene)
+{
+    // Without a scene every frame is presented
+    TestEngine engine("Test", nyra::Vector2U(100, 100));
+    engine.getWindow().mFramesLeft = 5;
+    engine.setIdleTime(0.0);
+    engine.run();
+    EXPECT_EQ(engine.getGraphics().mPresents, 5);
+    EXPECT_EQ(engine.getNumFrames(), 5);
+    EXPECT_EQ(engine.getNumSkippedFrames(), 0);
+}
+
+//===========================================================================//
+TEST(EngineBaseTest, AssetResolver)
+{
+    // The engine resolver follows the window, the default is left alone
+    const nyra::Vector2U defaultSize =
+            nyra::AssetResolver::getDefault().getWindowSize();
+    TestEngine engine("Test", nyra::Vector2U(2560, 1440));
+    EXPECT_EQ(engine.getAssetResolver().getWindowSize(),
+              nyra::Vector2U(2560, 1440));
+    EXPECT_FLOAT_EQ(engine.getAssetResolver().getDesiredScale(), 2.0f);
+    EXPECT_EQ(nyra::AssetResolver::getDefault().getWindowSize(),
+              defaultSize);
+
+    // Installing it opts loaders built with default arguments in
+    const nyra::AssetResolver saved = nyra::AssetResolver::getDefault();
+    engine.installAssetResolver();
+    EXPECT_EQ(nyra::AssetResolver::getDefault().getWindowSize(),
+              nyra::Vector2U(2560, 1440));
+    EXPECT_FLOAT_EQ(nyra::AssetResolver::getDefault().getDesiredScale(),
+                    2.0f);
+    nyra::AssetResolver::getDefault() = saved;
+}
+
+//===========================================================================//
+TEST(EngineBaseTest, SkipFrames)
+{
+    TestEngine engine("Test", nyra::Vector2U(100, 100));
+    nyra::Scene scene(nyra::RectF(nyra::Vector2F(0.0f, 0.0f),
+                                  nyra::Vector2F(100.0f, 100.0f)));
+    TestRenderable renderable;
+    nyra::Transform transform;
+    transform.setSize(renderable.getSize());
+    transform.setPosition(50.0f, 50.0f);
+    const size_t id = scene.add(renderable, transform);
+    engine.setScene(&scene);
+    engine.setIdleTime(0.0);
+
+    // The first frame is always drawn and nothing changes after it
+    engine.getWindow().mFramesLeft = 10;
+    engine.run();
+    EXPECT_EQ(engine.getNumFrames(), 1);
+    EXPECT_EQ(engine.getNumSkippedFrames(), 9);
+    EXPECT_EQ(engine.getNumSkippedPixels(), 9 * 100 * 100);
+    EXPECT_EQ(renderable.mRenders, 1);
+
+    // Leaving the screen is drawn once, moving while offscreen is not
+    transform.setPosition(500.0f, 500.0f);
+    scene.markMoved(id);
+    EXPECT_TRUE(engine.renderFrame());
+    transform.setPosition(600.0f, 500.0f);
+    scene.markMoved(id);
+    EXPECT_FALSE(engine.renderFrame());
+
+    // Damage or a resize causes a redraw
+    scene.invalidate(nyra::RectF(nyra::Vector2F(0.0f, 0.0f),
+                                 nyra::Vector2F(1.0f, 1.0f)));
+    EXPECT_TRUE(engine.renderFrame());
+    EXPECT_FALSE(engine.renderFrame());
+    engine.getWindow().mSize = nyra::Vector2U(200, 200);
+    EXPECT_TRUE(engine.renderFrame());
+    EXPECT_FALSE(engine.renderFrame());
+}
+
+//===========================================================================//
+TEST(EngineBaseTest, PartialRedraw)
+{
+    TestEngine engine("Test", nyra::Vector2U(100, 100));
+    nyra::Scene scene(nyra::RectF(nyra::Vector2F(0.0f, 0.0f),
+                                  nyra::Vector2F(100.0f, 100.0f)));
+    TestRenderable renderable;
+    nyra::Transform transform;
+    transform.setSize(renderable.getSize());
+    transform.setPosition(50.0f, 50.0f);
+    const size_t id = scene.add(renderable, transform);
+    engine.setScene(&scene);
+    engine.setPartialRedraw(true);
+
+    // The first frame covers everything
+    EXPECT_TRUE(engine.renderFrame());
+    EXPECT_TRUE(renderable.mScissor.isEmpty());
+    EXPECT_FALSE(engine.getGraphics().mScissored);
+
+    // The second frame still needs the whole back buffer
+    transform.setPosition(50.5f, 50.0f);
+    scene.markMoved(id);
+    EXPECT_TRUE(engine.renderFrame());
+    EXPECT_TRUE(renderable.mScissor.isEmpty());
+
+    // After that only the damage of the last two frames is redrawn
+    transform.setPosition(51.0f, 50.0f);
+    scene.markMoved(id);
+    const uint64_t skipped = engine.getNumSkippedPixels();
+    EXPECT_TRUE(engine.renderFrame());
+    EXPECT_EQ(renderable.mScissor,
+              nyra::RectI(nyra::Vector2I(45, 45), nyra::Vector2I(56, 55)));
+    EXPECT_FALSE(engine.getGraphics().mScissored);
+    EXPECT_EQ(engine.getNumSkippedPixels() - skipped,
+              (100 * 100) - (11 * 10));
+}
+
+//===========================================================================//
+TEST(EngineBaseTest, Cameras)
+{
+    TestEngine engine("Test", nyra::Vector2U(100, 100));
+    nyra::Scene scene(nyra::RectF(nyra::Vector2F(0.0f, 0.0f),
+                                  nyra::Vector2F(1000.0f, 1000.0f)));
+    TestRenderable renderable;
+    nyra::Transform transform;
+    transform.setSize(renderable.getSize());
+    transform.setPosition(500.0f, 500.0f);
+    const size_t id = scene.add(renderable, transform, 1);
+
+    // Added later but sorted under the first object
+    TestRenderable under;
+    nyra::Transform underTransform;
+    underTransform.setSize(under.getSize());
+    underTransform.setPosition(500.0f, 500.0f);
+    scene.add(under, underTransform, 0);
+    engine.setScene(&scene);
+
+    // The object is only on screen through the camera
+    EXPECT_TRUE(engine.renderFrame());
+    EXPECT_EQ(renderable.mRenders, 0);
+    const size_t index =
+            engine.addCamera(nyra::Camera(nyra::Vector2F(500.0f, 500.0f)));
+    EXPECT_EQ(engine.getNumCameras(), 1);
+    EXPECT_TRUE(engine.renderFrame());
+    EXPECT_EQ(renderable.mRenders, 1);
+    EXPECT_EQ(renderable.mScissor,
+              nyra::RectI(nyra::Vector2I(0, 0), nyra::Vector2I(100, 100)));
+    EXPECT_FALSE(engine.getGraphics().mScissored);
+    EXPECT_EQ(engine.getRenderQueue().getNumCommands(), 2);
+    EXPECT_LT(under.mOrder, renderable.mOrder);
+
+    // Nothing changed, then the camera moved
+    EXPECT_FALSE(engine.renderFrame());
+    engine.getCamera(index).setZoom(2.0f);
+    EXPECT_TRUE(engine.renderFrame());
+    EXPECT_EQ(renderable.mRenders, 2);
+
+    // Damage the camera cannot see is ignored
+    scene.invalidate(nyra::RectF(nyra::Vector2F(0.0f, 0.0f),
+                                 nyra::Vector2F(1.0f, 1.0f)));
+    EXPECT_FALSE(engine.renderFrame());
+    transform.setPosition(510.0f, 500.0f);
+    scene.markMoved(id);
+    EXPECT_TRUE(engine.renderFrame());
+
+    engine.clearCameras();
+    EXPECT_TRUE(engine.renderFrame());
+    EXPECT_EQ(renderable.mRenders, 3);
+}
@@ -0,0 +1,72 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <nyra/Image.h>
+#include <nyra/ImageWriter.h>
+#include <nyra/Constants.h>
+
+TEST(ImageWriter, RowStreaming)
+{
+    const nyra::Image originalImage(
+            nyra::Constants::APP_PATH + "../data/unittests/lena.png");
+    const std::string writePathname(
+            nyra::Constants::APP_PATH +
+            "../data/unittests/image_writer_test.png");
+
+    // Write the image in uneven bands to simulate a tiled capture.
+    {
+        const nyra::Vector2U& size = originalImage.getSize();
+        const size_t lineSize = size.x * originalImage.getPixelSize();
+        nyra::ImageWriter writer(writePathname,
+                                 size,
+                                 originalImage.getPixelSize());
+        const size_t bandSize = 100;
+        for (size_t row = 0; row < size.y; row += bandSize)
+        {
+            const size_t numRows = std::min<size_t>(bandSize, size.y - row);
+            writer.writeRows(originalImage.getBuffer() + (row * lineSize),
+                             numRows);
+            EXPECT_EQ(writer.getRowsWritten(), row + numRows);
+        }
+        writer.close();
+    }
+
+    const nyra::Image readBack(writePathname);
+    EXPECT_EQ(originalImage, readBack);
+}
+
+TEST(ImageWriter, Errors)
+{
+    const std::string writePathname(
+            nyra::Constants::APP_PATH +
+            "../data/unittests/image_writer_error_test.png");
+    EXPECT_THROW(nyra::ImageWriter(writePathname, nyra::Vector2U(4, 4), 2),
+                 std::runtime_error);
+
+    const uint8_t row[16] = {0};
+    nyra::ImageWriter writer(writePathname, nyra::Vector2U(4, 4), 4);
+    writer.writeRows(row, 1);
+    EXPECT_THROW(writer.writeRows(row, 4), std::runtime_error);
+    EXPECT_THROW(writer.close(), std::runtime_error);
+}
@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <nyra/Json.h>
+
+//===========================================================================//
+TEST(JsonTest, Parse)
+{
+    const nyra::JsonValue root = nyra::JsonValue::parse(
+            " {\"name\": \"a\\\"b\\u00e9\", \"list\": [1, -2.5e1, true, null],"
+            " \"empty\": {}, \"none\": []} ");
+    EXPECT_EQ(root.getType(), nyra::JsonValue::Type::OBJECT);
+    EXPECT_EQ(root.size(), 4);
+    EXPECT_EQ(root["name"].asString(), "a\"b\xC3\xA9");
+
+    const nyra::JsonValue& list = root["list"];
+    ASSERT_EQ(list.size(), 4);
+    EXPECT_EQ(list[0].asNumber(), 1.0);
+    EXPECT_EQ(list[1].asNumber(), -25.0);
+    EXPECT_TRUE(list[2].asBool());
+    EXPECT_EQ(list[3].getType(), nyra::JsonValue::Type::NONE);
+    EXPECT_EQ(root["empty"].size(), 0);
+    EXPECT_EQ(root["none"].size(), 0);
+    EXPECT_TRUE(root.has("none"));
+    EXPECT_FALSE(root.has("missing"));
+}
+
+//===========================================================================//
+TEST(JsonTest, Errors)
+{
+    EXPECT_THROW(nyra::JsonValue::parse("{\"a\": 1"), std::runtime_error);
+    EXPECT_THROW(nyra::JsonValue::parse("[1, 2,]"), std::runtime_error);
+    EXPECT_THROW(nyra::JsonValue::parse("\"abc"), std::runtime_error);
+    EXPECT_THROW(nyra::JsonValue::parse("[1] 2"), std::runtime_error);
+
+    // Only the JSON number grammar is accepted
+    EXPECT_THROW(nyra::JsonValue::parse("nan"), std::runtime_error);
+    EXPECT_THROW(nyra::JsonValue::parse("inf"), std::runtime_error);
+    EXPECT_THROW(nyra::JsonValue::parse("0x10"), std::runtime_error);
+    EXPECT_THROW(nyra::JsonValue::parse("+1"), std::runtime_error);
+    EXPECT_THROW(nyra::JsonValue::parse("01"), std::runtime_error);
+    EXPECT_THROW(nyra::JsonValue::parse("1."), std::runtime_error);
+    EXPECT_THROW(nyra::JsonValue::parse(".5"), std::runtime_error);
+    EXPECT_THROW(nyra::JsonValue::parse("1e"), std::runtime_error);
+    EXPECT_THROW(nyra::JsonValue::parse("1e999"), std::runtime_error);
+    EXPECT_EQ(nyra::JsonValue::parse("-0.5E+2").asNumber(), -50.0);
+
+    // Surrogates have to come as a valid pair
+    EXPECT_EQ(nyra::JsonValue::parse("\"\\ud83d\\ude00\"").asString(),
+              "\xF0\x9F\x98\x80");
+    EXPECT_THROW(nyra::JsonValue::parse("\"\\ud83d\\u0041\""),
+                 std::runtime_error);
+    EXPECT_THROW(nyra::JsonValue::parse("\"\\ud83d\""), std::runtime_error);
+    EXPECT_THROW(nyra::JsonValue::parse("\"\\ude00\""), std::runtime_error);
+    EXPECT_THROW(nyra::JsonValue::parse("\"\\u+041\""), std::runtime_error);
+
+    // Nesting is bounded
+    const size_t depth = nyra::JsonValue::MAX_DEPTH;
+    const std::string deepest =
+            std::string(depth, '[') + std::string(depth, ']');
+    EXPECT_NO_THROW(nyra::JsonValue::parse(deepest));
+    EXPECT_THROW(nyra::JsonValue::parse("[" + deepest + "]"),
+                 std::runtime_error);
+
+    const nyra::JsonValue root = nyra::JsonValue::parse("{\"a\": 1}");
+    EXPECT_THROW(root["b"], std::runtime_error);
+    EXPECT_THROW(root["a"].asString(), std::runtime_error);
+    EXPECT_THROW(root[0], std::runtime_error);
+}
@@ -0,0 +1,103 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include <nyra/Allocator.h>
+#include <nyra/Arena.h>
+#include <nyra/Constants.h>
+#include <nyra/Image.h>
+
+//===========================================================================//
+TEST(Arena, Allocation)
+{
+    nyra::Arena arena(256);
+    EXPECT_EQ(arena.getBytesReserved(), 0);
+
+    uint8_t* first = static_cast<uint8_t*>(arena.allocate(3, 1));
+    uint8_t* second = static_cast<uint8_t*>(arena.allocate(8, 8));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % 8, 0);
+    EXPECT_GT(second, first);
+    EXPECT_EQ(arena.getBytesAllocated(), 11);
+    EXPECT_EQ(arena.getBytesReserved(), 256);
+
+    // Oversized allocations should not waste the current block
+    arena.allocate(1000, 1);
+    EXPECT_EQ(arena.getBytesReserved(), 1256);
+    uint8_t* third = static_cast<uint8_t*>(arena.allocate(8, 8));
+    EXPECT_EQ(third, second + 8);
+
+    arena.release();
+    EXPECT_EQ(arena.getBytesAllocated(), 0);
+    EXPECT_EQ(arena.getBytesReserved(), 0);
+}
+
+//===========================================================================//
+TEST(Arena, OverAligned)
+{
+    // The heap hands out over-aligned memory and takes it back
+    nyra::MemoryResource& heap = nyra::MemoryResource::getDefault();
+    for (size_t alignment = 64; alignment <= 4096; alignment *= 4)
+    {
+        uint8_t* ptr = static_cast<uint8_t*>(heap.allocate(100, alignment));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, 0);
+        ptr[0] = 1;
+        ptr[99] = 2;
+        heap.deallocate(ptr, 100, alignment);
+    }
+
+    // Arena blocks start at the alignment of the request that made them
+    nyra::Arena arena(256);
+    void* first = arena.allocate(8, 1024);
+    void* second = arena.allocate(8, 128);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(first) % 1024, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % 128, 0);
+    EXPECT_EQ(arena.getBytesReserved(), 256);
+}
+
+//===========================================================================//
+TEST(Arena, Containers)
+{
+    nyra::Arena arena(4096);
+    {
+        std::vector<int, nyra::Allocator<int> > values(
+                (nyra::Allocator<int>(arena)));
+        for (int ii = 0; ii < 100; ++ii)
+        {
+            values.push_back(ii);
+        }
+        EXPECT_EQ(values[99], 99);
+        EXPECT_GE(arena.getBytesAllocated(), 100 * sizeof(int));
+    }
+
+    {
+        const nyra::Image image(
+                nyra::Constants::APP_PATH + "../data/unittests/lena.png",
+                arena);
+        const nyra::Image heapImage(
+                nyra::Constants::APP_PATH + "../data/unittests/lena.png");
+        EXPECT_EQ(image, heapImage);
+        EXPECT_GE(arena.getBytesAllocated(), 512 * 512 * 3);
+    }
+    arena.release();
+}
@@ -0,0 +1,154 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <nyra/ParallelRecorder.h>
+#include <nyra/RenderCommandList.h>
+#include <nyra/RenderQueue.h>
+
+namespace
+{
+//===========================================================================//
+class TestGraphics : public nyra::GraphicsInterface
+{
+public:
+    void clear(nyra::WindowsHandle handle) override
+    {
+    }
+
+    void present() override
+    {
+    }
+
+    void screenshot(const std::string& pathname) const override
+    {
+    }
+
+    std::vector<size_t> mOrder;
+};
+
+//===========================================================================//
+class TestRenderable : public nyra::RenderableInterface
+{
+public:
+    TestRenderable(size_t id) :
+        mId(id)
+    {
+    }
+
+    void render(const nyra::Matrix& matrix,
+                nyra::GraphicsInterface& graphics) override
+    {
+        dynamic_cast<TestGraphics&>(graphics).mOrder.push_back(mId);
+    }
+
+    nyra::Vector2U getSize() const override
+    {
+        return nyra::Vector2U(1, 1);
+    }
+
+private:
+    const size_t mId;
+};
+
+//===========================================================================//
+std::vector<size_t> recordFrame(std::vector<TestRenderable>& renderables,
+                                size_t numThreads,
+                                size_t numFrames)
+{
+    nyra::ParallelRecorder<nyra::RenderCommandList> recorder(numThreads);
+    EXPECT_EQ(recorder.getNumLists(), numThreads);
+    TestGraphics graphics;
+    nyra::RenderQueue queue;
+    for (size_t frame = 0; frame < numFrames; ++frame)
+    {
+        graphics.mOrder.clear();
+        recorder.record(renderables.size(),
+                        [&renderables](nyra::RenderCommandList& list,
+                                       size_t begin,
+                                       size_t end)
+        {
+            for (size_t ii = begin; ii < end; ++ii)
+            {
+                list.push(renderables[ii],
+                          nyra::Matrix(),
+                          nyra::RenderQueue::makeKey(
+                                  ii % 3, 0, ii % 5,
+                                  nyra::BlendMode::SOURCE_OVER));
+            }
+        });
+
+        for (size_t ii = 0; ii < recorder.getNumLists(); ++ii)
+        {
+            queue.append(recorder.getList(ii));
+        }
+        queue.flush(graphics);
+    }
+    return graphics.mOrder;
+}
+}
+
+//===========================================================================//
+TEST(ParallelRecorderTest, Deterministic)
+{
+    std::vector<TestRenderable> renderables;
+    for (size_t ii = 0; ii < 1000; ++ii)
+    {
+        renderables.push_back(TestRenderable(ii));
+    }
+
+    const std::vector<size_t> serial = recordFrame(renderables, 1, 1);
+    ASSERT_EQ(serial.size(), renderables.size());
+    EXPECT_EQ(recordFrame(renderables, 2, 3), serial);
+    EXPECT_EQ(recordFrame(renderables, 7, 3), serial);
+    EXPECT_EQ(recordFrame(renderables, 16, 3), serial);
+}
+
+//===========================================================================//
+TEST(ParallelRecorderTest, Exceptions)
+{
+    nyra::ParallelRecorder<nyra::RenderCommandList> recorder(4);
+    EXPECT_THROW(recorder.record(100,
+                                 [](nyra::RenderCommandList& list,
+                                    size_t begin,
+                                    size_t end)
+    {
+        if (begin > 0)
+        {
+            throw std::runtime_error("Worker failed");
+        }
+    }), std::runtime_error);
+
+    // The recorder is still usable afterwards
+    size_t total = 0;
+    std::mutex mutex;
+    recorder.record(100, [&total, &mutex](nyra::RenderCommandList& list,
+                                          size_t begin,
+                                          size_t end)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        total += end - begin;
+    });
+    EXPECT_EQ(total, 100);
+}
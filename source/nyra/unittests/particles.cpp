@@ -0,0 +1,127 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <nyra/ParticleBuffer.h>
+#include <nyra/ParticleEmitter.h>
+
+namespace
+{
+//===========================================================================//
+void fill(nyra::ParticleBuffer& buffer, size_t count)
+{
+    srand(1234);
+    for (size_t ii = 0; ii < count; ++ii)
+    {
+        buffer.spawn(nyra::Vector2F(rand() % 640, rand() % 480),
+                     nyra::Vector2F((rand() % 200) - 100.0f,
+                                    (rand() % 200) - 100.0f),
+                     0.1f + (rand() % 100) / 50.0f,
+                     rand());
+    }
+}
+}
+
+//===========================================================================//
+TEST(ParticleBufferTest, MatchesReference)
+{
+    // An odd count exercises the scalar tail of the SIMD loop
+    const size_t count = 1001;
+    nyra::ParticleBuffer simd(count);
+    nyra::ParticleBuffer reference(count);
+    fill(simd, count);
+    fill(reference, count);
+
+    const nyra::Vector2F gravity(0.0f, 98.0f);
+    for (size_t frame = 0; frame < 90; ++frame)
+    {
+        simd.update(1.0f / 30.0f, gravity, 6);
+        reference.updateReference(1.0f / 30.0f, gravity, 6);
+        ASSERT_EQ(simd.size(), reference.size());
+        for (size_t ii = 0; ii < simd.size(); ++ii)
+        {
+            ASSERT_EQ(simd.getPositionX()[ii], reference.getPositionX()[ii]);
+            ASSERT_EQ(simd.getPositionY()[ii], reference.getPositionY()[ii]);
+            ASSERT_EQ(simd.getAge()[ii], reference.getAge()[ii]);
+            ASSERT_EQ(simd.getColor()[ii], reference.getColor()[ii]);
+            ASSERT_EQ(simd.getFrame()[ii], reference.getFrame()[ii]);
+            ASSERT_LT(simd.getFrame()[ii], 6);
+        }
+    }
+
+    // Every particle lives at most 2.08 seconds
+    EXPECT_EQ(simd.size(), 0);
+}
+
+//===========================================================================//
+TEST(ParticleBufferTest, SpawnAndCompact)
+{
+    nyra::ParticleBuffer buffer(3);
+    EXPECT_TRUE(buffer.spawn(nyra::Vector2F(), nyra::Vector2F(1.0f, 0.0f),
+                             1.0f, 1));
+    EXPECT_TRUE(buffer.spawn(nyra::Vector2F(), nyra::Vector2F(2.0f, 0.0f),
+                             3.0f, 2));
+    EXPECT_TRUE(buffer.spawn(nyra::Vector2F(), nyra::Vector2F(3.0f, 0.0f),
+                             1.0f, 3));
+    EXPECT_FALSE(buffer.spawn(nyra::Vector2F(), nyra::Vector2F(), 1.0f, 4));
+
+    buffer.update(2.0f, nyra::Vector2F());
+    ASSERT_EQ(buffer.size(), 1);
+    EXPECT_EQ(buffer.getColor()[0], 2);
+    EXPECT_EQ(buffer.getPositionX()[0], 4.0f);
+    EXPECT_EQ(buffer.getAge()[0], 2.0f);
+}
+
+//===========================================================================//
+TEST(ParticleEmitterTest, Rate)
+{
+    nyra::ParticleEmitter::Settings settings;
+    settings.capacity = 50;
+    settings.rate = 10.0f;
+    settings.minLifetime = 100.0f;
+    settings.maxLifetime = 100.0f;
+    nyra::ParticleEmitter emitter(settings);
+    emitter.setPosition(nyra::Vector2F(5.0f, 5.0f));
+
+    // Fractions carry over between updates
+    for (size_t ii = 0; ii < 4; ++ii)
+    {
+        emitter.update(0.25f);
+    }
+    EXPECT_EQ(emitter.getParticles().size(), 10);
+
+    // Bursts are clamped to the capacity
+    emitter.emit(100);
+    EXPECT_EQ(emitter.getParticles().size(), 50);
+
+    // The same seed gives the same particles
+    nyra::ParticleEmitter other(settings);
+    other.setPosition(nyra::Vector2F(5.0f, 5.0f));
+    for (size_t ii = 0; ii < 4; ++ii)
+    {
+        other.update(0.25f);
+    }
+    EXPECT_EQ(other.getParticles().getPositionX()[3],
+              emitter.getParticles().getPositionX()[3]);
+}
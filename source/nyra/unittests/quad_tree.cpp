@@ -0,0 +1,166 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <stdlib.h>
+#include <nyra/QuadTree.h>
+
+namespace
+{
+//===========================================================================//
+float random(float min, float max)
+{
+    return min + (max - min) * (rand() / static_cast<float>(RAND_MAX));
+}
+
+//===========================================================================//
+nyra::RectF randomRect()
+{
+    // Some of these land outside of the world on purpose
+    const nyra::Vector2F min(random(-200.0f, 1100.0f),
+                             random(-200.0f, 1100.0f));
+    const float size = rand() % 10 == 0 ? random(100.0f, 600.0f) :
+                                          random(1.0f, 40.0f);
+    return nyra::RectF(min, nyra::Vector2F(min.x + size,
+                                           min.y + size * 0.5f));
+}
+
+//===========================================================================//
+std::vector<size_t> bruteForce(const std::vector<nyra::RectF>& rects,
+                               const std::vector<bool>& used,
+                               const nyra::RectF& area)
+{
+    std::vector<size_t> results;
+    for (size_t ii = 0; ii < rects.size(); ++ii)
+    {
+        if (used[ii] && rects[ii].intersects(area))
+        {
+            results.push_back(ii);
+        }
+    }
+    return results;
+}
+}
+
+//===========================================================================//
+TEST(QuadTreeTest, MatchesBruteForce)
+{
+    const nyra::RectF world(nyra::Vector2F(0.0f, 0.0f),
+                            nyra::Vector2F(1000.0f, 1000.0f));
+    nyra::QuadTree tree(world, 6);
+    const size_t numItems = 2000;
+    std::vector<nyra::RectF> rects;
+    std::vector<bool> used(numItems, true);
+    for (size_t ii = 0; ii < numItems; ++ii)
+    {
+        rects.push_back(randomRect());
+        tree.insert(ii, rects.back());
+    }
+    EXPECT_EQ(tree.size(), numItems);
+
+    std::vector<size_t> results;
+    for (size_t round = 0; round < 20; ++round)
+    {
+        // Move and remove some items between queries
+        for (size_t ii = 0; ii < numItems / 10; ++ii)
+        {
+            const size_t id = rand() % numItems;
+            if (!used[id])
+            {
+                rects[id] = randomRect();
+                tree.insert(id, rects[id]);
+                used[id] = true;
+            }
+            else if (rand() % 4 == 0)
+            {
+                tree.remove(id);
+                used[id] = false;
+            }
+            else
+            {
+                rects[id] = randomRect();
+                tree.update(id, rects[id]);
+            }
+        }
+
+        const nyra::RectF area = randomRect();
+        tree.query(area, results);
+        std::sort(results.begin(), results.end());
+        EXPECT_EQ(results, bruteForce(rects, used, area));
+
+        // Several areas find each overlapping item once
+        std::vector<nyra::RectF> areas(3);
+        std::vector<size_t> expected;
+        for (size_t ii = 0; ii < areas.size(); ++ii)
+        {
+            areas[ii] = randomRect();
+            const std::vector<size_t> found =
+                    bruteForce(rects, used, areas[ii]);
+            expected.insert(expected.end(), found.begin(), found.end());
+        }
+        std::sort(expected.begin(), expected.end());
+        expected.erase(std::unique(expected.begin(), expected.end()),
+                       expected.end());
+        tree.query(areas, results);
+        std::sort(results.begin(), results.end());
+        EXPECT_EQ(results, expected);
+    }
+}
+
+//===========================================================================//
+TEST(QuadTreeTest, LargerThanWorld)
+{
+    // Centered inside the world but reaching past the root loose bounds
+    nyra::QuadTree tree(nyra::RectF(nyra::Vector2F(0.0f, 0.0f),
+                                    nyra::Vector2F(100.0f, 100.0f)));
+    tree.insert(0, nyra::RectF(nyra::Vector2F(-100.0f, -100.0f),
+                               nyra::Vector2F(200.0f, 200.0f)));
+    std::vector<size_t> results;
+    tree.query(nyra::RectF(nyra::Vector2F(160.0f, 160.0f),
+                           nyra::Vector2F(170.0f, 170.0f)), results);
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0], 0);
+
+    tree.update(0, nyra::RectF(nyra::Vector2F(10.0f, 10.0f),
+                               nyra::Vector2F(20.0f, 20.0f)));
+    tree.query(nyra::RectF(nyra::Vector2F(160.0f, 160.0f),
+                           nyra::Vector2F(170.0f, 170.0f)), results);
+    EXPECT_TRUE(results.empty());
+}
+
+//===========================================================================//
+TEST(QuadTreeTest, Errors)
+{
+    EXPECT_THROW(nyra::QuadTree(nyra::RectF()), std::runtime_error);
+
+    nyra::QuadTree tree(nyra::RectF(nyra::Vector2F(0.0f, 0.0f),
+                                    nyra::Vector2F(10.0f, 10.0f)));
+    const nyra::RectF rect(nyra::Vector2F(1.0f, 1.0f),
+                           nyra::Vector2F(2.0f, 2.0f));
+    tree.insert(3, rect);
+    EXPECT_THROW(tree.insert(3, rect), std::runtime_error);
+    EXPECT_THROW(tree.remove(2), std::runtime_error);
+    tree.remove(3);
+    EXPECT_EQ(tree.size(), 0);
+}
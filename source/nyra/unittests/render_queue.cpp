@@ -0,0 +1,211 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <nyra/RenderQueue.h>
+
+namespace
+{
+//===========================================================================//
+class TestGraphics : public nyra::GraphicsInterface
+{
+public:
+    void clear(nyra::WindowsHandle handle) override
+    {
+    }
+
+    void present() override
+    {
+    }
+
+    void screenshot(const std::string& pathname) const override
+    {
+    }
+
+    std::vector<size_t> mOrder;
+};
+
+//===========================================================================//
+class TestRenderable : public nyra::RenderableInterface
+{
+public:
+    TestRenderable(size_t id) :
+        mId(id)
+    {
+    }
+
+    void render(const nyra::Matrix& matrix,
+                nyra::GraphicsInterface& graphics) override
+    {
+        dynamic_cast<TestGraphics&>(graphics).mOrder.push_back(mId);
+    }
+
+    nyra::Vector2U getSize() const override
+    {
+        return nyra::Vector2U(1, 1);
+    }
+
+private:
+    const size_t mId;
+};
+}
+
+//===========================================================================//
+TEST(RenderQueueTest, Keys)
+{
+    const uint64_t base = nyra::RenderQueue::makeKey(
+            1, 10, 5, nyra::BlendMode::SOURCE_OVER);
+
+    // Each field outranks the ones after it
+    EXPECT_LT(base, nyra::RenderQueue::makeKey(
+            2, 0, 0, nyra::BlendMode::REPLACE));
+    EXPECT_LT(base, nyra::RenderQueue::makeKey(
+            1, 11, 0, nyra::BlendMode::REPLACE));
+    EXPECT_LT(base, nyra::RenderQueue::makeKey(
+            1, 10, 6, nyra::BlendMode::REPLACE));
+    EXPECT_LT(base, nyra::RenderQueue::makeKey(
+            1, 10, 5, nyra::BlendMode::ADDITIVE));
+    EXPECT_GT(base, nyra::RenderQueue::makeKey(
+            0, 0xFFFF, 0xFFFFFFFF, nyra::BlendMode::MULTIPLY));
+}
+
+//===========================================================================//
+TEST(RenderQueueTest, Sort)
+{
+    std::vector<TestRenderable> renderables;
+    for (size_t ii = 0; ii < 8; ++ii)
+    {
+        renderables.push_back(TestRenderable(ii));
+    }
+
+    // Alternate textures on two layers, pushed back to front
+    const uint32_t textures[] = {1, 2, 1, 2, 1, 2, 1, 2};
+    const uint8_t layers[] = {1, 1, 1, 1, 0, 0, 0, 0};
+    nyra::RenderQueue queue;
+    for (size_t ii = 0; ii < renderables.size(); ++ii)
+    {
+        queue.push(renderables[ii],
+                   nyra::Matrix(),
+                   nyra::RenderQueue::makeKey(
+                           layers[ii], 0, textures[ii],
+                           nyra::BlendMode::SOURCE_OVER));
+    }
+
+    TestGraphics graphics;
+    queue.flush(graphics);
+    EXPECT_EQ(queue.getNumCommands(), 8);
+    EXPECT_EQ(queue.getStateChangesBefore(), 8);
+    EXPECT_EQ(queue.getStateChangesAfter(), 4);
+
+    // Layers first, then textures, keeping push order for equal keys
+    const size_t expected[] = {4, 6, 5, 7, 0, 2, 1, 3};
+    ASSERT_EQ(graphics.mOrder.size(), 8);
+    for (size_t ii = 0; ii < 8; ++ii)
+    {
+        EXPECT_EQ(graphics.mOrder[ii], expected[ii]);
+    }
+
+    // The queue is empty after a flush
+    graphics.mOrder.clear();
+    queue.flush(graphics);
+    EXPECT_TRUE(graphics.mOrder.empty());
+    EXPECT_EQ(queue.getNumCommands(), 0);
+}
+
+//===========================================================================//
+TEST(RenderQueueTest, Stable)
+{
+    const size_t numCommands = 10000;
+    std::vector<TestRenderable> renderables;
+    std::vector<uint64_t> keys;
+    nyra::RenderQueue queue;
+    renderables.reserve(numCommands);
+    for (size_t ii = 0; ii < numCommands; ++ii)
+    {
+        renderables.push_back(TestRenderable(ii));
+        keys.push_back(nyra::RenderQueue::makeKey(
+                rand() % 4, rand() % 3, rand() % 16,
+                nyra::BlendMode::SOURCE_OVER));
+        queue.push(renderables.back(), nyra::Matrix(), keys.back());
+    }
+
+    TestGraphics graphics;
+    queue.flush(graphics);
+    ASSERT_EQ(graphics.mOrder.size(), numCommands);
+    for (size_t ii = 1; ii < numCommands; ++ii)
+    {
+        const size_t previous = graphics.mOrder[ii - 1];
+        const size_t current = graphics.mOrder[ii];
+        ASSERT_LE(keys[previous], keys[current]);
+        if (keys[previous] == keys[current])
+        {
+            ASSERT_LT(previous, current);
+        }
+    }
+    EXPECT_LE(queue.getStateChangesAfter(), queue.getStateChangesBefore());
+}
+
+//===========================================================================//
+TEST(RenderQueueTest, Cameras)
+{
+    std::vector<TestRenderable> renderables;
+    for (size_t ii = 0; ii < 4; ++ii)
+    {
+        renderables.push_back(TestRenderable(ii));
+    }
+
+    // Pushed back to front, the first two are near the origin and the
+    // last two are far away
+    const float positions[] = {10.0f, 20.0f, 510.0f, 520.0f};
+    nyra::RenderQueue queue;
+    for (size_t ii = 0; ii < renderables.size(); ++ii)
+    {
+        queue.push(renderables[ii],
+                   nyra::Matrix(nyra::Vector2F(positions[ii], 10.0f),
+                                nyra::Vector2F(0.0f, 0.0f),
+                                nyra::Vector2F(1.0f, 1.0f),
+                                0.0f),
+                   nyra::RenderQueue::makeKey(
+                           static_cast<uint8_t>(3 - ii), 0, 0,
+                           nyra::BlendMode::SOURCE_OVER));
+    }
+
+    // A full view of the origin and a minimap of the far objects
+    std::vector<nyra::Camera> cameras(2);
+    cameras[0].setPosition(nyra::Vector2F(50.0f, 50.0f));
+    cameras[1].setPosition(nyra::Vector2F(515.0f, 15.0f));
+    cameras[1].setViewport(nyra::RectF(nyra::Vector2F(0.75f, 0.0f),
+                                       nyra::Vector2F(1.0f, 0.25f)));
+
+    // The queue is sorted once and each view draws what it can see
+    TestGraphics graphics;
+    queue.flush(graphics, cameras, nyra::Vector2U(100, 100));
+    EXPECT_EQ(queue.getNumCommands(), 4);
+    const size_t expected[] = {1, 0, 3, 2};
+    ASSERT_EQ(graphics.mOrder.size(), 4);
+    for (size_t ii = 0; ii < 4; ++ii)
+    {
+        EXPECT_EQ(graphics.mOrder[ii], expected[ii]);
+    }
+}
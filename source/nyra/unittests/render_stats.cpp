@@ -0,0 +1,146 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <nyra/RenderStats.h>
+#include <nyra/Json.h>
+
+namespace
+{
+//===========================================================================//
+void renderFrame(nyra::RenderStats& stats, size_t numDraws)
+{
+    int textures[2];
+    stats.beginClear();
+    stats.endClear();
+    for (size_t ii = 0; ii < numDraws; ++ii)
+    {
+        stats.addDraw(&textures[ii % 2], 4);
+    }
+    stats.beginPresent();
+    stats.endPresent();
+}
+}
+
+//===========================================================================//
+TEST(RenderStatsTest, Frame)
+{
+    nyra::RenderStats stats;
+    int first;
+    int second;
+    stats.addDraw(&first, 4);
+    stats.addDraw(&first, 4);
+    stats.addDraw(&second, 6);
+    stats.addDraw(nullptr, 3);
+    stats.addStateChange();
+    stats.addOffscreenPass();
+    EXPECT_EQ(stats.getCurrent().drawCalls, 4);
+    EXPECT_EQ(stats.getCurrent().vertices, 17);
+    EXPECT_EQ(stats.getCurrent().textureSwitches, 3);
+    EXPECT_EQ(stats.getCurrent().stateChanges, 1);
+    EXPECT_EQ(stats.getCurrent().offscreenPasses, 1);
+    EXPECT_EQ(stats.getNumFrames(), 0);
+    EXPECT_THROW(stats.getLast(), std::runtime_error);
+
+    stats.beginPresent();
+    stats.endPresent();
+    EXPECT_EQ(stats.getNumFrames(), 1);
+    EXPECT_EQ(stats.getLast().frame, 0);
+    EXPECT_EQ(stats.getLast().drawCalls, 4);
+    EXPECT_GE(stats.getLast().presentTime, 0.0);
+    EXPECT_EQ(stats.getLast().frameTime, 0.0);
+
+    // Counting starts over, including the bound texture
+    EXPECT_EQ(stats.getCurrent().frame, 1);
+    EXPECT_EQ(stats.getCurrent().drawCalls, 0);
+    stats.addDraw(nullptr, 3);
+    EXPECT_EQ(stats.getCurrent().textureSwitches, 0);
+    stats.addDraw(&first, 4);
+    EXPECT_EQ(stats.getCurrent().textureSwitches, 1);
+}
+
+//===========================================================================//
+TEST(RenderStatsTest, History)
+{
+    nyra::RenderStats stats(3);
+    for (size_t ii = 0; ii < 5; ++ii)
+    {
+        renderFrame(stats, ii);
+    }
+
+    // Only the three most recent frames are kept, oldest first
+    ASSERT_EQ(stats.getNumFrames(), 3);
+    for (size_t ii = 0; ii < 3; ++ii)
+    {
+        EXPECT_EQ(stats.getFrame(ii).frame, ii + 2);
+        EXPECT_EQ(stats.getFrame(ii).drawCalls, ii + 2);
+        EXPECT_EQ(stats.getFrame(ii).textureSwitches, ii + 2);
+    }
+    EXPECT_EQ(stats.getLast().frame, 4);
+
+    const nyra::FrameStats average = stats.getAverage();
+    EXPECT_EQ(average.frame, 4);
+    EXPECT_EQ(average.drawCalls, 3);
+    EXPECT_EQ(average.vertices, 12);
+
+    stats.clear();
+    EXPECT_EQ(stats.getNumFrames(), 0);
+    EXPECT_EQ(stats.getAverage().drawCalls, 0);
+    EXPECT_EQ(stats.getCurrent().frame, 0);
+}
+
+//===========================================================================//
+TEST(RenderStatsTest, Dump)
+{
+    nyra::RenderStats stats;
+    renderFrame(stats, 2);
+    renderFrame(stats, 5);
+
+    std::stringstream csv;
+    stats.writeCSV(csv);
+    std::string line;
+    std::getline(csv, line);
+    EXPECT_EQ(line, "frame,draw_calls,vertices,texture_switches,"
+                    "state_changes,offscreen_passes,clear_ms,present_ms,"
+                    "frame_ms");
+    std::getline(csv, line);
+    EXPECT_EQ(line.substr(0, 12), "0,2,8,2,0,0,");
+    std::getline(csv, line);
+    EXPECT_EQ(line.substr(0, 13), "1,5,20,5,0,0,");
+    EXPECT_FALSE(std::getline(csv, line));
+
+    std::stringstream json;
+    stats.writeJSON(json);
+    const nyra::JsonValue frames = nyra::JsonValue::parse(json.str());
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames[0]["frame"].asNumber(), 0.0);
+    EXPECT_EQ(frames[0]["draw_calls"].asNumber(), 2.0);
+    EXPECT_EQ(frames[0]["vertices"].asNumber(), 8.0);
+    EXPECT_EQ(frames[1]["frame"].asNumber(), 1.0);
+    EXPECT_EQ(frames[1]["texture_switches"].asNumber(), 5.0);
+    EXPECT_GE(frames[1]["frame_ms"].asNumber(), 0.0);
+
+    EXPECT_THROW(stats.save("stats.txt"), std::runtime_error);
+}
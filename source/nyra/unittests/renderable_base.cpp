@@ -0,0 +1,134 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <nyra/RenderableBase.h>
+
+namespace
+{
+//===========================================================================//
+class TestGraphics : public nyra::GraphicsInterface
+{
+public:
+    TestGraphics() :
+        mDraws(0)
+    {
+    }
+
+    void clear(nyra::WindowsHandle handle) override
+    {
+    }
+
+    void present() override
+    {
+    }
+
+    void screenshot(const std::string& pathname) const override
+    {
+    }
+
+    size_t mDraws;
+};
+
+//===========================================================================//
+class OtherGraphics : public TestGraphics
+{
+};
+
+//===========================================================================//
+class WrongGraphics : public nyra::GraphicsInterface
+{
+public:
+    void clear(nyra::WindowsHandle handle) override
+    {
+    }
+
+    void present() override
+    {
+    }
+
+    void screenshot(const std::string& pathname) const override
+    {
+    }
+};
+
+//===========================================================================//
+class TestRenderable :
+        public nyra::RenderableBase<TestRenderable, TestGraphics>
+{
+public:
+    using nyra::RenderableBase<TestRenderable, TestGraphics>::render;
+
+    void render(const nyra::Matrix& matrix, TestGraphics& graphics)
+    {
+        ++graphics.mDraws;
+    }
+
+    nyra::Vector2U getSize() const override
+    {
+        return nyra::Vector2U(1, 1);
+    }
+};
+}
+
+//===========================================================================//
+TEST(RenderableBaseTest, Dispatch)
+{
+    TestRenderable renderable;
+    TestGraphics graphics;
+    OtherGraphics other;
+    const nyra::Matrix matrix;
+
+    // Statically bound
+    renderable.render(matrix, graphics);
+    EXPECT_EQ(graphics.mDraws, 1);
+
+    // Through the virtual adapter
+    nyra::RenderableInterface& base = renderable;
+    base.render(matrix, graphics);
+    EXPECT_EQ(graphics.mDraws, 2);
+    base.render(matrix, other);
+    EXPECT_EQ(other.mDraws, 1);
+
+    WrongGraphics wrong;
+    EXPECT_THROW(base.render(matrix, wrong), std::runtime_error);
+}
+
+//===========================================================================//
+TEST(RenderableBaseTest, BackendLookup)
+{
+    // Switching between backend types gives the right answer every time
+    OtherGraphics graphics;
+    nyra::GraphicsInterface& base = graphics;
+    for (size_t ii = 0; ii < 3; ++ii)
+    {
+        EXPECT_EQ(base.getBackend<TestGraphics>(), &graphics);
+        EXPECT_EQ(base.getBackend<OtherGraphics>(), &graphics);
+        EXPECT_EQ(base.getBackend<WrongGraphics>(), nullptr);
+    }
+
+    // Copies look themselves up rather than the original
+    OtherGraphics copy(graphics);
+    nyra::GraphicsInterface& copyBase = copy;
+    EXPECT_EQ(copyBase.getBackend<OtherGraphics>(), &copy);
+}
@@ -0,0 +1,155 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <nyra/ResourceCache.h>
+#include <nyra/Constants.h>
+
+namespace
+{
+//===========================================================================//
+struct TestResource
+{
+    TestResource(const std::string& pathname) :
+        pathname(pathname)
+    {
+    }
+
+    std::string pathname;
+};
+}
+
+//===========================================================================//
+TEST(ResourceCacheTest, Pathname)
+{
+    EXPECT_EQ(nyra::lexicallyNormalPathname("a/./b//c"), "a/b/c");
+    EXPECT_EQ(nyra::lexicallyNormalPathname("a/b/../c/"), "a/c");
+    EXPECT_EQ(nyra::lexicallyNormalPathname("../a/.."), "..");
+    EXPECT_EQ(nyra::lexicallyNormalPathname("/../a//b"), "/a/b");
+    EXPECT_EQ(nyra::lexicallyNormalPathname("a/.."), ".");
+    EXPECT_EQ(nyra::lexicallyNormalPathname("//"), "/");
+
+    // Files that do not exist still get one key per spelling
+    EXPECT_EQ(nyra::normalizePathname("missing/./dir/../file.png"),
+              "missing/file.png");
+}
+
+//===========================================================================//
+TEST(ResourceCacheTest, Shares)
+{
+    const std::string pathname(nyra::Constants::APP_PATH +
+                               "../data/unittests/lena.png");
+    nyra::ResourceCache<TestResource> cache(
+            nyra::ResourceCache<TestResource>::Loader(
+                [](const std::string& key)
+                {
+                    return std::unique_ptr<TestResource>(
+                            new TestResource(key));
+                }),
+            [](const TestResource&)
+            {
+                return size_t(100);
+            });
+
+    {
+        nyra::ResourceCache<TestResource>::Handle first = cache.load(pathname);
+        nyra::ResourceCache<TestResource>::Handle second = cache.load(
+                nyra::Constants::APP_PATH + "../data//unittests/./lena.png");
+        EXPECT_EQ(first, second);
+        EXPECT_EQ(first->pathname, nyra::normalizePathname(pathname));
+        EXPECT_EQ(cache.getMisses(), 1);
+        EXPECT_EQ(cache.getHits(), 1);
+        EXPECT_EQ(cache.getNumResident(), 1);
+        EXPECT_EQ(cache.getBytesResident(), 100);
+    }
+
+    // The last handle takes the entry with it
+    EXPECT_EQ(cache.getNumResident(), 0);
+    EXPECT_EQ(cache.getNumEntries(), 0);
+    EXPECT_EQ(cache.getBytesResident(), 0);
+    cache.load(pathname);
+    EXPECT_EQ(cache.getMisses(), 2);
+    EXPECT_EQ(cache.getNumEntries(), 0);
+}
+
+//===========================================================================//
+TEST(ResourceCacheTest, Failure)
+{
+    size_t calls = 0;
+    nyra::ResourceCache<TestResource> cache(
+            [&calls](const std::string& key) -> std::unique_ptr<TestResource>
+            {
+                if (++calls == 1)
+                {
+                    throw std::runtime_error("Unable to load: " + key);
+                }
+                return std::unique_ptr<TestResource>(new TestResource(key));
+            });
+
+    // A failed load leaves nothing behind to wait on
+    EXPECT_THROW(cache.load("resource"), std::runtime_error);
+    EXPECT_EQ(cache.getNumEntries(), 0);
+    EXPECT_EQ(cache.load("resource")->pathname, "resource");
+    EXPECT_EQ(calls, 2);
+}
+
+//===========================================================================//
+TEST(ResourceCacheTest, Threads)
+{
+    // A slow loader keeps the first load in flight while the rest ask
+    std::atomic<size_t> calls(0);
+    nyra::ResourceCache<TestResource> cache(
+            [&calls](const std::string& key)
+            {
+                ++calls;
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                return std::unique_ptr<TestResource>(new TestResource(key));
+            });
+
+    std::vector<nyra::ResourceCache<TestResource>::Handle> handles(8);
+    std::vector<std::thread> threads;
+    for (size_t ii = 0; ii < handles.size(); ++ii)
+    {
+        threads.push_back(std::thread([&cache, &handles, ii]()
+        {
+            handles[ii] = cache.load("resource");
+        }));
+    }
+    for (size_t ii = 0; ii < threads.size(); ++ii)
+    {
+        threads[ii].join();
+    }
+
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(cache.getMisses(), 1);
+    EXPECT_EQ(cache.getHits(), handles.size() - 1);
+    for (size_t ii = 1; ii < handles.size(); ++ii)
+    {
+        EXPECT_EQ(handles[ii], handles[0]);
+    }
+}
@@ -0,0 +1,260 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <nyra/Scene.h>
+
+namespace
+{
+//===========================================================================//
+class TestGraphics : public nyra::GraphicsInterface
+{
+public:
+    void setScissor(const nyra::RectI& area) override
+    {
+        mScissor = area;
+    }
+
+    void clear(nyra::WindowsHandle handle) override
+    {
+    }
+
+    void present() override
+    {
+    }
+
+    void screenshot(const std::string& pathname) const override
+    {
+    }
+
+    nyra::RectI mScissor;
+};
+
+//===========================================================================//
+class TestRenderable : public nyra::RenderableInterface
+{
+public:
+    TestRenderable() :
+        mRenders(0),
+        mSize(10, 10)
+    {
+    }
+
+    void render(const nyra::Matrix& matrix,
+                nyra::GraphicsInterface& graphics) override
+    {
+        ++mRenders;
+        mPosition = nyra::Vector2F(matrix(0, 2), matrix(1, 2));
+        mScissor = dynamic_cast<TestGraphics&>(graphics).mScissor;
+    }
+
+    nyra::Vector2U getSize() const override
+    {
+        return mSize;
+    }
+
+    size_t mRenders;
+    nyra::Vector2U mSize;
+    nyra::Vector2F mPosition;
+    nyra::RectI mScissor;
+};
+}
+
+//===========================================================================//
+TEST(SceneTest, Cull)
+{
+    nyra::Scene scene(nyra::RectF(nyra::Vector2F(0.0f, 0.0f),
+                                  nyra::Vector2F(1000.0f, 1000.0f)));
+    const nyra::RectF view(nyra::Vector2F(0.0f, 0.0f),
+                           nyra::Vector2F(100.0f, 100.0f));
+
+    // A row of objects 50 pixels apart
+    std::vector<TestRenderable> renderables(20);
+    std::vector<nyra::Transform> transforms(20);
+    for (size_t ii = 0; ii < transforms.size(); ++ii)
+    {
+        transforms[ii].setSize(renderables[ii].getSize());
+        transforms[ii].setPosition(50.0f * ii + 20.0f, 20.0f);
+        EXPECT_EQ(scene.add(renderables[ii], transforms[ii]), ii);
+    }
+    EXPECT_EQ(scene.getNumObjects(), 20);
+    EXPECT_EQ(scene.getBounds(0),
+              nyra::RectF(nyra::Vector2F(15.0f, 15.0f),
+                          nyra::Vector2F(25.0f, 25.0f)));
+
+    const std::vector<size_t>& visible = scene.cull(view);
+    ASSERT_EQ(visible.size(), 2);
+    EXPECT_EQ(visible[0], 0);
+    EXPECT_EQ(visible[1], 1);
+    EXPECT_EQ(scene.getNumVisible(), 2);
+    EXPECT_EQ(scene.getNumCulled(), 18);
+    EXPECT_EQ(scene.getNumUpdated(), 0);
+
+    // Only marked objects are updated, once however often they are marked
+    transforms[10].setPosition(60.0f, 60.0f);
+    scene.markMoved(10);
+    scene.markMoved(10);
+    scene.cull(view);
+    EXPECT_EQ(scene.getNumUpdated(), 1);
+    EXPECT_EQ(scene.getNumVisible(), 3);
+    scene.cull(view);
+    EXPECT_EQ(scene.getNumUpdated(), 0);
+
+    // Objects removed after being marked are skipped
+    transforms[12].setPosition(70.0f, 520.0f);
+    scene.markMoved(12);
+    scene.remove(12);
+    scene.cull(view);
+    EXPECT_EQ(scene.getNumUpdated(), 0);
+    EXPECT_EQ(scene.getNumVisible(), 3);
+    EXPECT_EQ(scene.add(renderables[12], transforms[12]), 12);
+
+    // Removed ids are reused
+    scene.remove(1);
+    scene.cull(view);
+    EXPECT_EQ(scene.getNumVisible(), 2);
+    EXPECT_EQ(scene.getNumCulled(), 17);
+    EXPECT_EQ(scene.add(renderables[1], transforms[1]), 1);
+
+    TestGraphics graphics;
+    scene.render(view, graphics);
+    EXPECT_EQ(renderables[0].mRenders, 1);
+    EXPECT_EQ(renderables[10].mRenders, 1);
+    EXPECT_EQ(renderables[2].mRenders, 0);
+}
+
+//===========================================================================//
+TEST(SceneTest, Damage)
+{
+    nyra::Scene scene(nyra::RectF(nyra::Vector2F(0.0f, 0.0f),
+                                  nyra::Vector2F(1000.0f, 1000.0f)));
+    std::vector<TestRenderable> renderables(2);
+    std::vector<nyra::Transform> transforms(2);
+    for (size_t ii = 0; ii < transforms.size(); ++ii)
+    {
+        transforms[ii].setSize(renderables[ii].getSize());
+        transforms[ii].setPosition(100.0f * ii + 20.0f, 20.0f);
+        scene.add(renderables[ii], transforms[ii]);
+    }
+
+    // Adding objects damages where they are
+    EXPECT_EQ(scene.getDamage(),
+              nyra::RectF(nyra::Vector2F(15.0f, 15.0f),
+                          nyra::Vector2F(125.0f, 25.0f)));
+    scene.clearDamage();
+    scene.update();
+    EXPECT_TRUE(scene.getDamage().isEmpty());
+
+    // Moving damages both the old and new location
+    transforms[0].setPosition(20.0f, 50.0f);
+    scene.markMoved(0);
+    scene.update();
+    EXPECT_EQ(scene.getDamage(),
+              nyra::RectF(nyra::Vector2F(15.0f, 15.0f),
+                          nyra::Vector2F(25.0f, 55.0f)));
+    scene.clearDamage();
+
+    // Changes that do not move an object are marked by hand
+    scene.invalidate(1);
+    EXPECT_EQ(scene.getDamage(),
+              nyra::RectF(nyra::Vector2F(115.0f, 15.0f),
+                          nyra::Vector2F(125.0f, 25.0f)));
+    scene.clearDamage();
+
+    // A frame of a different size moves the bounds with it
+    renderables[1].mSize = nyra::Vector2U(30, 10);
+    scene.invalidate(1);
+    EXPECT_EQ(scene.getDamage(),
+              nyra::RectF(nyra::Vector2F(115.0f, 15.0f),
+                          nyra::Vector2F(145.0f, 25.0f)));
+    EXPECT_EQ(scene.getBounds(1), scene.getDamage());
+    EXPECT_EQ(scene.cull(nyra::RectF(nyra::Vector2F(130.0f, 0.0f),
+                                     nyra::Vector2F(140.0f, 50.0f))).size(),
+              1);
+    scene.clearDamage();
+
+    // Marking picks up a new size as well
+    renderables[0].mSize = nyra::Vector2U(10, 30);
+    scene.markMoved(0);
+    scene.update();
+    EXPECT_EQ(scene.getBounds(0),
+              nyra::RectF(nyra::Vector2F(15.0f, 45.0f),
+                          nyra::Vector2F(25.0f, 75.0f)));
+    scene.clearDamage();
+
+    scene.remove(1);
+    EXPECT_EQ(scene.getDamage(),
+              nyra::RectF(nyra::Vector2F(115.0f, 15.0f),
+                          nyra::Vector2F(145.0f, 25.0f)));
+}
+
+//===========================================================================//
+TEST(SceneTest, Cameras)
+{
+    nyra::Scene scene(nyra::RectF(nyra::Vector2F(0.0f, 0.0f),
+                                  nyra::Vector2F(1000.0f, 1000.0f)));
+    std::vector<TestRenderable> renderables(20);
+    std::vector<nyra::Transform> transforms(20);
+    for (size_t ii = 0; ii < transforms.size(); ++ii)
+    {
+        transforms[ii].setSize(renderables[ii].getSize());
+        transforms[ii].setPosition(50.0f * ii + 20.0f, 20.0f);
+        scene.add(renderables[ii], transforms[ii]);
+    }
+
+    // Split screen with each half looking at an opposite end of the row
+    const nyra::Vector2U target(200, 100);
+    std::vector<nyra::Camera> cameras(2);
+    cameras[0].setPosition(nyra::Vector2F(50.0f, 50.0f));
+    cameras[0].setViewport(nyra::RectF(nyra::Vector2F(0.0f, 0.0f),
+                                       nyra::Vector2F(0.5f, 1.0f)));
+    cameras[1].setPosition(nyra::Vector2F(850.0f, 50.0f));
+    cameras[1].setViewport(nyra::RectF(nyra::Vector2F(0.5f, 0.0f),
+                                       nyra::Vector2F(1.0f, 1.0f)));
+
+    // Nothing between the views is visited
+    const std::vector<size_t>& visible = scene.cull(cameras, target);
+    ASSERT_EQ(visible.size(), 4);
+    EXPECT_EQ(visible[0], 0);
+    EXPECT_EQ(visible[1], 1);
+    EXPECT_EQ(visible[2], 16);
+    EXPECT_EQ(visible[3], 17);
+    EXPECT_EQ(scene.getNumCulled(), 16);
+    EXPECT_EQ(scene.getViewArea(1),
+              nyra::RectF(nyra::Vector2F(800.0f, 0.0f),
+                          nyra::Vector2F(900.0f, 100.0f)));
+
+    TestGraphics graphics;
+    scene.render(cameras, target, graphics);
+    EXPECT_EQ(renderables[0].mRenders, 1);
+    EXPECT_EQ(renderables[17].mRenders, 1);
+    EXPECT_EQ(renderables[8].mRenders, 0);
+
+    // Each view is moved into and clipped to its own half
+    EXPECT_FLOAT_EQ(renderables[0].mPosition.x, 15.0f);
+    EXPECT_EQ(renderables[0].mScissor,
+              nyra::RectI(nyra::Vector2I(0, 0), nyra::Vector2I(100, 100)));
+    EXPECT_FLOAT_EQ(renderables[16].mPosition.x, 115.0f);
+    EXPECT_EQ(renderables[16].mScissor,
+              nyra::RectI(nyra::Vector2I(100, 0), nyra::Vector2I(200, 100)));
+}
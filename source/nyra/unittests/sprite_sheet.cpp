@@ -0,0 +1,179 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <fstream>
+#include <nyra/SpriteSheet.h>
+#include <nyra/AnimateSheet.h>
+#include <nyra/Constants.h>
+
+namespace
+{
+//===========================================================================//
+struct FrameAccessor : public nyra::SpriteInterface
+{
+public:
+    FrameAccessor() :
+        frame(0)
+    {
+    }
+
+    void setFrame(size_t index) override
+    {
+        frame = index;
+    }
+
+    size_t frame;
+};
+
+//===========================================================================//
+void checkSheet(const nyra::SpriteSheet& sheet)
+{
+    EXPECT_EQ(sheet.getTexturePathname(), nyra::Constants::APP_PATH +
+              "../data/unittests/hero.png");
+    EXPECT_EQ(sheet.getTextureSize(), nyra::Vector2U(128, 64));
+    ASSERT_EQ(sheet.getNumFrames(), 4);
+
+    const nyra::SpriteSheet::Frame& idle = sheet.getFrame(0);
+    EXPECT_EQ(idle.name, "idle");
+    EXPECT_EQ(idle.size, nyra::Vector2U(32, 64));
+    EXPECT_EQ(idle.pivot, nyra::Vector2F(0.5f, 1.0f));
+    EXPECT_FLOAT_EQ(idle.duration, 0.5f);
+
+    const nyra::SpriteSheet::Frame& last = sheet.getFrame(3);
+    EXPECT_EQ(last.position, nyra::Vector2U(96, 0));
+    EXPECT_EQ(last.pivot, nyra::Vector2F(0.5f, 0.5f));
+    EXPECT_FLOAT_EQ(last.duration, 0.1f);
+
+    const nyra::SpriteSheet::FrameUV& uv = sheet.getUV(3);
+    EXPECT_FLOAT_EQ(uv.left, 0.75f);
+    EXPECT_FLOAT_EQ(uv.top, 0.0f);
+    EXPECT_FLOAT_EQ(uv.right, 0.875f);
+    EXPECT_FLOAT_EQ(uv.bottom, 0.5f);
+
+    EXPECT_EQ(sheet.getFrameIndex("run_1"), 2);
+    EXPECT_THROW(sheet.getFrameIndex("jump"), std::runtime_error);
+
+    ASSERT_EQ(sheet.getNumAnimations(), 3);
+    const nyra::SpriteSheet::Animation& run = sheet.getAnimation("run");
+    EXPECT_EQ(run.mode, nyra::AnimateMode::PING_PONG_LOOP);
+    ASSERT_EQ(run.frames.size(), 3);
+    EXPECT_EQ(run.frames[0], 1);
+    EXPECT_EQ(sheet.getAnimation("land").mode,
+              nyra::AnimateMode::PLAY_ONCE);
+    EXPECT_THROW(sheet.getAnimation("jump"), std::runtime_error);
+}
+}
+
+//===========================================================================//
+TEST(SpriteSheetTest, Load)
+{
+    const std::string pathname(nyra::Constants::APP_PATH +
+                               "../data/unittests/sprite_sheet");
+    const nyra::SpriteSheet sheet(pathname + ".json");
+    checkSheet(sheet);
+
+    // The compiled form holds exactly the same data
+    sheet.write(pathname + ".bin");
+    checkSheet(nyra::SpriteSheet(pathname + ".bin"));
+
+    EXPECT_THROW(nyra::SpriteSheet(pathname + ".json.missing"),
+                 std::runtime_error);
+    EXPECT_THROW(nyra::SpriteSheet(nyra::Constants::APP_PATH +
+                                   "../data/unittests/lena.png"),
+                 std::runtime_error);
+}
+
+//===========================================================================//
+TEST(SpriteSheetTest, Animate)
+{
+    const nyra::SpriteSheet sheet(nyra::Constants::APP_PATH +
+                                  "../data/unittests/sprite_sheet.json");
+    FrameAccessor accessor;
+
+    // Ping pong using the duration of each frame. Steps carry a small
+    // margin since the durations are stored as floats.
+    nyra::AnimateSheet run(sheet, "run");
+    run.inject(accessor);
+    EXPECT_EQ(accessor.frame, 1);
+    EXPECT_TRUE(run.update(0.11));
+    EXPECT_EQ(accessor.frame, 2);
+    EXPECT_TRUE(run.update(0.15));
+    EXPECT_EQ(accessor.frame, 2);
+    EXPECT_TRUE(run.update(0.05));
+    EXPECT_EQ(accessor.frame, 3);
+    EXPECT_TRUE(run.update(0.1));
+    EXPECT_EQ(accessor.frame, 2);
+    EXPECT_TRUE(run.update(0.2));
+    EXPECT_EQ(accessor.frame, 1);
+    EXPECT_TRUE(run.update(0.1));
+    EXPECT_EQ(accessor.frame, 2);
+
+    // Play once finishes after the last frame
+    nyra::AnimateSheet land(sheet, "land");
+    EXPECT_EQ(land.getFrame(), 3);
+    EXPECT_TRUE(land.update(0.11));
+    EXPECT_EQ(land.getFrame(), 0);
+    EXPECT_TRUE(land.update(0.4));
+    EXPECT_FALSE(land.update(0.1));
+
+    // Running past the end in one update still shows the last frame
+    nyra::AnimateSheet skip(sheet, "land");
+    skip.inject(accessor);
+    EXPECT_EQ(accessor.frame, 3);
+    EXPECT_FALSE(skip.update(10.0));
+    EXPECT_EQ(accessor.frame, 0);
+}
+
+//===========================================================================//
+TEST(SpriteSheetTest, Corrupt)
+{
+    const std::string pathname(nyra::Constants::APP_PATH +
+                               "../data/unittests/sprite_sheet_corrupt");
+    const char* const sheets[] =
+    {
+        // Negative, wrapping and zero duration frames
+        "{\"texture\": \"a.png\", \"size\": [8, 8], \"frames\": "
+        "[{\"name\": \"a\", \"rect\": [-1, 0, 2, 2]}]}",
+        "{\"texture\": \"a.png\", \"size\": [8, 8], \"frames\": "
+        "[{\"name\": \"a\", \"rect\": [4294967295, 0, 2, 2]}]}",
+        "{\"texture\": \"a.png\", \"size\": [8, 8], \"frames\": "
+        "[{\"name\": \"a\", \"rect\": [0, 0, 2, 2], "
+        "\"duration\": 0}]}"
+    };
+    for (size_t ii = 0; ii < 3; ++ii)
+    {
+        std::ofstream(pathname + ".json") << sheets[ii];
+        EXPECT_THROW(nyra::SpriteSheet(pathname + ".json"),
+                     std::runtime_error) << sheets[ii];
+    }
+
+    // A frame count far larger than the file
+    {
+        std::ofstream file((pathname + ".bin").c_str(), std::ios::binary);
+        const uint32_t header[] = {1, 0, 8, 8, 0xFFFFFFFF};
+        file.write("NYSS", 4);
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    }
+    EXPECT_THROW(nyra::SpriteSheet(pathname + ".bin"), std::runtime_error);
+}
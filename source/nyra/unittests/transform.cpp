@@ -47,6 +47,19 @@ TEST(Transform, AccessorsMutators)
     EXPECT_EQ(transform.getPivot(), testVec);
 }
 
+TEST(Transform, Version)
+{
+    nyra::Transform transform;
+    const size_t version = transform.getVersion();
+    transform.getMatrix();
+    EXPECT_EQ(transform.getVersion(), version);
+
+    transform.setPosition(1.0f, 2.0f);
+    EXPECT_NE(transform.getVersion(), version);
+    EXPECT_EQ(transform.getMatrix()(0, 2), 1.0f);
+    EXPECT_EQ(transform.getMatrix()(1, 2), 2.0f);
+}
+
 TEST(Transform, Matrix)
 {
     //TODO: Test matrix